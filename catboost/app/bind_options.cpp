@@ -1060,6 +1060,52 @@ static void BindDistributedTrainingParams(NLastGetopt::TOpts* parserPtr, NJson::
         .Handler1T<TString>([plainJsonPtr](const TString& nodeFile) {
             (*plainJsonPtr)["file_with_hosts"] = nodeFile;
         });
+
+    const auto statsCodecHelp = TString::Join(
+        "Encoding of bucket statistics sent between hosts, must be one of: ",
+        GetEnumAllNames<EDistributedStatsCodec>(),
+        ". Float codecs reduce traffic at the cost of float32 precision; default is Double");
+    parser
+        .AddLongOption("distributed-stats-codec", statsCodecHelp)
+        .RequiredArgument("String")
+        .Handler1T<EDistributedStatsCodec>([plainJsonPtr](const auto codec) {
+            (*plainJsonPtr)["distributed_stats_codec"] = ToString(codec);
+        });
+
+    const auto reduceTopologyHelp = TString::Join(
+        "Where outputs of workers are reduced, must be one of: ",
+        GetEnumAllNames<EDistributedReduceTopology>(),
+        ". Tree pre-aggregates them on workers, which scales better with many workers; default is Master");
+    parser
+        .AddLongOption("distributed-reduce-topology", reduceTopologyHelp)
+        .RequiredArgument("String")
+        .Handler1T<EDistributedReduceTopology>([plainJsonPtr](const auto topology) {
+            (*plainJsonPtr)["distributed_reduce_topology"] = ToString(topology);
+        });
+
+    const auto dataLoadingHelp = TString::Join(
+        "How workers get their parts of the learn dataset, must be one of: ",
+        GetEnumAllNames<EDistributedDataLoading>(),
+        ". Workers makes each worker read its object range of the quantized learn pool, which must be available"
+        " at the same path on all hosts; default is Master");
+    parser
+        .AddLongOption("distributed-data-loading", dataLoadingHelp)
+        .RequiredArgument("String")
+        .Handler1T<EDistributedDataLoading>([plainJsonPtr](const auto dataLoading) {
+            (*plainJsonPtr)["distributed_data_loading"] = ToString(dataLoading);
+        });
+
+    const auto partitioningHelp = TString::Join(
+        "How the work is split between workers, must be one of: ",
+        GetEnumAllNames<EDistributedPartitioning>(),
+        ". Features gives all objects to every worker and splits features between them, which suits wide datasets;"
+        " default is Objects");
+    parser
+        .AddLongOption("distributed-partitioning", partitioningHelp)
+        .RequiredArgument("String")
+        .Handler1T<EDistributedPartitioning>([plainJsonPtr](const auto partitioning) {
+            (*plainJsonPtr)["distributed_partitioning"] = ToString(partitioning);
+        });
 }
 
 static void BindSystemParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* plainJsonPtr) {
@@ -1071,12 +1117,30 @@ static void BindSystemParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* p
             (*plainJsonPtr).InsertValue("thread_count", count);
         });
 
+    const auto threadAffinityHelp = TString::Join(
+        "CPU only. Binding of training threads to CPUs, must be one of: ",
+        GetEnumAllNames<EThreadAffinity>(),
+        ". NumaNodes binds each thread to its own CPU taking CPUs NUMA node by node, so that each thread keeps"
+        " processing the same part of data in its node's memory; default is None");
+    parser
+        .AddLongOption("thread-affinity", threadAffinityHelp)
+        .RequiredArgument("String")
+        .Handler1T<EThreadAffinity>([plainJsonPtr](const auto threadAffinity) {
+            (*plainJsonPtr)["thread_affinity"] = ToString(threadAffinity);
+        });
+
     parser.AddLongOption("used-ram-limit", "Try to limit used memory. CPU only. WARNING: This option affects CTR memory usage only.\nAllowed suffixes: GB, MB, KB in different cases")
             .RequiredArgument("TARGET_RSS")
             .Handler1T<TString>([plainJsonPtr](const TString& param) {
                 (*plainJsonPtr)["used_ram_limit"] = param;
             });
 
+    parser.AddLongOption("features-column-store-dir", "CPU only. Move quantized features data to a memory-mapped file in this directory to train on datasets that do not fit in RAM")
+            .RequiredArgument("PATH")
+            .Handler1T<TString>([plainJsonPtr](const TString& param) {
+                (*plainJsonPtr)["features_column_store_dir"] = param;
+            });
+
     parser
             .AddLongOption("gpu-ram-part")
             .RequiredArgument("double")
@@ -1139,6 +1203,12 @@ static void BindBinarizationParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonVa
         .Handler1T<ENanMode>([plainJsonPtr](const auto nanMode) {
             (*plainJsonPtr)["nan_mode"] = ToString(nanMode);
         });
+
+    parser.AddLongOption("dev-quantile-sketch-rank-error", "calculate float features borders from mergeable quantile sketches of all values with this rank error instead of exact values of a subsample, 0 - disabled")
+        .RequiredArgument("float")
+        .Handler1T<float>([plainJsonPtr](float rankError) {
+            (*plainJsonPtr)["dev_quantile_sketch_rank_error"] = rankError;
+        });
 }
 
 static void BindCatboostParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* plainJsonPtr) {
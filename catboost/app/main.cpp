@@ -5,13 +5,18 @@
 #include <catboost/private/libs/app_helpers/mode_normalize_model_helpers.h>
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/private/libs/init/init_reg.h>
+#include <catboost/libs/logging/event_trace.h>
 #include <catboost/libs/logging/logging.h>
 
 #include <library/getopt/small/modchooser.h>
 #include <library/svnversion/svnversion.h>
 
 #include <util/generic/ptr.h>
+#include <util/generic/scope.h>
+#include <util/generic/strbuf.h>
 #include <util/stream/output.h>
+#include <util/string/cast.h>
+#include <util/system/getpid.h>
 
 #include <cstdlib>
 
@@ -55,6 +60,14 @@ int main(int argc, const char* argv[]) {
     try {
         NCB::TCmdLineInit::Do(argc, argv);
 
+        // workers run with the master's environment, each of them writes its own trace
+        const bool isWorker = (argc > 1) && (TStringBuf(argv[1]) == AsStringBuf("run-worker"));
+        StartEventTraceFromEnv(isWorker ? TString::Join(".worker.", ToString(GetPID())) : TString());
+        Y_SCOPE_EXIT() {
+            // the trace has to be finished before static objects (including the global tracer) are destroyed
+            StopEventTrace();
+        };
+
         TSetLoggingVerbose inThisScope;
         TModChooser modChooser;
         modChooser.AddMode("fit", mode_fit, "train model");
@@ -69,6 +82,7 @@ int main(int argc, const char* argv[]) {
         modChooser.AddMode("roc", mode_roc, "evaluate data for roc curve");
         modChooser.AddMode("model-based-eval", mode_model_based_eval, "model-based eval");
         modChooser.AddMode("normalize-model", mode_normalize_model, "normalize model on a pool");
+        modChooser.AddMode("convert-pool", mode_convert_pool, "convert pool to raw-columns or quantized format");
         modChooser.DisableSvnRevisionOption();
         modChooser.SetVersionHandler(PrintProgramSvnVersion);
         return modChooser.Run(argc, argv);
@@ -0,0 +1,153 @@
+#include "modes.h"
+
+#include <catboost/libs/data/load_data.h>
+#include <catboost/libs/data/raw_columns_pool.h>
+#include <catboost/libs/data/streaming_quantization.h>
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/helpers/restorable_rng.h>
+#include <catboost/libs/logging/logging.h>
+#include <catboost/private/libs/data_util/path_with_scheme.h>
+#include <catboost/private/libs/options/analytical_mode_params.h>
+#include <catboost/private/libs/options/binarization_options.h>
+#include <catboost/private/libs/quantized_pool/serialization.h>
+
+#include <library/getopt/small/last_getopt.h>
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/serialized_enum.h>
+#include <util/system/info.h>
+
+
+using namespace NCB;
+
+int mode_convert_pool(int argc, const char* argv[]) {
+    TPathWithScheme poolPath;
+    NCatboostOptions::TColumnarPoolFormatParams columnarPoolFormatParams;
+    TPathWithScheme pairsFilePath;
+    TPathWithScheme groupWeightsFilePath;
+    TPathWithScheme baselineFilePath;
+    TString outputPath;
+    int threadCount = NSystemInfo::CachedNumberOfCpus();
+    bool quantize = false;
+    NCatboostOptions::TBinarizationOptions floatFeaturesBinarization(
+        EBorderSelectionType::GreedyLogSum,
+        254,
+        ENanMode::Min
+    );
+    ui32 blockSize = 100000;
+    ui64 seed = 0;
+    TString compressionCodec;
+
+    auto parser = NLastGetopt::TOpts();
+    parser.AddHelpOption();
+    parser.AddLongOption("input-path", "input path")
+        .Required()
+        .RequiredArgument("[SCHEME://]PATH")
+        .Handler1T<TStringBuf>([&poolPath](const TStringBuf& str) {
+            poolPath = TPathWithScheme(str, "dsv");
+        });
+    BindColumnarPoolFormatParams(&parser, &columnarPoolFormatParams);
+    parser.AddLongOption("input-pairs", "path to the pairs")
+        .RequiredArgument("[SCHEME://]PATH")
+        .Handler1T<TStringBuf>([&pairsFilePath](const TStringBuf& str) {
+            pairsFilePath = TPathWithScheme(str, "dsv");
+        });
+    parser.AddLongOption("input-group-weights", "path to the group weights")
+        .RequiredArgument("[SCHEME://]PATH")
+        .Handler1T<TStringBuf>([&groupWeightsFilePath](const TStringBuf& str) {
+            groupWeightsFilePath = TPathWithScheme(str, "dsv");
+        });
+    parser.AddLongOption("input-baseline", "path to the baseline")
+        .RequiredArgument("[SCHEME://]PATH")
+        .Handler1T<TStringBuf>([&baselineFilePath](const TStringBuf& str) {
+            baselineFilePath = TPathWithScheme(str, "dsv");
+        });
+    parser.AddLongOption('o', "output-path", "output path of the pool in raw-columns (or quantized with --quantize) format")
+        .Required()
+        .RequiredArgument("PATH")
+        .StoreResult(&outputPath);
+    parser.AddLongOption('T', "thread-count", "worker thread count")
+        .RequiredArgument("N")
+        .StoreResult(&threadCount);
+    parser.AddLongOption("quantize", "quantize features and save the pool in quantized format. Raw data is read in blocks, so the whole raw dataset is never in memory. Only dsv and libsvm input without pairs and group weights is supported")
+        .NoArgument()
+        .SetFlag(&quantize);
+    parser.AddLongOption('x', "border-count", "with --quantize: count of borders per float feature. Should be in range [1, 255]")
+        .RequiredArgument("int")
+        .Handler1T<ui32>([&floatFeaturesBinarization](ui32 count) {
+            floatFeaturesBinarization.BorderCount = count;
+        });
+    parser.AddLongOption("feature-border-type", TString::Join("with --quantize: must be one of: ", GetEnumAllNames<EBorderSelectionType>()))
+        .RequiredArgument("border-type")
+        .Handler1T<EBorderSelectionType>([&floatFeaturesBinarization](EBorderSelectionType type) {
+            floatFeaturesBinarization.BorderSelectionType = type;
+        });
+    parser.AddLongOption("nan-mode", TString::Join("with --quantize: must be one of: ", GetEnumAllNames<ENanMode>()))
+        .RequiredArgument("nan-mode")
+        .Handler1T<ENanMode>([&floatFeaturesBinarization](ENanMode nanMode) {
+            floatFeaturesBinarization.NanMode = nanMode;
+        });
+    parser.AddLongOption("block-size", "with --quantize: count of objects read and quantized at once")
+        .RequiredArgument("N")
+        .StoreResult(&blockSize);
+    parser.AddLongOption("random-seed", "with --quantize: seed of the sample used for borders calculation")
+        .RequiredArgument("N")
+        .StoreResult(&seed);
+    parser.AddLongOption("compression-codec", "with --quantize: block codec to compress feature chunks with (e.g. lz4, zstd_1), chunks are not compressed by default")
+        .RequiredArgument("CODEC")
+        .StoreResult(&compressionCodec);
+    parser.SetFreeArgsNum(0);
+    NLastGetopt::TOptsParseResult parserResult{&parser, argc, argv};
+
+    NPar::TLocalExecutor localExecutor;
+    localExecutor.RunAdditionalThreads(threadCount - 1);
+
+    if (quantize) {
+        CB_ENSURE(
+            !pairsFilePath.Inited() && !groupWeightsFilePath.Inited(),
+            "Pairs and group weights are not supported with --quantize"
+        );
+        CB_ENSURE(blockSize > 0, "Block size should be positive");
+        floatFeaturesBinarization.Validate();
+
+        TSrcData quantizedSrcData;
+        TRestorableFastRng64 rand(seed);
+        QuantizeInBlocks(
+            poolPath,
+            baselineFilePath,
+            columnarPoolFormatParams,
+            /*ignoredFeatures*/ {},
+            /*classNames*/ {},
+            floatFeaturesBinarization,
+            /*perFloatFeatureQuantization*/ {},
+            TQuantizationOptions(),
+            blockSize,
+            [&] (TQuantizedDataProviderPtr block) {
+                AddQuantizedBlockToSrcData(std::move(block), &localExecutor, &quantizedSrcData);
+            },
+            &rand,
+            &localExecutor
+        );
+        SaveQuantizedPool(quantizedSrcData, outputPath, compressionCodec);
+        CATBOOST_INFO_LOG << "Pool with " << quantizedSrcData.DocumentCount << " objects saved to quantized://"
+            << outputPath << Endl;
+        return 0;
+    }
+
+    const auto dataProvider = ReadDataset(
+        poolPath,
+        pairsFilePath,
+        groupWeightsFilePath,
+        baselineFilePath,
+        columnarPoolFormatParams,
+        /*ignoredFeatures*/ {},
+        EObjectsOrder::Undefined,
+        TDatasetSubset::MakeColumns(),
+        /*classNames*/ Nothing(),
+        &localExecutor
+    );
+    SaveRawColumnsPool(*dataProvider, outputPath, &localExecutor);
+    CATBOOST_INFO_LOG << "Pool with " << dataProvider->GetObjectCount() << " objects saved to raw-columns://"
+        << outputPath << Endl;
+    return 0;
+}
@@ -3,16 +3,25 @@
 
 #include <catboost/libs/data/data_provider.h>
 #include <catboost/libs/data/objects_grouping.h>
+#include <catboost/libs/data/text_parsing.h>
+#include <catboost/private/libs/data_util/line_data_reader.h>
 
+#include <library/string_utils/csv/csv.h>
 #include <library/testing/benchmark/bench.h>
 #include <library/unittest/tests_data.h>
 
+#include <util/string/cast.h>
+#include <util/string/printf.h>
+
 using namespace NCB;
 using namespace NDataNewUT;
 
 const size_t PrimersCount = 100;
 const size_t FeaturesCount = 100;
 
+// big enough for the parsing to dominate dataset creation overhead
+const size_t FloatPoolPrimersCount = 10000;
+
 TString GetPool() {
     TString pool = "";
     for (size_t primer = 0; primer < PrimersCount; ++primer) {
@@ -135,3 +144,155 @@ Y_CPU_BENCHMARK(DsvLoaderQuotedCatFeatures, iface) {
         Y_DO_NOT_OPTIMIZE_AWAY(dataProvider);
     }
 }
+
+static double GetFloatValue(size_t primer, size_t feature) {
+    return double((primer * 7919 + feature * 104729) % 1000003) / 1000003.0 - 0.5;
+}
+
+static TString GetFloatPool() {
+    TString pool = "";
+    for (size_t primer = 0; primer < FloatPoolPrimersCount; ++primer) {
+        pool += ToString(primer % 2);
+        for (size_t feature = 0; feature < FeaturesCount; ++feature) {
+            pool += Sprintf("\t%.6f", GetFloatValue(primer, feature));
+        }
+        pool += '\n';
+    }
+    return pool;
+}
+
+static TString GetFloatLibSvmPool() {
+    TString pool = "";
+    for (size_t primer = 0; primer < FloatPoolPrimersCount; ++primer) {
+        pool += ToString(primer % 2);
+        for (size_t feature = 0; feature < FeaturesCount; ++feature) {
+            pool += Sprintf(" %zu:%.6f", feature + 1, GetFloatValue(primer, feature));
+        }
+        pool += '\n';
+    }
+    return pool;
+}
+
+static const TString& GetCachedFloatPool() {
+    static const TString pool = GetFloatPool();
+    return pool;
+}
+
+static void ReadDatasetIterations(const TSrcData& srcData, size_t iterations) {
+    TReadDatasetMainParams readDatasetMainParams;
+    NPar::TLocalExecutor localExecutor;
+
+    TVector<THolder<TTempFile>> srcDataFiles;
+    SaveSrcData(srcData, &readDatasetMainParams, &srcDataFiles);
+
+    for (size_t i = 0; i < iterations; ++i) {
+        auto dataProvider = ReadDataset(
+            readDatasetMainParams.PoolPath,
+            readDatasetMainParams.PairsFilePath,        // can be uninited
+            readDatasetMainParams.GroupWeightsFilePath, // can be uninited
+            readDatasetMainParams.BaselineFilePath,     // can be uninited
+            readDatasetMainParams.ColumnarPoolFormatParams,
+            TVector<ui32>{},
+            EObjectsOrder::Undefined,
+            TDatasetSubset::MakeColumns(),
+            /*classNames*/ Nothing(),
+            &localExecutor);
+        Y_DO_NOT_OPTIMIZE_AWAY(dataProvider);
+    }
+}
+
+Y_CPU_BENCHMARK(DsvLoaderFloatFeatures, iface) {
+    TString Cd = "0\tTarget";
+    for (size_t feature = 0; feature < FeaturesCount; ++feature) {
+        Cd += "\n" + ToString(feature + 1) + "\tNum";
+    }
+
+    TSrcData srcData;
+    srcData.CdFileData = Cd;
+    srcData.DatasetFileData = GetCachedFloatPool();
+
+    ReadDatasetIterations(srcData, iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(LibSvmLoaderFloatFeatures, iface) {
+    const TString pool = GetFloatLibSvmPool();
+
+    TSrcData srcData;
+    srcData.Scheme = "libsvm";
+    srcData.DatasetFileData = pool;
+
+    ReadDatasetIterations(srcData, iface.Iterations());
+}
+
+/* Components of text loading on the same data:
+ *  memory scan as a lower bound, old and new field splitting and float parsing.
+ */
+
+Y_CPU_BENCHMARK(FloatPoolCountLines, iface) {
+    const TString& pool = GetCachedFloatPool();
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        Y_DO_NOT_OPTIMIZE_AWAY(CountLines(TStringBuf(pool)));
+    }
+}
+
+Y_CPU_BENCHMARK(FloatPoolCsvSplitter, iface) {
+    const TString& pool = GetCachedFloatPool();
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        size_t fieldCount = 0;
+        for (TStringBuf data = pool, line; data.NextTok('\n', line); ) {
+            auto splitter = NCsvFormat::CsvSplitter(line, '\t', '\0');
+            do {
+                Y_DO_NOT_OPTIMIZE_AWAY(splitter.Consume());
+                ++fieldCount;
+            } while (splitter.Step());
+        }
+        Y_DO_NOT_OPTIMIZE_AWAY(fieldCount);
+    }
+}
+
+Y_CPU_BENCHMARK(FloatPoolDelimitedFieldSplitter, iface) {
+    const TString& pool = GetCachedFloatPool();
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        size_t fieldCount = 0;
+        for (TStringBuf data = pool, line; data.NextTok('\n', line); ) {
+            TDelimitedFieldSplitter splitter(line, '\t');
+            for (TStringBuf field; splitter.Next(&field); ) {
+                Y_DO_NOT_OPTIMIZE_AWAY(field);
+                ++fieldCount;
+            }
+        }
+        Y_DO_NOT_OPTIMIZE_AWAY(fieldCount);
+    }
+}
+
+static TVector<TString> GetFloatPoolValues() {
+    TVector<TString> values;
+    for (size_t primer = 0; primer < 1000; ++primer) {
+        for (size_t feature = 0; feature < FeaturesCount; ++feature) {
+            values.push_back(Sprintf("%.6f", GetFloatValue(primer, feature)));
+        }
+    }
+    return values;
+}
+
+Y_CPU_BENCHMARK(FloatPoolTryFromString, iface) {
+    const TVector<TString> values = GetFloatPoolValues();
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        for (const auto& value : values) {
+            float result;
+            Y_DO_NOT_OPTIMIZE_AWAY(TryFromString<float>(value, result));
+            Y_DO_NOT_OPTIMIZE_AWAY(result);
+        }
+    }
+}
+
+Y_CPU_BENCHMARK(FloatPoolTryParseFloat, iface) {
+    const TVector<TString> values = GetFloatPoolValues();
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        for (const auto& value : values) {
+            float result;
+            Y_DO_NOT_OPTIMIZE_AWAY(TryParseFloat(value, &result));
+            Y_DO_NOT_OPTIMIZE_AWAY(result);
+        }
+    }
+}
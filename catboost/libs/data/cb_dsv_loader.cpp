@@ -1,5 +1,6 @@
 #include "baseline.h"
 #include "cb_dsv_loader.h"
+#include "text_parsing.h"
 
 #include <catboost/libs/column_description/cd_parser.h>
 #include <catboost/private/libs/data_util/exists_checker.h>
@@ -21,7 +22,7 @@ namespace NCB {
     TCBDsvDataLoader::TCBDsvDataLoader(TDatasetLoaderPullArgs&& args)
         : TCBDsvDataLoader(
             TLineDataLoaderPushArgs {
-                GetLineDataReader(args.PoolPath, args.CommonArgs.PoolFormat),
+                GetLineDataReader(args.PoolPath, args.CommonArgs.PoolFormat, args.CommonArgs.LocalExecutor),
                 std::move(args.CommonArgs)
             }
         )
@@ -29,9 +30,10 @@ namespace NCB {
     }
 
     TCBDsvDataLoader::TCBDsvDataLoader(TLineDataLoaderPushArgs&& args)
-        : TAsyncProcDataLoaderBase<TString>(std::move(args.CommonArgs))
+        : TAsyncProcDataLoaderBase<TStringBuf>(std::move(args.CommonArgs))
         , FieldDelimiter(Args.PoolFormat.Delimiter)
         , LineDataReader(std::move(args.Reader))
+        , LineReader(LineDataReader.Get(), 2 * Args.BlockSize)
         , BaselineReader(Args.BaselineFilePath, args.CommonArgs.ClassNames)
     {
         CB_ENSURE(!Args.PairsFilePath.Inited() || CheckExists(Args.PairsFilePath),
@@ -47,8 +49,8 @@ namespace NCB {
             headerColumns = TVector<TString>(NCsvFormat::CsvSplitter(*header, FieldDelimiter, '"'));
         }
 
-        TString firstLine;
-        CB_ENSURE(LineDataReader->ReadLine(&firstLine), "TCBDsvDataLoader: no data rows in pool");
+        TStringBuf firstLine;
+        CB_ENSURE(LineReader.ReadLine(&firstLine), "TCBDsvDataLoader: no data rows in pool");
         const ui32 columnsCount = TVector<TString>(NCsvFormat::CsvSplitter(firstLine, FieldDelimiter, '"')).size();
 
         auto columnsDescription = TDataColumnsMetaInfo{ CreateColumnsDescription(columnsCount) };
@@ -117,7 +119,7 @@ namespace NCB {
 
         auto& columnsDescription = DataMetaInfo.ColumnsInfo->Columns;
 
-        auto parseBlock = [&](TString& line, int lineIdx) {
+        auto parseBlock = [&](TStringBuf line, int lineIdx) {
             const auto& featuresLayout = *DataMetaInfo.FeaturesLayout;
 
             ui32 featureId = 0;
@@ -135,9 +137,7 @@ namespace NCB {
 
             size_t tokenCount = 0;
             try {
-                auto splitter = NCsvFormat::CsvSplitter(line, FieldDelimiter, catFeatures.empty() ? '\0' : '"');
-                do {
-                    TStringBuf token = splitter.Consume();
+                auto processToken = [&] (TStringBuf token) {
                     CB_ENSURE(
                         tokenCount < columnsDescription.size(),
                         "wrong column count: expected " << columnsDescription.ysize() << ", found " << tokenCount
@@ -230,7 +230,19 @@ namespace NCB {
                             << "\"): " << e.what();
                     }
                     ++tokenCount;
-                } while (splitter.Step());
+                };
+                if (catFeatures.empty() || (line.find('"') == TStringBuf::npos)) {
+                    // no quoted values, so quote processing is not needed
+                    TDelimitedFieldSplitter splitter(line, FieldDelimiter);
+                    for (TStringBuf token; splitter.Next(&token); ) {
+                        processToken(token);
+                    }
+                } else {
+                    auto splitter = NCsvFormat::CsvSplitter(line, FieldDelimiter, '"');
+                    do {
+                        processToken(splitter.Consume());
+                    } while (splitter.Step());
+                }
                 CB_ENSURE(
                     tokenCount == columnsDescription.size(),
                     "wrong column count: expected " << columnsDescription.ysize() << ", found " << tokenCount
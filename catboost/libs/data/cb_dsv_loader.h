@@ -8,6 +8,7 @@
 
 #include <util/generic/maybe.h>
 #include <util/generic/ptr.h>
+#include <util/generic/strbuf.h>
 #include <util/generic/string.h>
 #include <util/generic/vector.h>
 #include <util/generic/ylimits.h>
@@ -19,15 +20,15 @@ namespace NCB {
 
     // expose the declaration to allow to derive from it in other modules
     class TCBDsvDataLoader : public IRawObjectsOrderDatasetLoader
-                           , protected TAsyncProcDataLoaderBase<TString>
+                           , protected TAsyncProcDataLoaderBase<TStringBuf>
     {
     public:
-        using TBase = TAsyncProcDataLoaderBase<TString>;
+        using TBase = TAsyncProcDataLoaderBase<TStringBuf>;
 
     protected:
         decltype(auto) GetReadFunc() {
-            return [this](TString* line) -> bool {
-                return LineDataReader->ReadLine(line);
+            return [this](TStringBuf* line) -> bool {
+                return LineReader.ReadLine(line);
             };
         }
 
@@ -71,6 +72,7 @@ namespace NCB {
         TVector<bool> FeatureIgnored; // init in process
         char FieldDelimiter;
         THolder<NCB::ILineDataReader> LineDataReader;
+        TStringBufLineReader LineReader; // keeps lines valid while they are in AsyncRowProcessor read and parse buffers
         TBaselineReader BaselineReader;
 
         // cached
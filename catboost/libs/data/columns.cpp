@@ -1 +1,27 @@
 #include "columns.h"
+
+#include <util/system/align.h>
+#include <util/system/info.h>
+#include <util/system/platform.h>
+
+#if defined(_unix_)
+#include <sys/mman.h>
+#endif
+
+
+void NCB::ReadAheadMemory(const void* begin, size_t size) {
+#if defined(_unix_)
+    if (!size) {
+        return;
+    }
+    const size_t pageSize = NSystemInfo::GetPageSize();
+    const char* alignedBegin = AlignDown((const char*)begin, pageSize);
+    const size_t alignedSize = AlignUp(size + size_t((const char*)begin - alignedBegin), pageSize);
+
+    // result is ignored intentionally: it is just a hint
+    posix_madvise((void*)alignedBegin, alignedSize, POSIX_MADV_WILLNEED);
+#else
+    Y_UNUSED(begin);
+    Y_UNUSED(size);
+#endif
+}
@@ -328,6 +328,9 @@ namespace NCB {
     }
 
 
+    // hint OS to page in memory range if it is backed by a file, no-op for anonymous memory
+    void ReadAheadMemory(const void* begin, size_t size);
+
     template <class T, EFeatureValuesType TType>
     class TCompressedValuesHolderImpl : public TCloneableWithSubsetIndexingValuesHolder<T, TType> {
     public:
@@ -414,6 +417,28 @@ namespace NCB {
             return SrcData.GetBitsPerKey();
         }
 
+        TConstArrayRef<ui64> GetStorage() const {
+            return SrcData.GetStorage();
+        }
+
+        /* replaces storage in place (e.g. with a memory-mapped copy of the same data)
+         * so that holders referencing this one (packed binary, bundle and group parts) stay valid
+         */
+        void SetStorage(TMaybeOwningArrayHolder<ui64> storage) {
+            CB_ENSURE_INTERNAL(
+                storage.GetSize() == SrcData.GetStorage().size(),
+                "SetStorage: new storage size differs from the current one"
+            );
+            SrcData = TCompressedArray(SrcData.GetSize(), SrcData.GetBitsPerKey(), std::move(storage));
+            SrcDataRawPtr = SrcData.GetRawPtr();
+        }
+
+        // hint OS to page in data that is going to be read soon
+        void ReadAhead() const {
+            const auto storage = SrcData.GetStorage();
+            ReadAheadMemory(storage.data(), storage.size() * sizeof(ui64));
+        }
+
     private:
         TCompressedArray SrcData;
         void* SrcDataRawPtr;
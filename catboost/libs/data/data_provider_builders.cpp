@@ -1380,6 +1380,34 @@ namespace NCB {
             );
         }
 
+        void AddFloatFeature(
+            ui32 flatFeatureIdx,
+            ui8 bitsPerDocumentFeature,
+            TMaybeOwningConstArrayHolder<ui64> featureData
+        ) override {
+            FloatFeaturesStorage.SetAll(
+                GetInternalFeatureIdx<EFeatureType::Float>(flatFeatureIdx),
+                ObjectCount,
+                bitsPerDocumentFeature,
+                std::move(featureData),
+                LocalExecutor
+            );
+        }
+
+        void AddCatFeature(
+            ui32 flatFeatureIdx,
+            ui8 bitsPerDocumentFeature,
+            TMaybeOwningConstArrayHolder<ui64> featureData
+        ) override {
+            CategoricalFeaturesStorage.SetAll(
+                GetInternalFeatureIdx<EFeatureType::Categorical>(flatFeatureIdx),
+                ObjectCount,
+                bitsPerDocumentFeature,
+                std::move(featureData),
+                LocalExecutor
+            );
+        }
+
         // TRawTargetData
 
         void AddTargetPart(ui32 objectOffset, TUnalignedArrayBuf<float> targetPart) override {
@@ -1676,6 +1704,11 @@ namespace NCB {
             // view into storage for faster access
             TVector<TArrayRef<ui64>> DenseDstView; // [perTypeFeatureIdx]
 
+            /* holders of external data set by SetAll, DenseDstView points to this data for such features
+             * and DenseDataStorage is empty
+             */
+            TVector<TIntrusivePtr<IResourceHolder>> ExternalDataHolders; // [perTypeFeatureIdx]
+
             TVector<TIndexHelper<ui64>> IndexHelpers; // [perTypeFeatureIdx]
 
             /******************************************************************************************/
@@ -1704,6 +1737,7 @@ namespace NCB {
                 const size_t perTypeFeatureCount = (size_t)featuresLayout.GetFeatureCount(FeatureType);
                 DenseDataStorage.resize(perTypeFeatureCount);
                 DenseDstView.resize(perTypeFeatureCount);
+                ExternalDataHolders.assign(perTypeFeatureCount, nullptr);
                 IsAvailable.resize(perTypeFeatureCount, false); // filled from quantization Schema, then checked
                 IndexHelpers.resize(perTypeFeatureCount, TIndexHelper<ui64>(8));
                 FeatureIdxToPackedBinaryIndex.resize(perTypeFeatureCount);
@@ -1829,6 +1863,49 @@ namespace NCB {
                 }
             }
 
+            void SetAll(
+                TFeatureIdx<FeatureType> perTypeFeatureIdx,
+                ui32 objectCount,
+                ui8 bitsPerDocumentFeature,
+                TMaybeOwningConstArrayHolder<ui64> featureData,
+                NPar::TLocalExecutor* localExecutor
+            ) {
+                if (!IsAvailable[*perTypeFeatureIdx]) {
+                    return;
+                }
+
+                CB_ENSURE_INTERNAL(
+                    featureData.GetSize() == TIndexHelper<ui64>(bitsPerDocumentFeature).CompressedSize(objectCount),
+                    "Feature data size is inconsistent with objectCount; "
+                    LabeledOutput(perTypeFeatureIdx, featureData.GetSize(), objectCount, bitsPerDocumentFeature));
+
+                if (FeatureIdxToPackedBinaryIndex[*perTypeFeatureIdx]) {
+                    // has to be copied to binary packs
+                    Set(
+                        perTypeFeatureIdx,
+                        /*objectOffset*/ 0,
+                        bitsPerDocumentFeature,
+                        TConstArrayRef<ui8>(
+                            (const ui8*)featureData.data(),
+                            (size_t)objectCount * bitsPerDocumentFeature / CHAR_BIT
+                        ),
+                        localExecutor
+                    );
+                    return;
+                }
+
+                CB_ENSURE_INTERNAL(IndexHelpers[*perTypeFeatureIdx].GetBitsPerKey() == bitsPerDocumentFeature,
+                    "BitsPerKey should be equal to bitsPerDocumentFeature");
+
+                // release preallocated storage, data provider's features data is never modified
+                DenseDataStorage[*perTypeFeatureIdx] = nullptr;
+                DenseDstView[*perTypeFeatureIdx] = TArrayRef<ui64>(
+                    const_cast<ui64*>(featureData.data()),
+                    featureData.GetSize()
+                );
+                ExternalDataHolders[*perTypeFeatureIdx] = featureData.GetResourceHolder();
+            }
+
             template <class T, EFeatureValuesType FeatureValuesType>
             void GetResult(
                 ui32 objectCount,
@@ -1866,6 +1943,10 @@ namespace NCB {
                                 )
                             );
                         } else {
+                            TIntrusivePtr<IResourceHolder> dataHolder = DenseDataStorage[perTypeFeatureIdx];
+                            if (!dataHolder) {
+                                dataHolder = ExternalDataHolders[perTypeFeatureIdx];
+                            }
                             result->push_back(
                                 MakeHolder<TCompressedValuesHolderImpl<T, FeatureValuesType>>(
                                     featureId,
@@ -1874,7 +1955,7 @@ namespace NCB {
                                         IndexHelpers[perTypeFeatureIdx].GetBitsPerKey(),
                                         TMaybeOwningArrayHolder<ui64>::CreateOwning(
                                             DenseDstView[perTypeFeatureIdx],
-                                            DenseDataStorage[perTypeFeatureIdx]
+                                            std::move(dataHolder)
                                         )
                                     ),
                                     subsetIndexing
@@ -1927,6 +2008,57 @@ namespace NCB {
     };
 
 
+    template <class TStoredValue>
+    void AddFloatFeaturesFromExternalMatrix(
+        const TStoredValue* data,
+        ui32 objectCount,
+        size_t objectStride,
+        size_t columnStride,
+        TConstArrayRef<ui32> flatFeatureIndices,
+        TIntrusivePtr<IResourceHolder> resourceHolder,
+        IRawFeaturesOrderDataVisitor* visitor
+    ) {
+        CB_ENSURE_INTERNAL(objectStride && columnStride, "Zero stride for external matrix");
+        CB_ENSURE_INTERNAL(data || !objectCount || flatFeatureIndices.empty(), "No data for external matrix");
+
+        for (auto matrixColumnIdx : xrange(flatFeatureIndices.size())) {
+            visitor->AddFloatFeature(
+                flatFeatureIndices[matrixColumnIdx],
+                MakeStridedTypeCastArrayHolder<float, TStoredValue>(
+                    data + matrixColumnIdx * columnStride,
+                    objectCount,
+                    objectStride,
+                    resourceHolder
+                )
+            );
+        }
+    }
+
+#define INSTANTIATE_ADD_FLOAT_FEATURES_FROM_EXTERNAL_MATRIX(TStoredValue) \
+    template void AddFloatFeaturesFromExternalMatrix<TStoredValue>( \
+        const TStoredValue* data, \
+        ui32 objectCount, \
+        size_t objectStride, \
+        size_t columnStride, \
+        TConstArrayRef<ui32> flatFeatureIndices, \
+        TIntrusivePtr<IResourceHolder> resourceHolder, \
+        IRawFeaturesOrderDataVisitor* visitor \
+    );
+
+    INSTANTIATE_ADD_FLOAT_FEATURES_FROM_EXTERNAL_MATRIX(i8)
+    INSTANTIATE_ADD_FLOAT_FEATURES_FROM_EXTERNAL_MATRIX(i16)
+    INSTANTIATE_ADD_FLOAT_FEATURES_FROM_EXTERNAL_MATRIX(i32)
+    INSTANTIATE_ADD_FLOAT_FEATURES_FROM_EXTERNAL_MATRIX(i64)
+    INSTANTIATE_ADD_FLOAT_FEATURES_FROM_EXTERNAL_MATRIX(ui8)
+    INSTANTIATE_ADD_FLOAT_FEATURES_FROM_EXTERNAL_MATRIX(ui16)
+    INSTANTIATE_ADD_FLOAT_FEATURES_FROM_EXTERNAL_MATRIX(ui32)
+    INSTANTIATE_ADD_FLOAT_FEATURES_FROM_EXTERNAL_MATRIX(ui64)
+    INSTANTIATE_ADD_FLOAT_FEATURES_FROM_EXTERNAL_MATRIX(float)
+    INSTANTIATE_ADD_FLOAT_FEATURES_FROM_EXTERNAL_MATRIX(double)
+
+#undef INSTANTIATE_ADD_FLOAT_FEATURES_FROM_EXTERNAL_MATRIX
+
+
     THolder<IDataProviderBuilder> CreateDataProviderBuilder(
         EDatasetVisitorType visitorType,
         const TDataProviderBuilderOptions& options,
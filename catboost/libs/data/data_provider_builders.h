@@ -6,10 +6,12 @@
 #include "visitor.h"
 
 #include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/helpers/resource_holder.h>
 #include <catboost/libs/helpers/sparse_array.h>
 
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/array_ref.h>
 #include <util/generic/ptr.h>
 
 #include <functional>
@@ -93,6 +95,28 @@ namespace NCB {
     };
 
 
+    /*
+     * Adds float features from an externally owned dense matrix without copying the data:
+     *  element for (objectIdx, matrixColumnIdx) is data[objectIdx * objectStride + matrixColumnIdx * columnStride],
+     *  so row-major (columnStride = 1), column-major (objectStride = 1) and sliced matrices are supported.
+     * Strides are in elements.
+     * resourceHolder keeps the data alive while the resulting data provider (or its subsets) reference it,
+     *  it can be nullptr if the caller guarantees that the data outlives them.
+     *
+     * Explicitly instantiated for float, double and integer types.
+     */
+    template <class TStoredValue>
+    void AddFloatFeaturesFromExternalMatrix(
+        const TStoredValue* data,
+        ui32 objectCount,
+        size_t objectStride,
+        size_t columnStride,
+        TConstArrayRef<ui32> flatFeatureIndices, // [matrixColumnIdx]
+        TIntrusivePtr<IResourceHolder> resourceHolder,
+        IRawFeaturesOrderDataVisitor* visitor
+    );
+
+
     /*
      * call builderVisitor's methods in loader
      * then call GetResult of dataProvider
@@ -1,6 +1,7 @@
 #include "libsvm_loader.h"
 
 #include "features_layout.h"
+#include "text_parsing.h"
 
 #include <catboost/libs/column_description/cd_parser.h>
 #include <catboost/private/libs/data_util/exists_checker.h>
@@ -26,7 +27,7 @@ namespace NCB {
     TLibSvmDataLoader::TLibSvmDataLoader(TDatasetLoaderPullArgs&& args)
         : TLibSvmDataLoader(
             TLineDataLoaderPushArgs {
-                GetLineDataReader(args.PoolPath, args.CommonArgs.PoolFormat),
+                GetLineDataReader(args.PoolPath, args.CommonArgs.PoolFormat, args.CommonArgs.LocalExecutor),
                 std::move(args.CommonArgs)
             }
         )
@@ -34,8 +35,9 @@ namespace NCB {
     }
 
     TLibSvmDataLoader::TLibSvmDataLoader(TLineDataLoaderPushArgs&& args)
-        : TAsyncProcDataLoaderBase<TString>(std::move(args.CommonArgs))
+        : TAsyncProcDataLoaderBase<TStringBuf>(std::move(args.CommonArgs))
         , LineDataReader(std::move(args.Reader))
+        , LineReader(LineDataReader.Get(), 2 * Args.BlockSize)
         , BaselineReader(Args.BaselineFilePath, args.CommonArgs.ClassNames)
     {
         CB_ENSURE(!Args.PairsFilePath.Inited() || CheckExists(Args.PairsFilePath),
@@ -45,8 +47,8 @@ namespace NCB {
         CB_ENSURE(!Args.BaselineFilePath.Inited() || CheckExists(Args.BaselineFilePath),
                   "TLibSvmDataLoader:BaselineFilePathFilePath does not exist");
 
-        TString firstLine;
-        CB_ENSURE(LineDataReader->ReadLine(&firstLine), "TLibSvmDataLoader: no data rows");
+        TStringBuf firstLine;
+        CB_ENSURE(LineReader.ReadLine(&firstLine), "TLibSvmDataLoader: no data rows");
 
         DataMetaInfo.TargetCount = 1;
         DataMetaInfo.BaselineCount = BaselineReader.GetBaselineCount().GetOrElse(0);
@@ -124,7 +126,7 @@ namespace NCB {
     void TLibSvmDataLoader::ProcessBlock(IRawObjectsOrderDataVisitor* visitor) {
         visitor->StartNextBlock(AsyncRowProcessor.GetParseBufferSize());
 
-        auto parseBlock = [&](TString& line, int lineIdx) {
+        auto parseBlock = [&](TStringBuf line, int lineIdx) {
             const auto& featuresLayout = *DataMetaInfo.FeaturesLayout;
 
             TConstArrayRef<TFeatureMetaInfo> featuresMetaInfo = featuresLayout.GetExternalFeaturesMetaInfo();
@@ -140,28 +142,23 @@ namespace NCB {
             catFeatureValues.reserve(featuresLayout.GetCatFeatureCount());
 
             try {
-                auto lineSplitter = StringSplitter(line).Split(' ');
-                auto lineIterator = lineSplitter.begin();
-                auto lineEndIterator = lineSplitter.end();
+                TDelimitedFieldSplitter lineSplitter(line, ' ');
 
                 size_t tokenCount = 0;
                 TStringBuf token;
                 ui32 lastFeatureIdxPlus1 = 0; // +1 to allow to compare first featureIdx
                 try {
-                    CB_ENSURE(lineIterator != lineEndIterator, "line is empty");
-                    token = (*lineIterator).Token();
+                    CB_ENSURE(lineSplitter.Next(&token), "line is empty");
 
                     CB_ENSURE(token.length() != 0, "empty values not supported for Label");
                     float label;
-                    CB_ENSURE(TryFromString(token, label), "Target value must be float");
+                    CB_ENSURE(TryParseFloat(token, &label), "Target value must be float");
                     visitor->AddTarget(lineIdx, label);
 
                     ++tokenCount;
-                    ++lineIterator;
 
                     if (DataMetaInfo.HasGroupId) {
-                        CB_ENSURE(lineIterator != lineEndIterator, "line does not contain 'qid' field");
-                        token = (*lineIterator).Token();
+                        CB_ENSURE(lineSplitter.Next(&token), "line does not contain 'qid' field");
 
                         TStringBuf left;
                         TStringBuf right;
@@ -173,12 +170,9 @@ namespace NCB {
                         visitor->AddGroupId(lineIdx, groupId);
 
                         ++tokenCount;
-                        ++lineIterator;
                     }
 
-                    for (; lineIterator != lineEndIterator; ++lineIterator, ++tokenCount) {
-                        token = (*lineIterator).Token();
-
+                    for (; lineSplitter.Next(&token); ++tokenCount) {
                         TStringBuf left;
                         TStringBuf right;
                         token.Split(':', left, right);
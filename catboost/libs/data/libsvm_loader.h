@@ -20,15 +20,15 @@ namespace NCB {
 
     // expose the declaration to allow to derive from it in other modules
     class TLibSvmDataLoader : public IRawObjectsOrderDatasetLoader
-                           , protected TAsyncProcDataLoaderBase<TString>
+                           , protected TAsyncProcDataLoaderBase<TStringBuf>
     {
     public:
-        using TBase = TAsyncProcDataLoaderBase<TString>;
+        using TBase = TAsyncProcDataLoaderBase<TStringBuf>;
 
     protected:
         decltype(auto) GetReadFunc() {
-            return [this](TString* line) -> bool {
-                return LineDataReader->ReadLine(line);
+            return [this](TStringBuf* line) -> bool {
+                return LineReader.ReadLine(line);
             };
         }
 
@@ -82,6 +82,7 @@ namespace NCB {
     protected:
         TVector<bool> FeatureIgnored; // init in process
         THolder<NCB::ILineDataReader> LineDataReader;
+        TStringBufLineReader LineReader; // keeps lines valid while they are in AsyncRowProcessor read and parse buffers
         TBaselineReader BaselineReader;
 
         // cached
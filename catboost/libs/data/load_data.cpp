@@ -7,6 +7,7 @@
 #include <catboost/libs/column_description/cd_parser.h>
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/int_cast.h>
+#include <catboost/libs/logging/event_trace.h>
 #include <catboost/libs/logging/logging.h>
 
 #include <util/datetime/base.h>
@@ -26,6 +27,8 @@ namespace NCB {
         TMaybe<TVector<TString>*> classNames,
         NPar::TLocalExecutor* localExecutor
     ) {
+        CHROMIUM_TRACE_FUNCTION();
+
         CB_ENSURE_INTERNAL(!baselineFilePath.Inited() || classNames, "ClassNames must be specified if baseline file is specified");
         if (classNames) {
             UpdateClassNamesFromBaselineFile(baselineFilePath, *classNames);
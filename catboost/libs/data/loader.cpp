@@ -1,5 +1,6 @@
 #include "baseline.h"
 #include "loader.h"
+#include "text_parsing.h"
 
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/mem_usage.h>
@@ -297,7 +298,7 @@ namespace NCB {
     }
 
     bool TryParseFloatFeatureValue(TStringBuf stringValue, float* value) {
-        if (!TryFromString<float>(stringValue, *value)) {
+        if (!TryParseFloat(stringValue, value)) {
             if (IsMissingValue(stringValue)) {
                 *value = std::numeric_limits<float>::quiet_NaN();
             } else {
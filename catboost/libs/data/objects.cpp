@@ -17,7 +17,12 @@
 #include <util/generic/ylimits.h>
 #include <util/generic/ymath.h>
 #include <util/stream/format.h>
+#include <util/memory/blob.h>
 #include <util/stream/output.h>
+#include <util/system/align.h>
+#include <util/system/file.h>
+#include <util/system/fs.h>
+#include <util/system/info.h>
 #include <util/system/mem_info.h>
 #include <util/system/yassert.h>
 
@@ -2555,6 +2560,113 @@ void NCB::TQuantizedForCPUObjectsDataProvider::EnsureConsecutiveIfDenseFeaturesD
 }
 
 
+namespace {
+    struct TColumnStoreEntry {
+        TConstArrayRef<ui64> Storage;
+        std::function<void(TMaybeOwningArrayHolder<ui64>)> SetStorage;
+    };
+}
+
+
+template <class T, EFeatureValuesType TType>
+static void AddToColumnStoreIfDense(
+    TTypedFeatureValuesHolder<T, TType>* column,
+    TVector<TColumnStoreEntry>* columnStoreEntries
+) {
+    // non-dense columns (sparse, parts of packs, bundles or groups) are skipped
+    auto* denseColumn = dynamic_cast<TCompressedValuesHolderImpl<T, TType>*>(column);
+    if (denseColumn && !denseColumn->GetStorage().empty()) {
+        columnStoreEntries->push_back(
+            TColumnStoreEntry{
+                denseColumn->GetStorage(),
+                [denseColumn] (TMaybeOwningArrayHolder<ui64> storage) {
+                    denseColumn->SetStorage(std::move(storage));
+                }
+            }
+        );
+    }
+}
+
+
+ui64 NCB::TQuantizedForCPUObjectsDataProvider::MoveFeaturesDataToColumnStore(
+    const TString& filePath,
+    NPar::TLocalExecutor* localExecutor
+) {
+    CB_ENSURE_INTERNAL(!HasFeaturesColumnStore(), "Features data has already been moved to column store");
+
+    // same order as candidates are enumerated during training so that scoring reads file sequentially
+    TVector<TColumnStoreEntry> columnStoreEntries;
+    for (auto& floatFeature : Data.FloatFeatures) {
+        AddToColumnStoreIfDense(floatFeature.Get(), &columnStoreEntries);
+    }
+    for (auto& catFeature : Data.CatFeatures) {
+        AddToColumnStoreIfDense(catFeature.Get(), &columnStoreEntries);
+    }
+    for (auto& bundle : ExclusiveFeatureBundlesData.SrcData) {
+        AddToColumnStoreIfDense(bundle.Get(), &columnStoreEntries);
+    }
+    for (auto& binaryPack : PackedBinaryFeaturesData.SrcData) {
+        AddToColumnStoreIfDense(binaryPack.Get(), &columnStoreEntries);
+    }
+    for (auto& featuresGroup : FeaturesGroupsData.SrcData) {
+        AddToColumnStoreIfDense(featuresGroup.Get(), &columnStoreEntries);
+    }
+
+    if (columnStoreEntries.empty()) {
+        return 0;
+    }
+
+    // columns are page-aligned so that they are paged in and evicted independently
+    const ui64 pageSize = NSystemInfo::GetPageSize();
+    TVector<ui64> offsets;
+    offsets.yresize(columnStoreEntries.size());
+    ui64 columnStoreSize = 0;
+    for (auto i : xrange(columnStoreEntries.size())) {
+        offsets[i] = columnStoreSize;
+        columnStoreSize += AlignUp<ui64>(columnStoreEntries[i].Storage.size() * sizeof(ui64), pageSize);
+    }
+
+    {
+        TFile file(filePath, CreateAlways | WrOnly);
+        file.Resize(SafeIntegerCast<i64>(columnStoreSize));
+        localExecutor->ExecRangeWithThrow(
+            [&] (int i) {
+                const auto storage = columnStoreEntries[i].Storage;
+                file.Pwrite(storage.data(), storage.size() * sizeof(ui64), SafeIntegerCast<i64>(offsets[i]));
+            },
+            0,
+            SafeIntegerCast<int>(columnStoreEntries.size()),
+            NPar::TLocalExecutor::WAIT_COMPLETE
+        );
+        file.Close();
+    }
+
+    const TBlob columnStore = TBlob::FromFile(filePath);
+    CB_ENSURE(columnStore.Size() == columnStoreSize, "Features column store " << filePath << " has been modified");
+#if !defined(_win_)
+    // data stays accessible through the mapping, disk space is reclaimed when it is unmapped
+    NFs::Remove(filePath);
+#endif
+    FeaturesColumnStoreHolder = MakeIntrusive<TBlobHolder>(columnStore);
+
+    // mapping is read-only, data is never modified after this point
+    ui64* columnStoreData = const_cast<ui64*>(reinterpret_cast<const ui64*>(columnStore.Data()));
+    for (auto i : xrange(columnStoreEntries.size())) {
+        columnStoreEntries[i].SetStorage(
+            TMaybeOwningArrayHolder<ui64>::CreateOwning(
+                TArrayRef<ui64>(
+                    columnStoreData + offsets[i] / sizeof(ui64),
+                    columnStoreEntries[i].Storage.size()
+                ),
+                FeaturesColumnStoreHolder
+            )
+        );
+    }
+
+    return columnStoreSize;
+}
+
+
 template <class T, EFeatureValuesType FeatureValuesType>
 static void CheckFeaturesByType(
     EFeatureType featureType,
@@ -655,6 +655,18 @@ namespace NCB {
          */
         void EnsureConsecutiveIfDenseFeaturesData(NPar::TLocalExecutor* localExecutor);
 
+        /* Move storage of dense features columns (including binary packs, bundles and groups) to the
+         * file at filePath and use it memory-mapped, so features data is paged in on demand and
+         * resident memory is limited by the OS page cache instead of the dataset size.
+         * Sparse columns are unaffected.
+         * Returns column store size in bytes.
+         */
+        ui64 MoveFeaturesDataToColumnStore(const TString& filePath, NPar::TLocalExecutor* localExecutor);
+
+        bool HasFeaturesColumnStore() const {
+            return FeaturesColumnStoreHolder.Get() != nullptr;
+        }
+
         // needed for low-level optimizations in CPU training code
         const TFeaturesArraySubsetIndexing& GetFeaturesArraySubsetIndexing() const {
             return *CommonData.SubsetIndexing;
@@ -818,6 +830,9 @@ namespace NCB {
 
         // store directly instead of looking up in Data.QuantizedFeaturesInfo for runtime efficiency
         TVector<TCatFeatureUniqueValuesCounts> CatFeatureUniqueValuesCounts; // [catFeatureIdx]
+
+        // keeps memory-mapped column store alive, set if features data has been moved to it
+        TIntrusivePtr<IResourceHolder> FeaturesColumnStoreHolder;
     };
 
 
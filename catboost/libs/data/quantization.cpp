@@ -15,11 +15,13 @@
 #include <catboost/libs/helpers/parallel_tasks.h>
 #include <catboost/libs/helpers/sample.h>
 #include <catboost/libs/helpers/resource_constrained_executor.h>
+#include <catboost/libs/logging/event_trace.h>
 #include <catboost/libs/logging/logging.h>
 #include <catboost/private/libs/labels/label_converter.h>
 #include <catboost/private/libs/options/plain_options_helper.h>
 #include <catboost/private/libs/options/system_options.h>
 #include <catboost/private/libs/text_processing/text_column_builder.h>
+#include <catboost/private/libs/quantization/quantile_sketch.h>
 #include <catboost/private/libs/quantization/utils.h>
 #include <catboost/private/libs/quantization_schema/quantize.h>
 
@@ -267,14 +269,80 @@ namespace NCB {
     }
 
 
+    static constexpr ui32 MIN_QUANTILE_SKETCH_BLOCK_SIZE = 64 * 1024;
+
+    // blocks of objects are summarized in parallel, nans are not added to the sketch
+    static TQuantileSketch BuildQuantileSketch(
+        const ITypedArraySubset<float>& srcFeatureData,
+        float rankError,
+        bool* hasNans,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        const ui32 objectCount = srcFeatureData.GetSize();
+        const ui32 blockCount = Min<ui32>(
+            objectCount / MIN_QUANTILE_SKETCH_BLOCK_SIZE + 1,
+            SafeIntegerCast<ui32>(localExecutor->GetThreadCount() + 1)
+        );
+        const ui32 blockSize = CeilDiv(objectCount, blockCount);
+
+        TVector<TQuantileSketch> blockSketches;
+        for (auto blockIdx : xrange(blockCount)) {
+            blockSketches.emplace_back(rankError, blockIdx);
+        }
+        TVector<ui8> blockHasNans(blockCount, 0);
+
+        localExecutor->ExecRangeWithThrow(
+            [&] (int blockIdx) {
+                const ui32 blockBegin = blockIdx * blockSize;
+                const ui32 blockEnd = Min(blockBegin + blockSize, objectCount);
+                if (blockBegin >= blockEnd) {
+                    return;
+                }
+
+                auto blockIterator = srcFeatureData.GetBlockIterator(blockBegin);
+                TVector<float> nonNanValues;
+                for (ui32 offset = blockBegin; offset < blockEnd;) {
+                    TConstArrayRef<float> values = blockIterator->Next(blockEnd - offset);
+                    if (values.empty()) {
+                        break;
+                    }
+                    offset += values.size();
+
+                    nonNanValues.clear();
+                    for (auto value : values) {
+                        if (IsNan(value)) {
+                            blockHasNans[blockIdx] = 1;
+                        } else {
+                            nonNanValues.push_back(value);
+                        }
+                    }
+                    blockSketches[blockIdx].Add(nonNanValues);
+                }
+            },
+            0,
+            SafeIntegerCast<int>(blockCount),
+            NPar::TLocalExecutor::WAIT_COMPLETE
+        );
+
+        for (auto blockIdx : xrange<ui32>(1, blockCount)) {
+            blockSketches[0].Merge(blockSketches[blockIdx]);
+        }
+        *hasNans = Find(blockHasNans, 1) != blockHasNans.end();
+
+        return std::move(blockSketches[0]);
+    }
+
+
     static void CalcQuantizationAndNanMode(
         const TFloatValuesHolder& srcFeature,
         const TSubsetIndexingForBuildBorders& subsetIndexingForBuildBorders,
         const TQuantizedFeaturesInfo& quantizedFeaturesInfo,
         const TMaybe<TVector<float>>& initialBorders,
         TMaybe<float> quantizedDefaultBinFraction,
+        TMaybe<float> quantileSketchRankError,
         ENanMode* nanMode,
-        NSplitSelection::TQuantization* quantization
+        NSplitSelection::TQuantization* quantization,
+        NPar::TLocalExecutor* localExecutor
     ) {
         const auto& binarizationOptions = quantizedFeaturesInfo.GetFloatFeatureBinarization(srcFeature.GetId());
 
@@ -287,6 +355,9 @@ namespace NCB {
 
         bool hasNans = false;
 
+        // if defined - used instead of featureValues
+        TMaybe<TQuantileSketch> quantileSketch;
+
         auto processNonDefaultValue = [&] (ui32 /*idx*/, float value) {
             if (IsNan(value)) {
                 hasNans = true;
@@ -298,14 +369,24 @@ namespace NCB {
         if (const auto* denseSrcFeature = dynamic_cast<const TFloatArrayValuesHolder*>(&srcFeature)) {
             ITypedArraySubsetPtr<float> srcFeatureData = denseSrcFeature->GetData();
 
-            ITypedArraySubsetPtr<float> srcDataForBuildBorders = srcFeatureData->CloneWithNewSubsetIndexing(
-                &subsetIndexingForBuildBorders.ComposedSubset
-            );
+            if (quantileSketchRankError && !initialBorders && !quantizedDefaultBinFraction) {
+                // all objects are used, not only the subset for build borders
+                quantileSketch = BuildQuantileSketch(
+                    *srcFeatureData,
+                    *quantileSketchRankError,
+                    &hasNans,
+                    localExecutor
+                );
+            } else {
+                ITypedArraySubsetPtr<float> srcDataForBuildBorders = srcFeatureData->CloneWithNewSubsetIndexing(
+                    &subsetIndexingForBuildBorders.ComposedSubset
+                );
 
-            // does not contain nans
-            featureValues.Values.reserve(sampleCount);
+                // does not contain nans
+                featureValues.Values.reserve(sampleCount);
 
-            srcDataForBuildBorders->ForEach(processNonDefaultValue);
+                srcDataForBuildBorders->ForEach(processNonDefaultValue);
+            }
         } else if (const auto* sparseSrcFeature = dynamic_cast<const TFloatSparseValuesHolder*>(&srcFeature)) {
             const TConstPolymorphicValuesSparseArray<float, ui32>& sparseData = sparseSrcFeature->GetData();
 
@@ -363,14 +444,22 @@ namespace NCB {
         }
 
         if (nonNanValuesBorderCount > 0) {
-            *quantization = NSplitSelection::BestSplit(
-                std::move(featureValues),
-                /*featureValuesMayContainNans*/ false,
-                nonNanValuesBorderCount,
-                binarizationOptions.BorderSelectionType,
-                quantizedDefaultBinFraction,
-                initialBorders
-            );
+            if (quantileSketch) {
+                quantization->Borders = BuildBordersFromSketch(
+                    *quantileSketch,
+                    binarizationOptions.BorderSelectionType,
+                    SafeIntegerCast<ui32>(nonNanValuesBorderCount)
+                );
+            } else {
+                *quantization = NSplitSelection::BestSplit(
+                    std::move(featureValues),
+                    /*featureValuesMayContainNans*/ false,
+                    nonNanValuesBorderCount,
+                    binarizationOptions.BorderSelectionType,
+                    quantizedDefaultBinFraction,
+                    initialBorders
+                );
+            }
         }
 
         if (*nanMode == ENanMode::Min) {
@@ -1813,8 +1902,10 @@ namespace NCB {
                 *quantizedFeaturesInfo,
                 initialBordersForFeature,
                 options.DefaultValueFractionToEnableSparseStorage,
+                options.QuantileSketchRankError,
                 &nanMode,
-                &calculatedQuantization
+                &calculatedQuantization,
+                localExecutor
             );
 
             quantization = &calculatedQuantization;
@@ -2192,6 +2283,8 @@ namespace NCB {
             NPar::TLocalExecutor* localExecutor,
             const TInitialBorders& initialBorders = Nothing()
         ) {
+            CHROMIUM_TRACE_FUNCTION();
+
              CB_ENSURE_INTERNAL(
                 options.CpuCompatibleFormat || options.GpuCompatibleFormat,
                 "TQuantizationOptions: at least one of CpuCompatibleFormat or GpuCompatibleFormat"
@@ -2634,6 +2727,10 @@ namespace NCB {
 
         TQuantizationOptions quantizationOptions;
         quantizationOptions.GroupFeaturesForCpu = params.DataProcessingOptions->DevGroupFeatures.GetUnchecked();
+        const float quantileSketchRankError = params.DataProcessingOptions->DevQuantileSketchRankError.Get();
+        if (quantileSketchRankError > 0.0f) {
+            quantizationOptions.QuantileSketchRankError = quantileSketchRankError;
+        }
         if (params.GetTaskType() == ETaskType::CPU) {
             quantizationOptions.GpuCompatibleFormat = false;
 
@@ -46,6 +46,12 @@ namespace NCB {
 
         TMaybe<float> DefaultValueFractionToEnableSparseStorage = Nothing();
         ESparseArrayIndexingType SparseArrayIndexingType = ESparseArrayIndexingType::Indices;
+
+        /* if defined - borders for dense float features are calculated from quantile sketches
+         *  with this rank error built on all objects instead of
+         *  exact values of MaxSubsetSizeForBuildBordersAlgorithms objects subset
+         */
+        TMaybe<float> QuantileSketchRankError = Nothing();
     };
 
     /*
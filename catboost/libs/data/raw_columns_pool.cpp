@@ -0,0 +1,560 @@
+#include "raw_columns_pool.h"
+
+#include "baseline.h"
+#include "loader.h"
+#include "objects.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/helpers/resource_holder.h>
+#include <catboost/libs/logging/logging.h>
+#include <catboost/private/libs/data_util/exists_checker.h>
+
+#include <library/binsaver/util_stream_io.h>
+#include <library/object_factory/object_factory.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
+#include <util/generic/xrange.h>
+#include <util/memory/blob.h>
+#include <util/stream/buffer.h>
+#include <util/stream/file.h>
+#include <util/stream/length.h>
+#include <util/system/align.h>
+#include <util/system/byteorder.h>
+#include <util/system/unaligned_mem.h>
+
+
+namespace NCB {
+
+    static const TStringBuf RAW_COLUMNS_POOL_MAGIC = "CBRAWCOL";
+    static constexpr ui32 RAW_COLUMNS_POOL_VERSION = 1;
+    static constexpr size_t RAW_COLUMNS_POOL_PREFIX_SIZE = 16; // magic, version, reserved
+    static constexpr size_t RAW_COLUMNS_POOL_SUFFIX_SIZE = 16; // header offset and size
+
+#if defined(_little_endian_)
+    static constexpr bool IS_PLATFORM_SUPPORTED = true;
+#else
+    static constexpr bool IS_PLATFORM_SUPPORTED = false;
+#endif
+
+    static_assert(
+        RAW_COLUMNS_POOL_PREFIX_SIZE <= RAW_COLUMNS_POOL_ALIGNMENT,
+        "Prefix does not fit into the first aligned block"
+    );
+
+
+    enum class ERawColumnType : ui32 {
+        FloatFeature,       // Index is flatFeatureIdx
+        HashedCatFeature,   // Index is flatFeatureIdx
+        CatFeatureValues,   // strings array of unique values, Index is flatFeatureIdx
+        TextFeature,        // Index is flatFeatureIdx
+        FloatTarget,        // Index is targetIdx
+        StringTarget,       // Index is targetIdx
+        Baseline,           // Index is baselineIdx
+        Weights,
+        GroupWeights,
+        GroupId,
+        SubgroupId,
+        Timestamp
+    };
+
+    namespace {
+        struct TRawColumnDescription {
+            ERawColumnType Type = ERawColumnType::FloatFeature;
+            ui32 Index = 0;
+            ui64 Offset = 0; // from the beginning of the file
+            ui64 Size = 0; // in bytes
+
+        public:
+            SAVELOAD(Type, Index, Offset, Size);
+        };
+
+        struct TRawColumnsPoolHeader {
+            ui64 ObjectCount = 0;
+            EObjectsOrder Order = EObjectsOrder::Undefined;
+            TDataMetaInfo MetaInfo;
+            TVector<TRawColumnDescription> Columns;
+            TVector<TPair> Pairs;
+
+        public:
+            int operator&(IBinSaver& binSaver) {
+                binSaver.AddMulti(ObjectCount, Order);
+                AddWithShared(&binSaver, &MetaInfo);
+                binSaver.AddMulti(Columns, Pairs);
+                return 0;
+            }
+        };
+
+
+        class TRawColumnsPoolWriter {
+        public:
+            explicit TRawColumnsPoolWriter(const TString& filePath)
+                : FileOutput(filePath)
+                , Output(&FileOutput)
+            {
+                Output.Write(RAW_COLUMNS_POOL_MAGIC.data(), RAW_COLUMNS_POOL_MAGIC.size());
+                WriteValue(RAW_COLUMNS_POOL_VERSION);
+                WriteValue(ui32(0));
+            }
+
+            template <class T>
+            void AddColumn(ERawColumnType type, ui32 index, TConstArrayRef<T> data) {
+                static_assert(std::is_arithmetic<T>::value);
+
+                StartColumn(type, index);
+                Output.Write(data.data(), data.size() * sizeof(T));
+                FinishColumn();
+            }
+
+            template <class TStringLike>
+            void AddStringsColumn(ERawColumnType type, ui32 index, TConstArrayRef<TStringLike> data) {
+                StartColumn(type, index);
+                WriteValue(ui64(data.size()));
+                ui64 offset = 0;
+                WriteValue(offset);
+                for (const auto& value : data) {
+                    offset += value.size();
+                    WriteValue(offset);
+                }
+                for (const auto& value : data) {
+                    Output.Write(value.data(), value.size());
+                }
+                FinishColumn();
+            }
+
+            void Finish(
+                ui64 objectCount,
+                EObjectsOrder order,
+                const TDataMetaInfo& metaInfo,
+                TConstArrayRef<TPair> pairs
+            ) {
+                TRawColumnsPoolHeader header;
+                header.ObjectCount = objectCount;
+                header.Order = order;
+                header.MetaInfo = metaInfo;
+                header.Columns = std::move(Columns);
+                header.Pairs.assign(pairs.begin(), pairs.end());
+
+                const ui64 headerOffset = Output.Counter();
+                {
+                    TYaStreamOutput binSaverOutput(Output);
+                    IBinSaver binSaver(binSaverOutput, false);
+                    binSaver.Add(0, &header);
+                }
+                const ui64 headerSize = Output.Counter() - headerOffset;
+                WriteValue(headerOffset);
+                WriteValue(headerSize);
+                Output.Finish();
+            }
+
+        private:
+            template <class T>
+            void WriteValue(T value) {
+                value = HostToLittle(value);
+                Output.Write(&value, sizeof(value));
+            }
+
+            void StartColumn(ERawColumnType type, ui32 index) {
+                static const char padding[RAW_COLUMNS_POOL_ALIGNMENT] = {};
+                Output.Write(padding, AlignUp<ui64>(Output.Counter(), RAW_COLUMNS_POOL_ALIGNMENT) - Output.Counter());
+
+                Columns.push_back(TRawColumnDescription{type, index, Output.Counter(), 0});
+            }
+
+            void FinishColumn() {
+                Columns.back().Size = Output.Counter() - Columns.back().Offset;
+            }
+
+        private:
+            TFileOutput FileOutput;
+            TCountingOutput Output;
+            TVector<TRawColumnDescription> Columns;
+        };
+    }
+
+
+    void SaveRawColumnsPool(
+        const TDataProvider& dataProvider,
+        const TString& filePath,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        static_assert(
+            std::is_same<TGroupId, ui64>::value && std::is_same<TSubgroupId, ui32>::value,
+            "Raw columns pool format assumes TGroupId is ui64 and TSubgroupId is ui32"
+        );
+        CB_ENSURE(
+            IS_PLATFORM_SUPPORTED,
+            "Raw columns pool format is supported only on little-endian platforms"
+        );
+
+        const auto* rawObjectsData = dynamic_cast<const TRawObjectsDataProvider*>(dataProvider.ObjectsData.Get());
+        CB_ENSURE(rawObjectsData, "Only datasets with raw features data can be saved in raw columns format");
+
+        TRawColumnsPoolWriter writer(filePath);
+
+        const auto& featuresLayout = *dataProvider.MetaInfo.FeaturesLayout;
+
+        // features are written by one to avoid holding extracted copies of all of them simultaneously
+        featuresLayout.IterateOverAvailableFeatures<EFeatureType::Float>(
+            [&] (TFloatFeatureIdx floatFeatureIdx) {
+                const ui32 flatFeatureIdx = featuresLayout.GetExternalFeatureIdx(*floatFeatureIdx, EFeatureType::Float);
+                const auto values = (*rawObjectsData->GetFloatFeature(*floatFeatureIdx))->ExtractValues(localExecutor);
+                writer.AddColumn<float>(ERawColumnType::FloatFeature, flatFeatureIdx, *values);
+            }
+        );
+        featuresLayout.IterateOverAvailableFeatures<EFeatureType::Categorical>(
+            [&] (TCatFeatureIdx catFeatureIdx) {
+                const ui32 flatFeatureIdx
+                    = featuresLayout.GetExternalFeatureIdx(*catFeatureIdx, EFeatureType::Categorical);
+                const auto values = (*rawObjectsData->GetCatFeature(*catFeatureIdx))->ExtractValues(localExecutor);
+                writer.AddColumn<ui32>(ERawColumnType::HashedCatFeature, flatFeatureIdx, *values);
+
+                // hashes are recalculated from values on load
+                TVector<TStringBuf> uniqueValues;
+                for (const auto& [hash, value] : rawObjectsData->GetCatFeaturesHashToString(*catFeatureIdx)) {
+                    Y_UNUSED(hash);
+                    uniqueValues.push_back(value);
+                }
+                Sort(uniqueValues); // for reproducible output
+                writer.AddStringsColumn<TStringBuf>(ERawColumnType::CatFeatureValues, flatFeatureIdx, uniqueValues);
+            }
+        );
+        featuresLayout.IterateOverAvailableFeatures<EFeatureType::Text>(
+            [&] (TTextFeatureIdx textFeatureIdx) {
+                const ui32 flatFeatureIdx = featuresLayout.GetExternalFeatureIdx(*textFeatureIdx, EFeatureType::Text);
+                const auto values = (*rawObjectsData->GetTextFeature(*textFeatureIdx))->ExtractValues(localExecutor);
+                writer.AddStringsColumn<TString>(ERawColumnType::TextFeature, flatFeatureIdx, *values);
+            }
+        );
+
+        const auto& rawTargetData = dataProvider.RawTargetData;
+        if (const auto targets = rawTargetData.GetTarget()) {
+            for (auto targetIdx : xrange(targets->size())) {
+                const auto& target = (*targets)[targetIdx];
+                if (const ITypedSequencePtr<float>* floatTarget = GetIf<ITypedSequencePtr<float>>(&target)) {
+                    writer.AddColumn<float>(ERawColumnType::FloatTarget, targetIdx, ToVector(**floatTarget));
+                } else {
+                    writer.AddStringsColumn<TString>(
+                        ERawColumnType::StringTarget,
+                        targetIdx,
+                        Get<TVector<TString>>(target)
+                    );
+                }
+            }
+        }
+        if (const auto baseline = rawTargetData.GetBaseline()) {
+            for (auto baselineIdx : xrange(baseline->size())) {
+                writer.AddColumn<float>(ERawColumnType::Baseline, baselineIdx, (*baseline)[baselineIdx]);
+            }
+        }
+        if (dataProvider.MetaInfo.HasWeights && !rawTargetData.GetWeights().IsTrivial()) {
+            writer.AddColumn<float>(ERawColumnType::Weights, 0, rawTargetData.GetWeights().GetNonTrivialData());
+        }
+        if (dataProvider.MetaInfo.HasGroupWeight && !rawTargetData.GetGroupWeights().IsTrivial()) {
+            writer.AddColumn<float>(
+                ERawColumnType::GroupWeights,
+                0,
+                rawTargetData.GetGroupWeights().GetNonTrivialData()
+            );
+        }
+
+        if (const auto groupIds = rawObjectsData->GetGroupIds()) {
+            writer.AddColumn<TGroupId>(ERawColumnType::GroupId, 0, *groupIds);
+        }
+        if (const auto subgroupIds = rawObjectsData->GetSubgroupIds()) {
+            writer.AddColumn<TSubgroupId>(ERawColumnType::SubgroupId, 0, *subgroupIds);
+        }
+        if (const auto timestamp = rawObjectsData->GetTimestamp()) {
+            writer.AddColumn<ui64>(ERawColumnType::Timestamp, 0, *timestamp);
+        }
+
+        writer.Finish(
+            dataProvider.GetObjectCount(),
+            rawObjectsData->GetOrder(),
+            dataProvider.MetaInfo,
+            rawTargetData.GetPairs()
+        );
+    }
+
+
+    namespace {
+        class TRawColumnsDataLoader final : public IRawFeaturesOrderDatasetLoader {
+        public:
+            explicit TRawColumnsDataLoader(TDatasetLoaderPullArgs&& args)
+                : Args(std::move(args.CommonArgs))
+                , Pool(TBlob::FromFile(args.PoolPath.Path))
+            {
+                CB_ENSURE(
+                    IS_PLATFORM_SUPPORTED,
+                    "Raw columns pool format is supported only on little-endian platforms"
+                );
+                CB_ENSURE(!Args.PairsFilePath.Inited() || CheckExists(Args.PairsFilePath),
+                          "TRawColumnsDataLoader:PairsFilePath does not exist");
+                CB_ENSURE(!Args.GroupWeightsFilePath.Inited() || CheckExists(Args.GroupWeightsFilePath),
+                          "TRawColumnsDataLoader:GroupWeightsFilePath does not exist");
+                CB_ENSURE(!Args.BaselineFilePath.Inited() || CheckExists(Args.BaselineFilePath),
+                          "TRawColumnsDataLoader:BaselineFilePath does not exist");
+
+                ReadHeader(args.PoolPath.Path);
+
+                const ui64 objectCount = Min<ui64>(Header.ObjectCount, Args.DatasetSubset.Range.End);
+                CB_ENSURE(
+                    Args.DatasetSubset.Range.Begin <= objectCount,
+                    "Dataset subset begin is beyond the number of objects in pool"
+                );
+                ObjectCount = SafeIntegerCast<ui32>(objectCount - Args.DatasetSubset.Range.Begin);
+
+                DataMetaInfo = Header.MetaInfo;
+                DataMetaInfo.ObjectCount = ObjectCount;
+                if (Args.PairsFilePath.Inited()) {
+                    CB_ENSURE(!DataMetaInfo.HasPairs, "Pool already contains pairs, pairs file can't be used");
+                    DataMetaInfo.HasPairs = true;
+                }
+                if (Args.GroupWeightsFilePath.Inited()) {
+                    CB_ENSURE(
+                        !DataMetaInfo.HasGroupWeight,
+                        "Pool already contains group weights, group weights file can't be used"
+                    );
+                    DataMetaInfo.HasGroupWeight = true;
+                }
+                if (Args.BaselineFilePath.Inited()) {
+                    CB_ENSURE(
+                        !DataMetaInfo.BaselineCount,
+                        "Pool already contains baseline, baseline file can't be used"
+                    );
+                    DataMetaInfo.BaselineCount = *TBaselineReader(Args.BaselineFilePath, Args.ClassNames)
+                        .GetBaselineCount();
+                }
+                if (DataMetaInfo.ClassNames.empty()) {
+                    DataMetaInfo.ClassNames = Args.ClassNames;
+                }
+
+                ProcessIgnoredFeaturesList(
+                    Args.IgnoredFeatures,
+                    /*allFeaturesIgnoredMessage*/ Nothing(),
+                    &DataMetaInfo,
+                    &FeatureIgnored
+                );
+            }
+
+            void Do(IRawFeaturesOrderDataVisitor* visitor) override {
+                visitor->Start(
+                    DataMetaInfo,
+                    ObjectCount,
+                    Args.ObjectsOrder == EObjectsOrder::Undefined ? Header.Order : Args.ObjectsOrder,
+                    {MakeIntrusive<TBlobHolder>(Pool)}
+                );
+
+                for (const auto& column : Header.Columns) {
+                    AddColumn(column, visitor);
+                }
+
+                // pairs are set even if none of them is inside the objects subset
+                if (Header.MetaInfo.HasPairs) {
+                    visitor->SetPairs(GetPairsSubset());
+                }
+
+                SetGroupWeights(Args.GroupWeightsFilePath, ObjectCount, Args.DatasetSubset, visitor);
+                SetPairs(Args.PairsFilePath, ObjectCount, Args.DatasetSubset, visitor);
+                SetBaseline(Args.BaselineFilePath, ObjectCount, Args.DatasetSubset, DataMetaInfo.ClassNames, visitor);
+
+                visitor->Finish();
+            }
+
+        private:
+            void ReadHeader(const TString& poolPath) {
+                const size_t poolSize = Pool.Size();
+                CB_ENSURE(
+                    (poolSize >= RAW_COLUMNS_POOL_PREFIX_SIZE + RAW_COLUMNS_POOL_SUFFIX_SIZE)
+                        && (TStringBuf(Pool.AsCharPtr(), RAW_COLUMNS_POOL_MAGIC.size()) == RAW_COLUMNS_POOL_MAGIC),
+                    poolPath << " is not a raw columns pool"
+                );
+                const ui32 version = ReadUnaligned<ui32>(Pool.AsCharPtr() + RAW_COLUMNS_POOL_MAGIC.size());
+                CB_ENSURE(
+                    version == RAW_COLUMNS_POOL_VERSION,
+                    "Unsupported raw columns pool version " << version << " in " << poolPath
+                );
+
+                const char* suffix = Pool.AsCharPtr() + poolSize - RAW_COLUMNS_POOL_SUFFIX_SIZE;
+                const ui64 headerOffset = ReadUnaligned<ui64>(suffix);
+                const ui64 headerSize = ReadUnaligned<ui64>(suffix + sizeof(ui64));
+                CB_ENSURE(
+                    (headerOffset >= RAW_COLUMNS_POOL_PREFIX_SIZE)
+                        && (headerOffset + headerSize + RAW_COLUMNS_POOL_SUFFIX_SIZE == poolSize),
+                    "Raw columns pool " << poolPath << " is corrupted"
+                );
+
+                TMemoryInput headerInput(Pool.AsCharPtr() + headerOffset, headerSize);
+                SerializeFromStream(headerInput, Header);
+
+                for (const auto& column : Header.Columns) {
+                    CB_ENSURE(
+                        (column.Offset % RAW_COLUMNS_POOL_ALIGNMENT == 0)
+                            && (column.Offset + column.Size <= headerOffset),
+                        "Raw columns pool " << poolPath << " is corrupted"
+                    );
+                }
+            }
+
+            template <class T>
+            TConstArrayRef<T> GetObjectsData(const TRawColumnDescription& column) const {
+                CB_ENSURE(
+                    column.Size == Header.ObjectCount * sizeof(T),
+                    "Unexpected size of column of type " << ui32(column.Type) << " in raw columns pool"
+                );
+                const T* data = reinterpret_cast<const T*>(Pool.AsCharPtr() + column.Offset);
+                return TConstArrayRef<T>(data + Args.DatasetSubset.Range.Begin, ObjectCount);
+            }
+
+            template <class T>
+            TMaybeOwningConstArrayHolder<T> GetObjectsDataHolder(const TRawColumnDescription& column) const {
+                return TMaybeOwningConstArrayHolder<T>::CreateOwning(
+                    GetObjectsData<T>(column),
+                    MakeIntrusive<TBlobHolder>(Pool)
+                );
+            }
+
+            // returns all values if objectsSubset is false
+            TVector<TStringBuf> GetStrings(const TRawColumnDescription& column, bool objectsSubset) const {
+                const ui64* data = reinterpret_cast<const ui64*>(Pool.AsCharPtr() + column.Offset);
+                CB_ENSURE(column.Size >= 2 * sizeof(ui64), "Raw columns pool strings column is corrupted");
+                const ui64 size = data[0];
+                const ui64* offsets = data + 1;
+                const ui64 offsetsSize = (size + 2) * sizeof(ui64);
+                CB_ENSURE(
+                    (offsetsSize <= column.Size)
+                        && (offsetsSize + offsets[size] == column.Size)
+                        && (!objectsSubset || (size == Header.ObjectCount)),
+                    "Raw columns pool strings column is corrupted"
+                );
+
+                const char* stringsData = reinterpret_cast<const char*>(offsets + size + 1);
+                const ui64 begin = objectsSubset ? Args.DatasetSubset.Range.Begin : 0;
+                const ui64 end = objectsSubset ? begin + ObjectCount : size;
+
+                TVector<TStringBuf> result;
+                result.reserve(end - begin);
+                for (auto i : xrange(begin, end)) {
+                    result.push_back(TStringBuf(stringsData + offsets[i], stringsData + offsets[i + 1]));
+                }
+                return result;
+            }
+
+            TVector<TString> GetStringObjectsData(const TRawColumnDescription& column) const {
+                const auto values = GetStrings(column, /*objectsSubset*/ true);
+                return TVector<TString>(values.begin(), values.end());
+            }
+
+            TVector<TPair> GetPairsSubset() const {
+                const ui32 begin = Args.DatasetSubset.Range.Begin;
+                const ui32 end = begin + ObjectCount;
+
+                TVector<TPair> result;
+                for (const auto& pair : Header.Pairs) {
+                    if ((pair.WinnerId >= begin) && (pair.WinnerId < end)
+                        && (pair.LoserId >= begin) && (pair.LoserId < end))
+                    {
+                        result.emplace_back(pair.WinnerId - begin, pair.LoserId - begin, pair.Weight);
+                    }
+                }
+                return result;
+            }
+
+            bool IsFeatureSkipped(ui32 flatFeatureIdx) const {
+                return !Args.DatasetSubset.HasFeatures
+                    || ((flatFeatureIdx < FeatureIgnored.size()) && FeatureIgnored[flatFeatureIdx]);
+            }
+
+            void AddColumn(const TRawColumnDescription& column, IRawFeaturesOrderDataVisitor* visitor) const {
+                switch (column.Type) {
+                    case ERawColumnType::FloatFeature:
+                        if (!IsFeatureSkipped(column.Index)) {
+                            visitor->AddFloatFeature(
+                                column.Index,
+                                MakeIntrusive<TTypeCastArrayHolder<float, float>>(GetObjectsDataHolder<float>(column))
+                            );
+                        }
+                        break;
+                    case ERawColumnType::HashedCatFeature:
+                        if (!IsFeatureSkipped(column.Index)) {
+                            visitor->AddCatFeature(column.Index, GetObjectsDataHolder<ui32>(column));
+                        }
+                        break;
+                    case ERawColumnType::CatFeatureValues:
+                        if (!IsFeatureSkipped(column.Index)) {
+                            // fills hash to string mapping
+                            for (auto value : GetStrings(column, /*objectsSubset*/ false)) {
+                                visitor->GetCatFeatureValue(column.Index, value);
+                            }
+                        }
+                        break;
+                    case ERawColumnType::TextFeature:
+                        if (!IsFeatureSkipped(column.Index)) {
+                            visitor->AddTextFeature(
+                                column.Index,
+                                TMaybeOwningConstArrayHolder<TString>::CreateOwning(GetStringObjectsData(column))
+                            );
+                        }
+                        break;
+                    case ERawColumnType::FloatTarget:
+                        visitor->AddTarget(
+                            column.Index,
+                            MakeIntrusive<TTypeCastArrayHolder<float, float>>(GetObjectsDataHolder<float>(column))
+                        );
+                        break;
+                    case ERawColumnType::StringTarget:
+                        visitor->AddTarget(column.Index, GetStringObjectsData(column));
+                        break;
+                    case ERawColumnType::Baseline:
+                        visitor->AddBaseline(column.Index, GetObjectsData<float>(column));
+                        break;
+                    case ERawColumnType::Weights:
+                        visitor->AddWeights(GetObjectsData<float>(column));
+                        break;
+                    case ERawColumnType::GroupWeights:
+                        visitor->AddGroupWeights(GetObjectsData<float>(column));
+                        break;
+                    case ERawColumnType::GroupId:
+                        {
+                            const auto groupIds = GetObjectsData<TGroupId>(column);
+                            for (auto objectIdx : xrange(ObjectCount)) {
+                                visitor->AddGroupId(objectIdx, groupIds[objectIdx]);
+                            }
+                        }
+                        break;
+                    case ERawColumnType::SubgroupId:
+                        {
+                            const auto subgroupIds = GetObjectsData<TSubgroupId>(column);
+                            for (auto objectIdx : xrange(ObjectCount)) {
+                                visitor->AddSubgroupId(objectIdx, subgroupIds[objectIdx]);
+                            }
+                        }
+                        break;
+                    case ERawColumnType::Timestamp:
+                        {
+                            const auto timestamp = GetObjectsData<ui64>(column);
+                            for (auto objectIdx : xrange(ObjectCount)) {
+                                visitor->AddTimestamp(objectIdx, timestamp[objectIdx]);
+                            }
+                        }
+                        break;
+                    default:
+                        CB_ENSURE(false, "Unknown column type " << ui32(column.Type) << " in raw columns pool");
+                }
+            }
+
+        private:
+            TDatasetLoaderCommonArgs Args;
+            TBlob Pool;
+            TRawColumnsPoolHeader Header;
+            ui32 ObjectCount = 0;
+            TDataMetaInfo DataMetaInfo;
+            TVector<bool> FeatureIgnored; // [flatFeatureIdx]
+        };
+    }
+
+    namespace {
+        TExistsCheckerFactory::TRegistrator<TFSExistsChecker> RawColumnsExistsCheckerReg("raw-columns");
+        TDatasetLoaderFactory::TRegistrator<TRawColumnsDataLoader> RawColumnsDataLoaderReg("raw-columns");
+    }
+}
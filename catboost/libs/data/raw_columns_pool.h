@@ -0,0 +1,44 @@
+#pragma once
+
+#include "data_provider.h"
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/string.h>
+
+
+namespace NCB {
+
+    /* Binary columnar format for raw (non-quantized) datasets, scheme is "raw-columns".
+     *
+     * It is intended to be written once (from a dataset loaded in any format) and then loaded
+     *  many times without any parsing: the file is memory-mapped and float features, hashed
+     *  categorical features and float targets are passed to the data provider as is.
+     *
+     * Layout (all values are in little-endian byte order):
+     *   "CBRAWCOL" magic, ui32 format version, ui32 reserved
+     *   column data blocks, each is aligned to RAW_COLUMNS_POOL_ALIGNMENT bytes
+     *   header serialized with IBinSaver: object count, objects order, TDataMetaInfo,
+     *     column descriptions (type, index, offset and size in the file), pairs
+     *   ui64 header offset, ui64 header size
+     *
+     * Column data:
+     *   float features, float targets, baselines, weights, group weights - float[objectCount]
+     *   hashed categorical features - ui32[objectCount]
+     *   group ids, timestamps - ui64[objectCount], subgroup ids - ui32[objectCount]
+     *   text features, string targets, categorical features values - strings array:
+     *     ui64 size, ui64 offsets[size + 1] (from the end of offsets array), then concatenated string data.
+     *
+     * Sparse features are stored densified.
+     */
+
+    constexpr size_t RAW_COLUMNS_POOL_ALIGNMENT = 64;
+
+    // dataProvider must contain raw objects data
+    void SaveRawColumnsPool(
+        const TDataProvider& dataProvider,
+        const TString& filePath,
+        NPar::TLocalExecutor* localExecutor
+    );
+
+}
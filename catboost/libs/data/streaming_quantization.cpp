@@ -0,0 +1,355 @@
+#include "streaming_quantization.h"
+
+#include "data_provider_builders.h"
+#include "loader.h"
+
+#include <catboost/libs/column_description/cd_parser.h>
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/helpers/int_cast.h>
+#include <catboost/libs/helpers/polymorphic_type_containers.h>
+#include <catboost/libs/logging/logging.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/maybe.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ylimits.h>
+#include <util/generic/ymath.h>
+
+#include <limits>
+#include <numeric>
+
+
+using namespace NCB;
+
+
+static void ReadRawDatasetInBlocks(
+    const TPathWithScheme& poolPath,
+    const TPathWithScheme& baselineFilePath,
+    const NCatboostOptions::TColumnarPoolFormatParams& columnarPoolFormatParams,
+    const TVector<ui32>& ignoredFeatures,
+    const TVector<TString>& classNames,
+    ui32 blockSize,
+    NPar::TLocalExecutor* localExecutor,
+    const std::function<void(TRawDataProviderPtr)>& blockConsumer
+) {
+    const auto loadSubset = TDatasetSubset::MakeColumns();
+    auto datasetLoader = GetProcessor<IDatasetLoader>(
+        poolPath, // for choosing processor
+
+        // processor args
+        TDatasetLoaderPullArgs {
+            poolPath,
+
+            TDatasetLoaderCommonArgs {
+                /*PairsFilePath*/TPathWithScheme(),
+                /*GroupWeightsFilePath=*/TPathWithScheme(),
+                baselineFilePath,
+                classNames,
+                columnarPoolFormatParams.DsvFormat,
+                MakeCdProviderFromFile(columnarPoolFormatParams.CdFilePath),
+                ignoredFeatures,
+                EObjectsOrder::Undefined,
+                blockSize,
+                loadSubset,
+                localExecutor
+            }
+        }
+    );
+
+    auto* rawObjectsOrderDatasetLoader = dynamic_cast<IRawObjectsOrderDatasetLoader*>(datasetLoader.Get());
+    CB_ENSURE(
+        rawObjectsOrderDatasetLoader,
+        "Dataset " << poolPath.Path << " can't be loaded in blocks, quantization in blocks is not supported for it"
+    );
+
+    THolder<IDataProviderBuilder> dataProviderBuilder = CreateDataProviderBuilder(
+        datasetLoader->GetVisitorType(),
+        TDataProviderBuilderOptions{},
+        loadSubset,
+        localExecutor
+    );
+    CB_ENSURE_INTERNAL(
+        dataProviderBuilder,
+        "Failed to create data provider builder for visitor of type " << datasetLoader->GetVisitorType()
+    );
+    auto* visitor = dynamic_cast<IRawObjectsOrderDataVisitor*>(dataProviderBuilder.Get());
+    CB_ENSURE_INTERNAL(visitor, "failed cast of IDataProviderBuilder to IRawObjectsOrderDataVisitor");
+
+    auto processBlock = [&] (TDataProviderPtr block) {
+        auto rawBlock = block->CastMoveTo<TRawObjectsDataProvider>();
+        CB_ENSURE_INTERNAL(rawBlock, "Dataset block is not raw");
+        blockConsumer(std::move(rawBlock));
+    };
+
+    while (rawObjectsOrderDatasetLoader->DoBlock(visitor)) {
+        processBlock(dataProviderBuilder->GetResult());
+    }
+    auto lastResult = dataProviderBuilder->GetLastResult();
+    if (lastResult) {
+        processBlock(std::move(lastResult));
+    }
+}
+
+
+namespace {
+
+    /* Keeps float features values for a uniform random sample of objects.
+     * Each object gets a random key and objects with the smallest keys are selected,
+     *  candidates are accumulated up to 2 * SampleSize objects and then compacted to SampleSize
+     *  so the amortized cost per object is constant.
+     */
+    class TFloatFeaturesSampler {
+    public:
+        TFloatFeaturesSampler(const TFeaturesLayout& featuresLayout, ui32 sampleSize)
+            : SampleFeaturesLayout(MakeIntrusive<TFeaturesLayout>(featuresLayout))
+            , SampleSize(sampleSize)
+            , Values(featuresLayout.GetFloatFeatureCount())
+            , HasNans(featuresLayout.GetFloatFeatureCount(), 0)
+        {
+            CB_ENSURE_INTERNAL(SampleSize > 0, "Sample size for borders calculation should be positive");
+
+            // only float features are needed for borders calculation
+            const auto featuresMetaInfo = featuresLayout.GetExternalFeaturesMetaInfo();
+            for (auto externalFeatureIdx : xrange(featuresMetaInfo.size())) {
+                if (featuresMetaInfo[externalFeatureIdx].Type != EFeatureType::Float) {
+                    SampleFeaturesLayout->IgnoreExternalFeature(externalFeatureIdx);
+                }
+            }
+            SampleFeaturesLayout->IterateOverAvailableFeatures<EFeatureType::Float>(
+                [&] (TFloatFeatureIdx floatFeatureIdx) {
+                    FloatFeatures.push_back(floatFeatureIdx);
+                }
+            );
+        }
+
+        void AddBlock(
+            const TRawObjectsDataProvider& block,
+            TRestorableFastRng64* rand,
+            NPar::TLocalExecutor* localExecutor
+        ) {
+            const ui32 blockObjectCount = block.GetObjectCount();
+
+            TVector<ui32> selectedObjects;
+            for (auto objectIdx : xrange(blockObjectCount)) {
+                const ui64 key = rand->GenRand();
+                if (key < KeyThreshold) {
+                    selectedObjects.push_back(objectIdx);
+                    Keys.push_back(key);
+                }
+            }
+
+            localExecutor->ExecRangeWithThrow(
+                [&] (int i) {
+                    const TFloatFeatureIdx floatFeatureIdx = FloatFeatures[i];
+                    auto& dstValues = Values[*floatFeatureIdx];
+                    bool hasNans = false;
+
+                    auto blockIterator = (*block.GetFloatFeature(*floatFeatureIdx))->GetBlockIterator();
+                    ui32 objectIdx = 0;
+                    auto selectedObjectIt = selectedObjects.begin();
+                    for (auto values = blockIterator->Next(); !values.empty(); values = blockIterator->Next()) {
+                        for (auto value : values) {
+                            hasNans |= IsNan(value);
+                            if ((selectedObjectIt != selectedObjects.end()) && (*selectedObjectIt == objectIdx)) {
+                                dstValues.push_back(value);
+                                ++selectedObjectIt;
+                            }
+                            ++objectIdx;
+                        }
+                    }
+                    CB_ENSURE_INTERNAL(objectIdx == blockObjectCount, "Unexpected feature values count");
+                    if (hasNans) {
+                        HasNans[*floatFeatureIdx] = 1;
+                    }
+                },
+                0,
+                SafeIntegerCast<int>(FloatFeatures.size()),
+                NPar::TLocalExecutor::WAIT_COMPLETE
+            );
+
+            ObjectCount += blockObjectCount;
+            if (Keys.size() >= 2 * (size_t)SampleSize) {
+                Compact(localExecutor);
+            }
+        }
+
+        TRawDataProviderPtr GetSample(NPar::TLocalExecutor* localExecutor) {
+            CB_ENSURE(ObjectCount != 0, "Pool is empty");
+            if (Keys.size() > SampleSize) {
+                Compact(localExecutor);
+            }
+
+            /* nan mode is calculated from the sample
+             *  so make nan values visible there if they are present in the dataset
+             */
+            for (auto floatFeatureIdx : FloatFeatures) {
+                auto& values = Values[*floatFeatureIdx];
+                if (HasNans[*floatFeatureIdx] && !AnyOf(values, [] (float value) { return IsNan(value); })) {
+                    values[0] = std::numeric_limits<float>::quiet_NaN();
+                }
+            }
+
+            const ui32 sampleObjectCount = Keys.size();
+
+            TDataMetaInfo metaInfo;
+            metaInfo.ObjectCount = sampleObjectCount;
+            metaInfo.FeaturesLayout = SampleFeaturesLayout;
+
+            THolder<IDataProviderBuilder> dataProviderBuilder = CreateDataProviderBuilder(
+                EDatasetVisitorType::RawFeaturesOrder,
+                TDataProviderBuilderOptions{},
+                TDatasetSubset::MakeColumns(),
+                localExecutor
+            );
+            auto* visitor = dynamic_cast<IRawFeaturesOrderDataVisitor*>(dataProviderBuilder.Get());
+            CB_ENSURE_INTERNAL(visitor, "failed cast of IDataProviderBuilder to IRawFeaturesOrderDataVisitor");
+
+            visitor->Start(metaInfo, sampleObjectCount, EObjectsOrder::Undefined, {});
+            for (auto floatFeatureIdx : FloatFeatures) {
+                visitor->AddFloatFeature(
+                    SampleFeaturesLayout->GetExternalFeatureIdx(*floatFeatureIdx, EFeatureType::Float),
+                    MakeTypeCastArrayHolderFromVector<float, float>(Values[*floatFeatureIdx])
+                );
+            }
+            visitor->Finish();
+
+            Keys.clear();
+
+            return dataProviderBuilder->GetResult()->CastMoveTo<TRawObjectsDataProvider>();
+        }
+
+        ui64 GetObjectCount() const {
+            return ObjectCount;
+        }
+
+    private:
+        void Compact(NPar::TLocalExecutor* localExecutor) {
+            TVector<ui32> selected(Keys.size());
+            std::iota(selected.begin(), selected.end(), 0);
+            NthElement(
+                selected.begin(),
+                selected.begin() + SampleSize,
+                selected.end(),
+                [&] (ui32 lhs, ui32 rhs) { return Keys[lhs] < Keys[rhs]; }
+            );
+            selected.resize(SampleSize);
+            Sort(selected); // keep data order for better memory locality
+
+            TVector<ui64> selectedKeys;
+            selectedKeys.yresize(SampleSize);
+            for (auto i : xrange(SampleSize)) {
+                selectedKeys[i] = Keys[selected[i]];
+            }
+            Keys = std::move(selectedKeys);
+            KeyThreshold = *MaxElement(Keys.begin(), Keys.end());
+
+            localExecutor->ExecRangeWithThrow(
+                [&] (int i) {
+                    auto& values = Values[*FloatFeatures[i]];
+                    for (auto j : xrange(SampleSize)) {
+                        values[j] = values[selected[j]]; // selected is sorted so selected[j] >= j
+                    }
+                    values.resize(SampleSize);
+                    values.shrink_to_fit();
+                },
+                0,
+                SafeIntegerCast<int>(FloatFeatures.size()),
+                NPar::TLocalExecutor::WAIT_COMPLETE
+            );
+        }
+
+    private:
+        TFeaturesLayoutPtr SampleFeaturesLayout;
+        ui32 SampleSize;
+        TVector<TFloatFeatureIdx> FloatFeatures; // available in sample
+
+        ui64 ObjectCount = 0;
+        ui64 KeyThreshold = Max<ui64>(); // objects with greater keys can't be in the sample
+
+        TVector<ui64> Keys; // [sampledObjectIdx]
+        TVector<TVector<float>> Values; // [floatFeatureIdx][sampledObjectIdx]
+        TVector<ui8> HasNans; // [floatFeatureIdx], for all objects, not only sampled
+    };
+
+}
+
+
+TQuantizedFeaturesInfoPtr NCB::QuantizeInBlocks(
+    const TPathWithScheme& poolPath,
+    const TPathWithScheme& baselineFilePath,
+    const NCatboostOptions::TColumnarPoolFormatParams& columnarPoolFormatParams,
+    const TVector<ui32>& ignoredFeatures,
+    const TVector<TString>& classNames,
+    const NCatboostOptions::TBinarizationOptions& floatFeaturesBinarization,
+    const TMap<ui32, NCatboostOptions::TBinarizationOptions>& perFloatFeatureQuantization,
+    const TQuantizationOptions& options,
+    ui32 blockSize,
+    const TQuantizedBlockConsumer& quantizedBlockConsumer,
+    TRestorableFastRng64* rand,
+    NPar::TLocalExecutor* localExecutor
+) {
+    auto readInBlocks = [&] (const std::function<void(TRawDataProviderPtr)>& blockConsumer) {
+        ReadRawDatasetInBlocks(
+            poolPath,
+            baselineFilePath,
+            columnarPoolFormatParams,
+            ignoredFeatures,
+            classNames,
+            blockSize,
+            localExecutor,
+            blockConsumer
+        );
+    };
+
+    // first pass: calculate borders and nan modes
+    TQuantizedFeaturesInfoPtr quantizedFeaturesInfo;
+    TMaybe<TFloatFeaturesSampler> sampler;
+    readInBlocks(
+        [&] (TRawDataProviderPtr rawBlock) {
+            if (!quantizedFeaturesInfo) {
+                const auto& featuresLayout = *rawBlock->MetaInfo.FeaturesLayout;
+                CB_ENSURE(
+                    featuresLayout.GetTextFeatureCount() == 0,
+                    "Quantization in blocks is not supported for text features"
+                );
+                quantizedFeaturesInfo = MakeIntrusive<TQuantizedFeaturesInfo>(
+                    featuresLayout,
+                    ignoredFeatures,
+                    floatFeaturesBinarization,
+                    perFloatFeatureQuantization,
+                    /*floatFeaturesAllowNansInTestOnly*/ true,
+                    options.AllowWriteFiles
+                );
+                sampler.ConstructInPlace(featuresLayout, options.MaxSubsetSizeForBuildBordersAlgorithms);
+            }
+            sampler->AddBlock(*rawBlock->ObjectsData, rand, localExecutor);
+        }
+    );
+    CB_ENSURE(sampler, "Pool is empty");
+
+    const ui64 objectCount = sampler->GetObjectCount();
+    auto sample = sampler->GetSample(localExecutor);
+    sampler.Clear();
+    CATBOOST_DEBUG_LOG << "Calculate borders on " << sample->GetObjectCount() << " of "
+        << objectCount << " objects" << Endl;
+
+    CalcBordersAndNanMode(options, std::move(sample), quantizedFeaturesInfo, rand, localExecutor);
+
+    // second pass: quantize blocks with fixed borders
+    TQuantizationOptions blockOptions = options;
+
+    // these are calculated for the whole dataset
+    blockOptions.BundleExclusiveFeaturesForCpu = false;
+    blockOptions.PackBinaryFeaturesForCpu = false;
+    blockOptions.GroupFeaturesForCpu = false;
+
+    readInBlocks(
+        [&] (TRawDataProviderPtr rawBlock) {
+            quantizedBlockConsumer(
+                Quantize(blockOptions, std::move(rawBlock), quantizedFeaturesInfo, rand, localExecutor)
+            );
+        }
+    );
+
+    return quantizedFeaturesInfo;
+}
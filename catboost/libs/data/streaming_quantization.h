@@ -0,0 +1,57 @@
+#pragma once
+
+#include "data_provider.h"
+#include "quantization.h"
+#include "quantized_features_info.h"
+
+#include <catboost/libs/helpers/restorable_rng.h>
+#include <catboost/private/libs/data_util/path_with_scheme.h>
+#include <catboost/private/libs/options/binarization_options.h>
+#include <catboost/private/libs/options/load_options.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/map.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+#include <functional>
+
+
+namespace NCB {
+
+    // blocks are passed in the order of objects in the dataset
+    using TQuantizedBlockConsumer = std::function<void(TQuantizedDataProviderPtr)>;
+
+    /*
+     * Quantizes a dataset without loading all of its raw feature values into memory.
+     * The dataset is read twice in blocks of blockSize objects:
+     *  1) a uniform random sample of at most options.MaxSubsetSizeForBuildBordersAlgorithms objects
+     *     is collected, borders are calculated on this sample, nan modes - on all objects.
+     *  2) each block is quantized with these borders and passed to quantizedBlockConsumer.
+     * Peak memory usage is the sample and a few raw blocks instead of the whole raw dataset.
+     *
+     * Only datasets that can be loaded in blocks (IRawObjectsOrderDatasetLoader: dsv, libsvm) are supported,
+     *  pairs and group weights from separate files and text features are not supported.
+     * Categorical features are quantized (perfect hashed) by blocks, bundling and packing of features
+     *  is disabled because it is calculated for the whole dataset.
+     *
+     * Returns quantizedFeaturesInfo that has been used for all blocks.
+     */
+    TQuantizedFeaturesInfoPtr QuantizeInBlocks(
+        const TPathWithScheme& poolPath,
+        const TPathWithScheme& baselineFilePath, // can be uninited
+        const NCatboostOptions::TColumnarPoolFormatParams& columnarPoolFormatParams,
+        const TVector<ui32>& ignoredFeatures,
+        const TVector<TString>& classNames,
+        const NCatboostOptions::TBinarizationOptions& floatFeaturesBinarization,
+        const TMap<ui32, NCatboostOptions::TBinarizationOptions>& perFloatFeatureQuantization,
+        const TQuantizationOptions& options,
+        ui32 blockSize,
+        const TQuantizedBlockConsumer& quantizedBlockConsumer,
+        TRestorableFastRng64* rand,
+        NPar::TLocalExecutor* localExecutor
+    );
+
+}
@@ -0,0 +1,134 @@
+#include "text_parsing.h"
+
+#include <util/string/cast.h>
+
+#include <cfloat>
+
+
+// exactly representable in double
+static const double EXACT_POWERS_OF_10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static constexpr int MAX_EXACT_POWER_OF_10 = 22;
+static constexpr int MAX_MANTISSA_DIGITS = 19;
+static constexpr ui64 MAX_EXACT_MANTISSA = ui64(1) << 53;
+
+
+static inline bool IsDigit(char c) {
+    return (c >= '0') && (c <= '9');
+}
+
+// Clinger's fast path: both mantissa and power of 10 are exact, so the single operation is correctly rounded
+static bool TryParseDecimalFastPath(TStringBuf s, double* value) {
+#if FLT_EVAL_METHOD != 0
+    // extended precision intermediate results are rounded twice
+    Y_UNUSED(s);
+    Y_UNUSED(value);
+    return false;
+#else
+    const char* ptr = s.data();
+    const char* const end = s.data() + s.size();
+
+    const bool negative = (ptr != end) && (*ptr == '-');
+    if (negative) {
+        ++ptr;
+    }
+
+    ui64 mantissa = 0;
+    int mantissaDigits = 0;
+    int exponent = 0;
+
+    auto addDigit = [&] (char c) {
+        if (!mantissa && (c == '0')) {
+            return true; // leading zeros
+        }
+        if (mantissaDigits == MAX_MANTISSA_DIGITS) {
+            return false;
+        }
+        mantissa = mantissa * 10 + (c - '0');
+        ++mantissaDigits;
+        return true;
+    };
+
+    const char* const integerPartBegin = ptr;
+    for (; (ptr != end) && IsDigit(*ptr); ++ptr) {
+        if (!addDigit(*ptr)) {
+            return false;
+        }
+    }
+    if (ptr == integerPartBegin) {
+        return false;
+    }
+
+    if ((ptr != end) && (*ptr == '.')) {
+        ++ptr;
+        const char* const fractionalPartBegin = ptr;
+        for (; (ptr != end) && IsDigit(*ptr); ++ptr) {
+            if (!addDigit(*ptr)) {
+                return false;
+            }
+            --exponent;
+        }
+        if (ptr == fractionalPartBegin) {
+            return false;
+        }
+    }
+
+    if ((ptr != end) && ((*ptr == 'e') || (*ptr == 'E'))) {
+        ++ptr;
+        const bool negativeExponent = (ptr != end) && (*ptr == '-');
+        if ((ptr != end) && ((*ptr == '-') || (*ptr == '+'))) {
+            ++ptr;
+        }
+        const char* const exponentBegin = ptr;
+        int explicitExponent = 0;
+        for (; (ptr != end) && IsDigit(*ptr); ++ptr) {
+            if (explicitExponent > 2 * MAX_EXACT_POWER_OF_10 + MAX_MANTISSA_DIGITS) {
+                return false;
+            }
+            explicitExponent = explicitExponent * 10 + (*ptr - '0');
+        }
+        if (ptr == exponentBegin) {
+            return false;
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    if (ptr != end) {
+        return false;
+    }
+
+    double result;
+    if (!mantissa) {
+        result = 0.0;
+    } else {
+        if ((mantissa > MAX_EXACT_MANTISSA) || (exponent < -MAX_EXACT_POWER_OF_10) || (exponent > MAX_EXACT_POWER_OF_10)) {
+            return false;
+        }
+        result = (double)mantissa;
+        if (exponent < 0) {
+            result /= EXACT_POWERS_OF_10[-exponent];
+        } else {
+            result *= EXACT_POWERS_OF_10[exponent];
+        }
+    }
+    *value = negative ? -result : result;
+    return true;
+#endif
+}
+
+
+namespace NCB {
+
+    bool TryParseFloat(TStringBuf s, float* value) {
+        double result;
+        if (TryParseDecimalFastPath(s, &result)) {
+            *value = static_cast<float>(result);
+            return true;
+        }
+        return TryFromString<float>(s, *value);
+    }
+
+}
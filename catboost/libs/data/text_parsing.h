@@ -0,0 +1,93 @@
+#pragma once
+
+#include <library/sse/sse.h>
+
+#include <util/generic/bitops.h>
+#include <util/generic/strbuf.h>
+#include <util/system/types.h>
+
+
+namespace NCB {
+
+    /* Splits line by delimiter without quoting support:
+     *  the same fields as NCsvFormat::CsvSplitter with quote = '\0' or StringSplitter(line).Split(delimiter)
+     *  (empty fields are preserved, empty line contains one empty field).
+     *
+     * Delimiters are searched 16 bytes at a time with SSE2 (if available),
+     *  the mask of found delimiters is reused for the following fields of the same block.
+     */
+    class TDelimitedFieldSplitter {
+    public:
+        TDelimitedFieldSplitter(TStringBuf line, char delimiter)
+            : FieldBegin(line.data())
+            , End(line.data() + line.size())
+            , Delimiter(delimiter)
+            , ScanPos(FieldBegin)
+#ifdef ARCADIA_SSE
+            , DelimiterPattern(_mm_set1_epi8(delimiter))
+#endif
+        {}
+
+        // returns false if all fields have already been returned
+        bool Next(TStringBuf* field) {
+            if (Finished) {
+                return false;
+            }
+            const char* fieldEnd = FindNextDelimiter();
+            *field = TStringBuf(FieldBegin, fieldEnd);
+            if (fieldEnd == End) {
+                Finished = true;
+            } else {
+                FieldBegin = fieldEnd + 1;
+            }
+            return true;
+        }
+
+    private:
+        const char* FindNextDelimiter() {
+            while (!Mask) {
+#ifdef ARCADIA_SSE
+                if (End - ScanPos >= 16) {
+                    const __m128i block = _mm_loadu_si128((const __m128i*)ScanPos);
+                    Mask = (ui32)_mm_movemask_epi8(_mm_cmpeq_epi8(block, DelimiterPattern));
+                    MaskBase = ScanPos;
+                    ScanPos += 16;
+                    continue;
+                }
+#endif
+                for (; ScanPos != End; ++ScanPos) {
+                    if (*ScanPos == Delimiter) {
+                        return ScanPos++;
+                    }
+                }
+                return End;
+            }
+            const char* delimiterPos = MaskBase + CountTrailingZeroBits(Mask);
+            Mask &= Mask - 1;
+            return delimiterPos;
+        }
+
+    private:
+        const char* FieldBegin;
+        const char* const End;
+        const char Delimiter;
+        bool Finished = false;
+
+        // delimiters in [MaskBase, ScanPos) that have not been returned yet
+        const char* ScanPos;
+        const char* MaskBase = nullptr;
+        ui32 Mask = 0;
+#ifdef ARCADIA_SSE
+        const __m128i DelimiterPattern;
+#endif
+    };
+
+
+    /* Returns the same result as TryFromString<float>.
+     * Plain decimals ([-]digits[.digits][(e|E)[+|-]digits]) with at most 19 significant digits
+     *  that are exactly representable in double with exponent in [-22, 22] are converted directly
+     *  (correctly rounded double is then rounded to float as in TryFromString<float>),
+     *  other inputs are passed to TryFromString<float>.
+     */
+    bool TryParseFloat(TStringBuf s, float* value);
+}
@@ -1,10 +1,14 @@
 
 #include <catboost/libs/data/data_provider.h>
+#include <catboost/libs/data/data_provider_builders.h>
 
 #include <catboost/libs/data/ut/lib/for_objects.h>
 #include <catboost/libs/data/ut/lib/for_target.h>
 
 #include <library/binsaver/util_stream_io.h>
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/xrange.h>
 
 #include <library/unittest/registar.h>
 
@@ -476,3 +480,68 @@ Y_UNIT_TEST_SUITE(TProcessedDataProviderTemplate) {
         TestMultiTargetSerialization<TQuantizedForCPUObjectsDataProvider>();
     }
 }
+
+
+Y_UNIT_TEST_SUITE(ExternalFloatFeaturesMatrix) {
+    Y_UNIT_TEST(RowAndColumnMajor) {
+        constexpr ui32 objectCount = 4;
+        constexpr ui32 featureCount = 3;
+
+        NPar::TLocalExecutor localExecutor;
+
+        for (bool rowMajor : {true, false}) {
+            // data is owned only by the resource holder after the data provider is created
+            auto matrixHolder = MakeIntrusive<TVectorHolder<double>>();
+            matrixHolder->Data.resize(objectCount * featureCount);
+            for (auto objectIdx : xrange(objectCount)) {
+                for (auto featureIdx : xrange(featureCount)) {
+                    const size_t idx = rowMajor ?
+                        (objectIdx * featureCount + featureIdx)
+                        : (featureIdx * objectCount + objectIdx);
+                    matrixHolder->Data[idx] = 10.0 * objectIdx + featureIdx;
+                }
+            }
+            const double* matrixData = matrixHolder->Data.data();
+
+            TDataProviderPtr dataProvider = CreateDataProvider(
+                [&] (IRawFeaturesOrderDataVisitor* visitor) {
+                    TDataMetaInfo metaInfo;
+                    metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                        featureCount,
+                        TVector<ui32>{},
+                        TVector<ui32>{},
+                        TVector<TString>{}
+                    );
+                    visitor->Start(metaInfo, objectCount, EObjectsOrder::Undefined, {});
+
+                    AddFloatFeaturesFromExternalMatrix<double>(
+                        matrixData,
+                        objectCount,
+                        /*objectStride*/ rowMajor ? featureCount : 1,
+                        /*columnStride*/ rowMajor ? 1 : objectCount,
+                        TVector<ui32>{0, 1, 2},
+                        std::move(matrixHolder),
+                        visitor
+                    );
+
+                    visitor->Finish();
+                }
+            );
+
+            const auto* rawObjectsData = dynamic_cast<const TRawObjectsDataProvider*>(
+                dataProvider->ObjectsData.Get()
+            );
+            UNIT_ASSERT(rawObjectsData);
+            for (auto featureIdx : xrange(featureCount)) {
+                const auto values = (*rawObjectsData->GetFloatFeature(featureIdx))->ExtractValues(
+                    &localExecutor
+                );
+                TVector<float> expectedValues;
+                for (auto objectIdx : xrange(objectCount)) {
+                    expectedValues.push_back(10.0f * objectIdx + featureIdx);
+                }
+                UNIT_ASSERT_VALUES_EQUAL(TVector<float>(values.begin(), values.end()), expectedValues);
+            }
+        }
+    }
+}
@@ -14,6 +14,8 @@
 #include <util/random/fast.h>
 #include <util/random/shuffle.h>
 #include <util/system/info.h>
+#include <util/system/mktemp.h>
+#include <util/system/tempfile.h>
 
 #include <library/unittest/registar.h>
 
@@ -1017,6 +1019,26 @@ Y_UNIT_TEST_SUITE(TQuantizedObjectsData) {
                     objectsDataProvider->CalcFeaturesCheckSum(&localExecutor),
                     expectedUsedFeatureTypesToCheckSum.at(useFeatureTypes)
                 );
+
+                if (taskType == ETaskType::CPU) {
+                    auto& quantizedForCPUObjectsDataProvider =
+                        dynamic_cast<TQuantizedForCPUObjectsDataProvider&>(*objectsDataProvider);
+
+                    TTempFile columnStoreFile(MakeTempName());
+                    UNIT_ASSERT(
+                        quantizedForCPUObjectsDataProvider.MoveFeaturesDataToColumnStore(
+                            columnStoreFile.Name(),
+                            &localExecutor
+                        ) > 0
+                    );
+                    UNIT_ASSERT(quantizedForCPUObjectsDataProvider.HasFeaturesColumnStore());
+
+                    // features data is the same when it is read from the column store
+                    UNIT_ASSERT_VALUES_EQUAL(
+                        objectsDataProvider->CalcFeaturesCheckSum(&localExecutor),
+                        expectedUsedFeatureTypesToCheckSum.at(useFeatureTypes)
+                    );
+                }
             }
         }
     }
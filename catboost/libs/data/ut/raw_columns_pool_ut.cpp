@@ -0,0 +1,111 @@
+#include <catboost/libs/data/ut/lib/for_loader.h>
+
+#include <catboost/libs/data/load_data.h>
+#include <catboost/libs/data/raw_columns_pool.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/strbuf.h>
+#include <util/system/mktemp.h>
+#include <util/system/tempfile.h>
+
+#include <library/unittest/registar.h>
+
+
+using namespace NCB;
+using namespace NCB::NDataNewUT;
+
+
+static TDataProviderPtr ReadDatasetForTest(
+    const TReadDatasetMainParams& params,
+    TDatasetSubset loadSubset,
+    NPar::TLocalExecutor* localExecutor
+) {
+    return ReadDataset(
+        params.PoolPath,
+        params.PairsFilePath,
+        params.GroupWeightsFilePath,
+        params.BaselineFilePath,
+        params.ColumnarPoolFormatParams,
+        /*ignoredFeatures*/ {},
+        EObjectsOrder::Undefined,
+        loadSubset,
+        /*classNames*/ Nothing(),
+        localExecutor
+    );
+}
+
+
+Y_UNIT_TEST_SUITE(RawColumnsPool) {
+    Y_UNIT_TEST(SaveAndLoad) {
+        TSrcData srcData;
+        srcData.CdFileData = AsStringBuf(
+            "0\tTarget\n"
+            "1\tGroupId\n"
+            "2\tSubgroupId\n"
+            "3\tWeight\n"
+            "4\tNum\tf0\n"
+            "5\tCateg\tc0\n"
+            "6\tNum\tf1\n"
+            "7\tText\tt0\n"
+        );
+        srcData.DatasetFileData = AsStringBuf(
+            "0.12\tquery0\tsite1\t0.12\t0.1\tMale\t0.2\tthe cat\n"
+            "0.22\tquery0\tsite22\t0.18\t0.97\tFemale\t0.82\ta dog\n"
+            "0.34\tquery1\tSite9\t1.0\t0.13\tMale\t0.22\t\n"
+            "0.42\tQuery 2\tsite12\t0.45\t0.14\t\t0.18\tthe cat and the dog\n"
+            "0.01\tQuery 2\tsite22\t1.0\t0.9\tFemale\t0.67\tdog\n"
+            "0.0\tQuery 2\tSite45\t2.0\t0.66\tMale\t0.1\tcat\n"
+        );
+        srcData.PairsFileData = AsStringBuf(
+            "0\t1\n"
+            "3\t5\n"
+            "4\t3\n"
+        );
+
+        TReadDatasetMainParams readDatasetMainParams;
+        TVector<THolder<TTempFile>> srcDataFiles;
+        SaveSrcData(srcData, &readDatasetMainParams, &srcDataFiles);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        const auto dataProvider = ReadDatasetForTest(
+            readDatasetMainParams,
+            TDatasetSubset::MakeColumns(),
+            &localExecutor
+        );
+
+        TTempFile rawColumnsPoolFile(MakeTempName());
+        SaveRawColumnsPool(*dataProvider, rawColumnsPoolFile.Name(), &localExecutor);
+
+        TReadDatasetMainParams rawColumnsParams;
+        rawColumnsParams.PoolPath = TPathWithScheme(rawColumnsPoolFile.Name(), "raw-columns");
+
+        const auto loadedDataProvider = ReadDatasetForTest(
+            rawColumnsParams,
+            TDatasetSubset::MakeColumns(),
+            &localExecutor
+        );
+        UNIT_ASSERT(dataProvider->EqualTo(*loadedDataProvider));
+
+        // objects range subset
+        const auto loadedSubset = ReadDatasetForTest(
+            rawColumnsParams,
+            TDatasetSubset::MakeRange(3, 6),
+            &localExecutor
+        );
+        UNIT_ASSERT_VALUES_EQUAL(loadedSubset->GetObjectCount(), 3);
+        UNIT_ASSERT_VALUES_EQUAL(loadedSubset->RawTargetData.GetPairs().size(), 2);
+
+        // no pairs inside the subset
+        const auto loadedSubsetWithoutPairs = ReadDatasetForTest(
+            rawColumnsParams,
+            TDatasetSubset::MakeRange(1, 3),
+            &localExecutor
+        );
+        UNIT_ASSERT_VALUES_EQUAL(loadedSubsetWithoutPairs->GetObjectCount(), 2);
+        UNIT_ASSERT(loadedSubsetWithoutPairs->MetaInfo.HasPairs);
+        UNIT_ASSERT(loadedSubsetWithoutPairs->RawTargetData.GetPairs().empty());
+    }
+}
@@ -0,0 +1,165 @@
+#include <catboost/libs/data/streaming_quantization.h>
+
+#include <catboost/libs/data/load_data.h>
+#include <catboost/libs/data/ut/lib/for_loader.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/xrange.h>
+#include <util/string/builder.h>
+
+#include <library/unittest/registar.h>
+
+
+using namespace NCB;
+using namespace NCB::NDataNewUT;
+
+
+static TString MakeDataset(ui32 objectCount) {
+    TStringBuilder dataset;
+    for (auto i : xrange(objectCount)) {
+        dataset << (i % 2) << '\t'
+            << (i % 37) * 0.5f << '\t'
+            << ((i * 7919) % 1000) / 13.0f << '\t';
+        if (i == 777) {
+            dataset << "nan";
+        } else {
+            dataset << i;
+        }
+        dataset << '\n';
+    }
+    return dataset;
+}
+
+
+static TVector<TVector<ui8>> GetQuantizedFloatFeatures(
+    const TQuantizedObjectsDataProvider& objectsData,
+    NPar::TLocalExecutor* localExecutor
+) {
+    TVector<TVector<ui8>> result;
+    for (auto floatFeatureIdx : xrange(objectsData.GetFeaturesLayout()->GetFloatFeatureCount())) {
+        auto values = (*objectsData.GetFloatFeature(floatFeatureIdx))->ExtractValues(localExecutor);
+        TConstArrayRef<ui8> valuesRef = *values;
+        result.emplace_back(valuesRef.begin(), valuesRef.end());
+    }
+    return result;
+}
+
+
+Y_UNIT_TEST_SUITE(StreamingQuantization) {
+    void TestQuantizeInBlocks(ui32 objectCount, ui32 blockSize, ui32 sampleSize) {
+        const TString dataset = MakeDataset(objectCount);
+
+        TSrcData srcData;
+        srcData.CdFileData = TStringBuf("0\tTarget\n");
+        srcData.DatasetFileData = dataset;
+
+        TReadDatasetMainParams readDatasetMainParams;
+        TVector<THolder<TTempFile>> srcDataFiles;
+        SaveSrcData(srcData, &readDatasetMainParams, &srcDataFiles);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(2);
+
+        const NCatboostOptions::TBinarizationOptions binarizationOptions(
+            EBorderSelectionType::GreedyLogSum,
+            16,
+            ENanMode::Min
+        );
+
+        TQuantizationOptions options;
+        options.BundleExclusiveFeaturesForCpu = false;
+        options.PackBinaryFeaturesForCpu = false;
+        options.MaxSubsetSizeForBuildBordersAlgorithms = sampleSize;
+
+        TVector<TQuantizedDataProviderPtr> blocks;
+        TRestorableFastRng64 rand(0);
+        auto quantizedFeaturesInfo = QuantizeInBlocks(
+            readDatasetMainParams.PoolPath,
+            readDatasetMainParams.BaselineFilePath,
+            readDatasetMainParams.ColumnarPoolFormatParams,
+            /*ignoredFeatures*/ {},
+            /*classNames*/ {},
+            binarizationOptions,
+            /*perFloatFeatureQuantization*/ {},
+            options,
+            blockSize,
+            [&] (TQuantizedDataProviderPtr block) {
+                blocks.push_back(std::move(block));
+            },
+            &rand,
+            &localExecutor
+        );
+
+        UNIT_ASSERT_VALUES_EQUAL(blocks.size(), (objectCount + blockSize - 1) / blockSize);
+        ui32 quantizedObjectCount = 0;
+        for (const auto& block : blocks) {
+            UNIT_ASSERT(block->ObjectsData->GetQuantizedFeaturesInfo() == quantizedFeaturesInfo);
+            quantizedObjectCount += block->GetObjectCount();
+        }
+        UNIT_ASSERT_VALUES_EQUAL(quantizedObjectCount, objectCount);
+
+        // nan values are present only outside of small samples
+        UNIT_ASSERT_EQUAL(quantizedFeaturesInfo->GetNanMode(TFloatFeatureIdx(2)), ENanMode::Min);
+
+        if (sampleSize < objectCount) {
+            return;
+        }
+
+        // the whole dataset is the sample, so the result must be the same as for in-memory quantization
+        auto rawDataProvider = ReadDataset(
+            readDatasetMainParams.PoolPath,
+            TPathWithScheme(),
+            TPathWithScheme(),
+            TPathWithScheme(),
+            readDatasetMainParams.ColumnarPoolFormatParams,
+            /*ignoredFeatures*/ {},
+            EObjectsOrder::Undefined,
+            TDatasetSubset::MakeColumns(),
+            Nothing(),
+            &localExecutor
+        )->CastMoveTo<TRawObjectsDataProvider>();
+
+        auto expectedQuantizedFeaturesInfo = MakeIntrusive<TQuantizedFeaturesInfo>(
+            *rawDataProvider->MetaInfo.FeaturesLayout,
+            TConstArrayRef<ui32>(),
+            binarizationOptions
+        );
+        auto expectedData = Quantize(
+            options,
+            std::move(rawDataProvider),
+            expectedQuantizedFeaturesInfo,
+            &rand,
+            &localExecutor
+        );
+
+        const auto expectedFeatures = GetQuantizedFloatFeatures(*expectedData->ObjectsData, &localExecutor);
+        for (auto floatFeatureIdx : xrange(expectedFeatures.size())) {
+            UNIT_ASSERT_VALUES_EQUAL(
+                quantizedFeaturesInfo->GetBorders(TFloatFeatureIdx(floatFeatureIdx)),
+                expectedQuantizedFeaturesInfo->GetBorders(TFloatFeatureIdx(floatFeatureIdx))
+            );
+
+            TVector<ui8> features;
+            for (const auto& block : blocks) {
+                const auto blockFeatures = GetQuantizedFloatFeatures(*block->ObjectsData, &localExecutor);
+                features.insert(
+                    features.end(),
+                    blockFeatures[floatFeatureIdx].begin(),
+                    blockFeatures[floatFeatureIdx].end()
+                );
+            }
+            UNIT_ASSERT_VALUES_EQUAL(features, expectedFeatures[floatFeatureIdx]);
+        }
+    }
+
+    Y_UNIT_TEST(WholeDatasetSample) {
+        TestQuantizeInBlocks(1000, 64, 200000);
+        TestQuantizeInBlocks(1000, 1000, 200000);
+    }
+
+    Y_UNIT_TEST(SmallSample) {
+        TestQuantizeInBlocks(1000, 64, 100);
+        TestQuantizeInBlocks(1000, 7, 10);
+    }
+}
@@ -0,0 +1,74 @@
+#include <catboost/libs/data/text_parsing.h>
+
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/generic/ymath.h>
+#include <util/string/cast.h>
+#include <util/string/split.h>
+
+#include <library/unittest/registar.h>
+
+#include <cmath>
+
+
+using namespace NCB;
+
+
+static TVector<TString> SplitFields(TStringBuf line, char delimiter) {
+    TVector<TString> fields;
+    TDelimitedFieldSplitter splitter(line, delimiter);
+    for (TStringBuf field; splitter.Next(&field); ) {
+        fields.push_back(TString(field));
+    }
+    return fields;
+}
+
+
+Y_UNIT_TEST_SUITE(TextParsing) {
+    Y_UNIT_TEST(DelimitedFieldSplitter) {
+        const TVector<TString> lines = {
+            "",
+            "\t",
+            "a",
+            "a\tb",
+            "\ta\t\tb\t",
+            "0.12345\t1\t2\t3\t4\t5\t6\t7\t8\t9\t10\t11\t12\t13\t14\t15\t16\t17",
+            "long field without delimiters that does not fit into one block",
+            "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t",
+            "first field in the block\tsecond\t\tfourth field in the next block\t"
+        };
+        for (const auto& line : lines) {
+            const TVector<TString> expectedFields = StringSplitter(line).Split('\t');
+            UNIT_ASSERT_VALUES_EQUAL(SplitFields(line, '\t'), expectedFields);
+        }
+    }
+
+    Y_UNIT_TEST(TryParseFloat) {
+        const TVector<TString> values = {
+            "0", "-0", "1", "-1", "0.1", "0.5", "1.25", "-3.75", "00012", "0.000123",
+            "3.4028234e38", "1e-45", "1.5e10", "2E-3", "7e+2", "0.30000000000000004",
+            "123456789.123456789", "9007199254740993", "1e23", "1e-23", "1e400", "1e-400",
+            "0x1p3", "inf", "-inf", "nan", ".5", "1.", "0e999999"
+        };
+        for (const auto& value : values) {
+            float expected;
+            const bool expectedParsed = TryFromString<float>(value, expected);
+            float parsed;
+            UNIT_ASSERT_VALUES_EQUAL_C(TryParseFloat(value, &parsed), expectedParsed, value);
+            if (expectedParsed) {
+                if (IsNan(expected)) {
+                    UNIT_ASSERT_C(IsNan(parsed), value);
+                } else {
+                    UNIT_ASSERT_VALUES_EQUAL_C(parsed, expected, value);
+                    UNIT_ASSERT_VALUES_EQUAL_C(std::signbit(parsed), std::signbit(expected), value);
+                }
+            }
+        }
+
+        const TVector<TString> wrongValues = {"", "-", "+", "e5", "1e", "1e+", "1.2.3", "1,5", "12a", "a12"};
+        for (const auto& value : wrongValues) {
+            float parsed;
+            UNIT_ASSERT_C(!TryParseFloat(value, &parsed), value);
+        }
+    }
+}
@@ -249,6 +249,23 @@ namespace NCB {
             TMaybeOwningConstArrayHolder<ui8> featuresPart // per-object data size depends on BitsPerKey
         ) = 0;
 
+        /* feature data for all objects at once in TCompressedArray storage format
+         * (TIndexHelper<ui64>(bitsPerDocumentFeature).CompressedSize(objectCount) elements).
+         * Data is used without copying if possible (memory mapped file for example), so it must not be
+         * modified and must be kept available by the resource holder in featureData.
+         */
+        virtual void AddFloatFeature(
+            ui32 flatFeatureIdx,
+            ui8 bitsPerDocumentFeature,
+            TMaybeOwningConstArrayHolder<ui64> featureData
+        ) = 0;
+
+        virtual void AddCatFeature(
+            ui32 flatFeatureIdx,
+            ui8 bitsPerDocumentFeature,
+            TMaybeOwningConstArrayHolder<ui64> featureData
+        ) = 0;
+
 
         // TRawTargetData
 
@@ -0,0 +1,105 @@
+#include "arena.h"
+
+#include "exception.h"
+
+#include <util/generic/utility.h>
+#include <util/generic/xrange.h>
+#include <util/system/align.h>
+
+
+using namespace NCB;
+
+
+TArena::TArena(size_t initialChunkSize) {
+    AddChunk(initialChunkSize);
+}
+
+void TArena::AddChunk(size_t minSize) {
+    const size_t size = Max(minSize, ChunkSizes.empty() ? minSize : 2 * ChunkSizes.back());
+    Chunks.emplace_back(new char[size]);
+    ChunkSizes.push_back(size);
+}
+
+void* TArena::Allocate(size_t size, size_t align) {
+    AllocatedBytes += size;
+    for (;;) {
+        char* chunkBegin = Chunks[CurrentChunkIdx].Get();
+        const size_t alignedOffset = AlignUp(chunkBegin + CurrentOffset, align) - chunkBegin;
+        if (alignedOffset + size <= ChunkSizes[CurrentChunkIdx]) {
+            CurrentOffset = alignedOffset + size;
+            return chunkBegin + alignedOffset;
+        }
+        const size_t nextChunkIdx = CurrentChunkIdx + 1;
+        // chunks after the current one are free, those that are too small are dropped
+        while (nextChunkIdx < Chunks.size() && ChunkSizes[nextChunkIdx] < size + align) {
+            Chunks.erase(Chunks.begin() + nextChunkIdx);
+            ChunkSizes.erase(ChunkSizes.begin() + nextChunkIdx);
+        }
+        if (nextChunkIdx == Chunks.size()) {
+            AddChunk(size + align);
+        }
+        CurrentChunkIdx = nextChunkIdx;
+        CurrentOffset = 0;
+    }
+}
+
+void TArena::Rewind(TMark mark) {
+    CB_ENSURE_INTERNAL(
+        (mark.ChunkIdx < CurrentChunkIdx)
+            || ((mark.ChunkIdx == CurrentChunkIdx) && (mark.Offset <= CurrentOffset)),
+        "Arena is rewound past its current position"
+    );
+    CurrentChunkIdx = mark.ChunkIdx;
+    CurrentOffset = mark.Offset;
+}
+
+void TArena::Reset() {
+    if (Chunks.size() > 1) {
+        const size_t capacity = GetCapacity();
+        Chunks.clear();
+        ChunkSizes.clear();
+        AddChunk(capacity);
+    }
+    CurrentChunkIdx = 0;
+    CurrentOffset = 0;
+    AllocatedBytes = 0;
+}
+
+size_t TArena::GetCapacity() const {
+    size_t capacity = 0;
+    for (auto chunkSize : ChunkSizes) {
+        capacity += chunkSize;
+    }
+    return capacity;
+}
+
+
+TThreadArenas::TThreadArenas(NPar::TLocalExecutor* localExecutor)
+    : LocalExecutor(localExecutor)
+{
+    const int arenaCount = localExecutor->GetThreadCount() + 1;
+    for (auto i : xrange(arenaCount)) {
+        Y_UNUSED(i);
+        Arenas.emplace_back(MakeHolder<TArena>());
+    }
+}
+
+TArena* TThreadArenas::GetArena() {
+    const int workerThreadId = LocalExecutor->GetWorkerThreadId();
+    CB_ENSURE_INTERNAL(workerThreadId < Arenas.ysize(), "No arena for thread " << workerThreadId);
+    return Arenas[workerThreadId].Get();
+}
+
+void TThreadArenas::Reset() {
+    for (auto& arena : Arenas) {
+        arena->Reset();
+    }
+}
+
+ui64 TThreadArenas::GetAllocatedBytes() const {
+    ui64 allocatedBytes = 0;
+    for (const auto& arena : Arenas) {
+        allocatedBytes += arena->GetAllocatedBytes();
+    }
+    return allocatedBytes;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/noncopyable.h>
+#include <util/generic/ptr.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+#include <type_traits>
+
+
+namespace NCB {
+
+    /* Bump allocator for short-lived scratch arrays.
+     * Memory is released only in LIFO order, with TArenaScope or Reset, so allocation does not take locks and
+     * memory of released arrays is reused by the next allocations without returning it to malloc.
+     * Not thread-safe, use one arena per thread (see TThreadArenas).
+     */
+    class TArena : public TNonCopyable {
+    public:
+        struct TMark {
+            size_t ChunkIdx = 0;
+            size_t Offset = 0;
+        };
+
+    public:
+        explicit TArena(size_t initialChunkSize = 64 * 1024);
+
+        void* Allocate(size_t size, size_t align);
+
+        // uninitialized, T must be trivially destructible
+        template <class T>
+        TArrayRef<T> AllocateArray(size_t count) {
+            static_assert(std::is_trivially_destructible<T>::value, "Arena does not call destructors");
+            return TArrayRef<T>((T*)Allocate(count * sizeof(T), alignof(T)), count);
+        }
+
+        template <class T>
+        TArrayRef<T> AllocateArray(size_t count, const T& value) {
+            auto array = AllocateArray<T>(count);
+            for (auto& element : array) {
+                new (&element) T(value);
+            }
+            return array;
+        }
+
+        TMark GetMark() const {
+            return {CurrentChunkIdx, CurrentOffset};
+        }
+
+        // release everything allocated after mark
+        void Rewind(TMark mark);
+
+        /* release everything, if allocations did not fit in one chunk, chunks are replaced by one of their total size,
+         * so the same allocations fit in it next time
+         */
+        void Reset();
+
+        // sum of sizes of allocations since the last Reset (released ones included)
+        ui64 GetAllocatedBytes() const {
+            return AllocatedBytes;
+        }
+
+        // size of memory currently held by the arena
+        size_t GetCapacity() const;
+
+    private:
+        void AddChunk(size_t minSize);
+
+    private:
+        TVector<TArrayHolder<char>> Chunks;
+        TVector<size_t> ChunkSizes;
+        size_t CurrentChunkIdx = 0;
+        size_t CurrentOffset = 0;
+        ui64 AllocatedBytes = 0;
+    };
+
+
+    // releases allocations made in the arena during the lifetime of the scope, no-op for nullptr arena
+    class TArenaScope : public TNonCopyable {
+    public:
+        explicit TArenaScope(TArena* arena)
+            : Arena(arena)
+        {
+            if (Arena) {
+                Mark = Arena->GetMark();
+            }
+        }
+
+        ~TArenaScope() {
+            if (Arena) {
+                Arena->Rewind(Mark);
+            }
+        }
+
+    private:
+        TArena* Arena;
+        TArena::TMark Mark;
+    };
+
+
+    /* One arena for each thread of localExecutor (and the thread that calls it), selected by
+     * localExecutor->GetWorkerThreadId(), so threads running parallel sections of the same executor can allocate
+     * without synchronization.
+     */
+    class TThreadArenas : public TNonCopyable {
+    public:
+        explicit TThreadArenas(NPar::TLocalExecutor* localExecutor);
+
+        // arena of the calling thread
+        TArena* GetArena();
+
+        // must not be called while allocations in any arena are in use
+        void Reset();
+
+        ui64 GetAllocatedBytes() const;
+
+    private:
+        NPar::TLocalExecutor* LocalExecutor;
+        TVector<THolder<TArena>> Arenas; // [workerThreadId]
+    };
+
+
+    // arena of the calling thread or nullptr if threadArenas is nullptr
+    inline TArena* GetThreadArena(TThreadArenas* threadArenas) {
+        return threadArenas ? threadArenas->GetArena() : nullptr;
+    }
+
+    // uses the arena of the calling thread if threadArenas is not nullptr, otherwise allocates in holder
+    template <class T>
+    inline TArrayRef<T> AllocateScratchArray(size_t count, TThreadArenas* threadArenas, TVector<T>* holder) {
+        if (threadArenas) {
+            return threadArenas->GetArena()->AllocateArray<T>(count);
+        }
+        holder->yresize(count);
+        return *holder;
+    }
+}
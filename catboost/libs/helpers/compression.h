@@ -196,6 +196,15 @@ public:
         return reinterpret_cast<const char*>((*Storage).data());
     }
 
+    TConstArrayRef<ui64> GetStorage() const {
+        return *Storage;
+    }
+
+    // owner of storage memory, it can be external (e.g. memory-mapped file)
+    TIntrusivePtr<NCB::IResourceHolder> GetStorageResourceHolder() const {
+        return Storage.GetResourceHolder();
+    }
+
     template <class T>
     NCB::IDynamicBlockWithExactIteratorPtr<T> GetBlockIterator(ui64 offset) const;
 
@@ -413,6 +413,40 @@ namespace NCB {
         TVector<TDst> DstBuffer;
     };
 
+    // iterates over elements placed stride elements apart, values are copied to the block buffer
+    template <class TDst, class TSrc>
+    class TStridedArrayBlockIterator final : public IDynamicBlockWithExactIterator<TDst> {
+    public:
+        TStridedArrayBlockIterator(const TSrc* begin, size_t size, size_t stride)
+            : Current(begin)
+            , RemainingSize(size)
+            , Stride(stride)
+        {}
+
+        TConstArrayRef<TDst> Next(size_t maxBlockSize = Max<size_t>()) override {
+            return NextExact(Min(maxBlockSize, RemainingSize));
+        }
+
+        TConstArrayRef<TDst> NextExact(size_t exactBlockSize) override {
+            Y_ASSERT(exactBlockSize <= RemainingSize);
+            DstBuffer.yresize(exactBlockSize);
+            for (size_t i = 0; i < exactBlockSize; ++i) {
+                DstBuffer[i] = Current[i * Stride];
+            }
+            RemainingSize -= exactBlockSize;
+            if (RemainingSize) {
+                Current += exactBlockSize * Stride;
+            }
+            return DstBuffer;
+        }
+    private:
+        const TSrc* Current;
+        size_t RemainingSize;
+        const size_t Stride;
+
+        TVector<TDst> DstBuffer;
+    };
+
     template <class TDst, class TSrc, class TTransformer>
     class TTransformArrayBlockIterator final : public IDynamicBlockWithExactIterator<TDst> {
     public:
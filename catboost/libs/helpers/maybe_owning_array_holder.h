@@ -1,5 +1,6 @@
 #pragma once
 
+#include "exception.h"
 #include "resource_holder.h"
 #include "serialization.h"
 
@@ -7,6 +8,7 @@
 
 #include <util/generic/array_ref.h>
 #include <util/generic/cast.h>
+#include <util/generic/xrange.h>
 #include <util/system/compiler.h>
 
 #include <type_traits>
@@ -156,6 +158,88 @@ namespace NCB {
     template <class T>
     using TMaybeOwningConstArrayHolder = TMaybeOwningArrayHolder<const T>;
 
+    /* Read-only view of size elements placed Stride elements apart, e.g. a column of
+     * an externally owned row-major matrix.
+     * Data is kept alive by resourceHolder, if it is not specified the caller is responsible for
+     * the data lifetime.
+     */
+    template <class T>
+    class TStridedConstArrayHolder {
+    public:
+        TStridedConstArrayHolder() = default;
+
+        TStridedConstArrayHolder(
+            const T* begin,
+            size_t size,
+            size_t stride,
+            TIntrusivePtr<IResourceHolder> resourceHolder = nullptr
+        )
+            : Begin(begin)
+            , Size(size)
+            , Stride(stride)
+            , ResourceHolder(std::move(resourceHolder))
+        {
+            CB_ENSURE_INTERNAL(Stride > 0, "TStridedConstArrayHolder: zero stride");
+        }
+
+        // data is saved densely and loaded to an owned vector
+        int operator&(IBinSaver& binSaver) {
+            if (binSaver.IsReading()) {
+                auto data = TMaybeOwningConstArrayHolder<T>();
+                binSaver.Add(0, &data);
+                *this = TStridedConstArrayHolder(data.data(), data.GetSize(), 1, data.GetResourceHolder());
+            } else {
+                TVector<T> data(Begin ? Size : 0);
+                for (auto i : xrange(Size)) {
+                    data[i] = (*this)[i];
+                }
+                auto dataHolder = TMaybeOwningConstArrayHolder<T>::CreateNonOwning(data);
+                binSaver.Add(0, &dataHolder);
+            }
+            return 0;
+        }
+
+        // compares values
+        bool operator==(const TStridedConstArrayHolder& rhs) const {
+            if (Size != rhs.Size) {
+                return false;
+            }
+            for (auto i : xrange(Size)) {
+                if (!((*this)[i] == rhs[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        const T& operator[] (size_t idx) const {
+            return Begin[idx * Stride];
+        }
+
+        const T* data() const {
+            return Begin;
+        }
+
+        size_t GetSize() const {
+            return Size;
+        }
+
+        size_t GetStride() const {
+            return Stride;
+        }
+
+        TIntrusivePtr<IResourceHolder> GetResourceHolder() const {
+            return ResourceHolder;
+        }
+
+    private:
+        const T* Begin = nullptr;
+        size_t Size = 0;
+        size_t Stride = 1;
+        TIntrusivePtr<IResourceHolder> ResourceHolder;
+    };
+
+
     template <class TDst, class TSrc>
     TMaybeOwningArrayHolder<TDst> CreateOwningWithMaybeTypeCast(TMaybeOwningArrayHolder<TSrc> src) {
         if constexpr (std::is_same_v<std::remove_const_t<TDst>, TSrc>) {
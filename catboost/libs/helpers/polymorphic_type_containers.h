@@ -122,14 +122,18 @@ namespace NCB {
     using ITypedArraySubsetPtr = TIntrusivePtr<ITypedArraySubset<T>>;
 
 
-    template <class TInterfaceValue, class TStoredValue>
+    // TArrayLike must provide indexed access to TStoredValue elements
+    template <
+        class TInterfaceValue,
+        class TStoredValue,
+        class TArrayLike = TMaybeOwningConstArrayHolder<TStoredValue>>
     class TTypeCastArraySubset final : public ITypedArraySubset<TInterfaceValue> {
     public:
-        using TData = TMaybeOwningConstArrayHolder<TStoredValue>;
+        using TData = TArrayLike;
 
     public:
         TTypeCastArraySubset(
-            TMaybeOwningConstArrayHolder<TStoredValue> data,
+            TData data,
             const TArraySubsetIndexing<ui32>* subsetIndexing
         )
             : Data(std::move(data))
@@ -184,7 +188,7 @@ namespace NCB {
         TIntrusivePtr<ITypedArraySubset<TInterfaceValue>> CloneWithNewSubsetIndexing(
             const TArraySubsetIndexing<ui32>* newSubsetIndexing
         ) const override {
-            return MakeIntrusive<TTypeCastArraySubset<TInterfaceValue, TStoredValue>>(
+            return MakeIntrusive<TTypeCastArraySubset<TInterfaceValue, TStoredValue, TArrayLike>>(
                 Data,
                 newSubsetIndexing
             );
@@ -479,6 +483,88 @@ namespace NCB {
         );
     }
 
+    template <class TInterfaceValue, class TStoredValue>
+    class TStridedTypeCastArrayHolder final : public ITypedSequence<TInterfaceValue> {
+    public:
+        explicit TStridedTypeCastArrayHolder(TStridedConstArrayHolder<TStoredValue> values)
+            : Values(std::move(values))
+        {}
+
+        int operator&(IBinSaver& binSaver) override {
+            binSaver.Add(0, &Values);
+            return 0;
+        }
+
+        bool EqualTo(const ITypedSequence<TInterfaceValue>& rhs, bool strict = true) const override {
+            if (strict) {
+                if (const auto* rhsAsThisType
+                        = dynamic_cast<const TStridedTypeCastArrayHolder<TInterfaceValue, TStoredValue>*>(&rhs))
+                {
+                    return Values == rhsAsThisType->Values;
+                } else {
+                    return false;
+                }
+            } else {
+                return AreBlockedSequencesEqual<TInterfaceValue, TInterfaceValue>(
+                    ITypedSequence<TInterfaceValue>::GetBlockIterator(),
+                    rhs.ITypedSequence<TInterfaceValue>::GetBlockIterator()
+                );
+            }
+        }
+
+        ui32 GetSize() const override {
+            return SafeIntegerCast<ui32>(Values.GetSize());
+        }
+
+        IDynamicBlockWithExactIteratorPtr<TInterfaceValue> GetBlockIterator(
+            TIndexRange<ui32> indexRange
+        ) const override {
+            return MakeHolder<TStridedArrayBlockIterator<TInterfaceValue, TStoredValue>>(
+                Values.data() + size_t(indexRange.Begin) * Values.GetStride(),
+                indexRange.GetSize(),
+                Values.GetStride()
+            );
+        }
+
+        TIntrusivePtr<ITypedArraySubset<TInterfaceValue>> GetSubset(
+            const TArraySubsetIndexing<ui32>* subsetIndexing
+        ) const override {
+            return MakeIntrusive<
+                    TTypeCastArraySubset<TInterfaceValue, TStoredValue, TStridedConstArrayHolder<TStoredValue>>
+                >(
+                    Values,
+                    subsetIndexing
+                );
+        }
+
+    private:
+        TStridedConstArrayHolder<TStoredValue> Values;
+    };
+
+
+    /* Wraps externally owned data without copying, stride is in elements.
+     * Contiguous data (stride == 1) gets a plain TTypeCastArrayHolder to keep fast paths for it.
+     */
+    template <class TInterfaceValue, class TStoredValue>
+    ITypedSequencePtr<TInterfaceValue> MakeStridedTypeCastArrayHolder(
+        const TStoredValue* begin,
+        size_t size,
+        size_t stride,
+        TIntrusivePtr<IResourceHolder> resourceHolder = nullptr
+    ) {
+        if ((stride == 1) || (size <= 1)) {
+            return MakeIntrusive<TTypeCastArrayHolder<TInterfaceValue, TStoredValue>>(
+                TMaybeOwningConstArrayHolder<TStoredValue>::CreateOwning(
+                    TConstArrayRef<TStoredValue>(begin, size),
+                    std::move(resourceHolder)
+                )
+            );
+        }
+        return MakeIntrusive<TStridedTypeCastArrayHolder<TInterfaceValue, TStoredValue>>(
+            TStridedConstArrayHolder<TStoredValue>(begin, size, stride, std::move(resourceHolder))
+        );
+    }
+
     // for Cython where MakeHolder cannot be used
     template <class TInterfaceValue, class TStoredValue>
     ITypedSequencePtr<TInterfaceValue> MakeTypeCastArrayHolderFromVector(TVector<TStoredValue>& values) {
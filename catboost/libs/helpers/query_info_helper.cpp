@@ -51,3 +51,41 @@ TFlatPairsInfo UnpackPairsFromQueries(TConstArrayRef<TQueryInfo> queries) {
     pairs.shrink_to_fit();
     return pairs;
 }
+
+TCompactPairs UnpackCompactPairsFromQueries(TConstArrayRef<TQueryInfo> queries) {
+    size_t winnersCount = 0;
+    size_t pairsCount = 0;
+    for (const auto& query : queries) {
+        for (const auto& competitors : query.Competitors) {
+            winnersCount += !competitors.empty();
+            pairsCount += competitors.size();
+        }
+    }
+
+    TCompactPairs pairs;
+    pairs.WinnerIds.reserve(winnersCount);
+    pairs.WinnerOffsets.reserve(winnersCount + 1);
+    pairs.LoserIds.reserve(pairsCount);
+    pairs.Weights.reserve(pairsCount);
+
+    pairs.WinnerOffsets.push_back(0);
+    for (const auto& query : queries) {
+        if (query.Competitors.empty()) {
+            continue;
+        }
+
+        const ui32 begin = query.Begin;
+        const ui32 end = query.End;
+        for (ui32 winnerId = begin; winnerId < end; ++winnerId) {
+            for (const auto& competitor : query.Competitors[winnerId - begin]) {
+                pairs.LoserIds.push_back(competitor.Id + begin);
+                pairs.Weights.push_back(competitor.SampleWeight);
+            }
+            if (pairs.LoserIds.size() > pairs.WinnerOffsets.back()) {
+                pairs.WinnerIds.push_back(winnerId);
+                pairs.WinnerOffsets.push_back(pairs.LoserIds.size());
+            }
+        }
+    }
+    return pairs;
+}
@@ -7,3 +7,6 @@
 
 TVector<ui32> GetQueryIndicesForDocs(const TConstArrayRef<TQueryInfo> queriesInfo, const ui32 learnSampleCount);
 TFlatPairsInfo UnpackPairsFromQueries(TConstArrayRef<TQueryInfo> queries);
+
+// same pairs as UnpackPairsFromQueries, grouped by winner
+TCompactPairs UnpackCompactPairsFromQueries(TConstArrayRef<TQueryInfo> queries);
@@ -2,6 +2,7 @@
 
 #include <util/generic/ptr.h>
 #include <util/generic/vector.h>
+#include <util/memory/blob.h>
 
 
 namespace NCB {
@@ -21,5 +22,15 @@ namespace NCB {
         {}
     };
 
+    // keeps memory-mapped file (or other blob data) alive while it is referenced
+    struct TBlobHolder : public IResourceHolder {
+        TBlob Blob;
+
+    public:
+        explicit TBlobHolder(const TBlob& blob)
+            : Blob(blob)
+        {}
+    };
+
 }
 
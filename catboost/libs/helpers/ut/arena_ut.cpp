@@ -0,0 +1,82 @@
+#include <catboost/libs/helpers/arena.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+
+#include <library/unittest/registar.h>
+
+
+Y_UNIT_TEST_SUITE(TArenaTest) {
+    Y_UNIT_TEST(TestAllocate) {
+        NCB::TArena arena(/*initialChunkSize*/ 100);
+
+        auto bytes = arena.AllocateArray<ui8>(3, 7);
+        auto doubles = arena.AllocateArray<double>(1000, 1.5); // does not fit in the first chunk
+        auto ints = arena.AllocateArray<int>(10, 2);
+
+        UNIT_ASSERT(AllOf(bytes, [] (ui8 value) { return value == 7; }));
+        UNIT_ASSERT(AllOf(doubles, [] (double value) { return value == 1.5; }));
+        UNIT_ASSERT(AllOf(ints, [] (int value) { return value == 2; }));
+        UNIT_ASSERT_EQUAL((size_t)doubles.data() % alignof(double), 0);
+        UNIT_ASSERT_EQUAL((size_t)ints.data() % alignof(int), 0);
+        UNIT_ASSERT_EQUAL(arena.GetAllocatedBytes(), 3 + 1000 * sizeof(double) + 10 * sizeof(int));
+    }
+
+    Y_UNIT_TEST(TestScope) {
+        NCB::TArena arena(/*initialChunkSize*/ 1000);
+
+        auto outer = arena.AllocateArray<int>(10, 1);
+        int* innerData = nullptr;
+        {
+            NCB::TArenaScope scope(&arena);
+            auto inner = arena.AllocateArray<int>(2000, 2);
+            innerData = inner.data();
+        }
+        {
+            NCB::TArenaScope scope(&arena);
+            auto inner = arena.AllocateArray<int>(2000, 3);
+            UNIT_ASSERT_EQUAL(inner.data(), innerData); // released memory is reused
+        }
+        UNIT_ASSERT(AllOf(outer, [] (int value) { return value == 1; }));
+        UNIT_ASSERT_EQUAL(arena.GetAllocatedBytes(), (10 + 2000 + 2000) * sizeof(int));
+    }
+
+    Y_UNIT_TEST(TestReset) {
+        NCB::TArena arena(/*initialChunkSize*/ 100);
+        for (auto i : xrange(10)) {
+            arena.AllocateArray<double>(100 * (i + 1));
+        }
+        const size_t capacity = arena.GetCapacity();
+        arena.Reset();
+        UNIT_ASSERT_EQUAL(arena.GetAllocatedBytes(), 0);
+        UNIT_ASSERT_EQUAL(arena.GetCapacity(), capacity);
+
+        // all allocations fit in one chunk now
+        const auto first = arena.AllocateArray<double>(100);
+        for (auto i : xrange(1, 10)) {
+            arena.AllocateArray<double>(100 * (i + 1));
+        }
+        UNIT_ASSERT_EQUAL(arena.GetCapacity(), capacity);
+        UNIT_ASSERT_EQUAL(arena.GetMark().ChunkIdx, 0);
+        Y_UNUSED(first);
+    }
+
+    Y_UNIT_TEST(TestThreadArenas) {
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+        NCB::TThreadArenas threadArenas(&localExecutor);
+
+        TVector<int> sums(1000);
+        NPar::ParallelFor(localExecutor, 0, sums.size(), [&] (int i) {
+            NCB::TArenaScope scope(threadArenas.GetArena());
+            auto values = threadArenas.GetArena()->AllocateArray<int>(i + 1, 1);
+            sums[i] = Accumulate(values, 0);
+        });
+        for (auto i : xrange(sums.size())) {
+            UNIT_ASSERT_EQUAL(sums[i], (int)i + 1);
+        }
+        UNIT_ASSERT_EQUAL(threadArenas.GetAllocatedBytes(), 1000 * 1001 / 2 * sizeof(int));
+        threadArenas.Reset();
+        UNIT_ASSERT_EQUAL(threadArenas.GetAllocatedBytes(), 0);
+    }
+}
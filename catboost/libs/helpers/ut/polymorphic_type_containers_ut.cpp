@@ -284,3 +284,70 @@ Y_UNIT_TEST_SUITE(TTypeCastArrayHolder) {
         }
     }
 }
+
+Y_UNIT_TEST_SUITE(TStridedTypeCastArrayHolder) {
+    Y_UNIT_TEST(ColumnOfRowMajorMatrix) {
+        constexpr size_t rowCount = 10;
+        constexpr size_t columnCount = 3;
+
+        // matrix is owned only by the resource holder after the sequence is created
+        auto matrixHolder = MakeIntrusive<TVectorHolder<double>>();
+        for (auto row : xrange(rowCount)) {
+            for (auto column : xrange(columnCount)) {
+                matrixHolder->Data.push_back(double(row * 10 + column));
+            }
+        }
+        const double* column1Begin = matrixHolder->Data.data() + 1;
+
+        ITypedSequencePtr<float> typedSequencePtr = MakeStridedTypeCastArrayHolder<float, double>(
+            column1Begin,
+            rowCount,
+            columnCount,
+            matrixHolder
+        );
+        matrixHolder.Reset();
+
+        const TVector<float> expectedV = {1.0f, 11.0f, 21.0f, 31.0f, 41.0f, 51.0f, 61.0f, 71.0f, 81.0f, 91.0f};
+
+        UNIT_ASSERT((dynamic_cast<TStridedTypeCastArrayHolder<float, double>*>(typedSequencePtr.Get())));
+        UNIT_ASSERT_VALUES_EQUAL((size_t)typedSequencePtr->GetSize(), expectedV.size());
+        UNIT_ASSERT_VALUES_EQUAL(ToVector(*typedSequencePtr), expectedV);
+
+        for (auto offset : xrange(expectedV.size())) {
+            auto blockIterator = typedSequencePtr->GetBlockIterator(
+                TIndexRange<ui32>(offset, typedSequencePtr->GetSize())
+            );
+            size_t expectedI = offset;
+            while (auto block = blockIterator->NextExact(Min<size_t>(3, expectedV.size() - expectedI))) {
+                for (auto element : block) {
+                    UNIT_ASSERT_VALUES_EQUAL(element, expectedV[expectedI++]);
+                }
+            }
+            UNIT_ASSERT_VALUES_EQUAL(expectedV.size(), expectedI);
+        }
+
+        TArraySubsetIndexing<ui32> arraySubsetIndexing( TIndexedSubset<ui32>{6, 5, 2, 0, 1} );
+        const TVector<float> expectedSubset = {61.0f, 51.0f, 21.0f, 1.0f, 11.0f};
+
+        auto typedArraySubset = typedSequencePtr->GetSubset(&arraySubsetIndexing);
+        UNIT_ASSERT_EQUAL(typedArraySubset->GetSize(), expectedSubset.size());
+        typedArraySubset->ForEach(
+            [&](ui32 index, float value) {
+                UNIT_ASSERT_VALUES_EQUAL(expectedSubset[index], value);
+            }
+        );
+
+        // values are compared for non-strict comparison only
+        TVector<float> contiguousV = expectedV;
+        auto contiguousSequencePtr = MakeTypeCastArrayHolderFromVector<float, float>(contiguousV);
+        UNIT_ASSERT(!typedSequencePtr->EqualTo(*contiguousSequencePtr, /*strict*/ true));
+        UNIT_ASSERT(typedSequencePtr->EqualTo(*contiguousSequencePtr, /*strict*/ false));
+    }
+
+    Y_UNIT_TEST(ContiguousDataIsNotStrided) {
+        TVector<float> v = {1.0f, 2.0f, 3.0f};
+        ITypedSequencePtr<float> typedSequencePtr = MakeStridedTypeCastArrayHolder<float, float>(v.data(), v.size(), 1);
+        UNIT_ASSERT((dynamic_cast<TTypeCastArrayHolder<float, float>*>(typedSequencePtr.Get())));
+        UNIT_ASSERT_VALUES_EQUAL(ToVector(*typedSequencePtr), v);
+    }
+}
@@ -0,0 +1,44 @@
+#include "event_trace.h"
+
+#include <library/chromium_trace/global.h>
+
+#include <util/generic/ptr.h>
+#include <util/generic/singleton.h>
+#include <util/system/env.h>
+#include <util/system/mutex.h>
+
+
+namespace {
+    struct TEventTraceSinkHolder {
+        TMutex Lock;
+        THolder<NChromiumTrace::TGlobalJsonFileSink> Sink;
+    };
+}
+
+
+void StartEventTrace(const TString& fileName) {
+    /* sink uses the global tracer when it is destroyed, so the tracer singleton is created before
+     * the holder one to be destroyed after it
+     */
+    NChromiumTrace::GetGlobalTracer();
+    auto* holder = Singleton<TEventTraceSinkHolder>();
+    with_lock(holder->Lock) {
+        holder->Sink.Destroy();
+        holder->Sink = MakeHolder<NChromiumTrace::TGlobalJsonFileSink>(fileName);
+        NChromiumTrace::GetGlobalTracer()->AddCurrentProcessName(AsStringBuf("catboost"));
+    }
+}
+
+void StopEventTrace() {
+    auto* holder = Singleton<TEventTraceSinkHolder>();
+    with_lock(holder->Lock) {
+        holder->Sink.Destroy();
+    }
+}
+
+void StartEventTraceFromEnv(TStringBuf fileNameSuffix) {
+    const TString fileName = GetEnv(CB_EVENT_TRACE_FILE_ENV);
+    if (!fileName.empty()) {
+        StartEventTrace(fileName + fileNameSuffix);
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <library/chromium_trace/interface.h>
+
+#include <util/generic/string.h>
+#include <util/generic/strbuf.h>
+
+#define CB_EVENT_TRACE_FILE_ENV "CB_EVENT_TRACE_FILE"
+
+/* Scoped events (CHROMIUM_TRACE_SCOPE, CHROMIUM_TRACE_FUNCTION) of all threads are written to fileName
+ * in chromium trace JSON format (open it in chrome://tracing or Perfetto) until StopEventTrace.
+ * Training stages, data loading, quantization, model evaluation, TLocalExecutor jobs and distributed map steps
+ * are traced. When the trace is not started an event costs one check of the global tracer output.
+ * Must not be started or stopped while traced code is running in other threads.
+ */
+void StartEventTrace(const TString& fileName);
+void StopEventTrace();
+
+/* starts the trace if CB_EVENT_TRACE_FILE environment variable is set, fileNameSuffix is appended to its value
+ * so that processes that inherit the environment (e.g. distributed workers) write separate files
+ */
+void StartEventTraceFromEnv(TStringBuf fileNameSuffix = {});
@@ -876,7 +876,9 @@ void CrossValidate(
     TRestorableFastRng64 rand(cvParams.PartitionRandSeed);
 
     NPar::TLocalExecutor localExecutor;
-    localExecutor.RunAdditionalThreads(catBoostOptions.SystemOptions->NumThreads.Get() - 1);
+    localExecutor.RunAdditionalThreads(
+        catBoostOptions.SystemOptions->NumThreads.Get() - 1,
+        catBoostOptions.SystemOptions->ThreadAffinity.GetUnchecked() == EThreadAffinity::NumaNodes);
 
     const ui64 cpuUsedRamLimit =
         ParseMemorySizeDescription(catBoostOptions.SystemOptions->CpuUsedRamLimit.Get());
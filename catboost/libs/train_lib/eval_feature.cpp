@@ -6,12 +6,12 @@
 #include <catboost/private/libs/algo/approx_dimension.h>
 #include <catboost/private/libs/algo/data.h>
 #include <catboost/private/libs/algo/helpers.h>
+#include <catboost/private/libs/algo/incremental_snapshot.h>
 #include <catboost/private/libs/algo/preprocess.h>
 #include <catboost/private/libs/algo/train.h>
 #include <catboost/libs/fstr/output_fstr.h>
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/parallel_tasks.h>
-#include <catboost/libs/helpers/progress_helper.h>
 #include <catboost/libs/helpers/restorable_rng.h>
 #include <catboost/libs/helpers/vector_helpers.h>
 #include <catboost/libs/helpers/wx_test.h>
@@ -656,11 +656,11 @@ public:
     }
 
     void LoadSnapshot(ETaskType taskType, const TString& snapshotFile) {
-        TProgressHelper progressHelper(ToString(taskType));
         IsNextLoadValid = true;
-        progressHelper.CheckedLoad(
+        NCB::ReadSnapshot(
             snapshotFile,
-            [&](TIFStream* input) {
+            ToString(taskType),
+            [&](IInputStream* input) {
                 OnLoadSnapshot(input);
             });
         IsNextLoadValid = true;
@@ -1,8 +1,11 @@
 #include <catboost/libs/model/model_import_interface.h>
 #include <catboost/libs/model/model_build_helper.h>
+#include <catboost/private/libs/algo/incremental_snapshot.h>
 #include <catboost/private/libs/algo/learn_context.h>
 #include <catboost/private/libs/algo/split.h>
-#include <catboost/libs/helpers/progress_helper.h>
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/system/fs.h>
 
 
 
@@ -17,7 +20,7 @@ namespace NCB{
             CB_ENSURE(NFs::Exists(snapshotPath), "Model file doesn't exist: " << snapshotPath);
             TLearnProgress learnProgress;
             TProfileInfoData profileRestored;
-            TProgressHelper(ToString(ETaskType::CPU)).CheckedLoad(snapshotPath, [&](TIFStream* in) {
+            ReadSnapshot(snapshotPath, ToString(ETaskType::CPU), [&](IInputStream* in) {
                 learnProgress.Load(in);
                 ::Load(in, profileRestored);
             });
@@ -769,11 +769,21 @@ namespace {
 
 TTrainerFactory::TRegistrator<TCPUModelTrainer> CPURegistrator(ETaskType::CPU);
 
+// workers load their parts of the learn dataset themselves, the master needs no features data
 static bool IsDistributedShared(
     const NCatboostOptions::TPoolLoadParams* loadOptions,
     const NCatboostOptions::TCatBoostOptions& catBoostOptions
 ) {
-    return catBoostOptions.SystemOptions->IsMaster() && loadOptions != nullptr && IsSharedFs(loadOptions->LearnSetPath);
+    if (!catBoostOptions.SystemOptions->IsMaster()) {
+        return false;
+    }
+    if (catBoostOptions.SystemOptions->DistributedDataLoading == EDistributedDataLoading::Workers) {
+        CB_ENSURE(
+            loadOptions != nullptr && loadOptions->LearnSetPath.Scheme == "quantized",
+            "Loading of the learn dataset by workers requires a quantized learn pool specified by path");
+        return true;
+    }
+    return loadOptions != nullptr && IsSharedFs(loadOptions->LearnSetPath);
 }
 
 static void TrainModel(
@@ -889,7 +899,7 @@ static void TrainModel(
         initModel);
     if (catBoostOptions.SystemOptions->IsMaster()) {
         InitializeMaster(catBoostOptions.SystemOptions);
-        if (isQuantizedLearn && IsSharedFs(poolLoadOptions->LearnSetPath)) {
+        if (isQuantizedLearn && IsDistributedShared(poolLoadOptions, catBoostOptions)) {
             SetTrainDataFromQuantizedPool(
                 *poolLoadOptions,
                 catBoostOptions,
@@ -900,6 +910,7 @@ static void TrainModel(
         } else {
             SetTrainDataFromMaster(
                 trainingData.Cast<TQuantizedForCPUObjectsDataProvider>().Learn,
+                catBoostOptions.SystemOptions->DistributedPartitioning,
                 ParseMemorySizeDescription(catBoostOptions.SystemOptions->CpuUsedRamLimit.Get()),
                 executor
             );
@@ -1002,7 +1013,9 @@ void TrainModel(
 
 
     NPar::TLocalExecutor executor;
-    executor.RunAdditionalThreads(catBoostOptions.SystemOptions.Get().NumThreads.Get() - 1);
+    executor.RunAdditionalThreads(
+        catBoostOptions.SystemOptions.Get().NumThreads.Get() - 1,
+        catBoostOptions.SystemOptions.Get().ThreadAffinity.GetUnchecked() == EThreadAffinity::NumaNodes);
 
     TVector<TString> classNames = catBoostOptions.DataProcessingOptions->ClassNames;
     const auto objectsOrder = catBoostOptions.DataProcessingOptions->HasTimeFlag.Get() ?
@@ -1264,7 +1277,9 @@ void ModelBasedEval(
     );
 
     NPar::TLocalExecutor executor;
-    executor.RunAdditionalThreads(catBoostOptions.SystemOptions.Get().NumThreads.Get() - 1);
+    executor.RunAdditionalThreads(
+        catBoostOptions.SystemOptions.Get().NumThreads.Get() - 1,
+        catBoostOptions.SystemOptions.Get().ThreadAffinity.GetUnchecked() == EThreadAffinity::NumaNodes);
 
     TVector<TString> classNames = catBoostOptions.DataProcessingOptions->ClassNames;
 
@@ -1344,7 +1359,8 @@ void TrainModel(
 
     NPar::TLocalExecutor executor;
     executor.RunAdditionalThreads(
-        NCatboostOptions::GetThreadCount(trainOptionsJson) - 1);
+        NCatboostOptions::GetThreadCount(trainOptionsJson) - 1,
+        NCatboostOptions::GetThreadAffinity(trainOptionsJson) == EThreadAffinity::NumaNodes);
 
     TrainModel(
         trainOptionsJson,
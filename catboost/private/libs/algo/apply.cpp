@@ -7,6 +7,7 @@
 #include <catboost/libs/eval_result/eval_helpers.h>
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/vector_helpers.h>
+#include <catboost/libs/logging/event_trace.h>
 #include <catboost/libs/logging/logging.h>
 #include <catboost/libs/model/cpu/evaluator.h>
 
@@ -130,6 +131,8 @@ TVector<TVector<double>> ApplyModelMulti(
     int end,   /*= 0*/
     TLocalExecutor* executor)
 {
+    CHROMIUM_TRACE_FUNCTION();
+
     const int docCount = SafeIntegerCast<int>(objectsData.GetObjectCount());
     const int approxesDimension = model.GetDimensionsCount();
     TVector<double> approxesFlat(docCount * approxesDimension);
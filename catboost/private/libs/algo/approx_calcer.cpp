@@ -170,16 +170,18 @@ static void CalcLeafDers(
     blockParams.SetBlockCount(AdjustBlockCountLimit(sampleCount, CB_THREAD_LIMIT));
 
     const int leafCount = leafDers.size();
-    TVector<TVector<TDers>> blockBucketDers(
-        blockParams.GetBlockCount(),
-        TVector<TDers>(leafCount, TDers{/*Der1*/ 0.0, /*Der2*/ 0.0, /*Der3*/ 0.0}));
-    TVector<TDers>* blockBucketDersData = blockBucketDers.data();
+    const int blockCount = blockParams.GetBlockCount();
+    // [blockId * leafCount + leafId], one allocation for all blocks
+    TVector<TDers> blockBucketDers(
+        blockCount * leafCount,
+        TDers{/*Der1*/ 0.0, /*Der2*/ 0.0, /*Der3*/ 0.0});
+    TDers* blockBucketDersData = blockBucketDers.data();
     // TODO(espetrov): Do not calculate sumWeights for Newton.
     // TODO(espetrov): Calculate sumWeights only on first iteration for Gradient, because on next iteration it
     //  is the same.
     // Check speedup on flights dataset.
-    TVector<TVector<double>> blockBucketSumWeights(blockParams.GetBlockCount(), TVector<double>(leafCount, 0));
-    TVector<double>* blockBucketSumWeightsData = blockBucketSumWeights.data();
+    TVector<double> blockBucketSumWeights(blockCount * leafCount, 0);
+    double* blockBucketSumWeightsData = blockBucketSumWeights.data();
     localExecutor->ExecRangeWithThrow(
         [=, &error](int blockId) {
             constexpr int innerBlockSize = APPROX_BLOCK_SIZE;
@@ -190,8 +192,8 @@ static void CalcLeafDers(
             const int blockStart = blockId * blockParams.GetBlockSize();
             const int nextBlockStart = Min(sampleCount, blockStart + blockParams.GetBlockSize());
 
-            const auto bucketDers = MakeArrayRef(blockBucketDersData[blockId].data(), leafCount);
-            const auto bucketSumWeights = MakeArrayRef(blockBucketSumWeightsData[blockId].data(), leafCount);
+            const auto bucketDers = MakeArrayRef(blockBucketDersData + blockId * leafCount, leafCount);
+            const auto bucketSumWeights = MakeArrayRef(blockBucketSumWeightsData + blockId * leafCount, leafCount);
 
             for (int innerBlockStart = blockStart;
                  innerBlockStart < nextBlockStart;
@@ -228,16 +230,17 @@ static void CalcLeafDers(
             }
         },
         0,
-        blockParams.GetBlockCount(),
+        blockCount,
         NPar::TLocalExecutor::WAIT_COMPLETE);
 
     if (estimationMethod == ELeavesEstimation::Newton) {
         for (int leafId = 0; leafId < leafCount; ++leafId) {
-            for (int blockId = 0; blockId < blockParams.GetBlockCount(); ++blockId) {
-                if (blockBucketSumWeights[blockId][leafId] > FLT_EPSILON) {
+            for (int blockId = 0; blockId < blockCount; ++blockId) {
+                const int idx = blockId * leafCount + leafId;
+                if (blockBucketSumWeights[idx] > FLT_EPSILON) {
                     AddMethodDer<ELeavesEstimation::Newton>(
-                        blockBucketDers[blockId][leafId],
-                        blockBucketSumWeights[blockId][leafId],
+                        blockBucketDers[idx],
+                        blockBucketSumWeights[idx],
                         /* updateWeight */ false, // value doesn't matter
                         &leafDers[leafId]);
                 }
@@ -246,11 +249,12 @@ static void CalcLeafDers(
     } else {
         Y_ASSERT(estimationMethod == ELeavesEstimation::Gradient);
         for (int leafId = 0; leafId < leafCount; ++leafId) {
-            for (int blockId = 0; blockId < blockParams.GetBlockCount(); ++blockId) {
-                if (blockBucketSumWeights[blockId][leafId] > FLT_EPSILON) {
+            for (int blockId = 0; blockId < blockCount; ++blockId) {
+                const int idx = blockId * leafCount + leafId;
+                if (blockBucketSumWeights[idx] > FLT_EPSILON) {
                     AddMethodDer<ELeavesEstimation::Gradient>(
-                        blockBucketDers[blockId][leafId],
-                        blockBucketSumWeights[blockId][leafId],
+                        blockBucketDers[idx],
+                        blockBucketSumWeights[idx],
                         recalcLeafWeights,
                         &leafDers[leafId]);
                 }
@@ -275,7 +279,7 @@ void CalcLeafDersSimple(
     NPar::TLocalExecutor* localExecutor,
     TVector<TSum>* leafDers,
     TArray2D<double>* pairwiseBuckets,
-    TVector<TDers>* scratchDers) {
+    TArrayRef<TDers> scratchDers) {
     for (auto& leafDer : *leafDers) {
         leafDer.SetZeroDers();
     }
@@ -292,7 +296,7 @@ void CalcLeafDersSimple(
             estimationMethod,
             localExecutor,
             *leafDers,
-            *scratchDers);
+            scratchDers);
     } else {
         Y_ASSERT(
             error.GetErrorType() == EErrorType::QuerywiseError ||
@@ -324,11 +328,11 @@ void CalcLeafDersSimple(
             error,
             /*queryStartIndex=*/0,
             queryCount,
-            *scratchDers,
+            scratchDers,
             randomSeed,
             localExecutor);
         AddLeafDersForQueries(
-            *scratchDers,
+            scratchDers,
             indices,
             weights,
             queriesInfo,
@@ -356,7 +360,9 @@ void CalcLeafDeltasSimple(
     const NCatboostOptions::TCatBoostOptions& params,
     double sumAllWeights,
     int allDocCount,
-    TVector<double>* leafDeltas) {
+    NPar::TLocalExecutor* localExecutor,
+    TVector<double>* leafDeltas,
+    TVector<double>* pairwiseSystemMatrix) {
     const int leafCount = leafDers.ysize();
     const float l2Regularizer = params.ObliviousTreeOptions->L2Reg;
     const float pairwiseNonDiagReg = params.ObliviousTreeOptions->PairwiseNonDiagReg;
@@ -365,11 +371,14 @@ void CalcLeafDeltasSimple(
         for (int leaf = 0; leaf < leafCount; ++leaf) {
             derSums[leaf] = leafDers[leaf].SumDer;
         }
-        *leafDeltas = CalculatePairwiseLeafValues(
+        CalculatePairwiseLeafValues(
             pairwiseWeightSums,
             derSums,
             l2Regularizer,
-            pairwiseNonDiagReg);
+            pairwiseNonDiagReg,
+            localExecutor,
+            pairwiseSystemMatrix,
+            leafDeltas);
         return;
     }
 
@@ -592,14 +601,16 @@ static void CalcApproxDeltaSimple(
     const int scratchSize = Max(
         !ctx->Params.BoostingOptions->ApproxOnFullHistory ? 0 : bt.TailFinish - bt.BodyFinish,
         error.GetErrorType() == EErrorType::PerObjectError ? APPROX_BLOCK_SIZE * CB_THREAD_LIMIT : bt.BodyFinish);
-    TVector<TDers> weightedDers;
-    weightedDers.yresize(scratchSize); // iteration scratch space
+    NCB::TArenaScope arenaScope(ctx->IterationArenas.GetArena());
+    const TArrayRef<TDers> weightedDers
+        = ctx->IterationArenas.GetArena()->AllocateArray<TDers>(scratchSize); // iteration scratch space
 
     const auto treeLearnerOptions = ctx->Params.ObliviousTreeOptions.Get();
     const ui32 gradientIterations = treeLearnerOptions.LeavesEstimationIterations;
     const auto estimationMethod = treeLearnerOptions.LeavesEstimationMethod;
     TVector<TSum> leafDers(leafCount, TSum()); // iteration scratch space
     TArray2D<double> pairwiseBuckets;          // iteration scratch space
+    TVector<double> pairwiseSystemMatrix;      // iteration scratch space
     const bool treeHasMonotonicConstraints = AnyOf(
         treeMonotoneConstraints,
         [](int val) { return val != 0; });
@@ -651,7 +662,7 @@ static void CalcApproxDeltaSimple(
             ctx->LocalExecutor,
             &leafDers,
             &pairwiseBuckets,
-            &weightedDers);
+            weightedDers);
         if (treeHasMonotonicConstraints) {
             const double scaledL2Regularizer = (ctx->Params.ObliviousTreeOptions->L2Reg * (fold.GetSumWeight() / fold.GetLearnSampleCount()));
             CalcMonotonicLeafDeltasSimple(
@@ -668,7 +679,9 @@ static void CalcApproxDeltaSimple(
                 ctx->Params,
                 bt.BodySumWeight,
                 bt.BodyFinish,
-                &(*leafDeltas)[0]);
+                ctx->LocalExecutor,
+                &(*leafDeltas)[0],
+                &pairwiseSystemMatrix);
         }
     };
 
@@ -761,8 +774,8 @@ static void CalcLeafValuesSimple(
     const int scratchSize = error.GetErrorType() == EErrorType::PerObjectError
                                 ? APPROX_BLOCK_SIZE * CB_THREAD_LIMIT
                                 : fold.GetLearnSampleCount();
-    TVector<TDers> weightedDers;
-    weightedDers.yresize(scratchSize);
+    NCB::TArenaScope arenaScope(ctx->IterationArenas.GetArena());
+    const TArrayRef<TDers> weightedDers = ctx->IterationArenas.GetArena()->AllocateArray<TDers>(scratchSize);
     sumLeafDeltas->assign(1, TVector<double>(leafCount));
 
     const int queryCount = fold.LearnQueriesInfo.ysize();
@@ -781,6 +794,7 @@ static void CalcLeafValuesSimple(
     CopyApprox(bt.Approx, &approxes, ctx->LocalExecutor);
     TVector<TSum> leafDers(leafCount, TSum()); // iteration scratch space
     TArray2D<double> pairwiseBuckets;          // iteration scratch space
+    TVector<double> pairwiseSystemMatrix;      // iteration scratch space
     const auto leafUpdaterFunc = [&](
                                      bool recalcLeafWeights,
                                      const TVector<TVector<double>>& approxes,
@@ -827,7 +841,7 @@ static void CalcLeafValuesSimple(
             &localExecutor,
             &leafDers,
             &pairwiseBuckets,
-            &weightedDers);
+            weightedDers);
 
         if (treeHasMonotonicConstraints) {
             const double scaledL2Regularizer = (ctx->Params.ObliviousTreeOptions->L2Reg * (fold.GetSumWeight() / fold.GetLearnSampleCount()));
@@ -845,7 +859,9 @@ static void CalcLeafValuesSimple(
                 ctx->Params,
                 fold.GetSumWeight(),
                 fold.GetLearnSampleCount(),
-                &(*leafDeltas)[0]);
+                ctx->LocalExecutor,
+                &(*leafDeltas)[0],
+                &pairwiseSystemMatrix);
         }
     };
 
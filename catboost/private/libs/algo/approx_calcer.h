@@ -46,7 +46,7 @@ void CalcLeafDersSimple(
     NPar::TLocalExecutor* localExecutor,
     TVector<TSum>* leafDers,
     TArray2D<double>* pairwiseBuckets,
-    TVector<TDers>* scratchDers
+    TArrayRef<TDers> scratchDers
 );
 
 void CalcLeafDeltasSimple(
@@ -55,7 +55,9 @@ void CalcLeafDeltasSimple(
     const NCatboostOptions::TCatBoostOptions& params,
     double sumAllWeights,
     int allDocCount,
-    TVector<double>* leafDeltas
+    NPar::TLocalExecutor* localExecutor,
+    TVector<double>* leafDeltas,
+    TVector<double>* pairwiseSystemMatrix // scratch space, used only for pairwise losses
 );
 
 void CalcLeafValues(
@@ -80,6 +80,7 @@ void CalcLeafValuesMulti(
             l2Regularizer,
             sumWeight,
             learnSampleCount,
+            localExecutor,
             leafDeltas
         );
     };
@@ -94,7 +94,7 @@ static void AddMethodDersForLeaves(
 }
 
 void AddLeafDersForQueries(
-    const TVector<TDers>& weightedDers,
+    TConstArrayRef<TDers> weightedDers,
     const TVector<TIndexType>& indices,
     const TVector<float>& weights,
     const TVector<TQueryInfo>& queriesInfo,
@@ -32,7 +32,7 @@ void CalculateDersForQueries(
 );
 
 void AddLeafDersForQueries(
-    const TVector<TDers>& weightedDers,
+    TConstArrayRef<TDers> weightedDers,
     const TVector<TIndexType>& indices,
     const TVector<float>& weights,
     const TVector<TQueryInfo>& queriesInfo,
@@ -62,6 +62,7 @@ void CalcApproxDeltaMulti(
             l2Regularizer,
             bt.BodySumWeight,
             bt.BodyFinish,
+            ctx->LocalExecutor,
             leafDeltas
         );
     };
@@ -0,0 +1,583 @@
+/* Microbenchmarks of the CPU training hot paths.
+ *
+ * Data is synthetic by default, its size is set by environment variables:
+ *   CB_BENCH_DOC_COUNT, CB_BENCH_FEATURE_COUNT, CB_BENCH_CAT_FEATURE_COUNT, CB_BENCH_DEPTH
+ * A real dataset in dsv format can be used instead with CB_BENCH_POOL and CB_BENCH_CD.
+ * Every benchmark is run with 1 thread and with CB_BENCH_THREAD_COUNT threads (all CPUs by default).
+ *
+ * Use --format json or --format csv to get machine-readable results.
+ */
+
+#include <catboost/private/libs/algo/approx_calcer.h>
+#include <catboost/private/libs/algo/fold.h>
+#include <catboost/private/libs/algo/index_calcer.h>
+#include <catboost/private/libs/algo/learn_context.h>
+#include <catboost/private/libs/algo/mvs.h>
+#include <catboost/private/libs/algo/online_ctr.h>
+#include <catboost/private/libs/algo/pairwise_scoring.h>
+#include <catboost/private/libs/algo/score_calcers.h>
+#include <catboost/private/libs/algo/scoring.h>
+#include <catboost/private/libs/algo/split.h>
+#include <catboost/private/libs/algo/tensor_search_helpers.h>
+#include <catboost/private/libs/algo/data.h>
+#include <catboost/private/libs/algo_helpers/approx_updater_helpers.h>
+#include <catboost/private/libs/algo_helpers/error_functions.h>
+#include <catboost/libs/data/data_provider_builders.h>
+#include <catboost/libs/data/load_data.h>
+#include <catboost/libs/helpers/query_info_helper.h>
+#include <catboost/libs/helpers/restorable_rng.h>
+#include <catboost/private/libs/options/catboost_options.h>
+#include <catboost/private/libs/options/enum_helpers.h>
+#include <catboost/private/libs/options/output_file_options.h>
+#include <catboost/private/libs/options/plain_options_helper.h>
+#include <catboost/libs/train_lib/options_helper.h>
+
+#include <library/json/json_value.h>
+#include <library/testing/benchmark/bench.h>
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/maybe.h>
+#include <util/generic/ptr.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/string/cast.h>
+#include <util/system/env.h>
+#include <util/system/info.h>
+
+
+using namespace NCB;
+
+
+static ui32 GetEnvOrDefault(const TString& name, ui32 defaultValue) {
+    const TString value = GetEnv(name);
+    return value.empty() ? defaultValue : FromString<ui32>(value);
+}
+
+namespace {
+    struct TBenchConfig {
+        ui32 DocCount;
+        ui32 FloatFeatureCount;
+        ui32 CatFeatureCount;
+        ui32 Depth;
+        int ThreadCount;
+        TString PoolPath; // if not empty, used instead of synthetic data
+        TString CdPath;
+
+    public:
+        TBenchConfig()
+            : DocCount(GetEnvOrDefault("CB_BENCH_DOC_COUNT", 100000))
+            , FloatFeatureCount(GetEnvOrDefault("CB_BENCH_FEATURE_COUNT", 50))
+            , CatFeatureCount(GetEnvOrDefault("CB_BENCH_CAT_FEATURE_COUNT", 4))
+            , Depth(GetEnvOrDefault("CB_BENCH_DEPTH", 6))
+            , ThreadCount((int)GetEnvOrDefault("CB_BENCH_THREAD_COUNT", (ui32)NSystemInfo::CachedNumberOfCpus()))
+            , PoolPath(GetEnv("CB_BENCH_POOL"))
+            , CdPath(GetEnv("CB_BENCH_CD"))
+        {
+        }
+    };
+}
+
+static const TBenchConfig& GetConfig() {
+    static const TBenchConfig config;
+    return config;
+}
+
+// unique values count of synthetic categorical features, greater than one_hot_max_size to get online ctrs for them
+static const ui32 CatValueCount = 100;
+
+static TDataProviderPtr CreateSyntheticDataset(const TBenchConfig& config) {
+    TFastRng64 rng(0);
+    const ui32 featureCount = config.FloatFeatureCount + config.CatFeatureCount;
+
+    TVector<TVector<float>> floatFeatures(config.FloatFeatureCount, TVector<float>(config.DocCount));
+    TVector<TVector<TString>> catFeatures(config.CatFeatureCount, TVector<TString>(config.DocCount));
+    TVector<float> target(config.DocCount);
+    for (auto docIdx : xrange(config.DocCount)) {
+        float targetValue = 0.1f * rng.GenRandReal1();
+        for (auto featureIdx : xrange(config.FloatFeatureCount)) {
+            const float value = rng.GenRandReal1();
+            floatFeatures[featureIdx][docIdx] = value;
+            if (featureIdx < 8) {
+                targetValue += value / (featureIdx + 1);
+            }
+        }
+        for (auto featureIdx : xrange(config.CatFeatureCount)) {
+            const ui32 value = rng.Uniform(CatValueCount);
+            catFeatures[featureIdx][docIdx] = ToString(value);
+            if (featureIdx == 0) {
+                targetValue += 0.01f * value;
+            }
+        }
+        target[docIdx] = targetValue;
+    }
+
+    TVector<ui32> catFeatureIndices;
+    for (auto featureIdx : xrange(config.CatFeatureCount)) {
+        catFeatureIndices.push_back(config.FloatFeatureCount + featureIdx);
+    }
+
+    return CreateDataProvider(
+        [&] (IRawFeaturesOrderDataVisitor* visitor) {
+            TDataMetaInfo metaInfo;
+            metaInfo.TargetCount = 1;
+            metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                featureCount,
+                catFeatureIndices,
+                TVector<ui32>{},
+                TVector<TString>{});
+
+            visitor->Start(metaInfo, config.DocCount, EObjectsOrder::Undefined, {});
+
+            for (auto featureIdx : xrange(config.FloatFeatureCount)) {
+                visitor->AddFloatFeature(
+                    featureIdx,
+                    MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(floatFeatures[featureIdx]))
+                );
+            }
+            for (auto featureIdx : xrange(config.CatFeatureCount)) {
+                visitor->AddCatFeature(config.FloatFeatureCount + featureIdx, catFeatures[featureIdx]);
+            }
+            visitor->AddTarget(MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(target)));
+
+            visitor->Finish();
+        }
+    );
+}
+
+static TDataProviderPtr ReadBenchDataset(const TBenchConfig& config, NPar::TLocalExecutor* localExecutor) {
+    NCatboostOptions::TColumnarPoolFormatParams columnarPoolFormatParams;
+    if (!config.CdPath.empty()) {
+        columnarPoolFormatParams.CdFilePath = TPathWithScheme(config.CdPath, "file");
+    }
+    return ReadDataset(
+        TPathWithScheme(config.PoolPath, "dsv"),
+        TPathWithScheme(),
+        TPathWithScheme(),
+        TPathWithScheme(),
+        columnarPoolFormatParams,
+        TVector<ui32>{},
+        EObjectsOrder::Undefined,
+        TDatasetSubset::MakeColumns(),
+        /*classNames*/ Nothing(),
+        localExecutor);
+}
+
+
+namespace {
+    /* State of training right before the tree search: quantized data, learn context with folds and
+     * derivatives of the first iteration, leaf indices of a tree of config.Depth float splits and
+     * docs sampled for scoring.
+     */
+    class TTrainingFixture {
+    public:
+        explicit TTrainingFixture(int threadCount) {
+            const auto& config = GetConfig();
+            LocalExecutor.RunAdditionalThreads(threadCount - 1);
+
+            TDataProviders srcData;
+            srcData.Learn = config.PoolPath.empty()
+                ? CreateSyntheticDataset(config)
+                : ReadBenchDataset(config, &LocalExecutor);
+
+            NJson::TJsonValue plainParams;
+            plainParams.InsertValue("loss_function", "RMSE");
+            plainParams.InsertValue("boosting_type", "Plain");
+            plainParams.InsertValue("depth", (int)config.Depth);
+            plainParams.InsertValue("thread_count", threadCount);
+            plainParams.InsertValue("random_seed", 0);
+            plainParams.InsertValue("allow_writing_files", false);
+            NJson::TJsonValue trainOptionsJson;
+            NJson::TJsonValue outputFilesOptionsJson;
+            NCatboostOptions::PlainJsonToOptions(plainParams, &trainOptionsJson, &outputFilesOptionsJson);
+            auto params = NCatboostOptions::LoadOptions(trainOptionsJson);
+            NCatboostOptions::TOutputFilesOptions outputOptions;
+            outputOptions.Load(outputFilesOptionsJson);
+
+            TRestorableFastRng64 rand(0);
+            TLabelConverter labelConverter;
+            TTrainingDataProviders trainingData = GetTrainingData(
+                std::move(srcData),
+                /*bordersFile*/ Nothing(),
+                /*ensureConsecutiveIfDenseLearnFeaturesDataForCpu*/ true,
+                /*allowWriteFiles*/ false,
+                /*quantizedFeaturesInfo*/ nullptr,
+                &params,
+                &labelConverter,
+                &LocalExecutor,
+                &rand);
+            SetDataDependentDefaults(
+                trainingData.Learn->MetaInfo,
+                /*testDataMetaInfo*/ Nothing(),
+                /*continueFromModel*/ false,
+                /*continueFromProgress*/ false,
+                &outputOptions.UseBestModel,
+                &params);
+            Data = trainingData.Cast<TQuantizedForCPUObjectsDataProvider>();
+
+            Ctx = MakeHolder<TLearnContext>(
+                params,
+                /*objectiveDescriptor*/ Nothing(),
+                /*evalMetricDescriptor*/ Nothing(),
+                outputOptions,
+                Data,
+                labelConverter,
+                /*startingApprox*/ Nothing(),
+                /*initRand*/ Nothing(),
+                /*initModel*/ Nothing(),
+                /*initLearnProgress*/ nullptr,
+                TDataProviders(),
+                &LocalExecutor);
+            CB_ENSURE(!Ctx->LearnProgress->Folds.empty(), "No learning folds");
+            Fold = &Ctx->LearnProgress->Folds[0];
+
+            // as in InitializeSamplingStructures in train_model.cpp, without tree level caching
+            Ctx->SampledDocs.Create(
+                Ctx->LearnProgress->Folds,
+                IsPairwiseScoring(Ctx->Params.LossFunctionDescription->GetLossFunction()),
+                static_cast<int>(Ctx->Params.ObliviousTreeOptions->DevScoreCalcObjBlockSize),
+                GetBernoulliSampleRate(Ctx->Params.ObliviousTreeOptions->BootstrapConfig));
+
+            const auto error = BuildError(Ctx->Params, /*descriptor*/ Nothing());
+            CalcWeightedDerivatives(*error, /*bodyTailIdx*/ 0, Ctx->Params, /*randomSeed*/ 0, Fold, &LocalExecutor);
+
+            AddFloatCandidates();
+            CB_ENSURE(!FloatCandidates.empty(), "No unpacked float features to benchmark scoring");
+            for (auto splitIdx : xrange(Min<size_t>(config.Depth, FloatCandidates.size()))) {
+                const auto& splitCandidate = FloatCandidates[splitIdx].SplitEnsemble.SplitCandidate;
+                const int binCount = (int)Data.Learn->ObjectsData->GetQuantizedFeaturesInfo()->GetBinCount(
+                    TFloatFeatureIdx((ui32)splitCandidate.FeatureIdx));
+                Tree.AddSplit(TSplit(splitCandidate, binCount / 2));
+            }
+            Indices = BuildIndices(*Fold, Tree, Data.Learn, /*testData*/ {}, &LocalExecutor);
+
+            Bootstrap(
+                Ctx->Params,
+                Indices,
+                Ctx->LearnProgress->LeafValues,
+                Fold,
+                &Ctx->SampledDocs,
+                &LocalExecutor,
+                &Ctx->LearnProgress->Rand);
+
+            Data.Learn->ObjectsData->GetFeaturesLayout()->IterateOverAvailableFeatures<EFeatureType::Categorical>(
+                [&] (TCatFeatureIdx catFeatureIdx) {
+                    TProjection projection;
+                    projection.AddCatFeature((int)*catFeatureIdx);
+                    CatProjections.push_back(std::move(projection));
+                }
+            );
+        }
+
+        int GetLeafCount() const {
+            return 1 << Tree.GetDepth();
+        }
+
+    private:
+        // features stored in binary packs, bundles or groups are scored as split ensembles, skip them for simplicity
+        void AddFloatCandidates() {
+            const auto& objectsData = *Data.Learn->ObjectsData;
+            objectsData.GetFeaturesLayout()->IterateOverAvailableFeatures<EFeatureType::Float>(
+                [&] (TFloatFeatureIdx floatFeatureIdx) {
+                    if (objectsData.GetFloatFeatureToPackedBinaryIndex(floatFeatureIdx)
+                        || objectsData.GetFloatFeatureToExclusiveBundleIndex(floatFeatureIdx)
+                        || objectsData.GetFloatFeatureToFeaturesGroupIndex(floatFeatureIdx))
+                    {
+                        return;
+                    }
+                    TSplitCandidate splitCandidate;
+                    splitCandidate.FeatureIdx = (int)*floatFeatureIdx;
+                    splitCandidate.Type = ESplitType::FloatFeature;
+
+                    TCandidateInfo candidate;
+                    candidate.SplitEnsemble = TSplitEnsemble(std::move(splitCandidate));
+                    FloatCandidates.push_back(std::move(candidate));
+                }
+            );
+        }
+
+    public:
+        NPar::TLocalExecutor LocalExecutor;
+        TTrainingForCPUDataProviders Data;
+        THolder<TLearnContext> Ctx;
+        TFold* Fold = nullptr;
+        TVector<TCandidateInfo> FloatCandidates;
+        TVector<TProjection> CatProjections;
+        TSplitTree Tree;
+        TVector<TIndexType> Indices;
+    };
+}
+
+// fixtures are created on first use, so that only the data of benchmarks that are run is built
+static TTrainingFixture& GetFixture(bool multiThreaded) {
+    if (multiThreaded) {
+        static TTrainingFixture fixture(GetConfig().ThreadCount);
+        return fixture;
+    }
+    static TTrainingFixture fixture(1);
+    return fixture;
+}
+
+
+static void BenchCalcStatsAndScores(bool multiThreaded, size_t iterations) {
+    auto& fixture = GetFixture(multiThreaded);
+    auto& ctx = *fixture.Ctx;
+    const TCompactPairs pairs;
+    for (auto i : xrange(iterations)) {
+        TCosineScoreCalcer scoreCalcer;
+        CalcStatsAndScores(
+            *fixture.Data.Learn->ObjectsData,
+            fixture.Fold->GetAllCtrs(),
+            ctx.SampledDocs,
+            ctx.SmallestSplitSideDocs,
+            fixture.Fold,
+            pairs,
+            ctx.Params,
+            fixture.FloatCandidates[i % fixture.FloatCandidates.size()],
+            fixture.Tree.GetDepth(),
+            /*useTreeLevelCaching*/ false,
+            /*currTreeMonotonicConstraints*/ TVector<int>(),
+            /*monotonicConstraints*/ TMap<ui32, int>(),
+            &fixture.LocalExecutor,
+            &ctx.PrevTreeLevelStats,
+            /*stats3d*/ nullptr,
+            /*pairwiseStats*/ nullptr,
+            &scoreCalcer,
+            &ctx.IterationArenas);
+        Y_DO_NOT_OPTIMIZE_AWAY(scoreCalcer.GetScores());
+    }
+}
+
+Y_CPU_BENCHMARK(CalcStatsAndScores_1Thread, iface) {
+    BenchCalcStatsAndScores(false, iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(CalcStatsAndScores_NThreads, iface) {
+    BenchCalcStatsAndScores(true, iface.Iterations());
+}
+
+
+static void BenchComputeOnlineCTRs(bool multiThreaded, size_t iterations) {
+    auto& fixture = GetFixture(multiThreaded);
+    if (fixture.CatProjections.empty()) {
+        return;
+    }
+    for (auto i : xrange(iterations)) {
+        TOnlineCTR onlineCtr;
+        ComputeOnlineCTRs(
+            fixture.Data,
+            *fixture.Fold,
+            fixture.CatProjections[i % fixture.CatProjections.size()],
+            fixture.Ctx.Get(),
+            &onlineCtr);
+        Y_DO_NOT_OPTIMIZE_AWAY(onlineCtr);
+    }
+}
+
+Y_CPU_BENCHMARK(ComputeOnlineCTRs_1Thread, iface) {
+    BenchComputeOnlineCTRs(false, iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(ComputeOnlineCTRs_NThreads, iface) {
+    BenchComputeOnlineCTRs(true, iface.Iterations());
+}
+
+
+static void BenchBuildIndices(bool multiThreaded, size_t iterations) {
+    auto& fixture = GetFixture(multiThreaded);
+    for (auto i : xrange(iterations)) {
+        Y_UNUSED(i);
+        auto indices = BuildIndices(*fixture.Fold, fixture.Tree, fixture.Data.Learn, {}, &fixture.LocalExecutor);
+        Y_DO_NOT_OPTIMIZE_AWAY(indices);
+    }
+}
+
+Y_CPU_BENCHMARK(BuildIndices_1Thread, iface) {
+    BenchBuildIndices(false, iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(BuildIndices_NThreads, iface) {
+    BenchBuildIndices(true, iface.Iterations());
+}
+
+
+static void BenchUpdateApproxDeltas(bool multiThreaded, size_t iterations) {
+    auto& fixture = GetFixture(multiThreaded);
+    const int docCount = fixture.Indices.ysize();
+    TVector<double> leafValues(fixture.GetLeafCount());
+    for (auto leafIdx : xrange(leafValues.size())) {
+        leafValues[leafIdx] = 0.01 * leafIdx;
+    }
+    TVector<double> approxDeltas(docCount, 0.0);
+    for (auto i : xrange(iterations)) {
+        Y_UNUSED(i);
+        auto leafDeltas = leafValues;
+        UpdateApproxDeltas(
+            /*storeExpApprox*/ false,
+            fixture.Indices,
+            docCount,
+            &fixture.LocalExecutor,
+            &leafDeltas,
+            &approxDeltas);
+        Y_DO_NOT_OPTIMIZE_AWAY(approxDeltas);
+    }
+}
+
+Y_CPU_BENCHMARK(UpdateApproxDeltas_1Thread, iface) {
+    BenchUpdateApproxDeltas(false, iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(UpdateApproxDeltas_NThreads, iface) {
+    BenchUpdateApproxDeltas(true, iface.Iterations());
+}
+
+
+static void BenchMvsSampling(bool multiThreaded, size_t iterations) {
+    auto& fixture = GetFixture(multiThreaded);
+    const TMvsSampler sampler(fixture.Fold->GetLearnSampleCount(), /*sampleRate*/ 0.8f, /*lambda*/ Nothing());
+    TRestorableFastRng64 rand(0);
+    for (auto i : xrange(iterations)) {
+        Y_UNUSED(i);
+        sampler.GenSampleWeights(EBoostingType::Plain, /*leafValues*/ {}, &rand, &fixture.LocalExecutor, fixture.Fold);
+        Y_DO_NOT_OPTIMIZE_AWAY(fixture.Fold->SampleWeights);
+    }
+}
+
+Y_CPU_BENCHMARK(MvsSampling_1Thread, iface) {
+    BenchMvsSampling(false, iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(MvsSampling_NThreads, iface) {
+    BenchMvsSampling(true, iface.Iterations());
+}
+
+
+// derivatives calculation does not depend on the fixture, so it is run for several losses instead of thread counts
+static void BenchCalcDersRange(TStringBuf lossDescription, size_t iterations) {
+    NJson::TJsonValue optionsJson;
+    optionsJson.InsertValue("loss_function", TString(lossDescription));
+    const auto params = NCatboostOptions::LoadOptions(optionsJson);
+    const auto error = BuildError(params, /*descriptor*/ Nothing());
+    const bool isExpApprox = IsStoreExpApprox(params.LossFunctionDescription->GetLossFunction());
+
+    const int docCount = (int)GetConfig().DocCount;
+    TFastRng64 rng(0);
+    TVector<double> approxes(docCount);
+    TVector<float> targets(docCount);
+    for (auto docIdx : xrange(docCount)) {
+        const double approx = rng.GenRandReal1() - 0.5;
+        approxes[docIdx] = isExpApprox ? exp(approx) : approx;
+        targets[docIdx] = rng.GenRandReal1() < 0.5 ? 0.0f : 1.0f;
+    }
+    TVector<TDers> ders(docCount);
+    for (auto i : xrange(iterations)) {
+        Y_UNUSED(i);
+        error->CalcDersRange(
+            /*start*/ 0,
+            docCount,
+            /*calcThirdDer*/ false,
+            approxes.data(),
+            /*approxDeltas*/ nullptr,
+            targets.data(),
+            /*weights*/ nullptr,
+            ders.data());
+        Y_DO_NOT_OPTIMIZE_AWAY(ders);
+    }
+}
+
+Y_CPU_BENCHMARK(CalcDersRange_RMSE, iface) {
+    BenchCalcDersRange("RMSE", iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(CalcDersRange_Logloss, iface) {
+    BenchCalcDersRange("Logloss", iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(CalcDersRange_Quantile, iface) {
+    BenchCalcDersRange("Quantile:alpha=0.3", iface.Iterations());
+}
+
+Y_CPU_BENCHMARK(CalcDersRange_Poisson, iface) {
+    BenchCalcDersRange("Poisson", iface.Iterations());
+}
+
+
+namespace {
+    // statistics and scores of a split of one float feature for pairs within queries of synthetic data
+    struct TPairwiseFixture {
+        static constexpr int QuerySize = 20;
+        static constexpr int PairsPerDoc = 4;
+        static constexpr int BucketCount = 64;
+        static constexpr int LeafCount = 32;
+
+    public:
+        TPairwiseFixture() {
+            const ui32 docCount = GetConfig().DocCount;
+            TFastRng64 rng(0);
+            WeightedDerivatives.yresize(docCount);
+            LeafIndices.yresize(docCount);
+            Buckets.yresize(docCount);
+            for (auto docIdx : xrange(docCount)) {
+                WeightedDerivatives[docIdx] = rng.GenRandReal1() - 0.5;
+                LeafIndices[docIdx] = rng.Uniform(LeafCount);
+                Buckets[docIdx] = rng.Uniform(BucketCount);
+            }
+            TVector<TQueryInfo> queriesInfo;
+            for (ui32 queryBegin = 0; queryBegin < docCount; queryBegin += QuerySize) {
+                const ui32 queryEnd = Min(queryBegin + QuerySize, docCount);
+                TQueryInfo queryInfo(queryBegin, queryEnd);
+                queryInfo.Competitors.resize(queryEnd - queryBegin);
+                for (auto& competitors : queryInfo.Competitors) {
+                    for (auto pairIdx : xrange(PairsPerDoc)) {
+                        Y_UNUSED(pairIdx);
+                        competitors.push_back({(ui32)rng.Uniform(queryEnd - queryBegin), 1.0f});
+                    }
+                }
+                queriesInfo.push_back(std::move(queryInfo));
+            }
+            Pairs = UnpackCompactPairsFromQueries(queriesInfo);
+        }
+
+    public:
+        TVector<double> WeightedDerivatives;
+        TVector<TIndexType> LeafIndices;
+        TVector<ui8> Buckets;
+        TCompactPairs Pairs;
+    };
+}
+
+Y_CPU_BENCHMARK(PairwiseScoring, iface) {
+    static const TPairwiseFixture fixture;
+    const auto getBucket = [&] (ui32 docId) { return fixture.Buckets[docId]; };
+    for (auto i : xrange(iface.Iterations())) {
+        Y_UNUSED(i);
+        TPairwiseStats pairwiseStats;
+        pairwiseStats.DerSums = ComputeDerSums(
+            fixture.WeightedDerivatives,
+            TPairwiseFixture::LeafCount,
+            TPairwiseFixture::BucketCount,
+            fixture.LeafIndices,
+            getBucket,
+            NCB::TIndexRange<int>(fixture.WeightedDerivatives.ysize()));
+        ComputePairWeightStatistics(
+            fixture.Pairs,
+            TPairwiseFixture::LeafCount,
+            TPairwiseFixture::BucketCount,
+            fixture.LeafIndices,
+            getBucket,
+            NCB::TIndexRange<int>((int)fixture.Pairs.GetWinnerCount()),
+            &pairwiseStats.PairWeightStatistics);
+        pairwiseStats.SplitEnsembleSpec = TSplitEnsembleSpec::OneSplit(ESplitType::FloatFeature);
+
+        TPairwiseScoreCalcer scoreCalcer;
+        CalculatePairwiseScore(
+            pairwiseStats,
+            TPairwiseFixture::BucketCount,
+            /*l2DiagReg*/ 3.0f,
+            /*pairwiseBucketWeightPriorReg*/ 0.1f,
+            /*oneHotMaxSize*/ 2,
+            &scoreCalcer);
+        Y_DO_NOT_OPTIMIZE_AWAY(scoreCalcer.GetScores());
+    }
+}
@@ -6,7 +6,9 @@
 #include <catboost/libs/data/borders_io.h>
 #include <catboost/libs/data/quantization.h>
 #include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/helpers/mem_usage.h>
 #include <catboost/libs/helpers/restorable_rng.h>
+#include <catboost/libs/logging/logging.h>
 #include <catboost/libs/metrics/metric.h>
 #include <catboost/private/libs/labels/label_converter.h>
 #include <catboost/private/libs/options/catboost_options.h>
@@ -17,7 +19,10 @@
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/algorithm.h>
+#include <util/stream/format.h>
 #include <util/string/builder.h>
+#include <util/system/mem_info.h>
+#include <util/system/mktemp.h>
 
 
 namespace NCB {
@@ -56,6 +61,33 @@ namespace NCB {
         return bordersInInitModel;
     }
 
+    /* Storage of dense columns is swapped in place with memory-mapped copy of the same data,
+     * so objects data can be shared (e.g. with srcData or with the other dataset if learn and eval data is
+     * the same) - its heap columns are freed and one column store is used by all its users.
+     */
+    static void MoveFeaturesDataToColumnStoreIfNeeded(
+        const NCatboostOptions::TCatBoostOptions& params,
+        TStringBuf datasetName,
+        ui64 cpuRamLimit,
+        TQuantizedForCPUObjectsDataProvider* objectsData,
+        NPar::TLocalExecutor* localExecutor) {
+
+        const TString& featuresColumnStoreDir = params.SystemOptions->FeaturesColumnStoreDir.Get();
+        if (featuresColumnStoreDir.empty() || objectsData->HasFeaturesColumnStore()) {
+            return;
+        }
+        const ui64 columnStoreSize = objectsData->MoveFeaturesDataToColumnStore(
+            MakeTempName(featuresColumnStoreDir.c_str(), "features_column_store"),
+            localExecutor
+        );
+        const ui64 cpuRamUsage = NMemInfo::GetMemInfo().RSS;
+        CATBOOST_INFO_LOG << "Features data of " << datasetName << " dataset ("
+            << HumanReadableSize(columnStoreSize, SF_BYTES) << ") is memory-mapped from "
+            << featuresColumnStoreDir << ", resident memory: " << HumanReadableSize(cpuRamUsage, SF_BYTES)
+            << ", used_ram_limit: " << params.SystemOptions->CpuUsedRamLimit.Get() << Endl;
+        OutputWarningIfCpuRamUsageOverLimit(cpuRamUsage, cpuRamLimit);
+    }
+
     TTrainingDataProviderPtr GetTrainingData(
         TDataProviderPtr srcData,
         bool isLearnData,
@@ -103,6 +135,17 @@ namespace NCB {
                         quantizedForCPUObjectsDataProvider->EnsureConsecutiveIfDenseFeaturesData(localExecutor);
                     }
                 }
+
+                /* done before taking features subset so that srcData's heap columns are released
+                 * and the subset shares the column store
+                 */
+                MoveFeaturesDataToColumnStoreIfNeeded(
+                    *params,
+                    datasetName,
+                    cpuRamLimit,
+                    quantizedForCPUObjectsDataProvider,
+                    localExecutor
+                );
             } else { // GPU
                 /*
                  * if there're any cat features format should be CPU-compatible to enable final CTR
@@ -135,6 +178,22 @@ namespace NCB {
                 localExecutor,
                 rand,
                 GetInitialBorders(initModel));
+
+            if (params->GetTaskType() == ETaskType::CPU) {
+                auto* quantizedForCPUObjectsDataProvider
+                    = dynamic_cast<TQuantizedForCPUObjectsDataProvider*>(trainingData->ObjectsData.Get());
+                CB_ENSURE_INTERNAL(
+                    quantizedForCPUObjectsDataProvider,
+                    "Quantized objects data is not compatible with CPU task type"
+                );
+                MoveFeaturesDataToColumnStoreIfNeeded(
+                    *params,
+                    datasetName,
+                    cpuRamLimit,
+                    quantizedForCPUObjectsDataProvider,
+                    localExecutor
+                );
+            }
         }
 
         CB_ENSURE(
@@ -4,6 +4,7 @@
 #include "helpers.h"
 
 #include <catboost/private/libs/data_types/groupid.h>
+#include <catboost/libs/helpers/parallel_tasks.h>
 #include <catboost/libs/helpers/permutation.h>
 #include <catboost/libs/helpers/query_info_helper.h>
 #include <catboost/libs/helpers/restorable_rng.h>
@@ -166,14 +167,18 @@ TFold TFold::BuildDynamicFold(
 
         TFold::TBodyTail bt(bodyQueryFinish, tailQueryFinish, bodyFinish, tailFinish, bodySumWeight);
 
-        TVector<double> initialApprox(bt.TailFinish, GetNeutralApprox(storeExpApproxes));
+        // filled in parallel, so that pages of fold arrays are first touched by the threads that process them
+        NCB::FillRank2(GetNeutralApprox(storeExpApproxes), approxDimension, bt.TailFinish, &bt.Approx, localExecutor);
         if (startingApprox) {
-            double initApprox = ExpApproxIf(storeExpApproxes, *startingApprox);
-            for (ui32 i = leftPartLen; i < (ui32)bt.TailFinish; ++i) {
-                initialApprox[i] = initApprox;
+            const double initApprox = ExpApproxIf(storeExpApproxes, *startingApprox);
+            for (auto& approx : bt.Approx) {
+                NCB::ParallelFill(
+                    initApprox,
+                    /*blockSize*/ Nothing(),
+                    localExecutor,
+                    MakeArrayRef(approx).Slice(leftPartLen, bt.TailFinish - leftPartLen));
             }
         }
-        bt.Approx.resize(approxDimension, initialApprox);
         if (baseline) {
             InitApproxFromBaseline(
                 leftPartLen,
@@ -184,8 +189,8 @@ TFold TFold::BuildDynamicFold(
                 &bt.Approx
             );
         }
-        AllocateRank2(approxDimension, bt.TailFinish, bt.WeightedDerivatives);
-        AllocateRank2(approxDimension, bt.TailFinish, bt.SampleWeightedDerivatives);
+        NCB::FillRank2(0.0, approxDimension, bt.TailFinish, &bt.WeightedDerivatives, localExecutor);
+        NCB::FillRank2(0.0, approxDimension, bt.TailFinish, &bt.SampleWeightedDerivatives, localExecutor);
         if (hasPairwiseWeights) {
             bt.PairwiseWeights.resize(bt.TailFinish);
             bt.PairwiseWeights.insert(
@@ -257,12 +262,15 @@ TFold TFold::BuildPlainFold(
         ff.GetSumWeight()
     );
 
-    bt.Approx.resize(approxDimension,
-        TVector<double>(
-            learnSampleCount,
-            startingApprox ? ExpApproxIf(storeExpApproxes, *startingApprox) : GetNeutralApprox(storeExpApproxes)));
-    AllocateRank2(approxDimension, learnSampleCount, bt.WeightedDerivatives);
-    AllocateRank2(approxDimension, learnSampleCount, bt.SampleWeightedDerivatives);
+    // filled in parallel, so that pages of fold arrays are first touched by the threads that process them
+    NCB::FillRank2(
+        startingApprox ? ExpApproxIf(storeExpApproxes, *startingApprox) : GetNeutralApprox(storeExpApproxes),
+        approxDimension,
+        learnSampleCountAsInt,
+        &bt.Approx,
+        localExecutor);
+    NCB::FillRank2(0.0, approxDimension, learnSampleCountAsInt, &bt.WeightedDerivatives, localExecutor);
+    NCB::FillRank2(0.0, approxDimension, learnSampleCountAsInt, &bt.SampleWeightedDerivatives, localExecutor);
     if (hasPairwiseWeights) {
         bt.PairwiseWeights.resize(learnSampleCount);
         CalcPairwiseWeights(ff.LearnQueriesInfo, bt.TailQueryFinish, &bt.PairwiseWeights);
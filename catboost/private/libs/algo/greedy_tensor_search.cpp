@@ -11,18 +11,22 @@
 #include "tree_print.h"
 #include "monotonic_constraint_utils.h"
 
+#include <catboost/libs/data/columns.h>
 #include <catboost/libs/data/feature_index.h>
+#include <catboost/libs/data/objects.h>
 #include <catboost/libs/data/packed_binary_features.h>
 #include <catboost/private/libs/distributed/master.h>
 #include <catboost/libs/helpers/interrupt.h>
 #include <catboost/libs/helpers/query_info_helper.h>
 #include <catboost/libs/helpers/parallel_tasks.h>
+#include <catboost/libs/logging/event_trace.h>
 #include <catboost/libs/logging/profile_info.h>
 
 #include <library/fast_log/fast_log.h>
 
 #include <util/generic/cast.h>
 #include <util/generic/xrange.h>
+#include <util/stream/format.h>
 #include <util/string/builder.h>
 #include <util/system/mem_info.h>
 
@@ -576,6 +580,84 @@ static void SelectCtrsToDropAfterCalc(
     }
 }
 
+template <class T, EFeatureValuesType TType>
+static void ReadAheadIfDense(const TTypedFeatureValuesHolder<T, TType>& column) {
+    if (const auto* denseColumn = dynamic_cast<const TCompressedValuesHolderImpl<T, TType>*>(&column)) {
+        denseColumn->ReadAhead();
+    }
+}
+
+static void ReadAheadCandidateFeaturesData(
+    const TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
+    const TSplitEnsemble& splitEnsemble
+) {
+    switch (splitEnsemble.Type) {
+        case ESplitEnsembleType::OneFeature:
+            {
+                // ctr values are calculated in memory and are not read from column store
+                const auto& splitCandidate = splitEnsemble.SplitCandidate;
+                if (splitCandidate.Type == ESplitType::FloatFeature) {
+                    ReadAheadIfDense(**objectsDataProvider.GetNonPackedFloatFeature((ui32)splitCandidate.FeatureIdx));
+                } else if (splitCandidate.Type == ESplitType::OneHotFeature) {
+                    ReadAheadIfDense(**objectsDataProvider.GetNonPackedCatFeature((ui32)splitCandidate.FeatureIdx));
+                }
+            }
+            break;
+        case ESplitEnsembleType::BinarySplits:
+            ReadAheadIfDense(
+                objectsDataProvider.GetBinaryFeaturesPack(splitEnsemble.BinarySplitsPackRef.PackIdx)
+            );
+            break;
+        case ESplitEnsembleType::ExclusiveBundle:
+            ReadAheadIfDense(
+                objectsDataProvider.GetExclusiveFeaturesBundle(splitEnsemble.ExclusiveFeaturesBundleRef.BundleIdx)
+            );
+            break;
+        case ESplitEnsembleType::FeaturesGroup:
+            ReadAheadIfDense(
+                objectsDataProvider.GetFeaturesGroup(splitEnsemble.FeaturesGroupRef.GroupIdx)
+            );
+            break;
+    }
+}
+
+/* If features data is memory-mapped from column store, hint OS to page in data of candidates that
+ * will be scored next while the current ones are scored.
+ * Candidates are processed by the local executor threads approximately in order, so data is requested
+ * one candidate per thread ahead.
+ */
+class TCandidatesFeaturesDataReadAhead {
+public:
+    TCandidatesFeaturesDataReadAhead(
+        const TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
+        const TCandidateList& candList,
+        NPar::TLocalExecutor* localExecutor
+    )
+        : ObjectsDataProvider(objectsDataProvider)
+        , CandList(candList)
+        , Distance(objectsDataProvider.HasFeaturesColumnStore() ? localExecutor->GetThreadCount() + 1 : 0)
+    {
+        for (auto candId : xrange(Min(Distance, CandList.ysize()))) {
+            ReadAheadCandidateFeaturesData(ObjectsDataProvider, CandList[candId].Candidates[0].SplitEnsemble);
+        }
+    }
+
+    // call before processing candId
+    void Next(int candId) const {
+        if (Distance && (candId + Distance < CandList.ysize())) {
+            ReadAheadCandidateFeaturesData(
+                ObjectsDataProvider,
+                CandList[candId + Distance].Candidates[0].SplitEnsemble
+            );
+        }
+    }
+
+private:
+    const TQuantizedForCPUObjectsDataProvider& ObjectsDataProvider;
+    const TCandidateList& CandList;
+    int Distance;
+};
+
 static void CalcBestScore(
     const TTrainingForCPUDataProviders& data,
     const TSplitTree& currentTree,
@@ -585,7 +667,9 @@ static void CalcBestScore(
     TFold* fold,
     TLearnContext* ctx) {
 
-    const TFlatPairsInfo pairs = UnpackPairsFromQueries(fold->LearnQueriesInfo);
+    CHROMIUM_TRACE_FUNCTION();
+
+    const TCompactPairs pairs = UnpackCompactPairsFromQueries(fold->LearnQueriesInfo);
     TCandidateList& candList = candidatesContext->CandidateList;
     const auto& monotonicConstraints = ctx->Params.ObliviousTreeOptions->MonotoneConstraints.Get();
     const TVector<int> currTreeMonotonicConstraints = (
@@ -593,8 +677,15 @@ static void CalcBestScore(
         ? TVector<int>()
         : GetTreeMonotoneConstraints(currentTree, monotonicConstraints)
     );
+    const TCandidatesFeaturesDataReadAhead featuresDataReadAhead(
+        *data.Learn->ObjectsData,
+        candList,
+        ctx->LocalExecutor
+    );
     ctx->LocalExecutor->ExecRange(
         [&](int id) {
+            featuresDataReadAhead.Next(id);
+
             auto& candidate = candList[id];
 
             const auto& splitEnsemble = candidate.Candidates[0].SplitEnsemble;
@@ -647,7 +738,8 @@ static void CalcBestScore(
                         &ctx->PrevTreeLevelStats,
                         /*stats3d*/nullptr,
                         /*pairwiseStats*/nullptr,
-                        scoreCalcer.Get());
+                        scoreCalcer.Get(),
+                        &ctx->IterationArenas);
                     scoreCalcer->GetScores().swap(allScores[oneCandidate]);
                 },
                 0,
@@ -721,8 +813,15 @@ static void CalcBestScoreLeafwise(
 
     TCandidateList& candList = candidatesContext->CandidateList;
 
+    const TCandidatesFeaturesDataReadAhead featuresDataReadAhead(
+        *data.Learn->ObjectsData,
+        candList,
+        ctx->LocalExecutor
+    );
     ctx->LocalExecutor->ExecRange(
         [&](int candId) {
+            featuresDataReadAhead.Next(candId);
+
             auto& candidate = candList[candId];
 
             const auto& splitEnsemble = candidate.Candidates[0].SplitEnsemble;
@@ -939,6 +1038,7 @@ TSplitTree GreedyTensorSearchOblivious(
             }
         }
 
+        int redundantIdx = -1;
         if (ctx->Params.SystemOptions->IsSingleHost()) {
             SetPermutedIndices(
                 bestSplit,
@@ -962,18 +1062,15 @@ TSplitTree GreedyTensorSearchOblivious(
             }
         } else {
             Y_ASSERT(bestSplit.Type != ESplitType::OnlineCtr);
-            MapSetIndices(bestSplit, ctx);
+            redundantIdx = MapSetIndices(bestSplit, ctx);
         }
         currentSplitTree.AddSplit(bestSplit);
         CATBOOST_INFO_LOG << BuildDescription(*ctx->Layout, bestSplit) << " score " << bestScore << "\n";
 
         profile.AddOperation(TStringBuilder() << "Select best split " << curDepth);
 
-        int redundantIdx = -1;
         if (ctx->Params.SystemOptions->IsSingleHost()) {
             redundantIdx = GetRedundantSplitIdx(GetIsLeafEmpty(curDepth + 1, *indices));
-        } else {
-            redundantIdx = MapGetRedundantSplitIdx(ctx);
         }
         if (redundantIdx != -1) {
             currentSplitTree.DeleteSplit(redundantIdx);
@@ -1009,6 +1106,8 @@ void GreedyTensorSearch(
     TLearnContext* ctx,
     TVariant<TSplitTree, TNonSymmetricTreeStructure>* resTreeStructure) {
 
+    CHROMIUM_TRACE_FUNCTION();
+
     TrimOnlineCTRcache({fold});
 
     ui32 learnSampleCount = data.Learn->ObjectsData->GetObjectCount();
@@ -1042,4 +1141,9 @@ void GreedyTensorSearch(
             fold,
             ctx);
     }
+
+    if (!ctx->Params.SystemOptions->IsSingleHost()) {
+        CATBOOST_DEBUG_LOG << "Bucket stats sent between hosts for the tree: "
+            << HumanReadableSize(GetStatsTransportBytesInTree(), SF_BYTES) << Endl;
+    }
 }
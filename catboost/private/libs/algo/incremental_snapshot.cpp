@@ -0,0 +1,244 @@
+#include "incremental_snapshot.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/logging/logging.h>
+
+#include <library/blockcodecs/core/codecs.h>
+#include <library/threading/future/async.h>
+
+#include <util/digest/city.h>
+#include <util/folder/path.h>
+#include <util/generic/guid.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+#include <util/stream/buffer.h>
+#include <util/stream/file.h>
+#include <util/system/fs.h>
+#include <util/ysaveload.h>
+
+
+using namespace NCB;
+
+
+static const TStringBuf INCREMENTAL_SNAPSHOT_LABEL_SUFFIX = "_incremental";
+
+
+static TString GetIncrementalLabel(const TString& label) {
+    return label + INCREMENTAL_SNAPSHOT_LABEL_SUFFIX;
+}
+
+static TStringBuf GetChunk(const TBuffer& state, size_t chunkSize, size_t chunkIdx) {
+    const size_t chunkBegin = chunkIdx * chunkSize;
+    return TStringBuf(state.Data() + chunkBegin, Min(chunkSize, state.Size() - chunkBegin));
+}
+
+template <class TWriter>
+static void WriteFileAtomically(const TString& path, TWriter&& writer) {
+    const TString tempName = JoinFsPaths(TFsPath(path).Dirname(), CreateGuidAsString()) + ".tmp";
+    try {
+        {
+            TOFStream out(tempName);
+            writer(&out);
+            out.Finish();
+        }
+        NFs::Rename(tempName, path);
+    } catch (...) {
+        NFs::Remove(tempName);
+        throw;
+    }
+}
+
+
+TIncrementalSnapshotWriter::TIncrementalSnapshotWriter(
+    const TString& path,
+    const TString& label,
+    TStringBuf codecName,
+    size_t chunkSize
+)
+    : Path(path)
+    , Label(label)
+    , Codec(NBlockCodecs::Codec(codecName))
+    , ChunkSize(chunkSize)
+{
+    CB_ENSURE_INTERNAL(ChunkSize > 0, "Snapshot chunk size should be positive");
+    WriterQueue.Start(1);
+}
+
+TIncrementalSnapshotWriter::~TIncrementalSnapshotWriter() {
+    Wait();
+    WriterQueue.Stop();
+}
+
+void TIncrementalSnapshotWriter::WriteAsync(TBuffer&& state) {
+    Wait();
+    PendingState = std::move(state);
+    PendingWrite = NThreading::Async(
+        [this] () {
+            Write(PendingState);
+        },
+        WriterQueue
+    );
+}
+
+void TIncrementalSnapshotWriter::Wait() {
+    if (PendingWrite.Initialized()) {
+        PendingWrite.GetValueSync();
+        PendingWrite = NThreading::TFuture<void>();
+        PendingState = TBuffer();
+    }
+}
+
+void TIncrementalSnapshotWriter::Write(const TBuffer& state) {
+    try {
+        const size_t chunkCount = CeilDiv(state.Size(), ChunkSize);
+        TVector<ui64> chunkHashes;
+        chunkHashes.yresize(chunkCount);
+        for (auto chunkIdx : xrange(chunkCount)) {
+            chunkHashes[chunkIdx] = CityHash64(GetChunk(state, ChunkSize, chunkIdx));
+        }
+
+        TVector<ui64> changedChunks;
+        if (!BaseId.empty()) {
+            for (auto chunkIdx : xrange(chunkCount)) {
+                if (chunkIdx >= BaseChunkHashes.size() || BaseChunkHashes[chunkIdx] != chunkHashes[chunkIdx]) {
+                    changedChunks.push_back(chunkIdx);
+                }
+            }
+        }
+
+        if (BaseId.empty() || 2 * changedChunks.size() > chunkCount) {
+            WriteBase(state, chunkHashes);
+            CATBOOST_INFO_LOG << "Saved progress (" << chunkCount << " chunks)" << Endl;
+        } else {
+            WriteDelta(state, chunkHashes, changedChunks);
+            CATBOOST_INFO_LOG << "Saved progress (" << changedChunks.size() << " of "
+                << chunkCount << " chunks changed)" << Endl;
+        }
+    } catch (...) {
+        // next write will be a full one
+        BaseId.clear();
+        CATBOOST_WARNING_LOG << "Can't save progress to file, got exception: " << CurrentExceptionMessage() << Endl;
+    }
+}
+
+void TIncrementalSnapshotWriter::WriteBase(const TBuffer& state, const TVector<ui64>& chunkHashes) {
+    BaseId.clear();
+    const TString baseId = CreateGuidAsString();
+    WriteFileAtomically(
+        Path,
+        [&] (IOutputStream* out) {
+            const ui64 stateSize = state.Size();
+            const ui64 chunkSize = ChunkSize;
+            const ui64 chunkCount = chunkHashes.size();
+            ::SaveMany(out, GetIncrementalLabel(Label), baseId, stateSize, chunkSize, TString(Codec->Name()), chunkCount);
+            TString compressedChunk;
+            for (auto chunkIdx : xrange(chunkCount)) {
+                Codec->Encode(GetChunk(state, ChunkSize, chunkIdx), compressedChunk);
+                ::SaveMany(out, chunkHashes[chunkIdx], compressedChunk);
+            }
+        }
+    );
+    // delta of the previous base is not valid anymore, it is ignored on load even if removal fails
+    NFs::Remove(GetSnapshotDeltaPath(Path));
+    BaseId = baseId;
+    BaseChunkHashes = chunkHashes;
+}
+
+void TIncrementalSnapshotWriter::WriteDelta(
+    const TBuffer& state,
+    const TVector<ui64>& chunkHashes,
+    const TVector<ui64>& changedChunks
+) {
+    WriteFileAtomically(
+        GetSnapshotDeltaPath(Path),
+        [&] (IOutputStream* out) {
+            const ui64 stateSize = state.Size();
+            const ui64 changedChunkCount = changedChunks.size();
+            ::SaveMany(out, GetIncrementalLabel(Label), BaseId, stateSize, chunkHashes, changedChunkCount);
+            TString compressedChunk;
+            for (auto chunkIdx : changedChunks) {
+                Codec->Encode(GetChunk(state, ChunkSize, chunkIdx), compressedChunk);
+                ::SaveMany(out, chunkIdx, compressedChunk);
+            }
+        }
+    );
+}
+
+
+TString NCB::GetSnapshotDeltaPath(const TString& path) {
+    return path + ".delta";
+}
+
+static void ReadIncrementalSnapshot(
+    const TString& path,
+    const TString& label,
+    IInputStream* baseInput,
+    std::function<void(IInputStream*)> reader
+) {
+    TString baseId;
+    ui64 stateSize;
+    ui64 chunkSize;
+    TString codecName;
+    ui64 chunkCount;
+    ::LoadMany(baseInput, baseId, stateSize, chunkSize, codecName, chunkCount);
+    const NBlockCodecs::ICodec* codec = NBlockCodecs::Codec(codecName);
+
+    TVector<ui64> chunkHashes(chunkCount);
+    TVector<TString> compressedChunks(chunkCount);
+    for (auto chunkIdx : xrange(chunkCount)) {
+        ::LoadMany(baseInput, chunkHashes[chunkIdx], compressedChunks[chunkIdx]);
+    }
+
+    const TString deltaPath = GetSnapshotDeltaPath(path);
+    if (NFs::Exists(deltaPath)) {
+        TIFStream deltaInput(deltaPath);
+        TString deltaLabel;
+        TString deltaBaseId;
+        ::LoadMany(&deltaInput, deltaLabel, deltaBaseId);
+        CB_ENSURE(deltaLabel == GetIncrementalLabel(label), "Error: expect " << label << " progress delta. Got " << deltaLabel);
+        if (deltaBaseId == baseId) {
+            ui64 changedChunkCount;
+            ::LoadMany(&deltaInput, stateSize, chunkHashes, changedChunkCount);
+            compressedChunks.resize(chunkHashes.size());
+            for (ui64 i = 0; i < changedChunkCount; ++i) {
+                ui64 chunkIdx;
+                ::Load(&deltaInput, chunkIdx);
+                CB_ENSURE(chunkIdx < compressedChunks.size(), "Snapshot delta is broken");
+                ::Load(&deltaInput, compressedChunks[chunkIdx]);
+            }
+        } else {
+            CATBOOST_DEBUG_LOG << "Snapshot delta " << deltaPath << " does not match the base, ignored" << Endl;
+        }
+    }
+
+    TBuffer state;
+    state.Reserve(stateSize);
+    TString chunk;
+    for (auto chunkIdx : xrange(compressedChunks.size())) {
+        const ui64 chunkBegin = chunkIdx * chunkSize;
+        CB_ENSURE(chunkBegin < stateSize, "Snapshot is broken");
+        codec->Decode(compressedChunks[chunkIdx], chunk);
+        CB_ENSURE(
+            (chunk.size() == Min(chunkSize, stateSize - chunkBegin)) && (CityHash64(chunk) == chunkHashes[chunkIdx]),
+            "Snapshot is broken"
+        );
+        state.Append(chunk.data(), chunk.size());
+        TString().swap(compressedChunks[chunkIdx]);
+    }
+    CB_ENSURE(state.Size() == stateSize, "Snapshot is broken");
+
+    TBufferInput stateInput(state);
+    reader(&stateInput);
+}
+
+void NCB::ReadSnapshot(const TString& path, const TString& label, std::function<void(IInputStream*)> reader) {
+    TIFStream input(path);
+    TString savedLabel;
+    ::Load(&input, savedLabel);
+    if (savedLabel == label) {
+        reader(&input);
+        return;
+    }
+    CB_ENSURE(savedLabel == GetIncrementalLabel(label), "Error: expect " << label << " progress. Got " << savedLabel);
+    ReadIncrementalSnapshot(path, label, &input, std::move(reader));
+}
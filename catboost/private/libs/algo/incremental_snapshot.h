@@ -0,0 +1,72 @@
+#pragma once
+
+#include <library/threading/future/future.h>
+
+#include <util/generic/buffer.h>
+#include <util/generic/ptr.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/stream/input.h>
+#include <util/thread/pool.h>
+
+#include <functional>
+
+
+namespace NBlockCodecs {
+    struct ICodec;
+}
+
+
+namespace NCB {
+
+    /* Snapshot state is split into chunks that are compressed independently.
+     *  Base file (at snapshot path) contains all chunks,
+     *  delta file (at snapshot path + ".delta") contains only chunks that differ from the base.
+     *  Base is rewritten when the delta becomes larger than a half of the state.
+     */
+    class TIncrementalSnapshotWriter {
+    public:
+        TIncrementalSnapshotWriter(
+            const TString& path,
+            const TString& label,
+            TStringBuf codecName = TStringBuf("lz4"),
+            size_t chunkSize = 4 << 20
+        );
+
+        ~TIncrementalSnapshotWriter();
+
+        // waits for the previous write, then writes state in background
+        void WriteAsync(TBuffer&& state);
+
+        void Wait();
+
+        // synchronous version, used by WriteAsync; errors are logged, not thrown
+        void Write(const TBuffer& state);
+
+    private:
+        void WriteBase(const TBuffer& state, const TVector<ui64>& chunkHashes);
+        void WriteDelta(const TBuffer& state, const TVector<ui64>& chunkHashes, const TVector<ui64>& changedChunks);
+
+    private:
+        TString Path;
+        TString Label;
+        const NBlockCodecs::ICodec* Codec;
+        size_t ChunkSize;
+
+        // state of the base file
+        TString BaseId;
+        TVector<ui64> BaseChunkHashes;
+
+        TBuffer PendingState;
+        TThreadPool WriterQueue;
+        NThreading::TFuture<void> PendingWrite;
+    };
+
+    TString GetSnapshotDeltaPath(const TString& path);
+
+    /* Calls reader for the state saved by TIncrementalSnapshotWriter or
+     *  for the rest of the file in TProgressHelper format (label check is done in both cases).
+     */
+    void ReadSnapshot(const TString& path, const TString& label, std::function<void(IInputStream*)> reader);
+
+}
@@ -10,7 +10,6 @@
 
 #include <catboost/libs/helpers/checksum.h>
 #include <catboost/libs/helpers/parallel_tasks.h>
-#include <catboost/libs/helpers/progress_helper.h>
 #include <catboost/libs/helpers/vector_helpers.h>
 #include <catboost/libs/model/model.h>
 #include <catboost/private/libs/algo_helpers/error_functions.h>
@@ -28,6 +27,7 @@
 #include <util/generic/guid.h>
 #include <util/generic/xrange.h>
 #include <util/folder/path.h>
+#include <util/stream/buffer.h>
 #include <util/stream/file.h>
 #include <util/system/fs.h>
 
@@ -247,6 +247,7 @@ TLearnContext::TLearnContext(
     , OutputOptions(outputOptions)
     , Files(outputOptions, fileNamesPrefix)
     , Profile((int)Params.BoostingOptions->IterationCount)
+    , IterationArenas(localExecutor)
     , LearnAndTestDataPackingAreCompatible(false)
     , UseTreeLevelCachingFlag(false)
     , HasWeights(data.Learn->MetaInfo.HasWeights) {
@@ -378,15 +379,14 @@ void TLearnContext::SaveProgress(std::function<void(IOutputStream*)> onSaveSnaps
     if (!OutputOptions.SaveSnapshot()) {
         return;
     }
-    const auto snapshotBackup = Files.SnapshotFile + ".bak";
-    TProgressHelper(ToString(ETaskType::CPU)).Write(
-        snapshotBackup,
-        [&](IOutputStream* out) {
-            onSaveSnapshot(out);
-            ::SaveMany(out, *LearnProgress, Profile.DumpProfileInfo());
-        }
-    );
-    TFsPath(snapshotBackup).ForceRenameTo(Files.SnapshotFile);
+    // only in-memory serialization is done here, compression and writing are done in background
+    TBufferOutput out;
+    onSaveSnapshot(&out);
+    ::SaveMany(&out, *LearnProgress, Profile.DumpProfileInfo());
+    if (!SnapshotWriter) {
+        SnapshotWriter = MakeHolder<NCB::TIncrementalSnapshotWriter>(Files.SnapshotFile, ToString(ETaskType::CPU));
+    }
+    SnapshotWriter->WriteAsync(std::move(out.Buffer()));
 }
 
 bool TLearnContext::TryLoadProgress(std::function<bool(IInputStream*)> onLoadSnapshot) {
@@ -394,9 +394,10 @@ bool TLearnContext::TryLoadProgress(std::function<bool(IInputStream*)> onLoadSna
         return false;
     }
     try {
-        TProgressHelper(ToString(ETaskType::CPU)).CheckedLoad(
+        NCB::ReadSnapshot(
             Files.SnapshotFile,
-            [&](TIFStream* in) {
+            ToString(ETaskType::CPU),
+            [&](IInputStream* in) {
                 if (!onLoadSnapshot(in)) {
                     return;
                 }
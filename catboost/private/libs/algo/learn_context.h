@@ -3,12 +3,14 @@
 #include "calc_score_cache.h"
 #include "ctr_helper.h"
 #include "fold.h"
+#include "incremental_snapshot.h"
 #include "online_ctr.h"
 #include "split.h"
 
 #include <catboost/private/libs/algo_helpers/custom_objective_descriptor.h>
 #include <catboost/libs/data/data_provider.h>
 #include <catboost/libs/data/features_layout.h>
+#include <catboost/libs/helpers/arena.h>
 #include <catboost/libs/helpers/restorable_rng.h>
 #include <catboost/private/libs/labels/label_converter.h>
 #include <catboost/libs/loggers/catboost_logger_helpers.h>
@@ -208,11 +210,17 @@ public:
     TBucketStatsCache PrevTreeLevelStats;
     TProfileInfo Profile;
 
+    // scratch memory for temporary arrays of one iteration, reset at the start of each iteration
+    NCB::TThreadArenas IterationArenas;
+
     bool LearnAndTestDataPackingAreCompatible;
 
 private:
     bool UseTreeLevelCachingFlag;
     bool HasWeights;
+
+    // created on first SaveProgress, waits for pending write on destruction
+    THolder<NCB::TIncrementalSnapshotWriter> SnapshotWriter;
 };
 
 bool NeedToUseTreeLevelCaching(
@@ -10,6 +10,7 @@
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/mem_usage.h>
 #include <catboost/libs/helpers/resource_constrained_executor.h>
+#include <catboost/libs/logging/event_trace.h>
 #include <catboost/libs/model/ctr_value_table.h>
 #include <catboost/libs/model/model.h>
 
@@ -554,6 +555,8 @@ void ComputeOnlineCTRs(
     const TLearnContext* ctx,
     TOnlineCTR* dst) {
 
+    CHROMIUM_TRACE_FUNCTION();
+
     const TCtrHelper& ctrHelper = ctx->CtrsHelper;
     const auto& ctrInfo = ctrHelper.GetCtrInfo(proj);
     dst->Feature.resize(ctrInfo.size());
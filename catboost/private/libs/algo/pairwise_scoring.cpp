@@ -4,6 +4,7 @@
 #include <catboost/private/libs/algo_helpers/pairwise_leaves_calculation.h>
 #include <catboost/libs/helpers/short_vector_ops.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/xrange.h>
 #include <util/system/yassert.h>
 
@@ -27,24 +28,33 @@ void TPairwiseStats::Add(const TPairwiseStats& rhs) {
         }
     }
 
-    Y_ASSERT(PairWeightStatistics.GetXSize() == rhs.PairWeightStatistics.GetXSize());
-    Y_ASSERT(PairWeightStatistics.GetYSize() == rhs.PairWeightStatistics.GetYSize());
+    PairWeightStatistics.Add(rhs.PairWeightStatistics);
+}
 
-    for (auto leafIdx1 : xrange(PairWeightStatistics.GetYSize())) {
-        auto dst1 = PairWeightStatistics[leafIdx1];
-        const auto add1 = rhs.PairWeightStatistics[leafIdx1];
 
-        for (auto leafIdx2 : xrange(PairWeightStatistics.GetXSize())) {
-            auto& dst2 = dst1[leafIdx2];
-            const auto& add2 = add1[leafIdx2];
+// statistics memory is contiguous, so it's enough to sum the flat buffers
+void TPairWeightStatistics::Add(const TPairWeightStatistics& rhs) {
+    Y_ASSERT(LeafCount == rhs.LeafCount);
+    Y_ASSERT(StatsCount == rhs.StatsCount);
+    Y_ASSERT(Data.size() == rhs.Data.size());
 
-            Y_ASSERT(dst2.size() == add2.size());
+    for (auto i : xrange(Data.size())) {
+        Data[i].Add(rhs.Data[i]);
+    }
+}
 
-            for (auto bucketIdx : xrange(dst2.size())) {
-                dst2[bucketIdx].Add(add2[bucketIdx]);
-            }
-        }
+
+NCB::TIndexRange<int> GetWinnerIndexRange(const TCompactPairs& pairs, ui64 pairBegin, ui64 pairEnd) {
+    const int winnerCount = pairs.GetWinnerCount();
+    if (winnerCount == 0) {
+        return NCB::TIndexRange<int>(0);
     }
+    const auto winnerOffsets = MakeArrayRef(pairs.WinnerOffsets);
+    const auto getWinnerIdx = [&] (ui64 pairIdx) {
+        // first winner whose pairs start at or after pairIdx
+        return (int)(LowerBound(winnerOffsets.begin(), winnerOffsets.end() - 1, pairIdx) - winnerOffsets.begin());
+    };
+    return NCB::TIndexRange<int>(getWinnerIdx(pairBegin), getWinnerIdx(pairEnd));
 }
 
 
@@ -135,6 +145,10 @@ void CalculatePairwiseScore(
 
     TArray2D<double> weightSum(2 * leafCount, 2 * leafCount);
 
+    // buffers reused for all splits
+    TVector<double> systemMatrix;
+    TVector<double> leafValues;
+
     // TODO(ilyzhin): refactor this (extract common code to functions)
     switch (pairwiseStats.SplitEnsembleSpec.Type) {
         case ESplitEnsembleType::OneFeature:
@@ -152,8 +166,8 @@ void CalculatePairwiseScore(
 
                 for (int y = 0; y < leafCount; ++y) {
                     for (int x = y + 1; x < leafCount; ++x) {
-                        const TBucketPairWeightStatistics* xyData = pairWeightStatistics[x][y].data();
-                        const TBucketPairWeightStatistics* yxData = pairWeightStatistics[y][x].data();
+                        const TBucketPairWeightStatistics* xyData = pairWeightStatistics(x, y).data();
+                        const TBucketPairWeightStatistics* yxData = pairWeightStatistics(y, x).data();
                         auto totalXY0 = NSimdOps::MakeZeros();
                         auto totalXY2 = NSimdOps::MakeZeros();
                         auto totalYX0 = NSimdOps::MakeZeros();
@@ -207,26 +221,29 @@ void CalculatePairwiseScore(
                         derSum[2 * y] += derDelta;
                         derSum[2 * y + 1] -= derDelta;
 
-                        const double weightDelta = (pairWeightStatistics[y][y][splitId].SmallerBorderWeightSum
-                            - pairWeightStatistics[y][y][splitId].GreaterBorderRightWeightSum);
+                        const double weightDelta = (pairWeightStatistics(y, y)[splitId].SmallerBorderWeightSum
+                            - pairWeightStatistics(y, y)[splitId].GreaterBorderRightWeightSum);
                         weightSum[2 * y][2 * y + 1] += weightDelta;
                         weightSum[2 * y + 1][2 * y] += weightDelta;
                         weightSum[2 * y][2 * y] -= weightDelta;
                         weightSum[2 * y + 1][2 * y + 1] -= weightDelta;
 
                         for (int x = y + 1; x < leafCount; ++x) {
-                            const TBucketPairWeightStatistics& xy = pairWeightStatistics[x][y][splitId];
-                            const TBucketPairWeightStatistics& yx = pairWeightStatistics[y][x][splitId];
+                            const TBucketPairWeightStatistics& xy = pairWeightStatistics(x, y)[splitId];
+                            const TBucketPairWeightStatistics& yx = pairWeightStatistics(y, x)[splitId];
 
                             UpdateWeightSumFromNonDiagStats(y, x, xy, yx, &weightSum);
                         }
                     }
 
-                    const TVector<double> leafValues = CalculatePairwiseLeafValues(
+                    CalculatePairwiseLeafValues(
                         weightSum,
                         derSum,
                         l2DiagReg,
-                        pairwiseBucketWeightPriorReg);
+                        pairwiseBucketWeightPriorReg,
+                        /*localExecutor*/ nullptr,
+                        &systemMatrix,
+                        &leafValues);
                     scoreCalcer->CalculateScore(splitId, leafValues, derSum, weightSum);
                 }
             }
@@ -253,16 +270,16 @@ void CalculatePairwiseScore(
 
                     for (int y = 0; y < leafCount; ++y) {
                         const double weightDelta =
-                            (pairWeightStatistics[y][y][2 * binFeatureIdx].SmallerBorderWeightSum
-                             - pairWeightStatistics[y][y][2 * binFeatureIdx].GreaterBorderRightWeightSum);
+                            (pairWeightStatistics(y, y)[2 * binFeatureIdx].SmallerBorderWeightSum
+                             - pairWeightStatistics(y, y)[2 * binFeatureIdx].GreaterBorderRightWeightSum);
                         weightSum[2 * y][2 * y + 1] += weightDelta;
                         weightSum[2 * y + 1][2 * y] += weightDelta;
                         weightSum[2 * y][2 * y] -= weightDelta;
                         weightSum[2 * y + 1][2 * y + 1] -= weightDelta;
 
                         for (int x = y + 1; x < leafCount; ++x) {
-                            const TBucketPairWeightStatistics* xyData = pairWeightStatistics[x][y].data();
-                            const TBucketPairWeightStatistics* yxData = pairWeightStatistics[y][x].data();
+                            const TBucketPairWeightStatistics* xyData = pairWeightStatistics(x, y).data();
+                            const TBucketPairWeightStatistics* yxData = pairWeightStatistics(y, x).data();
 
                             double total =
                                 xyData[2 * binFeatureIdx].SmallerBorderWeightSum
@@ -279,11 +296,14 @@ void CalculatePairwiseScore(
                         }
                     }
 
-                    const TVector<double> leafValues = CalculatePairwiseLeafValues(
+                    CalculatePairwiseLeafValues(
                         weightSum,
                         binDerSums,
                         l2DiagReg,
-                        pairwiseBucketWeightPriorReg);
+                        pairwiseBucketWeightPriorReg,
+                        /*localExecutor*/ nullptr,
+                        &systemMatrix,
+                        &leafValues);
                     scoreCalcer->CalculateScore(binFeatureIdx, leafValues, binDerSums, weightSum);
                 }
             }
@@ -341,8 +361,8 @@ void CalculatePairwiseScore(
 
                     for (int y = 0; y < leafCount; ++y) {
                         for (int x = y + 1; x < leafCount; ++x) {
-                            const TBucketPairWeightStatistics* xyData = pairWeightStatistics[x][y].data();
-                            const TBucketPairWeightStatistics* yxData = pairWeightStatistics[y][x].data();
+                            const TBucketPairWeightStatistics* xyData = pairWeightStatistics(x, y).data();
+                            const TBucketPairWeightStatistics* yxData = pairWeightStatistics(y, x).data();
                             auto totalXY0 = NSimdOps::MakeZeros();
                             auto totalXY2 = NSimdOps::MakeZeros();
                             auto totalYX0 = NSimdOps::MakeZeros();
@@ -397,26 +417,29 @@ void CalculatePairwiseScore(
                             }
 
                             const double weightDelta =
-                                (pairWeightStatistics[y][y][bucketId].SmallerBorderWeightSum
-                                 - pairWeightStatistics[y][y][bucketId].GreaterBorderRightWeightSum);
+                                (pairWeightStatistics(y, y)[bucketId].SmallerBorderWeightSum
+                                 - pairWeightStatistics(y, y)[bucketId].GreaterBorderRightWeightSum);
                             weightSum[2 * y][2 * y + 1] += weightDelta;
                             weightSum[2 * y + 1][2 * y] += weightDelta;
                             weightSum[2 * y][2 * y] -= weightDelta;
                             weightSum[2 * y + 1][2 * y + 1] -= weightDelta;
 
                             for (int x = y + 1; x < leafCount; ++x) {
-                                const TBucketPairWeightStatistics& xy = pairWeightStatistics[x][y][bucketId];
-                                const TBucketPairWeightStatistics& yx = pairWeightStatistics[y][x][bucketId];
+                                const TBucketPairWeightStatistics& xy = pairWeightStatistics(x, y)[bucketId];
+                                const TBucketPairWeightStatistics& yx = pairWeightStatistics(y, x)[bucketId];
 
                                 UpdateWeightSumFromNonDiagStats(y, x, xy, yx, &weightSum);
                             }
                         }
 
-                        const TVector<double> leafValues = CalculatePairwiseLeafValues(
+                        CalculatePairwiseLeafValues(
                             weightSum,
                             derSum,
                             l2DiagReg,
-                            pairwiseBucketWeightPriorReg);
+                            pairwiseBucketWeightPriorReg,
+                            /*localExecutor*/ nullptr,
+                            &systemMatrix,
+                            &leafValues);
                         scoreCalcer->CalculateScore(
                             dstBinOffset + splitId,
                             leafValues,
@@ -448,8 +471,8 @@ void CalculatePairwiseScore(
                     }
                     for (int y = 0; y < leafCount; ++y) {
                         for (int x = y + 1; x < leafCount; ++x) {
-                            const TBucketPairWeightStatistics* xyData = pairWeightStatistics[x][y].data();
-                            const TBucketPairWeightStatistics* yxData = pairWeightStatistics[y][x].data();
+                            const TBucketPairWeightStatistics* xyData = pairWeightStatistics(x, y).data();
+                            const TBucketPairWeightStatistics* yxData = pairWeightStatistics(y, x).data();
                             auto totalXY0 = NSimdOps::MakeZeros();
                             auto totalXY2 = NSimdOps::MakeZeros();
                             auto totalYX0 = NSimdOps::MakeZeros();
@@ -496,23 +519,26 @@ void CalculatePairwiseScore(
                             derSum[2 * y] += derDelta;
                             derSum[2 * y + 1] -= derDelta;
                             const double weightDelta = (
-                                pairWeightStatistics[y][y][bucketId].SmallerBorderWeightSum
-                                - pairWeightStatistics[y][y][bucketId].GreaterBorderRightWeightSum);
+                                pairWeightStatistics(y, y)[bucketId].SmallerBorderWeightSum
+                                - pairWeightStatistics(y, y)[bucketId].GreaterBorderRightWeightSum);
                             weightSum[2 * y][2 * y + 1] += weightDelta;
                             weightSum[2 * y + 1][2 * y] += weightDelta;
                             weightSum[2 * y][2 * y] -= weightDelta;
                             weightSum[2 * y + 1][2 * y + 1] -= weightDelta;
                             for (int x = y + 1; x < leafCount; ++x) {
-                                const TBucketPairWeightStatistics& xy = pairWeightStatistics[x][y][bucketId];
-                                const TBucketPairWeightStatistics& yx = pairWeightStatistics[y][x][bucketId];
+                                const TBucketPairWeightStatistics& xy = pairWeightStatistics(x, y)[bucketId];
+                                const TBucketPairWeightStatistics& yx = pairWeightStatistics(y, x)[bucketId];
                                 UpdateWeightSumFromNonDiagStats(y, x, xy, yx, &weightSum);
                             }
                         }
-                        const TVector<double> leafValues = CalculatePairwiseLeafValues(
+                        CalculatePairwiseLeafValues(
                             weightSum,
                             derSum,
                             l2DiagReg,
-                            pairwiseBucketWeightPriorReg);
+                            pairwiseBucketWeightPriorReg,
+                            /*localExecutor*/ nullptr,
+                            &systemMatrix,
+                            &leafValues);
                         scoreCalcer->CalculateScore(splitId, leafValues, derSum, weightSum);
                     }
                     bucketIdxOffset += part.BucketCount;
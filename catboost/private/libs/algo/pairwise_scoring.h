@@ -7,10 +7,17 @@
 
 #include <catboost/libs/data/feature_grouping.h>
 #include <catboost/libs/data/packed_binary_features.h>
+#include <catboost/private/libs/data_types/pair.h>
 #include <catboost/private/libs/index_range/index_range.h>
 
 #include <library/binsaver/bin_saver.h>
 
+#include <util/generic/array_ref.h>
+#include <util/generic/xrange.h>
+
+#include <array>
+#include <type_traits>
+
 
 struct TBucketPairWeightStatistics {
     double SmallerBorderWeightSum = 0.0; // The weight sum of pair elements with smaller border.
@@ -26,6 +33,49 @@ public:
 };
 
 
+// [leafCount][leafCount][statsCount] statistics in one contiguous buffer
+class TPairWeightStatistics {
+public:
+    // zeroes statistics, already allocated memory is reused
+    void Resize(int leafCount, int statsCount) {
+        LeafCount = leafCount;
+        StatsCount = statsCount;
+        Data.assign((size_t)leafCount * leafCount * statsCount, TBucketPairWeightStatistics());
+    }
+
+    int GetLeafCount() const {
+        return LeafCount;
+    }
+
+    int GetStatsCount() const {
+        return StatsCount;
+    }
+
+    TArrayRef<TBucketPairWeightStatistics> operator()(int leafId1, int leafId2) {
+        return MakeArrayRef(Data.data() + GetOffset(leafId1, leafId2), StatsCount);
+    }
+
+    TConstArrayRef<TBucketPairWeightStatistics> operator()(int leafId1, int leafId2) const {
+        return MakeArrayRef(Data.data() + GetOffset(leafId1, leafId2), StatsCount);
+    }
+
+    void Add(const TPairWeightStatistics& rhs);
+
+    SAVELOAD(LeafCount, StatsCount, Data);
+
+private:
+    size_t GetOffset(int leafId1, int leafId2) const {
+        Y_ASSERT(leafId1 < LeafCount && leafId2 < LeafCount);
+        return ((size_t)leafId1 * LeafCount + leafId2) * StatsCount;
+    }
+
+private:
+    int LeafCount = 0;
+    int StatsCount = 0;
+    TVector<TBucketPairWeightStatistics> Data;
+};
+
+
 struct TPairwiseStats {
     TVector<TVector<double>> DerSums; // [leafCount][bucketCount]
 
@@ -35,7 +85,7 @@ struct TPairwiseStats {
      *  For ExclusiveFeaturesBundle: bucketCount for all used features
      *  For FeaturesGroup:           bucketCount for all grouped features
      */
-    TArray2D<TVector<TBucketPairWeightStatistics>> PairWeightStatistics; // [leafCount][leafCount][statsCount]
+    TPairWeightStatistics PairWeightStatistics; // [leafCount][leafCount][statsCount]
 
     TSplitEnsembleSpec SplitEnsembleSpec;
 
@@ -66,97 +116,153 @@ inline TVector<TVector<double>> ComputeDerSums(
     return derSums;
 }
 
+
+// range of winners whose pairs are approximately [pairBegin, pairEnd)
+NCB::TIndexRange<int> GetWinnerIndexRange(const TCompactPairs& pairs, ui64 pairBegin, ui64 pairEnd);
+
+
+constexpr ui32 PAIRS_BLOCK_SIZE = 512;
+
+/* Calls processPair(winnerBucket, winnerLeafId, loserBucket, loserLeafId, weight) for all pairs
+ *  of winners in winnerIndexRange.
+ * Pairs are streamed in blocks: losers' buckets and leaf indices of a block are gathered first,
+ *  so that random reads are not interleaved with statistics updates.
+ */
+template <class TGetBucketFunc, class TProcessPairFunc>
+inline void ForEachPairInBlocks(
+    const TCompactPairs& pairs,
+    const TVector<TIndexType>& leafIndices,
+    TGetBucketFunc&& getBucketFunc,
+    NCB::TIndexRange<int> winnerIndexRange,
+    TProcessPairFunc&& processPair
+) {
+    if (winnerIndexRange.Empty()) {
+        return;
+    }
+    using TBucket = std::decay_t<decltype(getBucketFunc(ui32(0)))>;
+    std::array<TBucket, PAIRS_BLOCK_SIZE> loserBuckets;
+    std::array<TIndexType, PAIRS_BLOCK_SIZE> loserLeafIds;
+
+    const ui64* winnerOffsets = pairs.WinnerOffsets.data();
+    const ui32* loserIds = pairs.LoserIds.data();
+    const float* weights = pairs.Weights.data();
+
+    int winnerIdx = winnerIndexRange.Begin;
+    const ui64 pairEnd = winnerOffsets[winnerIndexRange.End];
+    for (ui64 blockBegin = winnerOffsets[winnerIndexRange.Begin]; blockBegin < pairEnd; blockBegin += PAIRS_BLOCK_SIZE) {
+        const ui64 blockEnd = Min<ui64>(blockBegin + PAIRS_BLOCK_SIZE, pairEnd);
+        for (ui64 pairIdx : xrange(blockBegin, blockEnd)) {
+            const ui32 loserId = loserIds[pairIdx];
+            loserBuckets[pairIdx - blockBegin] = getBucketFunc(loserId);
+            loserLeafIds[pairIdx - blockBegin] = leafIndices[loserId];
+        }
+        for (ui64 pairIdx = blockBegin; pairIdx < blockEnd;) {
+            while (winnerOffsets[winnerIdx + 1] <= pairIdx) {
+                ++winnerIdx;
+            }
+            const ui32 winnerId = pairs.WinnerIds[winnerIdx];
+            const TBucket winnerBucket = getBucketFunc(winnerId);
+            const TIndexType winnerLeafId = leafIndices[winnerId];
+            const ui64 winnerPairEnd = Min<ui64>(winnerOffsets[winnerIdx + 1], blockEnd);
+            for (; pairIdx < winnerPairEnd; ++pairIdx) {
+                processPair(
+                    winnerBucket,
+                    winnerLeafId,
+                    loserBuckets[pairIdx - blockBegin],
+                    loserLeafIds[pairIdx - blockBegin],
+                    weights[pairIdx]);
+            }
+        }
+    }
+}
+
 // TGetBucketFunc is of type ui32(ui32 docId)
 template <class TGetBucketFunc>
-inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistics(
-    const TFlatPairsInfo& pairs,
+inline void ComputePairWeightStatistics(
+    const TCompactPairs& pairs,
     int leafCount,
     int bucketCount,
     const TVector<TIndexType>& leafIndices,
     TGetBucketFunc getBucketFunc,
-    NCB::TIndexRange<int> pairIndexRange
+    NCB::TIndexRange<int> winnerIndexRange,
+    TPairWeightStatistics* weightSums
 ) {
-    TArray2D<TVector<TBucketPairWeightStatistics>> weightSums(leafCount, leafCount);
-    weightSums.FillEvery(TVector<TBucketPairWeightStatistics>(bucketCount));
-    for (size_t pairIdx : pairIndexRange.Iter()) {
-        const auto winnerIdx = pairs[pairIdx].WinnerId;
-        const auto loserIdx = pairs[pairIdx].LoserId;
-        if (winnerIdx == loserIdx) {
-            continue;
-        }
-        const size_t winnerBucketId = getBucketFunc(winnerIdx);
-        const auto winnerLeafId = leafIndices[winnerIdx];
-        const size_t loserBucketId = getBucketFunc(loserIdx);
-        const auto loserLeafId = leafIndices[loserIdx];
-        const float weight = pairs[pairIdx].Weight;
-        if (winnerBucketId > loserBucketId) {
-            weightSums[loserLeafId][winnerLeafId][loserBucketId].SmallerBorderWeightSum -= weight;
-            weightSums[loserLeafId][winnerLeafId][winnerBucketId].GreaterBorderRightWeightSum -= weight;
-        } else {
-            weightSums[winnerLeafId][loserLeafId][winnerBucketId].SmallerBorderWeightSum -= weight;
-            weightSums[winnerLeafId][loserLeafId][loserBucketId].GreaterBorderRightWeightSum -= weight;
-        }
-    }
-
-    return weightSums;
+    weightSums->Resize(leafCount, bucketCount);
+    ForEachPairInBlocks(
+        pairs,
+        leafIndices,
+        getBucketFunc,
+        winnerIndexRange,
+        [weightSums] (size_t winnerBucketId, TIndexType winnerLeafId, size_t loserBucketId, TIndexType loserLeafId, float weight) {
+            if (winnerBucketId > loserBucketId) {
+                const auto leafPairStats = (*weightSums)(loserLeafId, winnerLeafId);
+                leafPairStats[loserBucketId].SmallerBorderWeightSum -= weight;
+                leafPairStats[winnerBucketId].GreaterBorderRightWeightSum -= weight;
+            } else {
+                const auto leafPairStats = (*weightSums)(winnerLeafId, loserLeafId);
+                leafPairStats[winnerBucketId].SmallerBorderWeightSum -= weight;
+                leafPairStats[loserBucketId].GreaterBorderRightWeightSum -= weight;
+            }
+        });
 }
 
 // TGetBinaryFeaturesPack is of type TBinaryFeaturesPack(ui32 docId)
 template <class TGetBinaryFeaturesPack>
-inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatisticsForBinaryFeaturesPacks(
-    const TFlatPairsInfo& pairs,
+inline void ComputePairWeightStatisticsForBinaryFeaturesPacks(
+    const TCompactPairs& pairs,
     int leafCount,
     int bucketCount,
     const TVector<TIndexType>& leafIndices,
     TGetBinaryFeaturesPack getBinaryFeaturesPack,
-    NCB::TIndexRange<int> pairIndexRange
+    NCB::TIndexRange<int> winnerIndexRange,
+    TPairWeightStatistics* weightSums
 ) {
     const int binaryFeaturesCount = (int)GetValueBitCount(bucketCount - 1);
 
-    TArray2D<TVector<TBucketPairWeightStatistics>> weightSums(leafCount, leafCount);
-    weightSums.FillEvery(TVector<TBucketPairWeightStatistics>(2 * binaryFeaturesCount));
-    for (size_t pairIdx : pairIndexRange.Iter()) {
-        const auto winnerIdx = pairs[pairIdx].WinnerId;
-        const auto loserIdx = pairs[pairIdx].LoserId;
-        if (winnerIdx == loserIdx) {
-            continue;
-        }
-        const NCB::TBinaryFeaturesPack winnerFeaturesPack = getBinaryFeaturesPack(winnerIdx);
-        const auto winnerLeafId = leafIndices[winnerIdx];
-        const NCB::TBinaryFeaturesPack loserFeaturesPack = getBinaryFeaturesPack(loserIdx);
-        const auto loserLeafId = leafIndices[loserIdx];
-        const float weight = pairs[pairIdx].Weight;
-
-        for (auto bitIndex : xrange<NCB::TBinaryFeaturesPack>(binaryFeaturesCount)) {
-            auto winnerBit = (winnerFeaturesPack >> bitIndex) & 1;
-            auto loserBit = (loserFeaturesPack >> bitIndex) & 1;
-
-            if (winnerBit > loserBit) {
-                weightSums[loserLeafId][winnerLeafId][2 * bitIndex].SmallerBorderWeightSum -= weight;
-                weightSums[loserLeafId][winnerLeafId][2 * bitIndex + 1].GreaterBorderRightWeightSum -= weight;
-            } else {
-                auto winnerBucketId = 2 * bitIndex + winnerBit;
-                weightSums[winnerLeafId][loserLeafId][winnerBucketId].SmallerBorderWeightSum -= weight;
-                auto loserBucketId = 2 * bitIndex + loserBit;
-                weightSums[winnerLeafId][loserLeafId][loserBucketId].GreaterBorderRightWeightSum -= weight;
+    weightSums->Resize(leafCount, 2 * binaryFeaturesCount);
+    ForEachPairInBlocks(
+        pairs,
+        leafIndices,
+        getBinaryFeaturesPack,
+        winnerIndexRange,
+        [=] (
+            NCB::TBinaryFeaturesPack winnerFeaturesPack,
+            TIndexType winnerLeafId,
+            NCB::TBinaryFeaturesPack loserFeaturesPack,
+            TIndexType loserLeafId,
+            float weight
+        ) {
+            const auto winnerLoserStats = (*weightSums)(winnerLeafId, loserLeafId);
+            const auto loserWinnerStats = (*weightSums)(loserLeafId, winnerLeafId);
+            for (auto bitIndex : xrange<NCB::TBinaryFeaturesPack>(binaryFeaturesCount)) {
+                auto winnerBit = (winnerFeaturesPack >> bitIndex) & 1;
+                auto loserBit = (loserFeaturesPack >> bitIndex) & 1;
+
+                if (winnerBit > loserBit) {
+                    loserWinnerStats[2 * bitIndex].SmallerBorderWeightSum -= weight;
+                    loserWinnerStats[2 * bitIndex + 1].GreaterBorderRightWeightSum -= weight;
+                } else {
+                    auto winnerBucketId = 2 * bitIndex + winnerBit;
+                    winnerLoserStats[winnerBucketId].SmallerBorderWeightSum -= weight;
+                    auto loserBucketId = 2 * bitIndex + loserBit;
+                    winnerLoserStats[loserBucketId].GreaterBorderRightWeightSum -= weight;
+                }
             }
-        }
-    }
-
-    return weightSums;
+        });
 }
 
 
 // TGetExclusiveFeaturesBundleValue is of type TBundle(ui32 docId)
 template <class TGetExclusiveFeaturesBundleValue>
-inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatisticsForExclusiveFeaturesBundle(
+inline void ComputePairWeightStatisticsForExclusiveFeaturesBundle(
     ui32 oneHotMaxSize,
-    const TFlatPairsInfo& pairs,
+    const TCompactPairs& pairs,
     int leafCount,
     const TVector<TIndexType>& leafIndices,
     const NCB::TExclusiveFeaturesBundle& exclusiveFeaturesBundle,
     TGetExclusiveFeaturesBundleValue getExclusiveFeaturesBundleValue,
-    NCB::TIndexRange<int> pairIndexRange
+    NCB::TIndexRange<int> winnerIndexRange,
+    TPairWeightStatistics* weightSums
 ) {
     size_t totalBucketCount = 0;
     TVector<bool> calcStatsForBundlePart; // don't calc for cat features that are not one hot
@@ -172,97 +278,78 @@ inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistic
         }
     }
 
-    TArray2D<TVector<TBucketPairWeightStatistics>> weightSums(leafCount, leafCount);
-    weightSums.FillEvery(TVector<TBucketPairWeightStatistics>(totalBucketCount));
-    for (size_t pairIdx : pairIndexRange.Iter()) {
-        const auto winnerIdx = pairs[pairIdx].WinnerId;
-        const auto loserIdx = pairs[pairIdx].LoserId;
-        if (winnerIdx == loserIdx) {
-            continue;
-        }
-        const ui32 winnerBundleValue = getExclusiveFeaturesBundleValue(winnerIdx);
-        const auto winnerLeafId = leafIndices[winnerIdx];
-        const ui32 loserBundleValue = getExclusiveFeaturesBundleValue(loserIdx);
-        const auto loserLeafId = leafIndices[loserIdx];
-        const float weight = pairs[pairIdx].Weight;
-
-        ui32 bucketOffset = 0;
-        for (auto bundlePartIdx : xrange(exclusiveFeaturesBundle.Parts.size())) {
-            if (!calcStatsForBundlePart[bundlePartIdx]) {
-                continue;
-            }
-
-            NCB::TBoundsInBundle boundsInBundle = exclusiveFeaturesBundle.Parts[bundlePartIdx].Bounds;
-
-            auto winnerBucketId = NCB::GetBinFromBundle<ui32>(winnerBundleValue, boundsInBundle);
-            auto loserBucketId = NCB::GetBinFromBundle<ui32>(loserBundleValue, boundsInBundle);
-
-            if (winnerBucketId > loserBucketId) {
-                weightSums[loserLeafId][winnerLeafId][bucketOffset + loserBucketId].SmallerBorderWeightSum
-                    -= weight;
-                weightSums[loserLeafId][winnerLeafId][bucketOffset + winnerBucketId].GreaterBorderRightWeightSum
-                    -= weight;
-            } else {
-                weightSums[winnerLeafId][loserLeafId][bucketOffset + winnerBucketId].SmallerBorderWeightSum
-                    -= weight;
-                weightSums[winnerLeafId][loserLeafId][bucketOffset + loserBucketId].GreaterBorderRightWeightSum
-                    -= weight;
+    weightSums->Resize(leafCount, totalBucketCount);
+    ForEachPairInBlocks(
+        pairs,
+        leafIndices,
+        getExclusiveFeaturesBundleValue,
+        winnerIndexRange,
+        [&] (ui32 winnerBundleValue, TIndexType winnerLeafId, ui32 loserBundleValue, TIndexType loserLeafId, float weight) {
+            const auto winnerLoserStats = (*weightSums)(winnerLeafId, loserLeafId);
+            const auto loserWinnerStats = (*weightSums)(loserLeafId, winnerLeafId);
+
+            ui32 bucketOffset = 0;
+            for (auto bundlePartIdx : xrange(exclusiveFeaturesBundle.Parts.size())) {
+                if (!calcStatsForBundlePart[bundlePartIdx]) {
+                    continue;
+                }
+
+                NCB::TBoundsInBundle boundsInBundle = exclusiveFeaturesBundle.Parts[bundlePartIdx].Bounds;
+
+                auto winnerBucketId = NCB::GetBinFromBundle<ui32>(winnerBundleValue, boundsInBundle);
+                auto loserBucketId = NCB::GetBinFromBundle<ui32>(loserBundleValue, boundsInBundle);
+
+                if (winnerBucketId > loserBucketId) {
+                    loserWinnerStats[bucketOffset + loserBucketId].SmallerBorderWeightSum -= weight;
+                    loserWinnerStats[bucketOffset + winnerBucketId].GreaterBorderRightWeightSum -= weight;
+                } else {
+                    winnerLoserStats[bucketOffset + winnerBucketId].SmallerBorderWeightSum -= weight;
+                    winnerLoserStats[bucketOffset + loserBucketId].GreaterBorderRightWeightSum -= weight;
+                }
+
+                bucketOffset += boundsInBundle.GetSize() + 1;
             }
-
-            bucketOffset += boundsInBundle.GetSize() + 1;
-        }
-    }
-
-    return weightSums;
+        });
 }
 
 
 // TGetFeaturesGroupValue is of type TGroupValue(ui32 docId)
 template <class TGetFeaturesGroupValue>
-inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatisticsForFeaturesGroup(
-    const TFlatPairsInfo& pairs,
+inline void ComputePairWeightStatisticsForFeaturesGroup(
+    const TCompactPairs& pairs,
     int leafCount,
     const TVector<TIndexType>& leafIndices,
     const NCB::TFeaturesGroup& featuresGroup,
     TGetFeaturesGroupValue getFeaturesGroupValue,
-    NCB::TIndexRange<int> pairIndexRange
+    NCB::TIndexRange<int> winnerIndexRange,
+    TPairWeightStatistics* weightSums
 ) {
-    TArray2D<TVector<TBucketPairWeightStatistics>> weightSums(leafCount, leafCount);
-    weightSums.FillEvery(TVector<TBucketPairWeightStatistics>(featuresGroup.TotalBucketCount));
-    for (size_t pairIdx : pairIndexRange.Iter()) {
-        const auto winnerIdx = pairs[pairIdx].WinnerId;
-        const auto loserIdx = pairs[pairIdx].LoserId;
-        if (winnerIdx == loserIdx) {
-            continue;
-        }
-        const auto winnerGroupValue = getFeaturesGroupValue(winnerIdx);
-        const auto winnerLeafId = leafIndices[winnerIdx];
-        const auto loserGroupValue = getFeaturesGroupValue(loserIdx);
-        const auto loserLeafId = leafIndices[loserIdx];
-        const float weight = pairs[pairIdx].Weight;
-
-        ui32 bucketOffset = 0;
-        for (auto partIdx : xrange(featuresGroup.Parts.size())) {
-            auto winnerBucketId = NCB::GetPartValueFromGroup(winnerGroupValue, partIdx);
-            auto loserBucketId = NCB::GetPartValueFromGroup(loserGroupValue, partIdx);
-
-            if (winnerBucketId > loserBucketId) {
-                weightSums[loserLeafId][winnerLeafId][bucketOffset + loserBucketId].SmallerBorderWeightSum
-                    -= weight;
-                weightSums[loserLeafId][winnerLeafId][bucketOffset + winnerBucketId].GreaterBorderRightWeightSum
-                    -= weight;
-            } else {
-                weightSums[winnerLeafId][loserLeafId][bucketOffset + winnerBucketId].SmallerBorderWeightSum
-                    -= weight;
-                weightSums[winnerLeafId][loserLeafId][bucketOffset + loserBucketId].GreaterBorderRightWeightSum
-                    -= weight;
+    weightSums->Resize(leafCount, featuresGroup.TotalBucketCount);
+    ForEachPairInBlocks(
+        pairs,
+        leafIndices,
+        getFeaturesGroupValue,
+        winnerIndexRange,
+        [&] (auto winnerGroupValue, TIndexType winnerLeafId, auto loserGroupValue, TIndexType loserLeafId, float weight) {
+            const auto winnerLoserStats = (*weightSums)(winnerLeafId, loserLeafId);
+            const auto loserWinnerStats = (*weightSums)(loserLeafId, winnerLeafId);
+
+            ui32 bucketOffset = 0;
+            for (auto partIdx : xrange(featuresGroup.Parts.size())) {
+                auto winnerBucketId = NCB::GetPartValueFromGroup(winnerGroupValue, partIdx);
+                auto loserBucketId = NCB::GetPartValueFromGroup(loserGroupValue, partIdx);
+
+                if (winnerBucketId > loserBucketId) {
+                    loserWinnerStats[bucketOffset + loserBucketId].SmallerBorderWeightSum -= weight;
+                    loserWinnerStats[bucketOffset + winnerBucketId].GreaterBorderRightWeightSum -= weight;
+                } else {
+                    winnerLoserStats[bucketOffset + winnerBucketId].SmallerBorderWeightSum -= weight;
+                    winnerLoserStats[bucketOffset + loserBucketId].GreaterBorderRightWeightSum -= weight;
+                }
+
+                bucketOffset += featuresGroup.Parts[partIdx].BucketCount;
             }
-
-            bucketOffset += featuresGroup.Parts[partIdx].BucketCount;
-        }
-    }
-
-    return weightSums;
+        });
 }
 
 
@@ -270,7 +357,7 @@ template <typename TBucket, typename TGetBucketFunc>
 inline void ComputePairwiseStats(
     ESplitEnsembleType splitEnsembleType,
     TConstArrayRef<double> weightedDerivatives,
-    const TFlatPairsInfo& pairs,
+    const TCompactPairs& pairs,
     int leafCount,
     int bucketCount,
     ui32 oneHotMaxSize,
@@ -281,7 +368,7 @@ inline void ComputePairwiseStats(
     // used only if SplitEnsembleType == ESplitEnsembleType::FeaturesGroup
     TMaybe<const NCB::TFeaturesGroup*> featuresGroup,
     NCB::TIndexRange<int> docIndexRange,
-    NCB::TIndexRange<int> pairIndexRange,
+    NCB::TIndexRange<int> winnerIndexRange,
     TGetBucketFunc&& getBucketFunc,
     TPairwiseStats* output
 ) {
@@ -296,44 +383,48 @@ inline void ComputePairwiseStats(
 
     switch (splitEnsembleType) {
         case ESplitEnsembleType::OneFeature:
-            output->PairWeightStatistics = ComputePairWeightStatistics(
+            ComputePairWeightStatistics(
                 pairs,
                 leafCount,
                 bucketCount,
                 leafIndices,
                 getBucketFunc,
-                pairIndexRange
+                winnerIndexRange,
+                &output->PairWeightStatistics
             );
             break;
         case ESplitEnsembleType::BinarySplits:
-            output->PairWeightStatistics = ComputePairWeightStatisticsForBinaryFeaturesPacks(
+            ComputePairWeightStatisticsForBinaryFeaturesPacks(
                 pairs,
                 leafCount,
                 bucketCount,
                 leafIndices,
                 getBucketFunc,
-                pairIndexRange
+                winnerIndexRange,
+                &output->PairWeightStatistics
             );
             break;
         case ESplitEnsembleType::ExclusiveBundle:
-            output->PairWeightStatistics = ComputePairWeightStatisticsForExclusiveFeaturesBundle(
+            ComputePairWeightStatisticsForExclusiveFeaturesBundle(
                 oneHotMaxSize,
                 pairs,
                 leafCount,
                 leafIndices,
                 **exclusiveFeaturesBundle,
                 getBucketFunc,
-                pairIndexRange
+                winnerIndexRange,
+                &output->PairWeightStatistics
             );
             break;
         case ESplitEnsembleType::FeaturesGroup:
-            output->PairWeightStatistics = ComputePairWeightStatisticsForFeaturesGroup(
+            ComputePairWeightStatisticsForFeaturesGroup(
                 pairs,
                 leafCount,
                 leafIndices,
                 **featuresGroup,
                 getBucketFunc,
-                pairIndexRange
+                winnerIndexRange,
+                &output->PairWeightStatistics
             );
             break;
     }
@@ -344,7 +435,7 @@ template <class T, NCB::EFeatureValuesType FeatureValuesType>
 inline void ComputePairwiseStats(
     const TCalcScoreFold& fold,
     TConstArrayRef<double> weightedDerivatives,
-    const TFlatPairsInfo& pairs,
+    const TCompactPairs& pairs,
     int leafCount,
     int bucketCount,
     ui32 oneHotMaxSize,
@@ -355,7 +446,7 @@ inline void ComputePairwiseStats(
     TMaybe<const NCB::TFeaturesGroup*> featuresGroup,
     const NCB::TTypedFeatureValuesHolder<T, FeatureValuesType>& column,
     NCB::TIndexRange<int> docIndexRange,
-    NCB::TIndexRange<int> pairIndexRange,
+    NCB::TIndexRange<int> winnerIndexRange,
     TPairwiseStats* output
 ) {
     ESplitEnsembleType splitEnsembleType;
@@ -392,7 +483,7 @@ inline void ComputePairwiseStats(
                     exclusiveFeaturesBundle,
                     featuresGroup,
                     docIndexRange,
-                    pairIndexRange,
+                    winnerIndexRange,
                     [bucketSrcData, bucketIndexing](ui32 docIdx) {
                         return bucketSrcData[bucketIndexing[docIdx]];
                     },
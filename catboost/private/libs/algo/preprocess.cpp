@@ -1,8 +1,8 @@
 #include "preprocess.h"
+#include "incremental_snapshot.h"
 
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/permutation.h>
-#include <catboost/libs/helpers/progress_helper.h>
 #include <catboost/libs/helpers/restorable_rng.h>
 #include <catboost/private/libs/options/catboost_options.h>
 #include <catboost/private/libs/options/defaults_helper.h>
@@ -52,7 +52,7 @@ void UpdateUndefinedRandomSeed(
     ETaskType taskType,
     const NCatboostOptions::TOutputFilesOptions& outputOptions,
     NJson::TJsonValue* updatedJsonParams,
-    std::function<void(TIFStream*, TString&)> paramsLoader) {
+    std::function<void(IInputStream*, TString&)> paramsLoader) {
 
     const TString snapshotFilename = TOutputFiles::AlignFilePath(
         outputOptions.GetTrainDir(),
@@ -63,9 +63,10 @@ void UpdateUndefinedRandomSeed(
         TString serializedTrainParams;
         NJson::TJsonValue restoredJsonParams;
         try {
-            TProgressHelper(ToString(taskType)).CheckedLoad(
+            NCB::ReadSnapshot(
                 snapshotFilename,
-                [&](TIFStream* inputStream) {
+                ToString(taskType),
+                [&](IInputStream* inputStream) {
                     paramsLoader(inputStream, serializedTrainParams);
                 }
             );
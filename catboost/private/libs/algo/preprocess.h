@@ -32,7 +32,7 @@ void UpdateUndefinedRandomSeed(
     ETaskType taskType,
     const NCatboostOptions::TOutputFilesOptions& outputOptions,
     NJson::TJsonValue* updatedJsonParams,
-    std::function<void(TIFStream*, TString&)> paramsLoader
+    std::function<void(IInputStream*, TString&)> paramsLoader
 );
 
 void UpdateUndefinedClassNames(
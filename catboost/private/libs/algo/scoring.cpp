@@ -10,7 +10,9 @@
 #include "tensor_search_helpers.h"
 
 #include <catboost/libs/data/objects.h>
+#include <catboost/libs/helpers/arena.h>
 #include <catboost/libs/helpers/map_merge.h>
+#include <catboost/libs/logging/event_trace.h>
 #include <catboost/private/libs/algo_helpers/online_predictor.h>
 #include <catboost/private/libs/algo_helpers/scoring_helpers.h>
 #include <catboost/private/libs/data_types/pair.h>
@@ -63,15 +65,14 @@ inline static void SetSingleIndex(
     const int bucketBeginOffset,
     const int permBlockSize,
     NCB::TIndexRange<int> docIndexRange, // aligned by permutation blocks in docPermutation
-    TVector<TFullIndexType>* singleIdx // already of proper size
+    TArrayRef<TFullIndexType> singleIdx // already of proper size
 ) {
     const int docCount = fold.GetDocCount();
     const TIndexType* indices = GetDataPtr(fold.Indices);
-    const TArrayRef<TFullIndexType> singleIdxRef(*singleIdx);
 
     if (bucketIndexing == nullptr) {
         for (int doc : docIndexRange.Iter()) {
-            singleIdxRef[doc] = indexer.GetIndex(indices[doc], bucketIndex[bucketBeginOffset + doc]);
+            singleIdx[doc] = indexer.GetIndex(indices[doc], bucketIndex[bucketBeginOffset + doc]);
         }
     } else if (permBlockSize > 1) {
         const int blockCount = (docCount + permBlockSize - 1) / permBlockSize;
@@ -90,14 +91,14 @@ inline static void SetSingleIndex(
             const int originalBlockIdx = static_cast<int>(bucketIndexing[blockStart]);
             for (int doc = blockStart; doc < nextBlockStart; ++doc) {
                 const int originalDocIdx = originalBlockIdx + doc - blockStart;
-                singleIdxRef[doc] = indexer.GetIndex(indices[doc], bucketIndex[originalDocIdx]);
+                singleIdx[doc] = indexer.GetIndex(indices[doc], bucketIndex[originalDocIdx]);
             }
             blockStart = nextBlockStart;
         }
     } else {
         for (int doc : docIndexRange.Iter()) {
             const ui32 originalDocIdx = bucketIndexing[doc];
-            singleIdxRef[doc] = indexer.GetIndex(indices[doc], bucketIndex[originalDocIdx]);
+            singleIdx[doc] = indexer.GetIndex(indices[doc], bucketIndex[originalDocIdx]);
         }
     }
 }
@@ -109,7 +110,7 @@ inline static void BuildSingleIndex(
     const TTypedFeatureValuesHolder<T, FeatureValuesType>& column,
     const TStatsIndexer& indexer,
     NCB::TIndexRange<int> docIndexRange,
-    TVector<TFullIndexType>* singleIdx // already of proper size
+    TArrayRef<TFullIndexType> singleIdx // already of proper size
 ) {
     if (const auto* denseColumnData
             = dynamic_cast<const TCompressedValuesHolderImpl<T, FeatureValuesType>*>(&column))
@@ -154,7 +155,7 @@ inline static void BuildSingleIndex(
     const TSplitEnsemble& splitEnsemble,
     const TStatsIndexer& indexer,
     NCB::TIndexRange<int> docIndexRange,
-    TVector<TFullIndexType>* singleIdx // already of proper size
+    TArrayRef<TFullIndexType> singleIdx // already of proper size
 ) {
     if (splitEnsemble.IsSplitOfType(ESplitType::OnlineCtr)) {
         const TCtr& ctr = splitEnsemble.SplitCandidate.Ctr;
@@ -221,7 +222,7 @@ inline static void BuildSingleIndex(
 // Update bootstraped sums on docIndexRange in a bucket
 template <typename TFullIndexType>
 inline static void UpdateWeighted(
-    const TVector<TFullIndexType>& singleIdx,
+    TConstArrayRef<TFullIndexType> singleIdx,
     const double* weightedDer,
     const float* sampleWeights,
     NCB::TIndexRange<int> docIndexRange,
@@ -238,7 +239,7 @@ inline static void UpdateWeighted(
 // Update not bootstraped sums on docIndexRange in a bucket
 template <typename TFullIndexType>
 inline static void UpdateDeltaCount(
-    const TVector<TFullIndexType>& singleIdx,
+    TConstArrayRef<TFullIndexType> singleIdx,
     const double* derivatives,
     const float* learnWeights,
     NCB::TIndexRange<int> docIndexRange,
@@ -263,7 +264,7 @@ inline static void UpdateDeltaCount(
 template <typename TFullIndexType>
 inline static void CalcStatsKernel(
     bool isCaching,
-    const TVector<TFullIndexType>& singleIdx,
+    TConstArrayRef<TFullIndexType> singleIdx,
     const TCalcScoreFold& fold,
     bool isPlainMode,
     const TStatsIndexer& indexer,
@@ -348,7 +349,7 @@ template <typename TFullIndexType, typename TIsCaching>
 static void CalcStatsImpl(
     const TCalcScoreFold& fold,
     const TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
-    const TFlatPairsInfo& pairs,
+    const TCompactPairs& pairs,
     const std::tuple<const TOnlineCTRHash&, const TOnlineCTRHash&>& allCtrs,
     const TSplitEnsemble& splitEnsemble,
     const TStatsIndexer& indexer,
@@ -358,6 +359,7 @@ static void CalcStatsImpl(
     int depth,
     int /*splitStatsCount*/,
     NPar::TLocalExecutor* localExecutor,
+    NCB::TThreadArenas* /*threadArenas*/,
     TPairwiseStats* stats
 ) {
     const int approxDimension = fold.GetApproxDimension();
@@ -373,8 +375,9 @@ static void CalcStatsImpl(
     const auto blockCount = fold.GetCalcStatsIndexRanges().RangesCount();
     const auto docPart = CeilDiv(docCount, blockCount);
 
-    const auto pairCount = pairs.ysize();
-    const auto pairPart = CeilDiv(pairCount, blockCount);
+    // pairs are split by winners, with approximately equal pair count per part
+    const ui64 pairCount = pairs.GetPairCount();
+    const ui64 pairPart = CeilDiv<ui64>(pairCount, blockCount);
 
     NCB::MapMerge(
         localExecutor,
@@ -387,7 +390,8 @@ static void CalcStatsImpl(
                 Min(docCount, docPart * partIndexRange.End)
             );
 
-            auto pairIndexRange = NCB::TIndexRange<int>(
+            auto winnerIndexRange = GetWinnerIndexRange(
+                pairs,
                 Min(pairCount, pairPart * partIndexRange.Begin),
                 Min(pairCount, pairPart * partIndexRange.End)
             );
@@ -408,7 +412,7 @@ static void CalcStatsImpl(
                     featuresGroup,
                     column,
                     docIndexRange,
-                    pairIndexRange,
+                    winnerIndexRange,
                     output);
             };
 
@@ -437,7 +441,7 @@ static void CalcStatsImpl(
                                         /*exclusiveFeaturesBundle*/ Nothing(),
                                         /*featuresGroup*/ Nothing(),
                                         docIndexRange,
-                                        pairIndexRange,
+                                        winnerIndexRange,
                                         [buckets](ui32 docIdx) { return buckets[docIdx]; },
                                         output);
                                 }
@@ -498,7 +502,7 @@ template <typename TFullIndexType, typename TIsCaching>
 static void CalcStatsImpl(
     const TCalcScoreFold& fold,
     const TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
-    const TFlatPairsInfo& /*pairs*/,
+    const TCompactPairs& /*pairs*/,
     const std::tuple<const TOnlineCTRHash&, const TOnlineCTRHash&>& allCtrs,
     const TSplitEnsemble& splitEnsemble,
     const TStatsIndexer& indexer,
@@ -508,14 +512,16 @@ static void CalcStatsImpl(
     int depth,
     int splitStatsCount,
     NPar::TLocalExecutor* localExecutor,
+    NCB::TThreadArenas* threadArenas,
     TBucketStatsRefOptionalHolder* stats
 ) {
     Y_ASSERT(!isCaching || depth > 0);
 
     const int docCount = fold.GetDocCount();
 
-    TVector<TFullIndexType> singleIdx;
-    singleIdx.yresize(docCount);
+    NCB::TArenaScope arenaScope(NCB::GetThreadArena(threadArenas));
+    TVector<TFullIndexType> singleIdxHolder;
+    const TArrayRef<TFullIndexType> singleIdx = NCB::AllocateScratchArray(docCount, threadArenas, &singleIdxHolder);
 
     const int statsCount = fold.GetBodyTailCount() * fold.GetApproxDimension() * splitStatsCount;
     const int filledSplitStatsCount = indexer.CalcSize(depth);
@@ -548,7 +554,7 @@ static void CalcStatsImpl(
                 splitEnsemble,
                 indexer,
                 docIndexRange,
-                &singleIdx
+                singleIdx
             );
 
             if (output->NonInited()) {
@@ -560,7 +566,7 @@ static void CalcStatsImpl(
             forEachBodyTailAndApproxDimension(
                 [&](int bodyTailIdx, int dim, int bucketStatsArrayBegin) {
                     TBucketStats* statsSubset = output->GetData().data() + bucketStatsArrayBegin;
-                    CalcStatsKernel(
+                    CalcStatsKernel<TFullIndexType>(
                         isCaching && (indexRange.Begin == 0),
                         singleIdx,
                         fold,
@@ -822,7 +828,7 @@ void CalcStatsAndScores(
     const TCalcScoreFold& fold,
     const TCalcScoreFold& prevLevelData,
     const TFold* initialFold,
-    const TFlatPairsInfo& pairs,
+    const TCompactPairs& pairs,
     const NCatboostOptions::TCatBoostOptions& fitParams,
     const TCandidateInfo& candidateInfo,
     int depth,
@@ -833,8 +839,11 @@ void CalcStatsAndScores(
     TBucketStatsCache* statsFromPrevTree,
     TStats3D* stats3d,
     TPairwiseStats* pairwiseStats,
-    IScoreCalcer* scoreCalcer
+    IScoreCalcer* scoreCalcer,
+    NCB::TThreadArenas* threadArenas
 ) {
+    CHROMIUM_TRACE_FUNCTION();
+
     CB_ENSURE(
         stats3d || pairwiseStats || scoreCalcer,
         "stats3d, pairwiseStats, and scoreCalcer are empty - nothing to calculate"
@@ -878,6 +887,7 @@ void CalcStatsAndScores(
                 depth,
                 splitStatsCount,
                 localExecutor,
+                threadArenas,
                 stats
             );
         } else if (fullIndexBitCount <= 16) {
@@ -894,6 +904,7 @@ void CalcStatsAndScores(
                 depth,
                 splitStatsCount,
                 localExecutor,
+                threadArenas,
                 stats
             );
         } else if (fullIndexBitCount <= 32) {
@@ -910,6 +921,7 @@ void CalcStatsAndScores(
                 depth,
                 splitStatsCount,
                 localExecutor,
+                threadArenas,
                 stats
             );
         }
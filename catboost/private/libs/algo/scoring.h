@@ -23,6 +23,7 @@ namespace NCatboostOptions {
 
 namespace NCB {
     class TQuantizedForCPUObjectsDataProvider;
+    class TThreadArenas;
 }
 
 namespace NPar {
@@ -42,7 +43,7 @@ void CalcStatsAndScores(
 
     // used only in score calculation, nullptr can be passed for stats (used in distibuted mode now)
     const TFold* initialFold,
-    const TFlatPairsInfo& pairs,
+    const TCompactPairs& pairs,
     const NCatboostOptions::TCatBoostOptions& fitParams,
     const TCandidateInfo& candidateInfo,
     int depth,
@@ -57,7 +58,10 @@ void CalcStatsAndScores(
     TPairwiseStats* pairwiseStats,
 
     // can be nullptr, if so - don't calc and return this data (used in dictributed mode now)
-    IScoreCalcer* scoreCalcer
+    IScoreCalcer* scoreCalcer,
+
+    // can be nullptr, if so - temporary arrays are allocated on the heap
+    NCB::TThreadArenas* threadArenas = nullptr
 );
 
 TVector<double> GetScores(
@@ -15,6 +15,7 @@
 #include <catboost/libs/data/data_provider.h>
 #include <catboost/libs/helpers/interrupt.h>
 #include <catboost/libs/helpers/query_info_helper.h>
+#include <catboost/libs/logging/event_trace.h>
 #include <catboost/libs/logging/profile_info.h>
 #include <catboost/private/libs/algo/approx_calcer/leafwise_approx_calcer.h>
 #include <catboost/private/libs/algo_helpers/approx_calcer_helpers.h>
@@ -185,9 +186,12 @@ void CalcApproxesLeafwise(
 }
 
 void TrainOneIteration(const NCB::TTrainingForCPUDataProviders& data, TLearnContext* ctx) {
+    CHROMIUM_TRACE_FUNCTION();
+
     const auto error = BuildError(ctx->Params, ctx->ObjectiveDescriptor);
     ctx->LearnProgress->HessianType = error->GetHessianType();
     TProfileInfo& profile = ctx->Profile;
+    ctx->IterationArenas.Reset();
 
     const size_t iterationIndex = ctx->LearnProgress->TreeStruct.size();
     const int foldCount = ctx->LearnProgress->Folds.ysize();
@@ -220,6 +224,7 @@ void TrainOneIteration(const NCB::TTrainingForCPUDataProviders& data, TLearnCont
             ctx->LearnProgress->Rand.GenRand()
         );
         if (ctx->Params.SystemOptions->IsSingleHost()) {
+            CHROMIUM_TRACE_SCOPE("Calc derivatives");
             ctx->LocalExecutor->ExecRangeWithThrow(
                 [&](int bodyTailId) {
                     CalcWeightedDerivatives(
@@ -275,6 +280,7 @@ void TrainOneIteration(const NCB::TTrainingForCPUDataProviders& data, TLearnCont
                 }
             };
 
+            CHROMIUM_TRACE_SCOPE("ComputeOnlineCTRs for tree struct");
             TVector<TLocalJobData> parallelJobsData;
             THashSet<TProjection> seenProjections;
             for (const auto& ctr : GetUsedCtrs(bestTree)) {
@@ -309,6 +315,7 @@ void TrainOneIteration(const NCB::TTrainingForCPUDataProviders& data, TLearnCont
 
         if (ctx->Params.SystemOptions->IsSingleHost()) {
             const TVector<ui64> randomSeeds = GenRandUI64Vector(foldCount, ctx->LearnProgress->Rand.GenRand());
+            CHROMIUM_TRACE_SCOPE("Update approxes");
             ctx->LocalExecutor->ExecRangeWithThrow(
                 [&](int foldId) {
                     UpdateLearningFold(
@@ -405,4 +412,6 @@ void TrainOneIteration(const NCB::TTrainingForCPUDataProviders& data, TLearnCont
         profile.AddOperation("Update final approxes");
         CheckInterrupted(); // check after long-lasting operation
     }
+    CATBOOST_DEBUG_LOG << "Scratch memory allocated in iteration " << iterationIndex << ": "
+        << ctx->IterationArenas.GetAllocatedBytes() << " bytes" << Endl;
 }
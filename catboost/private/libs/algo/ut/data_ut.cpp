@@ -0,0 +1,148 @@
+#include <catboost/libs/data/data_provider.h>
+#include <catboost/libs/data/data_provider_builders.h>
+#include <catboost/libs/data/visitor.h>
+#include <catboost/libs/helpers/resource_holder.h>
+#include <catboost/libs/helpers/restorable_rng.h>
+#include <catboost/libs/helpers/vector_helpers.h>
+#include <catboost/private/libs/algo/data.h>
+#include <catboost/private/libs/labels/label_converter.h>
+#include <catboost/private/libs/options/catboost_options.h>
+
+#include <library/threading/local_executor/local_executor.h>
+#include <library/unittest/registar.h>
+
+#include <util/folder/tempdir.h>
+#include <util/generic/xrange.h>
+
+using namespace NCB;
+
+Y_UNIT_TEST_SUITE(GetTrainingDataTest) {
+    static TDataProviderPtr CreateQuantizedDataProvider(
+        const TVector<TVector<ui8>>& quantizedFloatFeatures,
+        const TVector<float>& target) {
+
+        return CreateDataProvider<IQuantizedFeaturesDataVisitor>(
+            [&] (IQuantizedFeaturesDataVisitor* visitor) {
+                const ui32 floatFeatureCount = quantizedFloatFeatures.size();
+                const ui32 objectCount = target.size();
+
+                TDataMetaInfo metaInfo;
+                metaInfo.TargetCount = 1;
+                metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                    floatFeatureCount,
+                    TVector<ui32>{},
+                    TVector<TString>{}
+                );
+
+                TPoolQuantizationSchema schema;
+                for (auto featureIdx : xrange(floatFeatureCount)) {
+                    schema.FeatureIndices.push_back(featureIdx);
+                    // 3 borders so that features are not packed as binary
+                    schema.Borders.push_back({0.5f, 1.5f, 2.5f});
+                    schema.NanModes.push_back(ENanMode::Forbidden);
+                }
+
+                visitor->Start(metaInfo, objectCount, EObjectsOrder::Undefined, false, {}, schema);
+
+                for (auto featureIdx : xrange(floatFeatureCount)) {
+                    auto holder = TMaybeOwningArrayHolder<const ui8>::CreateNonOwning(
+                        quantizedFloatFeatures[featureIdx]
+                    );
+                    visitor->AddFloatFeaturePart(featureIdx, 0, 8, holder);
+                }
+
+                visitor->AddTargetPart(0, {target.data(), target.size() * sizeof(float)});
+
+                visitor->Finish();
+            }
+        );
+    }
+
+    static const TQuantizedFloatValuesHolder& GetDenseFloatFeature(
+        const TQuantizedForCPUObjectsDataProvider& objectsData,
+        ui32 floatFeatureIdx) {
+
+        const auto* column = dynamic_cast<const TQuantizedFloatValuesHolder*>(
+            *objectsData.GetNonPackedFloatFeature(floatFeatureIdx)
+        );
+        UNIT_ASSERT(column);
+        return *column;
+    }
+
+    static TIntrusivePtr<IResourceHolder> GetStorageResourceHolder(const TQuantizedFloatValuesHolder& column) {
+        return column.GetCompressedData().GetSrc()->GetStorageResourceHolder();
+    }
+
+    Y_UNIT_TEST(FeaturesColumnStoreFreesSharedHeapColumns) {
+        const TVector<TVector<ui8>> quantizedFloatFeatures = {
+            {0, 1, 2, 3, 3, 2},
+            {3, 1, 2, 1, 0, 2}
+        };
+        const TVector<float> target = {0.0f, 1.0f, 0.5f, 0.2f, 0.3f, 0.8f};
+
+        // srcData is kept alive, as it is when the same pool is used for learn and eval or for several fits
+        TDataProviderPtr srcData = CreateQuantizedDataProvider(quantizedFloatFeatures, target);
+        auto& srcObjectsData = dynamic_cast<TQuantizedForCPUObjectsDataProvider&>(*srcData->ObjectsData);
+
+        TVector<TIntrusivePtr<IResourceHolder>> heapStorageHolders;
+        for (auto featureIdx : xrange(quantizedFloatFeatures.size())) {
+            heapStorageHolders.push_back(
+                GetStorageResourceHolder(GetDenseFloatFeature(srcObjectsData, featureIdx))
+            );
+            UNIT_ASSERT(heapStorageHolders.back());
+            UNIT_ASSERT(!dynamic_cast<TBlobHolder*>(heapStorageHolders.back().Get()));
+        }
+
+        TTempDir columnStoreDir;
+        NCatboostOptions::TCatBoostOptions catBoostOptions(ETaskType::CPU);
+        catBoostOptions.SystemOptions->FeaturesColumnStoreDir = columnStoreDir.Name();
+        TLabelConverter labelConverter;
+        NPar::TLocalExecutor localExecutor;
+        TRestorableFastRng64 rand(0);
+
+        TVector<TTrainingDataProviderPtr> trainingData;
+        for (auto isLearnData : {true, false}) {
+            TMaybe<float> targetBorder = catBoostOptions.DataProcessingOptions->TargetBorder;
+            trainingData.push_back(
+                GetTrainingData(
+                    srcData,
+                    isLearnData,
+                    isLearnData ? "learn" : "test",
+                    Nothing(),
+                    true,
+                    false,
+                    true,
+                    nullptr,
+                    &catBoostOptions,
+                    &labelConverter,
+                    &targetBorder,
+                    &localExecutor,
+                    &rand
+                )
+            );
+        }
+
+        UNIT_ASSERT(srcObjectsData.HasFeaturesColumnStore());
+
+        for (auto featureIdx : xrange(quantizedFloatFeatures.size())) {
+            // heap columns are referenced only by this test, so they are freed
+            UNIT_ASSERT_VALUES_EQUAL(heapStorageHolders[featureIdx]->RefCount(), 1);
+
+            const auto srcStorageHolder = GetStorageResourceHolder(
+                GetDenseFloatFeature(srcObjectsData, featureIdx)
+            );
+            UNIT_ASSERT(dynamic_cast<TBlobHolder*>(srcStorageHolder.Get()));
+
+            // learn and test data share one column store
+            for (const auto& data : trainingData) {
+                const auto& objectsData
+                    = dynamic_cast<const TQuantizedForCPUObjectsDataProvider&>(*data->ObjectsData);
+                const auto& column = GetDenseFloatFeature(objectsData, featureIdx);
+                UNIT_ASSERT_EQUAL(GetStorageResourceHolder(column), srcStorageHolder);
+                UNIT_ASSERT(
+                    Equal<ui8>(*column.ExtractValues(&localExecutor), quantizedFloatFeatures[featureIdx])
+                );
+            }
+        }
+    }
+}
@@ -0,0 +1,167 @@
+#include <catboost/private/libs/algo/incremental_snapshot.h>
+#include <catboost/private/libs/algo/learn_context.h>
+
+#include <catboost/libs/helpers/progress_helper.h>
+
+#include <library/unittest/registar.h>
+
+#include <util/stream/buffer.h>
+#include <util/stream/input.h>
+#include <util/system/fs.h>
+
+
+using namespace NCB;
+
+
+static TString ReadState(const TString& path, const TString& label) {
+    TString state;
+    ReadSnapshot(path, label, [&] (IInputStream* in) {
+        state = in->ReadAll();
+    });
+    return state;
+}
+
+static TBuffer MakeBuffer(const TString& data) {
+    return TBuffer(data.data(), data.size());
+}
+
+
+Y_UNIT_TEST_SUITE(IncrementalSnapshot) {
+    Y_UNIT_TEST(BaseAndDelta) {
+        const TString path = "incremental_snapshot_ut.bin";
+        const TString label = "CPU";
+        const size_t chunkSize = 16;
+
+        TString state(10 * chunkSize + 5, 'a');
+        {
+            TIncrementalSnapshotWriter writer(path, label, "lz4", chunkSize);
+
+            writer.Write(MakeBuffer(state));
+            UNIT_ASSERT(!NFs::Exists(GetSnapshotDeltaPath(path)));
+            UNIT_ASSERT_VALUES_EQUAL(ReadState(path, label), state);
+
+            // one changed chunk and one new chunk
+            state[3 * chunkSize + 1] = 'b';
+            state += TString(chunkSize, 'c');
+            writer.Write(MakeBuffer(state));
+            UNIT_ASSERT(NFs::Exists(GetSnapshotDeltaPath(path)));
+            UNIT_ASSERT_VALUES_EQUAL(ReadState(path, label), state);
+
+            // delta is built against the base, not against the previous delta
+            state.resize(state.size() - 7);
+            writer.WriteAsync(MakeBuffer(state));
+            writer.Wait();
+            UNIT_ASSERT_VALUES_EQUAL(ReadState(path, label), state);
+
+            // most of the chunks changed, base is rewritten
+            for (auto& c : state) {
+                c = 'd';
+            }
+            writer.WriteAsync(MakeBuffer(state));
+        }
+        UNIT_ASSERT(!NFs::Exists(GetSnapshotDeltaPath(path)));
+        UNIT_ASSERT_VALUES_EQUAL(ReadState(path, label), state);
+
+        UNIT_ASSERT_EXCEPTION(ReadState(path, "GPU"), TCatBoostException);
+
+        NFs::Remove(path);
+    }
+
+    Y_UNIT_TEST(LegacyFormat) {
+        const TString path = "legacy_snapshot_ut.bin";
+        const TString label = "CPU";
+        const TString state = "legacy snapshot state";
+        TProgressHelper(label).Write(path, [&] (IOutputStream* out) {
+            out->Write(state);
+        });
+        UNIT_ASSERT_VALUES_EQUAL(ReadState(path, label), state);
+
+        NFs::Remove(path);
+    }
+
+    Y_UNIT_TEST(LegacyLearnProgress) {
+        const TString path = "legacy_learn_progress_ut.bin";
+        const TString label = "CPU";
+
+        // TLearnProgress fields in the order they are written by snapshots of previous versions
+        const TString serializedTrainParams = "{\"loss_function\":\"RMSE\"}";
+        const bool enableSaveLoadApprox = false;
+        const TVector<TVector<TVector<double>>> testApprox = {{{0.5, -1.0, 2.0}}};
+        const TVector<TVector<double>> bestTestApprox = {{0.25, -0.5, 1.0}};
+        const TVector<TCatFeature> catFeatures;
+        const TVector<TFloatFeature> floatFeatures;
+        const int approxDimension = 1;
+        const TVector<TVariant<TSplitTree, TNonSymmetricTreeStructure>> treeStruct;
+        const TVector<TTreeStats> treeStats;
+        const TVector<TVector<TVector<double>>> leafValues;
+        const TVector<double> modelShrinkHistory = {1.0, 0.5};
+        const ui32 initTreesSize = 2;
+        const TMetricsAndTimeLeftHistory metricsAndTimeHistory;
+        const THashSet<std::pair<ECtrType, TProjection>> usedCtrSplits;
+        const ui32 learnAndTestQuantizedFeaturesCheckSum = 123;
+        const ui32 separateInitModelTreesSize = 4;
+        const ui32 separateInitModelCheckSum = 567;
+        const TRestorableFastRng64 rand(42);
+        TProgressHelper(label).Write(path, [&] (IOutputStream* out) {
+            ::SaveMany(
+                out,
+                serializedTrainParams,
+                enableSaveLoadApprox,
+                testApprox,
+                bestTestApprox,
+                catFeatures,
+                floatFeatures,
+                approxDimension,
+                treeStruct,
+                treeStats,
+                leafValues,
+                modelShrinkHistory,
+                initTreesSize,
+                metricsAndTimeHistory,
+                usedCtrSplits,
+                learnAndTestQuantizedFeaturesCheckSum,
+                separateInitModelTreesSize,
+                separateInitModelCheckSum,
+                rand
+            );
+        });
+
+        TLearnProgress learnProgress;
+        ReadSnapshot(path, label, [&] (IInputStream* in) {
+            learnProgress.Load(in);
+        });
+        UNIT_ASSERT_VALUES_EQUAL(learnProgress.SerializedTrainParams, serializedTrainParams);
+        UNIT_ASSERT(!learnProgress.EnableSaveLoadApprox);
+        UNIT_ASSERT_EQUAL(learnProgress.TestApprox, testApprox);
+        UNIT_ASSERT_EQUAL(learnProgress.BestTestApprox, bestTestApprox);
+        UNIT_ASSERT_VALUES_EQUAL(learnProgress.ApproxDimension, approxDimension);
+        UNIT_ASSERT_VALUES_EQUAL(learnProgress.ModelShrinkHistory, modelShrinkHistory);
+        UNIT_ASSERT_VALUES_EQUAL(learnProgress.InitTreesSize, initTreesSize);
+        UNIT_ASSERT_VALUES_EQUAL(
+            learnProgress.LearnAndTestQuantizedFeaturesCheckSum,
+            learnAndTestQuantizedFeaturesCheckSum
+        );
+        UNIT_ASSERT_VALUES_EQUAL(learnProgress.SeparateInitModelTreesSize, separateInitModelTreesSize);
+        UNIT_ASSERT_VALUES_EQUAL(learnProgress.SeparateInitModelCheckSum, separateInitModelCheckSum);
+        TRestorableFastRng64 expectedRand(42);
+        UNIT_ASSERT_VALUES_EQUAL(learnProgress.Rand.GenRand(), expectedRand.GenRand());
+
+        // the same state is written by the current version
+        TIncrementalSnapshotWriter(path, label).Write(
+            [&] {
+                TBufferOutput out;
+                learnProgress.Save(&out);
+                return out.Buffer();
+            }()
+        );
+        TLearnProgress reloadedLearnProgress;
+        ReadSnapshot(path, label, [&] (IInputStream* in) {
+            reloadedLearnProgress.Load(in);
+        });
+        UNIT_ASSERT_EQUAL(reloadedLearnProgress.TestApprox, testApprox);
+        UNIT_ASSERT_VALUES_EQUAL(reloadedLearnProgress.ModelShrinkHistory, modelShrinkHistory);
+        UNIT_ASSERT_VALUES_EQUAL(reloadedLearnProgress.SeparateInitModelCheckSum, separateInitModelCheckSum);
+
+        NFs::Remove(path);
+    }
+}
@@ -37,15 +37,15 @@ static TPairwiseStats CalcPairwiseStats(
         leafIndices,
         [&](ui32 docId) { return bucketIndices[docId]; },
         NCB::TIndexRange<int>(docCount));
-    const auto flatPairs = UnpackPairsFromQueries(queriesInfo);
-    const int pairCount = flatPairs.ysize();
-    pairwiseStats.PairWeightStatistics = ComputePairWeightStatistics(
-        flatPairs,
+    const auto compactPairs = UnpackCompactPairsFromQueries(queriesInfo);
+    ComputePairWeightStatistics(
+        compactPairs,
         leafCount,
         bucketCount,
         leafIndices,
         [&](ui32 docId) { return bucketIndices[docId]; },
-        NCB::TIndexRange<int>(pairCount));
+        NCB::TIndexRange<int>((int)compactPairs.GetWinnerCount()),
+        &pairwiseStats.PairWeightStatistics);
     pairwiseStats.SplitEnsembleSpec = TSplitEnsembleSpec::OneSplit(ESplitType::FloatFeature);
 
     return pairwiseStats;
@@ -192,4 +192,81 @@ Y_UNIT_TEST_SUITE(PairwiseScoringTest) {
         UNIT_ASSERT_DOUBLES_EQUAL(scores1[1], scores2[1], 1e-6);
         UNIT_ASSERT_DOUBLES_EQUAL(scores1[2], scores2[2], 1e-6);
     }
+
+    Y_UNIT_TEST(PairwiseStatsSeveralPairBlocks) {
+        const int docCount = 200;
+        const int leafCount = 4;
+        const int bucketCount = 5;
+        TVector<TIndexType> leafIndices(docCount);
+        TVector<ui8> bucketIndices(docCount);
+        TVector<TQueryInfo> queriesInfo = {{0, (ui32)docCount / 2}, {(ui32)docCount / 2, (ui32)docCount}};
+        for (auto& queryInfo : queriesInfo) {
+            queryInfo.Competitors.resize(queryInfo.GetSize());
+            for (int docId = 0; docId < queryInfo.GetSize(); ++docId) {
+                for (int loserId = (docId * 7) % 3; loserId < queryInfo.GetSize(); loserId += 1 + docId % 5) {
+                    queryInfo.Competitors[docId].push_back({loserId, 0.5f + (docId + loserId) % 3});
+                }
+            }
+        }
+        for (int docId = 0; docId < docCount; ++docId) {
+            leafIndices[docId] = (docId * 13) % leafCount;
+            bucketIndices[docId] = (docId * 7) % bucketCount;
+        }
+        const auto getBucket = [&](ui32 docId) { return bucketIndices[docId]; };
+
+        const auto compactPairs = UnpackCompactPairsFromQueries(queriesInfo);
+        UNIT_ASSERT(compactPairs.GetPairCount() > 4 * PAIRS_BLOCK_SIZE);
+
+        TPairWeightStatistics expected;
+        expected.Resize(leafCount, bucketCount);
+        for (const auto& pair : UnpackPairsFromQueries(queriesInfo)) {
+            const ui32 winnerBucketId = bucketIndices[pair.WinnerId];
+            const ui32 loserBucketId = bucketIndices[pair.LoserId];
+            const TIndexType winnerLeafId = leafIndices[pair.WinnerId];
+            const TIndexType loserLeafId = leafIndices[pair.LoserId];
+            if (winnerBucketId > loserBucketId) {
+                expected(loserLeafId, winnerLeafId)[loserBucketId].SmallerBorderWeightSum -= pair.Weight;
+                expected(loserLeafId, winnerLeafId)[winnerBucketId].GreaterBorderRightWeightSum -= pair.Weight;
+            } else {
+                expected(winnerLeafId, loserLeafId)[winnerBucketId].SmallerBorderWeightSum -= pair.Weight;
+                expected(winnerLeafId, loserLeafId)[loserBucketId].GreaterBorderRightWeightSum -= pair.Weight;
+            }
+        }
+
+        const ui64 pairCount = compactPairs.GetPairCount();
+        const ui64 partCount = 3;
+        TPairWeightStatistics actual;
+        actual.Resize(leafCount, bucketCount);
+        TPairWeightStatistics partStats;
+        for (ui64 partIdx : xrange(partCount)) {
+            const auto winnerIndexRange = GetWinnerIndexRange(
+                compactPairs,
+                pairCount * partIdx / partCount,
+                pairCount * (partIdx + 1) / partCount);
+            ComputePairWeightStatistics(
+                compactPairs,
+                leafCount,
+                bucketCount,
+                leafIndices,
+                getBucket,
+                winnerIndexRange,
+                &partStats);
+            actual.Add(partStats);
+        }
+
+        for (int leafId1 : xrange(leafCount)) {
+            for (int leafId2 : xrange(leafCount)) {
+                for (int bucketId : xrange(bucketCount)) {
+                    UNIT_ASSERT_DOUBLES_EQUAL(
+                        expected(leafId1, leafId2)[bucketId].SmallerBorderWeightSum,
+                        actual(leafId1, leafId2)[bucketId].SmallerBorderWeightSum,
+                        1e-6);
+                    UNIT_ASSERT_DOUBLES_EQUAL(
+                        expected(leafId1, leafId2)[bucketId].GreaterBorderRightWeightSum,
+                        actual(leafId1, leafId2)[bucketId].GreaterBorderRightWeightSum,
+                        1e-6);
+                }
+            }
+        }
+    }
 }
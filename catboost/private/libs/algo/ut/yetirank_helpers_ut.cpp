@@ -0,0 +1,133 @@
+#include <catboost/private/libs/algo/yetirank_helpers.h>
+#include <catboost/private/libs/data_types/pair.h>
+#include <catboost/private/libs/data_types/query.h>
+#include <catboost/private/libs/options/loss_description.h>
+
+#include <library/threading/local_executor/local_executor.h>
+#include <library/unittest/registar.h>
+
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+#include <cmath>
+
+static TVector<TQueryInfo> MakeQueriesInfo(const TVector<ui32>& querySizes, float queryWeight) {
+    TVector<TQueryInfo> queriesInfo;
+    ui32 begin = 0;
+    for (ui32 querySize : querySizes) {
+        queriesInfo.emplace_back(begin, begin + querySize);
+        queriesInfo.back().Weight = queryWeight;
+        begin += querySize;
+    }
+    return queriesInfo;
+}
+
+static void UpdatePairs(
+    TConstArrayRef<double> expApproxes,
+    TConstArrayRef<float> relevances,
+    TStringBuf lossDescription,
+    int threadCount,
+    TVector<TQueryInfo>* queriesInfo) {
+
+    NPar::TLocalExecutor localExecutor;
+    localExecutor.RunAdditionalThreads(threadCount - 1);
+    UpdatePairsForYetiRank(
+        expApproxes,
+        relevances,
+        NCatboostOptions::ParseLossDescription(lossDescription),
+        /*randomSeed*/ 0,
+        /*queryBegin*/ 0,
+        queriesInfo->ysize(),
+        queriesInfo,
+        &localExecutor
+    );
+}
+
+static void CheckCompetitors(
+    const TVector<TVector<TCompetitor>>& competitors,
+    const TVector<TVector<std::pair<ui32, double>>>& expectedCompetitors) {
+
+    UNIT_ASSERT_VALUES_EQUAL(competitors.size(), expectedCompetitors.size());
+    for (auto winnerIdx : xrange(competitors.size())) {
+        UNIT_ASSERT_VALUES_EQUAL(competitors[winnerIdx].size(), expectedCompetitors[winnerIdx].size());
+        for (auto i : xrange(competitors[winnerIdx].size())) {
+            UNIT_ASSERT_VALUES_EQUAL(competitors[winnerIdx][i].Id, expectedCompetitors[winnerIdx][i].first);
+            UNIT_ASSERT_DOUBLES_EQUAL(competitors[winnerIdx][i].Weight, expectedCompetitors[winnerIdx][i].second, 1e-6);
+            UNIT_ASSERT_EQUAL(competitors[winnerIdx][i].SampleWeight, competitors[winnerIdx][i].Weight);
+        }
+    }
+}
+
+Y_UNIT_TEST_SUITE(YetiRankHelpersTest) {
+    /* Approxes differ by far more than the bootstrap noise can change them,
+     * so documents of a query are in the same order in every permutation: 0, 1, ..., 5.
+     * Pairs are made of neighbours in this order, their weights are 0.15 * decay^position * |relevance diff|.
+     */
+    static const TVector<double> OrderedExpApproxes = {1e100, 1e80, 1e60, 1e40, 1e20, 1.0};
+    static const TVector<float> Relevances = {1.0f, 3.0f, 2.0f, 2.0f, 0.0f, 4.0f};
+    static constexpr float QueryWeight = 2.0f;
+
+    Y_UNIT_TEST(AllPositions) {
+        auto queriesInfo = MakeQueriesInfo({6}, QueryWeight);
+        UpdatePairs(OrderedExpApproxes, Relevances, "YetiRank:decay=0.5;permutations=3", 1, &queriesInfo);
+
+        // top size is 25 for decay 0.5, so pairs for all positions are generated
+        // position 2 has documents with equal relevances, so there's no pair for it
+        const double scale = 0.15 * QueryWeight;
+        CheckCompetitors(
+            queriesInfo[0].Competitors,
+            {
+                {},
+                {{0, scale * 1.0 * 2}, {2, scale * 0.5 * 1}},
+                {},
+                {{4, scale * 0.125 * 2}},
+                {},
+                {{4, scale * 0.0625 * 4}}
+            }
+        );
+    }
+
+    Y_UNIT_TEST(TopPositions) {
+        auto queriesInfo = MakeQueriesInfo({6}, QueryWeight);
+        UpdatePairs(OrderedExpApproxes, Relevances, "YetiRank:decay=0.001;permutations=3", 1, &queriesInfo);
+
+        // decay^3 is below the threshold of 1e-7, so only 4 top documents are ordered and paired
+        const double scale = 0.15 * QueryWeight;
+        CheckCompetitors(
+            queriesInfo[0].Competitors,
+            {
+                {},
+                {{0, scale * 1.0 * 2}, {2, scale * 0.001 * 1}},
+                {},
+                {},
+                {},
+                {}
+            }
+        );
+    }
+
+    Y_UNIT_TEST(Deterministic) {
+        const TVector<ui32> querySizes = {1, 7, 300, 2, 15, 40, 3, 1000, 9, 64, 5, 120};
+        const auto srcQueriesInfo = MakeQueriesInfo(querySizes, 1.0f);
+        const ui32 objectCount = srcQueriesInfo.back().End;
+
+        TFastRng64 rand(0);
+        TVector<double> expApproxes(objectCount);
+        TVector<float> relevances(objectCount);
+        for (auto i : xrange(objectCount)) {
+            expApproxes[i] = std::exp(rand.GenRandReal1() * 4.0 - 2.0);
+            relevances[i] = rand.Uniform(5);
+        }
+
+        for (TStringBuf lossDescription : {"YetiRank:decay=0.99", "YetiRank:decay=0.01"}) {
+            auto referenceQueriesInfo = srcQueriesInfo;
+            UpdatePairs(expApproxes, relevances, lossDescription, 1, &referenceQueriesInfo);
+            for (int threadCount : {1, 4}) {
+                auto queriesInfo = srcQueriesInfo;
+                UpdatePairs(expApproxes, relevances, lossDescription, threadCount, &queriesInfo);
+                // same competitors in the same order with the same weights
+                UNIT_ASSERT_EQUAL(queriesInfo, referenceQueriesInfo);
+            }
+        }
+    }
+}
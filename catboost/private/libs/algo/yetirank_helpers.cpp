@@ -2,14 +2,49 @@
 
 #include "approx_updater_helpers.h"
 
+#include <catboost/private/libs/algo_helpers/query_blocks.h>
 #include <catboost/private/libs/data_types/pair.h>
 #include <catboost/private/libs/options/catboost_options.h>
 #include <catboost/private/libs/options/loss_description.h>
 
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/vector.h>
+#include <util/generic/xrange.h>
 
+#include <tuple>
+
+
+// pair weights decay geometrically with position in a noisy permutation,
+//  pairs beyond the position where decay drops below this threshold are negligible
+static constexpr double YETI_RANK_MIN_DECAY = 1e-7;
+
+namespace {
+    struct TYetiRankPair {
+        ui32 Winner;
+        ui32 Loser;
+        float Weight;
+    };
+
+    // per-thread buffers reused for all queries processed by the thread
+    struct TYetiRankScratch {
+        TVector<int> Indices;
+        TVector<double> BootstrappedApprox;
+        TVector<TYetiRankPair> Pairs;
+    };
+}
+
+static ui32 GetYetiRankTopSize(ui32 querySize, double decaySpeed) {
+    if (querySize <= 1 || decaySpeed >= 1.0) {
+        return querySize;
+    }
+    if (decaySpeed <= 0.0) {
+        return Min<ui32>(querySize, 2);
+    }
+    const double topSize = 1.0 + ceil(log(YETI_RANK_MIN_DECAY) / log(decaySpeed));
+    return topSize < querySize ? static_cast<ui32>(topSize) : querySize;
+}
 
 static void GenerateYetiRankPairsForQuery(
     const float* relevs,
@@ -19,6 +54,7 @@ static void GenerateYetiRankPairsForQuery(
     int permutationCount,
     double decaySpeed,
     ui64 randomSeed,
+    TYetiRankScratch* scratch,
     TVector<TVector<TCompetitor>>* competitors
 ) {
     TFastRng64 rand(randomSeed);
@@ -26,26 +62,34 @@ static void GenerateYetiRankPairsForQuery(
     competitorsRef.clear();
     competitorsRef.resize(querySize);
 
-    TVector<int> indices(querySize);
-    TVector<TVector<float>> competitorsWeights(querySize, TVector<float>(querySize));
+    const ui32 topSize = GetYetiRankTopSize(querySize, decaySpeed);
+    TVector<int>& indices = scratch->Indices;
+    indices.yresize(querySize);
+    TVector<double>& bootstrappedApprox = scratch->BootstrappedApprox;
+    bootstrappedApprox.yresize(querySize);
+    TVector<TYetiRankPair>& pairs = scratch->Pairs;
+    pairs.clear();
+    pairs.reserve(permutationCount * (topSize > 0 ? topSize - 1 : 0));
+
     for (int permutationIndex = 0; permutationIndex < permutationCount; ++permutationIndex) {
         std::iota(indices.begin(), indices.end(), 0);
-        TVector<double> bootstrappedApprox(expApproxes, expApproxes + querySize);
         for (ui32 docId = 0; docId < querySize; ++docId) {
             const float uniformValue = rand.GenRandReal1();
             // TODO(nikitxskv): try to experiment with different bootstraps.
-            bootstrappedApprox[docId] *= uniformValue / (1.000001f - uniformValue);
+            bootstrappedApprox[docId] = expApproxes[docId] * (uniformValue / (1.000001f - uniformValue));
         }
 
-        Sort(
-            indices,
-            [&](int i, int j) {
-                return bootstrappedApprox[i] > bootstrappedApprox[j];
-            }
-        );
+        const auto isBetter = [&](int i, int j) {
+            return bootstrappedApprox[i] > bootstrappedApprox[j];
+        };
+        if (topSize == querySize) {
+            Sort(indices, isBetter);
+        } else {
+            std::partial_sort(indices.begin(), indices.begin() + topSize, indices.end(), isBetter);
+        }
 
         double decayCoefficient = 1;
-        for (ui32 docId = 1; docId < querySize; ++docId) {
+        for (ui32 docId = 1; docId < topSize; ++docId) {
             const int firstCandidate = indices[docId - 1];
             const int secondCandidate = indices[docId];
             const double magicConst = 0.15; // Like in GPU
@@ -53,23 +97,35 @@ static void GenerateYetiRankPairsForQuery(
             const float pairWeight = magicConst * decayCoefficient
                 * Abs(relevs[firstCandidate] - relevs[secondCandidate]);
             if (relevs[firstCandidate] > relevs[secondCandidate]) {
-                competitorsWeights[firstCandidate][secondCandidate] += pairWeight;
+                pairs.push_back({static_cast<ui32>(firstCandidate), static_cast<ui32>(secondCandidate), pairWeight});
             } else if (relevs[firstCandidate] < relevs[secondCandidate]) {
-                competitorsWeights[secondCandidate][firstCandidate] += pairWeight;
+                pairs.push_back({static_cast<ui32>(secondCandidate), static_cast<ui32>(firstCandidate), pairWeight});
             }
             decayCoefficient *= decaySpeed;
         }
     }
 
-    // TODO(nikitxskv): Can be optimized
-    for (ui32 winnerIndex = 0; winnerIndex < querySize; ++winnerIndex) {
-        for (ui32 loserIndex = 0; loserIndex < querySize; ++loserIndex) {
-            const float competitorsWeight
-                = queryWeight * competitorsWeights[winnerIndex][loserIndex] / permutationCount;
-            if (competitorsWeight != 0) {
-                competitorsRef[winnerIndex].push_back({loserIndex, competitorsWeight});
-            }
+    // stable sort keeps permutation order of weights for each pair, so the sums are accumulated
+    //  in the same order as with dense per-query weights matrix
+    StableSort(
+        pairs,
+        [](const TYetiRankPair& lhs, const TYetiRankPair& rhs) {
+            return std::tie(lhs.Winner, lhs.Loser) < std::tie(rhs.Winner, rhs.Loser);
         }
+    );
+    for (size_t pairBegin = 0; pairBegin < pairs.size();) {
+        const ui32 winnerIndex = pairs[pairBegin].Winner;
+        const ui32 loserIndex = pairs[pairBegin].Loser;
+        float pairWeightSum = 0;
+        size_t pairEnd = pairBegin;
+        for (; pairEnd < pairs.size() && pairs[pairEnd].Winner == winnerIndex && pairs[pairEnd].Loser == loserIndex; ++pairEnd) {
+            pairWeightSum += pairs[pairEnd].Weight;
+        }
+        const float competitorsWeight = queryWeight * pairWeightSum / permutationCount;
+        if (competitorsWeight != 0) {
+            competitorsRef[winnerIndex].push_back({loserIndex, competitorsWeight});
+        }
+        pairBegin = pairEnd;
     }
 }
 
@@ -86,20 +142,47 @@ void UpdatePairsForYetiRank(
     const int permutationCount = NCatboostOptions::GetYetiRankPermutations(lossDescription);
     const double decaySpeed = NCatboostOptions::GetYetiRankDecay(lossDescription);
 
-    NPar::TLocalExecutor::TExecRangeParams blockParams(queryBegin, queryEnd);
-    blockParams.SetBlockCount(CB_THREAD_LIMIT);
-    const int blockSize = blockParams.GetBlockSize();
-    const ui32 blockCount = blockParams.GetBlockCount();
-    const TVector<ui64> randomSeeds = GenRandUI64Vector(blockCount, randomSeed);
+    // seeds of queries depend on fixed blocks only, so that generated pairs do not depend on thread count
+    NPar::TLocalExecutor::TExecRangeParams seedBlockParams(queryBegin, queryEnd);
+    seedBlockParams.SetBlockCount(CB_THREAD_LIMIT);
+    const int seedBlockSize = seedBlockParams.GetBlockSize();
+    const ui32 seedBlockCount = seedBlockParams.GetBlockCount();
+    const TVector<ui64> randomSeeds = GenRandUI64Vector(seedBlockCount, randomSeed);
+    TVector<ui64> querySeeds;
+    querySeeds.yresize(queryEnd - queryBegin);
     NPar::ParallelFor(
         *localExecutor,
         0,
-        blockCount,
+        seedBlockCount,
         [&](int blockId) {
             TFastRng64 rand(randomSeeds[blockId]);
-            const int from = queryBegin + blockId * blockSize;
-            const int to = Min<int>(queryBegin + (blockId + 1) * blockSize, queryEnd);
+            const int from = queryBegin + blockId * seedBlockSize;
+            const int to = Min<int>(queryBegin + (blockId + 1) * seedBlockSize, queryEnd);
             for (int queryIndex = from; queryIndex < to; ++queryIndex) {
+                querySeeds[queryIndex - queryBegin] = rand.GenRand();
+            }
+        }
+    );
+
+    const TQueryBlocks queryBlocks = SplitQueriesByCost(
+        *queriesInfo,
+        queryBegin,
+        queryEnd,
+        /*addCompetitorsCount*/ false,
+        GetQueryBlockCount(*localExecutor));
+    // giant queries go first so that small blocks fill the gaps at the end
+    TVector<NCB::TIndexRange<int>> tasks;
+    tasks.reserve(queryBlocks.GiantQueries.size() + queryBlocks.SmallQueryBlocks.size());
+    for (int queryIndex : queryBlocks.GiantQueries) {
+        tasks.emplace_back(queryIndex, queryIndex + 1);
+    }
+    tasks.insert(tasks.end(), queryBlocks.SmallQueryBlocks.begin(), queryBlocks.SmallQueryBlocks.end());
+
+    TVector<TYetiRankScratch> threadScratches(localExecutor->GetThreadCount() + 1);
+    localExecutor->ExecRangeWithThrow(
+        [&](int taskId) {
+            TYetiRankScratch& scratch = threadScratches[localExecutor->GetWorkerThreadId()];
+            for (int queryIndex : tasks[taskId].Iter()) {
                 TQueryInfo& queryInfoRef = (*queriesInfo)[queryIndex];
                 GenerateYetiRankPairsForQuery(
                     relevances.data() + queryInfoRef.Begin,
@@ -108,11 +191,15 @@ void UpdatePairsForYetiRank(
                     queryInfoRef.End - queryInfoRef.Begin,
                     permutationCount,
                     decaySpeed,
-                    rand.GenRand(),
+                    querySeeds[queryIndex - queryBegin],
+                    &scratch,
                     &queryInfoRef.Competitors
                 );
             }
-        }
+        },
+        0,
+        tasks.ysize(),
+        NPar::TLocalExecutor::WAIT_COMPLETE
     );
 }
 
@@ -126,7 +213,19 @@ void YetiRankRecalculation(
     TVector<float>* recalculatedPairwiseWeights
 ) {
     Y_ASSERT(ff.LearnTarget.size() == 1);
-    *recalculatedQueriesInfo = ff.LearnQueriesInfo;
+    // competitors of the first TailQueryFinish queries are regenerated, so only their bounds are copied
+    recalculatedQueriesInfo->resize(ff.LearnQueriesInfo.size());
+    for (auto queryIndex : xrange(ff.LearnQueriesInfo.size())) {
+        const TQueryInfo& srcQueryInfo = ff.LearnQueriesInfo[queryIndex];
+        TQueryInfo& dstQueryInfo = (*recalculatedQueriesInfo)[queryIndex];
+        dstQueryInfo.Begin = srcQueryInfo.Begin;
+        dstQueryInfo.End = srcQueryInfo.End;
+        dstQueryInfo.Weight = srcQueryInfo.Weight;
+        dstQueryInfo.SubgroupId = srcQueryInfo.SubgroupId;
+        if (queryIndex >= static_cast<size_t>(bt.TailQueryFinish)) {
+            dstQueryInfo.Competitors = srcQueryInfo.Competitors;
+        }
+    }
     UpdatePairsForYetiRank(
         bt.Approx[0],
         ff.LearnTarget[0],
@@ -1,6 +1,9 @@
 #include "approx_calcer_multi_helpers.h"
 
 #include <catboost/libs/helpers/dispatch_generic_lambda.h>
+#include <catboost/private/libs/index_range/index_range.h>
+
+#include <library/threading/local_executor/local_executor.h>
 
 inline void AddDersRangeMulti(
     TConstArrayRef<TIndexType> leafIndices,
@@ -116,25 +119,43 @@ void CalcLeafDersMulti(
     );
 }
 
+static constexpr i64 MIN_NEWTON_MULTI_LEAF_BLOCK_COST = 1 << 15;
+
 void CalcLeafDeltasMulti(
     const TVector<TSumMulti>& leafDers,
     ELeavesEstimation estimationMethod,
     float l2Regularizer,
     double sumAllWeights,
     int docCount,
+    NPar::TLocalExecutor* localExecutor,
     TVector<TVector<double>>* curLeafValues
 ) {
     const int leafCount = leafDers.ysize();
-    TVector<double> curDelta;
     if (estimationMethod == ELeavesEstimation::Newton) {
-        for (int leaf = 0; leaf < leafCount; ++leaf) {
-            CalcDeltaNewtonMulti(leafDers[leaf], l2Regularizer, sumAllWeights, docCount, &curDelta);
-            for (int dim = 0; dim < curDelta.ysize(); ++dim) {
-                (*curLeafValues)[dim][leaf] = curDelta[dim];
-            }
+        if (leafCount == 0) {
+            return;
         }
+        // per-leaf systems are small, so they are solved in batches of leaves
+        const i64 approxDimension = leafDers[0].SumDer.ysize();
+        const i64 leafCost = Max<i64>(approxDimension * approxDimension * approxDimension, 1);
+        const int leafBlockSize = Max<i64>(MIN_NEWTON_MULTI_LEAF_BLOCK_COST / leafCost, 1);
+        const NCB::TSimpleIndexRangesGenerator<int> leafBlocks(NCB::TIndexRange<int>(leafCount), leafBlockSize);
+        localExecutor->ExecRangeWithThrow(
+            [&] (int blockIdx) {
+                TVector<double> curDelta;
+                for (int leaf : leafBlocks.GetRange(blockIdx).Iter()) {
+                    CalcDeltaNewtonMulti(leafDers[leaf], l2Regularizer, sumAllWeights, docCount, &curDelta);
+                    for (int dim = 0; dim < curDelta.ysize(); ++dim) {
+                        (*curLeafValues)[dim][leaf] = curDelta[dim];
+                    }
+                }
+            },
+            0,
+            leafBlocks.RangesCount(),
+            NPar::TLocalExecutor::WAIT_COMPLETE);
     } else {
         Y_ASSERT(estimationMethod == ELeavesEstimation::Gradient);
+        TVector<double> curDelta;
         for (int leaf = 0; leaf < leafCount; ++leaf) {
             CalcDeltaGradientMulti(leafDers[leaf], l2Regularizer, sumAllWeights, docCount, &curDelta);
             for (int dim = 0; dim < curDelta.ysize(); ++dim) {
@@ -150,6 +171,7 @@ void CalcLeafDeltasMulti(
     float l2Regularizer,
     double sumAllWeights,
     int docCount,
+    NPar::TLocalExecutor* /*localExecutor*/,
     TVector<double>* curLeafValues
 ) {
     Y_ASSERT(leafDer.ysize() == 1);
@@ -55,6 +55,7 @@ void CalcLeafDeltasMulti(
     float l2Regularizer,
     double sumAllWeights,
     int docCount,
+    NPar::TLocalExecutor* localExecutor,
     TVector<TVector<double>>* curLeafValues
 );
 
@@ -64,5 +65,6 @@ void CalcLeafDeltasMulti(
     float l2Regularizer,
     double sumAllWeights,
     int docCount,
+    NPar::TLocalExecutor* localExecutor,
     TVector<double>* curLeafValues
 );
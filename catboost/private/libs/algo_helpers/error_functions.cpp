@@ -1,4 +1,7 @@
 #include "error_functions.h"
+#include "query_blocks.h"
+
+#include <catboost/libs/helpers/map_merge.h>
 
 #include <util/generic/xrange.h>
 
@@ -498,56 +501,384 @@ void TCrossEntropyError::CalcDersRange(
     }
 }
 
-void TQuerySoftMaxError::CalcDersForSingleQuery(
+void TPairLogitError::AddPairDers(
+    const TQueryInfo& queryInfo,
+    int winnerBegin,
+    int winnerEnd,
+    TConstArrayRef<double> expApproxes,
+    TArrayRef<TDers> queryDers
+) const {
+    const int begin = queryInfo.Begin;
+    for (int docId = winnerBegin; docId < winnerEnd; ++docId) {
+        double winnerDer = 0.0;
+        double winnerSecondDer = 0.0;
+        for (const auto& competitor : queryInfo.Competitors[docId - begin]) {
+            const double p = expApproxes[competitor.Id + begin] /
+                (expApproxes[competitor.Id + begin] + expApproxes[docId]);
+            winnerDer += competitor.Weight * p;
+            queryDers[competitor.Id].Der1 -= competitor.Weight * p;
+            winnerSecondDer += competitor.Weight * p * (p - 1);
+            queryDers[competitor.Id].Der2 += competitor.Weight * p * (p - 1);
+        }
+        queryDers[docId - begin].Der1 += winnerDer;
+        queryDers[docId - begin].Der2 += winnerSecondDer;
+    }
+}
+
+void TPairLogitError::CalcDersForQueries(
+    int queryStartIndex,
+    int queryEndIndex,
+    const TVector<double>& expApproxes,
+    const TVector<float>& /*targets*/,
+    const TVector<float>& /*weights*/,
+    const TVector<TQueryInfo>& queriesInfo,
+    TArrayRef<TDers> ders,
+    ui64 /*randomSeed*/,
+    NPar::TLocalExecutor* localExecutor
+) const {
+    CB_ENSURE(queryStartIndex < queryEndIndex);
+    const int start = queriesInfo[queryStartIndex].Begin;
+    const TQueryBlocks queryBlocks = SplitQueriesByCost(
+        queriesInfo,
+        queryStartIndex,
+        queryEndIndex,
+        /*addCompetitorsCount*/ true,
+        GetQueryBlockCount(*localExecutor));
+    localExecutor->ExecRangeWithThrow(
+        [&] (int blockId) {
+            for (int queryIndex : queryBlocks.SmallQueryBlocks[blockId].Iter()) {
+                const auto& queryInfo = queriesInfo[queryIndex];
+                TDers* dersData = ders.data() + queryInfo.Begin - start;
+                Fill(dersData, dersData + queryInfo.GetSize(), TDers{/*1st*/0.0, /*2nd*/0.0, /*3rd*/0.0});
+                AddPairDers(
+                    queryInfo,
+                    queryInfo.Begin,
+                    queryInfo.End,
+                    expApproxes,
+                    MakeArrayRef(dersData, queryInfo.GetSize()));
+            }
+        },
+        0,
+        queryBlocks.SmallQueryBlocks.ysize(),
+        NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    // losers of a giant query are scattered over the whole query, so each part of winners
+    //  accumulates ders in its own buffer, buffers are reused for all giant queries
+    TVector<TVector<TDers>> partDers;
+    for (int queryIndex : queryBlocks.GiantQueries) {
+        const auto& queryInfo = queriesInfo[queryIndex];
+        const int querySize = queryInfo.GetSize();
+        const auto partsGenerator = GetGiantQueryPartsGenerator(queryInfo, *localExecutor);
+        const int partCount = partsGenerator.RangesCount();
+        if (partDers.ysize() < partCount) {
+            partDers.resize(partCount);
+        }
+        localExecutor->ExecRangeWithThrow(
+            [&] (int partId) {
+                auto& queryDers = partDers[partId];
+                queryDers.yresize(querySize);
+                Fill(queryDers.begin(), queryDers.end(), TDers{/*1st*/0.0, /*2nd*/0.0, /*3rd*/0.0});
+                const auto winnersRange = partsGenerator.GetRange(partId);
+                AddPairDers(queryInfo, winnersRange.Begin, winnersRange.End, expApproxes, queryDers);
+            },
+            0,
+            partCount,
+            NPar::TLocalExecutor::WAIT_COMPLETE);
+        TDers* dersData = ders.data() + queryInfo.Begin - start;
+        NPar::ParallelFor(
+            *localExecutor,
+            0,
+            querySize,
+            [&] (ui32 docId) {
+                TDers docDers{/*1st*/0.0, /*2nd*/0.0, /*3rd*/0.0};
+                for (int partId : xrange(partCount)) {
+                    docDers.Der1 += partDers[partId][docId].Der1;
+                    docDers.Der2 += partDers[partId][docId].Der2;
+                }
+                dersData[docId] = docDers;
+            });
+    }
+}
+
+std::pair<double, double> TQueryRmseError::CalcQuerySums(
+    int begin,
+    int end,
+    const TVector<double>& approxes,
+    const TVector<float>& targets,
+    const TVector<float>& weights
+) const {
+    double querySum = 0;
+    double queryCount = 0;
+    for (int docId = begin; docId < end; ++docId) {
+        double w = weights.empty() ? 1 : weights[docId];
+        querySum += (targets[docId] - approxes[docId]) * w;
+        queryCount += w;
+    }
+    return {querySum, queryCount};
+}
+
+static double CalcQueryAvrg(double querySum, double queryCount) {
+    double queryAvrg = 0;
+    if (queryCount > 0) {
+        queryAvrg = querySum / queryCount;
+    }
+    return queryAvrg;
+}
+
+void TQueryRmseError::CalcDersRange(
     int start,
-    int offset,
-    int count,
+    int begin,
+    int end,
+    double queryAvrg,
+    const TVector<double>& approxes,
+    const TVector<float>& targets,
+    const TVector<float>& weights,
+    TArrayRef<TDers> ders
+) const {
+    for (int docId = begin; docId < end; ++docId) {
+        ders[docId - start].Der1 = targets[docId] - approxes[docId] - queryAvrg;
+        ders[docId - start].Der2 = -1;
+        if (!weights.empty()) {
+            ders[docId - start].Der1 *= weights[docId];
+            ders[docId - start].Der2 *= weights[docId];
+        }
+    }
+}
+
+void TQueryRmseError::CalcDersForQueries(
+    int queryStartIndex,
+    int queryEndIndex,
+    const TVector<double>& approxes,
+    const TVector<float>& targets,
+    const TVector<float>& weights,
+    const TVector<TQueryInfo>& queriesInfo,
+    TArrayRef<TDers> ders,
+    ui64 /*randomSeed*/,
+    NPar::TLocalExecutor* localExecutor
+) const {
+    const int start = queriesInfo[queryStartIndex].Begin;
+    const TQueryBlocks queryBlocks = SplitQueriesByCost(
+        queriesInfo,
+        queryStartIndex,
+        queryEndIndex,
+        /*addCompetitorsCount*/ false,
+        GetQueryBlockCount(*localExecutor));
+    localExecutor->ExecRangeWithThrow(
+        [&] (int blockId) {
+            for (int queryIndex : queryBlocks.SmallQueryBlocks[blockId].Iter()) {
+                const int begin = queriesInfo[queryIndex].Begin;
+                const int end = queriesInfo[queryIndex].End;
+                const auto [querySum, queryCount] = CalcQuerySums(begin, end, approxes, targets, weights);
+                const double queryAvrg = CalcQueryAvrg(querySum, queryCount);
+                CalcDersRange(start, begin, end, queryAvrg, approxes, targets, weights, ders);
+            }
+        },
+        0,
+        queryBlocks.SmallQueryBlocks.ysize(),
+        NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    for (int queryIndex : queryBlocks.GiantQueries) {
+        const auto partsGenerator = GetGiantQueryPartsGenerator(queriesInfo[queryIndex], *localExecutor);
+        std::pair<double, double> querySums;
+        NCB::MapMerge(
+            localExecutor,
+            partsGenerator,
+            /*mapFunc*/ [&] (NCB::TIndexRange<int> partRange, std::pair<double, double>* partSums) {
+                *partSums = CalcQuerySums(partRange.Begin, partRange.End, approxes, targets, weights);
+            },
+            /*mergeFunc*/ [] (std::pair<double, double>* sums, TVector<std::pair<double, double>>&& addVector) {
+                for (const auto& partSums : addVector) {
+                    sums->first += partSums.first;
+                    sums->second += partSums.second;
+                }
+            },
+            &querySums);
+        const double queryAvrg = CalcQueryAvrg(querySums.first, querySums.second);
+        localExecutor->ExecRangeWithThrow(
+            [&] (int partId) {
+                const auto partRange = partsGenerator.GetRange(partId);
+                CalcDersRange(start, partRange.Begin, partRange.End, queryAvrg, approxes, targets, weights, ders);
+            },
+            0,
+            partsGenerator.RangesCount(),
+            NPar::TLocalExecutor::WAIT_COMPLETE);
+    }
+}
+
+void TQuerySoftMaxError::UpdateMaxApproxAndTargetSum(
+    int begin,
+    int end,
     TConstArrayRef<double> approxes,
     TConstArrayRef<float> targets,
     TConstArrayRef<float> weights,
-    TArrayRef<TDers> ders
+    TSoftMaxNormalizers* normalizers
 ) const {
-    double maxApprox = -std::numeric_limits<double>::max();
-    float sumWeightedTargets = 0;
-    for (int dim = offset; dim < offset + count; ++dim) {
-        const float weight = weights.empty() ? 1.0f : weights[start + dim];
+    for (int docId = begin; docId < end; ++docId) {
+        const float weight = weights.empty() ? 1.0f : weights[docId];
         if (weight > 0) {
-            maxApprox = std::max(maxApprox, approxes[start + dim]);
-            if (targets[start + dim] > 0) {
-                sumWeightedTargets += weight * targets[start + dim];
+            normalizers->MaxApprox = std::max(normalizers->MaxApprox, approxes[docId]);
+            if (targets[docId] > 0) {
+                normalizers->SumWeightedTargets += weight * targets[docId];
             }
         }
     }
-    if (sumWeightedTargets > 0) {
-        TExpForwardView</*Capacity*/16> expApproxes(MakeArrayRef(approxes.data(), offset + count), -maxApprox);
-        double sumExpApprox = 0;
-        for (int dim = offset; dim < offset + count; ++dim) {
-            const float weight = weights.empty() ? 1.0f : weights[start + dim];
-            if (weight > 0) {
-                const double expApprox = expApproxes[start + dim] * weight;
-                ders[dim].Der1 = expApprox;
-                sumExpApprox += expApprox;
-            }
+}
+
+double TQuerySoftMaxError::CalcExpApproxes(
+    int start,
+    int begin,
+    int end,
+    double maxApprox,
+    TConstArrayRef<double> approxes,
+    TConstArrayRef<float> weights,
+    TArrayRef<TDers> ders
+) const {
+    TExpForwardView</*Capacity*/16> expApproxes(MakeArrayRef(approxes.data() + begin, end - begin), -maxApprox);
+    double sumExpApprox = 0;
+    for (int docId = begin; docId < end; ++docId) {
+        const float weight = weights.empty() ? 1.0f : weights[docId];
+        if (weight > 0) {
+            const double expApprox = expApproxes[docId - begin] * weight;
+            ders[docId - start].Der1 = expApprox;
+            sumExpApprox += expApprox;
         }
-        for (int dim = offset; dim < offset + count; ++dim) {
-            const float weight = weights.empty() ? 1.0f : weights[start + dim];
-            if (weight > 0) {
-                const double p = ders[dim].Der1 / sumExpApprox;
-                ders[dim].Der2 = sumWeightedTargets * (p * (p - 1.0) - LambdaReg);
-                ders[dim].Der1 = -sumWeightedTargets * p;
-                if (targets[start + dim] > 0) {
-                    ders[dim].Der1 += weight * targets[start + dim];
-                }
-            } else {
-                ders[dim].Der2 = 0.0;
-                ders[dim].Der1 = 0.0;
+    }
+    return sumExpApprox;
+}
+
+void TQuerySoftMaxError::CalcDersRange(
+    int start,
+    int begin,
+    int end,
+    const TSoftMaxNormalizers& normalizers,
+    TConstArrayRef<float> targets,
+    TConstArrayRef<float> weights,
+    TArrayRef<TDers> ders
+) const {
+    const float sumWeightedTargets = normalizers.SumWeightedTargets;
+    for (int docId = begin; docId < end; ++docId) {
+        TDers& docDers = ders[docId - start];
+        const float weight = weights.empty() ? 1.0f : weights[docId];
+        if (sumWeightedTargets > 0 && weight > 0) {
+            const double p = docDers.Der1 / normalizers.SumExpApprox;
+            docDers.Der2 = sumWeightedTargets * (p * (p - 1.0) - LambdaReg);
+            docDers.Der1 = -sumWeightedTargets * p;
+            if (targets[docId] > 0) {
+                docDers.Der1 += weight * targets[docId];
             }
+        } else {
+            docDers.Der2 = 0.0;
+            docDers.Der1 = 0.0;
         }
-    } else {
-        for (int dim = offset; dim < offset + count; ++dim) {
-            ders[dim].Der2 = 0.0;
-            ders[dim].Der1 = 0.0;
-        }
+    }
+}
+
+void TQuerySoftMaxError::CalcDersForSingleQuery(
+    int start,
+    int begin,
+    int end,
+    TConstArrayRef<double> approxes,
+    TConstArrayRef<float> targets,
+    TConstArrayRef<float> weights,
+    TArrayRef<TDers> ders
+) const {
+    TSoftMaxNormalizers normalizers;
+    UpdateMaxApproxAndTargetSum(begin, end, approxes, targets, weights, &normalizers);
+    if (normalizers.SumWeightedTargets > 0) {
+        normalizers.SumExpApprox = CalcExpApproxes(start, begin, end, normalizers.MaxApprox, approxes, weights, ders);
+    }
+    CalcDersRange(start, begin, end, normalizers, targets, weights, ders);
+}
+
+void TQuerySoftMaxError::CalcDersForGiantQuery(
+    int start,
+    const TQueryInfo& queryInfo,
+    TConstArrayRef<double> approxes,
+    TConstArrayRef<float> targets,
+    TConstArrayRef<float> weights,
+    TArrayRef<TDers> ders,
+    NPar::TLocalExecutor* localExecutor
+) const {
+    const auto partsGenerator = GetGiantQueryPartsGenerator(queryInfo, *localExecutor);
+    const int partCount = partsGenerator.RangesCount();
+
+    TSoftMaxNormalizers normalizers;
+    NCB::MapMerge(
+        localExecutor,
+        partsGenerator,
+        /*mapFunc*/ [&] (NCB::TIndexRange<int> partRange, TSoftMaxNormalizers* partNormalizers) {
+            UpdateMaxApproxAndTargetSum(partRange.Begin, partRange.End, approxes, targets, weights, partNormalizers);
+        },
+        /*mergeFunc*/ [] (TSoftMaxNormalizers* normalizers, TVector<TSoftMaxNormalizers>&& addVector) {
+            for (const auto& partNormalizers : addVector) {
+                normalizers->MaxApprox = std::max(normalizers->MaxApprox, partNormalizers.MaxApprox);
+                normalizers->SumWeightedTargets += partNormalizers.SumWeightedTargets;
+            }
+        },
+        &normalizers);
+
+    if (normalizers.SumWeightedTargets > 0) {
+        TVector<double> partSumExpApprox(partCount, 0.0);
+        localExecutor->ExecRangeWithThrow(
+            [&] (int partId) {
+                const auto partRange = partsGenerator.GetRange(partId);
+                partSumExpApprox[partId] = CalcExpApproxes(
+                    start,
+                    partRange.Begin,
+                    partRange.End,
+                    normalizers.MaxApprox,
+                    approxes,
+                    weights,
+                    ders);
+            },
+            0,
+            partCount,
+            NPar::TLocalExecutor::WAIT_COMPLETE);
+        normalizers.SumExpApprox = Accumulate(partSumExpApprox, 0.0);
+    }
+
+    localExecutor->ExecRangeWithThrow(
+        [&] (int partId) {
+            const auto partRange = partsGenerator.GetRange(partId);
+            CalcDersRange(start, partRange.Begin, partRange.End, normalizers, targets, weights, ders);
+        },
+        0,
+        partCount,
+        NPar::TLocalExecutor::WAIT_COMPLETE);
+}
+
+void TQuerySoftMaxError::CalcDersForQueries(
+    int queryStartIndex,
+    int queryEndIndex,
+    const TVector<double>& approxes,
+    const TVector<float>& targets,
+    const TVector<float>& weights,
+    const TVector<TQueryInfo>& queriesInfo,
+    TArrayRef<TDers> ders,
+    ui64 /*randomSeed*/,
+    NPar::TLocalExecutor* localExecutor
+) const {
+    const int start = queriesInfo[queryStartIndex].Begin;
+    const TQueryBlocks queryBlocks = SplitQueriesByCost(
+        queriesInfo,
+        queryStartIndex,
+        queryEndIndex,
+        /*addCompetitorsCount*/ false,
+        GetQueryBlockCount(*localExecutor));
+    localExecutor->ExecRangeWithThrow(
+        [&] (int blockId) {
+            for (int queryIndex : queryBlocks.SmallQueryBlocks[blockId].Iter()) {
+                const int begin = queriesInfo[queryIndex].Begin;
+                const int end = queriesInfo[queryIndex].End;
+                CalcDersForSingleQuery(start, begin, end, approxes, targets, weights, ders);
+            }
+        },
+        0,
+        queryBlocks.SmallQueryBlocks.ysize(),
+        NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    for (int queryIndex : queryBlocks.GiantQueries) {
+        CalcDersForGiantQuery(start, queriesInfo[queryIndex], approxes, targets, weights, ders, localExecutor);
     }
 }
 
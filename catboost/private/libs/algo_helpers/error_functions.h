@@ -579,40 +579,23 @@ public:
         int queryStartIndex,
         int queryEndIndex,
         const TVector<double>& expApproxes,
-        const TVector<float>& /*targets*/,
-        const TVector<float>& /*weights*/,
+        const TVector<float>& targets,
+        const TVector<float>& weights,
         const TVector<TQueryInfo>& queriesInfo,
         TArrayRef<TDers> ders,
-        ui64 /*randomSeed*/,
+        ui64 randomSeed,
         NPar::TLocalExecutor* localExecutor
-    ) const override {
-        CB_ENSURE(queryStartIndex < queryEndIndex);
-        const int start = queriesInfo[queryStartIndex].Begin;
-        NPar::ParallelFor(
-            *localExecutor,
-            queryStartIndex,
-            queryEndIndex,
-            [&] (ui32 queryIndex) {
-                const int begin = queriesInfo[queryIndex].Begin;
-                const int end = queriesInfo[queryIndex].End;
-                TDers* dersData = ders.data() + begin - start;
-                Fill(dersData, dersData + end - begin, TDers{/*1st*/0.0, /*2nd*/0.0, /*3rd*/0.0});
-                for (int docId = begin; docId < end; ++docId) {
-                    double winnerDer = 0.0;
-                    double winnerSecondDer = 0.0;
-                    for (const auto& competitor : queriesInfo[queryIndex].Competitors[docId - begin]) {
-                        const double p = expApproxes[competitor.Id + begin] /
-                            (expApproxes[competitor.Id + begin] + expApproxes[docId]);
-                        winnerDer += competitor.Weight * p;
-                        dersData[competitor.Id].Der1 -= competitor.Weight * p;
-                        winnerSecondDer += competitor.Weight * p * (p - 1);
-                        dersData[competitor.Id].Der2 += competitor.Weight * p * (p - 1);
-                    }
-                    dersData[docId - begin].Der1 += winnerDer;
-                    dersData[docId - begin].Der2 += winnerSecondDer;
-                }
-            });
-    }
+    ) const override;
+
+private:
+    // adds ders of pairs with winners in [winnerBegin, winnerEnd) to queryDers (indexed from query begin)
+    void AddPairDers(
+        const TQueryInfo& queryInfo,
+        int winnerBegin,
+        int winnerEnd,
+        TConstArrayRef<double> expApproxes,
+        TArrayRef<TDers> queryDers
+    ) const;
 };
 
 class TQueryRmseError final : public IDerCalcer {
@@ -631,52 +614,30 @@ public:
         const TVector<float>& weights,
         const TVector<TQueryInfo>& queriesInfo,
         TArrayRef<TDers> ders,
-        ui64 /*randomSeed*/,
+        ui64 randomSeed,
         NPar::TLocalExecutor* localExecutor
-    ) const override {
-        const int start = queriesInfo[queryStartIndex].Begin;
-        NPar::ParallelFor(
-            *localExecutor,
-            queryStartIndex,
-            queryEndIndex,
-            [&] (ui32 queryIndex) {
-                const int begin = queriesInfo[queryIndex].Begin;
-                const int end = queriesInfo[queryIndex].End;
-                const int querySize = end - begin;
-
-                const double queryAvrg = CalcQueryAvrg(begin, querySize, approxes, targets, weights);
-                for (int docId = begin; docId < end; ++docId) {
-                    ders[docId - start].Der1 = targets[docId] - approxes[docId] - queryAvrg;
-                    ders[docId - start].Der2 = -1;
-                    if (!weights.empty()) {
-                        ders[docId - start].Der1 *= weights[docId];
-                        ders[docId - start].Der2 *= weights[docId];
-                    }
-                }
-            });
-    }
+    ) const override;
+
 private:
-    double CalcQueryAvrg(
-        int start,
-        int count,
+    // returns (weighted sum of residuals, sum of weights) for documents in [begin, end)
+    std::pair<double, double> CalcQuerySums(
+        int begin,
+        int end,
         const TVector<double>& approxes,
         const TVector<float>& targets,
         const TVector<float>& weights
-    ) const {
-        double querySum = 0;
-        double queryCount = 0;
-        for (int docId = start; docId < start + count; ++docId) {
-            double w = weights.empty() ? 1 : weights[docId];
-            querySum += (targets[docId] - approxes[docId]) * w;
-            queryCount += w;
-        }
+    ) const;
 
-        double queryAvrg = 0;
-        if (queryCount > 0) {
-            queryAvrg = querySum / queryCount;
-        }
-        return queryAvrg;
-    }
+    void CalcDersRange(
+        int start,
+        int begin,
+        int end,
+        double queryAvrg,
+        const TVector<double>& approxes,
+        const TVector<float>& targets,
+        const TVector<float>& weights,
+        TArrayRef<TDers> ders
+    ) const;
 };
 
 class TQuerySoftMaxError final : public IDerCalcer {
@@ -699,31 +660,68 @@ public:
         const TVector<float>& weights,
         const TVector<TQueryInfo>& queriesInfo,
         TArrayRef<TDers> ders,
-        ui64 /*randomSeed*/,
+        ui64 randomSeed,
         NPar::TLocalExecutor* localExecutor
-    ) const override {
-        int start = queriesInfo[queryStartIndex].Begin;
-        NPar::ParallelFor(
-            *localExecutor,
-            queryStartIndex,
-            queryEndIndex,
-            [&](int queryIndex) {
-                int begin = queriesInfo[queryIndex].Begin;
-                int end = queriesInfo[queryIndex].End;
-                CalcDersForSingleQuery(start, begin - start, end - begin, approxes, targets, weights, ders);
-            });
-    }
+    ) const override;
 
 private:
+    struct TSoftMaxNormalizers {
+        double MaxApprox = -std::numeric_limits<double>::max();
+        float SumWeightedTargets = 0;
+        double SumExpApprox = 0;
+    };
+
+    // Der1 of documents in [begin, end) of a query is split into three passes
+    //  so that the normalizers of giant queries can be reduced from per-thread partial values
+    void UpdateMaxApproxAndTargetSum(
+        int begin,
+        int end,
+        TConstArrayRef<double> approxes,
+        TConstArrayRef<float> targets,
+        TConstArrayRef<float> weights,
+        TSoftMaxNormalizers* normalizers
+    ) const;
+
+    // stores weighted exp approxes to ders Der1 and returns their sum
+    double CalcExpApproxes(
+        int start,
+        int begin,
+        int end,
+        double maxApprox,
+        TConstArrayRef<double> approxes,
+        TConstArrayRef<float> weights,
+        TArrayRef<TDers> ders
+    ) const;
+
+    void CalcDersRange(
+        int start,
+        int begin,
+        int end,
+        const TSoftMaxNormalizers& normalizers,
+        TConstArrayRef<float> targets,
+        TConstArrayRef<float> weights,
+        TArrayRef<TDers> ders
+    ) const;
+
     void CalcDersForSingleQuery(
         int start,
-        int offset,
-        int count,
+        int begin,
+        int end,
         TConstArrayRef<double> approxes,
         TConstArrayRef<float> targets,
         TConstArrayRef<float> weights,
         TArrayRef<TDers> ders
     ) const;
+
+    void CalcDersForGiantQuery(
+        int start,
+        const TQueryInfo& queryInfo,
+        TConstArrayRef<double> approxes,
+        TConstArrayRef<float> targets,
+        TConstArrayRef<float> weights,
+        TArrayRef<TDers> ders,
+        NPar::TLocalExecutor* localExecutor
+    ) const;
 };
 
 class TCustomError final : public IDerCalcer {
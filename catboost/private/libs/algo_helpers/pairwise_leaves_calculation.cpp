@@ -6,11 +6,14 @@
 #include <catboost/private/libs/lapack/linear_system.h>
 
 
-TVector<double> CalculatePairwiseLeafValues(
+void CalculatePairwiseLeafValues(
     const TArray2D<double>& pairwiseWeightSums,
     const TVector<double>& derSums,
     float l2DiagReg,
-    float pairwiseBucketWeightPriorReg
+    float pairwiseBucketWeightPriorReg,
+    NPar::TLocalExecutor* localExecutor,
+    TVector<double>* systemMatrix,
+    TVector<double>* leafValues
 ) {
     Y_ASSERT(pairwiseWeightSums.GetXSize() > 1);
     Y_ASSERT(pairwiseWeightSums.GetXSize() == pairwiseWeightSums.GetYSize());
@@ -21,7 +24,7 @@ TVector<double> CalculatePairwiseLeafValues(
     const double nonDiagReg = -pairwiseBucketWeightPriorReg * cellPrior;
     const double diagReg = pairwiseBucketWeightPriorReg * (1 - cellPrior) + l2DiagReg;
 
-    TVector<double> res;
+    auto& res = *leafValues;
     if (systemSize == 2) {
        /* In case of 2x2 matrix we have the system of such form:
         *     / a11 -a11\ /x1\  --  / b1\
@@ -30,24 +33,42 @@ TVector<double> CalculatePairwiseLeafValues(
         * */
         res = {derSums[0] / (pairwiseWeightSums[0][0] + diagReg), 0.0};
         MakeZeroAverage(&res);
-        return res;
+        return;
     }
 
-    TVector<double> systemMatrix((systemSize - 1) * (systemSize - 1));
+    systemMatrix->yresize((systemSize - 1) * (systemSize - 1));
     // Copy only upper triangular of the matrix as it is symmetric and another half is not referenced in potrf.
     for (int y = 0; y < systemSize - 1; ++y) {
+        double* systemMatrixRow = systemMatrix->data() + y * (systemSize - 1);
         for (int x = 0; x < y; ++x) {
-            systemMatrix[y * (systemSize - 1) + x] = pairwiseWeightSums[y][x] + nonDiagReg;
+            systemMatrixRow[x] = pairwiseWeightSums[y][x] + nonDiagReg;
         }
-        systemMatrix[y * (systemSize - 1) + y] = pairwiseWeightSums[y][y] + diagReg;
+        systemMatrixRow[y] = pairwiseWeightSums[y][y] + diagReg;
     }
 
-    res = derSums;
-    res.pop_back();
-    SolveLinearSystemCholesky(&systemMatrix, &res);
+    res.assign(derSums.begin(), derSums.end() - 1);
+    SolveLinearSystemCholesky(systemMatrix, &res, localExecutor);
     res.push_back(0.0);
 
     MakeZeroAverage(&res);
+}
+
+TVector<double> CalculatePairwiseLeafValues(
+    const TArray2D<double>& pairwiseWeightSums,
+    const TVector<double>& derSums,
+    float l2DiagReg,
+    float pairwiseBucketWeightPriorReg
+) {
+    TVector<double> systemMatrix;
+    TVector<double> res;
+    CalculatePairwiseLeafValues(
+        pairwiseWeightSums,
+        derSums,
+        l2DiagReg,
+        pairwiseBucketWeightPriorReg,
+        /*localExecutor*/ nullptr,
+        &systemMatrix,
+        &res);
     return res;
 }
 
@@ -12,6 +12,19 @@ namespace NPar {
 }
 
 
+/* systemMatrix is a workspace that can be reused between calls,
+ * large systems are solved in parallel if localExecutor is not nullptr
+ */
+void CalculatePairwiseLeafValues(
+    const TArray2D<double>& pairwiseWeightSums,
+    const TVector<double>& derSums,
+    float l2DiagReg,
+    float pairwiseBucketWeightPriorReg,
+    NPar::TLocalExecutor* localExecutor,
+    TVector<double>* systemMatrix,
+    TVector<double>* leafValues
+);
+
 TVector<double> CalculatePairwiseLeafValues(
     const TArray2D<double>& pairwiseWeightSums,
     const TVector<double>& derSums,
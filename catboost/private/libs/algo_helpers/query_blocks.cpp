@@ -0,0 +1,89 @@
+#include "query_blocks.h"
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/utility.h>
+#include <util/generic/ymath.h>
+
+
+static constexpr int QUERY_BLOCKS_PER_THREAD = 4;
+static constexpr ui64 MIN_GIANT_QUERY_COST = 4096;
+static constexpr int MIN_GIANT_QUERY_PART_SIZE = 1024;
+
+
+static ui64 GetQueryCost(const TQueryInfo& queryInfo, bool addCompetitorsCount) {
+    ui64 cost = queryInfo.GetSize();
+    if (addCompetitorsCount) {
+        for (const auto& competitors : queryInfo.Competitors) {
+            cost += competitors.size();
+        }
+    }
+    return cost;
+}
+
+TQueryBlocks SplitQueriesByCost(
+    const TVector<TQueryInfo>& queriesInfo,
+    int queryStartIndex,
+    int queryEndIndex,
+    bool addCompetitorsCount,
+    int blockCount
+) {
+    Y_ASSERT(blockCount > 0);
+    TQueryBlocks queryBlocks;
+    if (queryStartIndex >= queryEndIndex) {
+        return queryBlocks;
+    }
+
+    TVector<ui64> queryCosts;
+    queryCosts.yresize(queryEndIndex - queryStartIndex);
+    ui64 totalCost = 0;
+    for (int queryIndex = queryStartIndex; queryIndex < queryEndIndex; ++queryIndex) {
+        const ui64 cost = GetQueryCost(queriesInfo[queryIndex], addCompetitorsCount);
+        queryCosts[queryIndex - queryStartIndex] = cost;
+        totalCost += cost;
+    }
+    const ui64 blockCostLimit = Max<ui64>(CeilDiv<ui64>(totalCost, blockCount), 1);
+    const ui64 giantQueryCost = Max(blockCostLimit, MIN_GIANT_QUERY_COST);
+
+    int blockBegin = queryStartIndex;
+    ui64 blockCost = 0;
+    for (int queryIndex = queryStartIndex; queryIndex < queryEndIndex; ++queryIndex) {
+        const ui64 cost = queryCosts[queryIndex - queryStartIndex];
+        if (cost > giantQueryCost) {
+            if (blockBegin < queryIndex) {
+                queryBlocks.SmallQueryBlocks.emplace_back(blockBegin, queryIndex);
+            }
+            queryBlocks.GiantQueries.push_back(queryIndex);
+            blockBegin = queryIndex + 1;
+            blockCost = 0;
+            continue;
+        }
+        blockCost += cost;
+        if (blockCost >= blockCostLimit) {
+            queryBlocks.SmallQueryBlocks.emplace_back(blockBegin, queryIndex + 1);
+            blockBegin = queryIndex + 1;
+            blockCost = 0;
+        }
+    }
+    if (blockBegin < queryEndIndex) {
+        queryBlocks.SmallQueryBlocks.emplace_back(blockBegin, queryEndIndex);
+    }
+    return queryBlocks;
+}
+
+int GetQueryBlockCount(const NPar::TLocalExecutor& localExecutor) {
+    return (localExecutor.GetThreadCount() + 1) * QUERY_BLOCKS_PER_THREAD;
+}
+
+NCB::TEqualRangesGenerator<int> GetGiantQueryPartsGenerator(
+    const TQueryInfo& queryInfo,
+    const NPar::TLocalExecutor& localExecutor
+) {
+    const int querySize = queryInfo.GetSize();
+    const int partCount = Max(
+        Min(localExecutor.GetThreadCount() + 1, CeilDiv(querySize, MIN_GIANT_QUERY_PART_SIZE)),
+        1);
+    return NCB::TEqualRangesGenerator<int>(
+        NCB::TIndexRange<int>(queryInfo.Begin, queryInfo.End),
+        partCount);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <catboost/private/libs/data_types/query.h>
+#include <catboost/private/libs/index_range/index_range.h>
+
+#include <util/generic/vector.h>
+
+
+namespace NPar {
+    class TLocalExecutor;
+}
+
+
+/* Queries in [queryStartIndex, queryEndIndex) grouped for parallel processing.
+ *
+ * Cost of a query is its document count plus (optionally) its competitors count.
+ * SmallQueryBlocks are consecutive query ranges with approximately equal total cost,
+ * GiantQueries are queries too expensive to be processed by a single thread
+ * (they are not included in SmallQueryBlocks).
+ */
+struct TQueryBlocks {
+    TVector<NCB::TIndexRange<int>> SmallQueryBlocks;
+    TVector<int> GiantQueries;
+};
+
+TQueryBlocks SplitQueriesByCost(
+    const TVector<TQueryInfo>& queriesInfo,
+    int queryStartIndex,
+    int queryEndIndex,
+    bool addCompetitorsCount,
+    int blockCount
+);
+
+// several blocks per thread so that executor can balance remaining skew dynamically
+int GetQueryBlockCount(const NPar::TLocalExecutor& localExecutor);
+
+// ranges for intra-query parallel processing of a giant query
+NCB::TEqualRangesGenerator<int> GetGiantQueryPartsGenerator(
+    const TQueryInfo& queryInfo,
+    const NPar::TLocalExecutor& localExecutor
+);
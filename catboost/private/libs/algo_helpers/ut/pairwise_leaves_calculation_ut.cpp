@@ -1,6 +1,11 @@
 #include <library/unittest/registar.h>
 #include <catboost/private/libs/algo_helpers/pairwise_leaves_calculation.h>
 
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
 static TArray2D<double> Convert(const TVector<TVector<double>>& matrix) {
     if (matrix.empty()) {
         return {};
@@ -45,4 +50,50 @@ Y_UNIT_TEST_SUITE(PairwiseLeafCalculationTest) {
         UNIT_ASSERT_DOUBLES_EQUAL(leafValues[2], 5.448432894, 1e-6);
         UNIT_ASSERT_DOUBLES_EQUAL(leafValues[3], 1.093156891, 1e-6);
     }
+
+    Y_UNIT_TEST(PairwiseLeafCalculationTestBlockedSolver) {
+        const int leafCount = 300;
+        TArray2D<double> pairwiseWeightSums(leafCount, leafCount);
+        pairwiseWeightSums.FillZero();
+        TVector<double> derSums(leafCount);
+        TFastRng<ui64> rng(0);
+        for (int pairIdx = 0; pairIdx < 20 * leafCount; ++pairIdx) {
+            const int winner = rng.Uniform(leafCount);
+            const int loser = rng.Uniform(leafCount);
+            if (winner == loser) {
+                continue;
+            }
+            const double weight = rng.GenRandReal1();
+            pairwiseWeightSums[winner][loser] -= weight;
+            pairwiseWeightSums[loser][winner] -= weight;
+            pairwiseWeightSums[winner][winner] += weight;
+            pairwiseWeightSums[loser][loser] += weight;
+        }
+        for (auto& derSum : derSums) {
+            derSum = rng.GenRandReal1() - 0.5;
+        }
+        const float l2DiagReg = 0.3;
+        const float pairwiseNonDiagReg = 0.1;
+
+        const TVector<double> expectedLeafValues = CalculatePairwiseLeafValues(pairwiseWeightSums, derSums, l2DiagReg, pairwiseNonDiagReg);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+        TVector<double> systemMatrix;
+        TVector<double> leafValues;
+        for (int repetition = 0; repetition < 2; ++repetition) {
+            CalculatePairwiseLeafValues(
+                pairwiseWeightSums,
+                derSums,
+                l2DiagReg,
+                pairwiseNonDiagReg,
+                &localExecutor,
+                &systemMatrix,
+                &leafValues);
+            UNIT_ASSERT_VALUES_EQUAL(leafValues.size(), expectedLeafValues.size());
+            for (auto leafIdx : xrange(leafCount)) {
+                UNIT_ASSERT_DOUBLES_EQUAL(leafValues[leafIdx], expectedLeafValues[leafIdx], 1e-9);
+            }
+        }
+    }
 }
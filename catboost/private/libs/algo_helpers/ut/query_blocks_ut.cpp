@@ -0,0 +1,305 @@
+#include <library/unittest/registar.h>
+#include <catboost/private/libs/algo_helpers/error_functions.h>
+#include <catboost/private/libs/algo_helpers/query_blocks.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+#include <util/random/fast.h>
+
+#include <cmath>
+
+static TVector<TQueryInfo> MakeQueriesInfo(const TVector<ui32>& querySizes) {
+    TVector<TQueryInfo> queriesInfo;
+    ui32 begin = 0;
+    for (ui32 querySize : querySizes) {
+        queriesInfo.emplace_back(begin, begin + querySize);
+        begin += querySize;
+    }
+    return queriesInfo;
+}
+
+Y_UNIT_TEST_SUITE(QueryBlocksTest) {
+    Y_UNIT_TEST(SplitEqualQueries) {
+        const auto queriesInfo = MakeQueriesInfo(TVector<ui32>(8, 10));
+
+        const TQueryBlocks queryBlocks = SplitQueriesByCost(
+            queriesInfo,
+            /*queryStartIndex*/ 0,
+            /*queryEndIndex*/ 8,
+            /*addCompetitorsCount*/ false,
+            /*blockCount*/ 4);
+
+        UNIT_ASSERT(queryBlocks.GiantQueries.empty());
+        const TVector<NCB::TIndexRange<int>> expectedBlocks = {{0, 2}, {2, 4}, {4, 6}, {6, 8}};
+        UNIT_ASSERT_EQUAL(queryBlocks.SmallQueryBlocks, expectedBlocks);
+    }
+
+    Y_UNIT_TEST(SplitSkewedQueries) {
+        const auto queriesInfo = MakeQueriesInfo({2, 3, 20000, 2, 5, 10000, 1});
+
+        const TQueryBlocks queryBlocks = SplitQueriesByCost(
+            queriesInfo,
+            /*queryStartIndex*/ 1,
+            /*queryEndIndex*/ 7,
+            /*addCompetitorsCount*/ false,
+            /*blockCount*/ 8);
+
+        const TVector<int> expectedGiantQueries = {2, 5};
+        UNIT_ASSERT_VALUES_EQUAL(queryBlocks.GiantQueries, expectedGiantQueries);
+        const TVector<NCB::TIndexRange<int>> expectedBlocks = {{1, 2}, {3, 5}, {6, 7}};
+        UNIT_ASSERT_EQUAL(queryBlocks.SmallQueryBlocks, expectedBlocks);
+    }
+
+    Y_UNIT_TEST(SplitByCompetitorsCount) {
+        auto queriesInfo = MakeQueriesInfo({2, 2, 2, 2});
+        queriesInfo[0].Competitors = {{TCompetitor(1, 1.0f)}, {}};
+        queriesInfo[1].Competitors.resize(2);
+        for (ui32 competitorId : xrange(5000)) {
+            Y_UNUSED(competitorId);
+            queriesInfo[1].Competitors[0].emplace_back(1, 1.0f);
+        }
+
+        const TQueryBlocks queryBlocks = SplitQueriesByCost(
+            queriesInfo,
+            /*queryStartIndex*/ 0,
+            /*queryEndIndex*/ 4,
+            /*addCompetitorsCount*/ true,
+            /*blockCount*/ 2);
+
+        const TVector<int> expectedGiantQueries = {1};
+        UNIT_ASSERT_VALUES_EQUAL(queryBlocks.GiantQueries, expectedGiantQueries);
+        const TVector<NCB::TIndexRange<int>> expectedBlocks = {{0, 1}, {2, 4}};
+        UNIT_ASSERT_EQUAL(queryBlocks.SmallQueryBlocks, expectedBlocks);
+    }
+}
+
+// queries 2 and 4 are giant, so they are processed by parts in different threads
+static const TVector<ui32> GIANT_QUERIES_SIZES = {3, 7, 6000, 5, 9000, 2, 4};
+
+struct TQueriesData {
+    TVector<TQueryInfo> QueriesInfo;
+    TVector<double> Approxes;
+    TVector<float> Targets;
+    TVector<float> Weights;
+};
+
+static TQueriesData GenerateQueriesData(const TVector<ui32>& querySizes, bool addCompetitors) {
+    TFastRng64 rng(0);
+    TQueriesData data;
+    data.QueriesInfo = MakeQueriesInfo(querySizes);
+    const ui32 docCount = data.QueriesInfo.back().End;
+    for (auto docId : xrange(docCount)) {
+        Y_UNUSED(docId);
+        data.Approxes.push_back(2.0 * rng.GenRandReal1() - 1.0);
+        // multiples of 1/4, so that float sums of weighted targets don't depend on summation order
+        data.Targets.push_back(rng.Uniform(5) / 4.0f);
+        data.Weights.push_back(rng.Uniform(8) == 0 ? 0.0f : (2 + rng.Uniform(4)) / 4.0f);
+    }
+    if (addCompetitors) {
+        for (auto& queryInfo : data.QueriesInfo) {
+            const ui32 querySize = queryInfo.GetSize();
+            queryInfo.Competitors.resize(querySize);
+            for (ui32 pairIdx : xrange(querySize)) {
+                Y_UNUSED(pairIdx);
+                const ui32 winnerId = rng.Uniform(querySize);
+                const ui32 loserId = rng.Uniform(querySize);
+                if (winnerId != loserId) {
+                    queryInfo.Competitors[winnerId].emplace_back(loserId, static_cast<float>(rng.GenRandReal1()));
+                }
+            }
+        }
+    }
+    return data;
+}
+
+static TVector<TDers> CalcDersForQueries(
+    const IDerCalcer& calcer,
+    int queryStartIndex,
+    int queryEndIndex,
+    const TQueriesData& data,
+    const TVector<double>& approxes,
+    int threadCount
+) {
+    NPar::TLocalExecutor localExecutor;
+    localExecutor.RunAdditionalThreads(threadCount - 1);
+
+    const auto& queriesInfo = data.QueriesInfo;
+    TVector<TDers> ders(queriesInfo[queryEndIndex - 1].End - queriesInfo[queryStartIndex].Begin);
+    calcer.CalcDersForQueries(
+        queryStartIndex,
+        queryEndIndex,
+        approxes,
+        data.Targets,
+        data.Weights,
+        queriesInfo,
+        ders,
+        /*randomSeed*/ 0,
+        &localExecutor);
+    return ders;
+}
+
+static void AssertDersEqual(const TVector<TDers>& ders, const TVector<TDers>& expectedDers, double relativeEps) {
+    UNIT_ASSERT_VALUES_EQUAL(ders.size(), expectedDers.size());
+    for (auto docId : xrange(ders.size())) {
+        const double der1Eps = relativeEps * Max(1.0, Abs(expectedDers[docId].Der1));
+        const double der2Eps = relativeEps * Max(1.0, Abs(expectedDers[docId].Der2));
+        UNIT_ASSERT_DOUBLES_EQUAL_C(ders[docId].Der1, expectedDers[docId].Der1, der1Eps, "docId " << docId);
+        UNIT_ASSERT_DOUBLES_EQUAL_C(ders[docId].Der2, expectedDers[docId].Der2, der2Eps, "docId " << docId);
+    }
+}
+
+// reference implementations process each query sequentially as a whole
+
+static TVector<TDers> CalcQueryRmseDers(const TQueriesData& data, int queryStartIndex, int queryEndIndex) {
+    const int start = data.QueriesInfo[queryStartIndex].Begin;
+    TVector<TDers> ders(data.QueriesInfo[queryEndIndex - 1].End - start);
+    for (int queryIndex : xrange(queryStartIndex, queryEndIndex)) {
+        const auto& queryInfo = data.QueriesInfo[queryIndex];
+        double querySum = 0;
+        double queryCount = 0;
+        for (ui32 docId : xrange(queryInfo.Begin, queryInfo.End)) {
+            querySum += (data.Targets[docId] - data.Approxes[docId]) * data.Weights[docId];
+            queryCount += data.Weights[docId];
+        }
+        const double queryAvrg = queryCount > 0 ? querySum / queryCount : 0;
+        for (ui32 docId : xrange(queryInfo.Begin, queryInfo.End)) {
+            ders[docId - start].Der1 = (data.Targets[docId] - data.Approxes[docId] - queryAvrg) * data.Weights[docId];
+            ders[docId - start].Der2 = -data.Weights[docId];
+        }
+    }
+    return ders;
+}
+
+static TVector<TDers> CalcQuerySoftMaxDers(
+    const TQueriesData& data,
+    double lambdaReg,
+    int queryStartIndex,
+    int queryEndIndex
+) {
+    const int start = data.QueriesInfo[queryStartIndex].Begin;
+    TVector<TDers> ders(data.QueriesInfo[queryEndIndex - 1].End - start, TDers{0.0, 0.0, 0.0});
+    for (int queryIndex : xrange(queryStartIndex, queryEndIndex)) {
+        const auto& queryInfo = data.QueriesInfo[queryIndex];
+        double maxApprox = -std::numeric_limits<double>::max();
+        double sumWeightedTargets = 0;
+        for (ui32 docId : xrange(queryInfo.Begin, queryInfo.End)) {
+            if (data.Weights[docId] > 0) {
+                maxApprox = Max(maxApprox, data.Approxes[docId]);
+                if (data.Targets[docId] > 0) {
+                    sumWeightedTargets += data.Weights[docId] * data.Targets[docId];
+                }
+            }
+        }
+        if (sumWeightedTargets <= 0) {
+            continue;
+        }
+        double sumExpApprox = 0;
+        for (ui32 docId : xrange(queryInfo.Begin, queryInfo.End)) {
+            if (data.Weights[docId] > 0) {
+                sumExpApprox += std::exp(data.Approxes[docId] - maxApprox) * data.Weights[docId];
+            }
+        }
+        for (ui32 docId : xrange(queryInfo.Begin, queryInfo.End)) {
+            if (data.Weights[docId] > 0) {
+                const double p = std::exp(data.Approxes[docId] - maxApprox) * data.Weights[docId] / sumExpApprox;
+                ders[docId - start].Der2 = sumWeightedTargets * (p * (p - 1.0) - lambdaReg);
+                ders[docId - start].Der1 = -sumWeightedTargets * p;
+                if (data.Targets[docId] > 0) {
+                    ders[docId - start].Der1 += data.Weights[docId] * data.Targets[docId];
+                }
+            }
+        }
+    }
+    return ders;
+}
+
+static TVector<TDers> CalcPairLogitDers(
+    const TQueriesData& data,
+    const TVector<double>& expApproxes,
+    int queryStartIndex,
+    int queryEndIndex
+) {
+    const int start = data.QueriesInfo[queryStartIndex].Begin;
+    TVector<TDers> ders(data.QueriesInfo[queryEndIndex - 1].End - start, TDers{0.0, 0.0, 0.0});
+    for (int queryIndex : xrange(queryStartIndex, queryEndIndex)) {
+        const auto& queryInfo = data.QueriesInfo[queryIndex];
+        const int begin = queryInfo.Begin;
+        for (ui32 winnerId : xrange(queryInfo.GetSize())) {
+            for (const auto& competitor : queryInfo.Competitors[winnerId]) {
+                const double p = expApproxes[begin + competitor.Id] /
+                    (expApproxes[begin + competitor.Id] + expApproxes[begin + winnerId]);
+                ders[begin + winnerId - start].Der1 += competitor.Weight * p;
+                ders[begin + winnerId - start].Der2 += competitor.Weight * p * (p - 1);
+                ders[begin + competitor.Id - start].Der1 -= competitor.Weight * p;
+                ders[begin + competitor.Id - start].Der2 += competitor.Weight * p * (p - 1);
+            }
+        }
+    }
+    return ders;
+}
+
+Y_UNIT_TEST_SUITE(GiantQueryDersTest) {
+    Y_UNIT_TEST(QueryRmse) {
+        const auto data = GenerateQueriesData(GIANT_QUERIES_SIZES, /*addCompetitors*/ false);
+        const int queryCount = data.QueriesInfo.ysize();
+        const TQueryRmseError calcer(/*isExpApprox*/ false);
+        for (int threadCount : {1, 4}) {
+            for (int queryStartIndex : {0, 1, 3}) {
+                AssertDersEqual(
+                    CalcDersForQueries(calcer, queryStartIndex, queryCount, data, data.Approxes, threadCount),
+                    CalcQueryRmseDers(data, queryStartIndex, queryCount),
+                    1e-9);
+            }
+        }
+    }
+
+    Y_UNIT_TEST(QuerySoftMax) {
+        const auto data = GenerateQueriesData(GIANT_QUERIES_SIZES, /*addCompetitors*/ false);
+        const int queryCount = data.QueriesInfo.ysize();
+        const double lambdaReg = 0.01;
+        const TQuerySoftMaxError calcer(lambdaReg, /*isExpApprox*/ false);
+        for (int threadCount : {1, 4}) {
+            // ranges that start after the first document check exp approxes indexing inside the range
+            for (int queryStartIndex : {0, 1, 3}) {
+                AssertDersEqual(
+                    CalcDersForQueries(calcer, queryStartIndex, queryCount, data, data.Approxes, threadCount),
+                    CalcQuerySoftMaxDers(data, lambdaReg, queryStartIndex, queryCount),
+                    1e-6);
+            }
+        }
+    }
+
+    Y_UNIT_TEST(QuerySoftMaxSmallQueriesOffset) {
+        // only small queries, none of them starts at the first document of the range except the first one
+        const auto data = GenerateQueriesData({5, 20, 17, 33, 2, 40}, /*addCompetitors*/ false);
+        const int queryCount = data.QueriesInfo.ysize();
+        const double lambdaReg = 0.01;
+        const TQuerySoftMaxError calcer(lambdaReg, /*isExpApprox*/ false);
+        for (int queryStartIndex : {0, 2}) {
+            AssertDersEqual(
+                CalcDersForQueries(calcer, queryStartIndex, queryCount, data, data.Approxes, /*threadCount*/ 2),
+                CalcQuerySoftMaxDers(data, lambdaReg, queryStartIndex, queryCount),
+                1e-6);
+        }
+    }
+
+    Y_UNIT_TEST(PairLogit) {
+        const auto data = GenerateQueriesData(GIANT_QUERIES_SIZES, /*addCompetitors*/ true);
+        const int queryCount = data.QueriesInfo.ysize();
+        TVector<double> expApproxes;
+        for (double approx : data.Approxes) {
+            expApproxes.push_back(std::exp(approx));
+        }
+        const TPairLogitError calcer(/*isExpApprox*/ true);
+        for (int threadCount : {1, 4}) {
+            for (int queryStartIndex : {0, 1, 3}) {
+                AssertDersEqual(
+                    CalcDersForQueries(calcer, queryStartIndex, queryCount, data, expApproxes, threadCount),
+                    CalcPairLogitDers(data, expApproxes, queryStartIndex, queryCount),
+                    1e-9);
+            }
+        }
+    }
+}
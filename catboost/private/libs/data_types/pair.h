@@ -3,6 +3,7 @@
 #include <library/binsaver/bin_saver.h>
 
 #include <util/digest/multi.h>
+#include <util/generic/vector.h>
 #include <util/stream/output.h>
 #include <util/str_stl.h>
 
@@ -62,3 +63,25 @@ struct TCompetitor {
 };
 
 using TFlatPairsInfo = TVector<TPair>;
+
+/* Pairs grouped by winner in CSR layout:
+ *  pairs of winner WinnerIds[i] are [WinnerOffsets[i], WinnerOffsets[i + 1]) in LoserIds and Weights.
+ * Takes 8 bytes per pair instead of 12 for TFlatPairsInfo and lets scoring load winner data once.
+ */
+struct TCompactPairs {
+    TVector<ui32> WinnerIds;
+    TVector<ui64> WinnerOffsets; // WinnerIds.size() + 1 elements
+    TVector<ui32> LoserIds;
+    TVector<float> Weights;
+
+public:
+    size_t GetWinnerCount() const {
+        return WinnerIds.size();
+    }
+
+    size_t GetPairCount() const {
+        return LoserIds.size();
+    }
+
+    SAVELOAD(WinnerIds, WinnerOffsets, LoserIds, Weights);
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "path_shards.h"
 #include "path_with_scheme.h"
 
 #include <library/object_factory/object_factory.h>
@@ -26,8 +27,9 @@ namespace NCB {
     bool IsSharedFs(const TPathWithScheme& pathWithScheme);
 
     struct TFSExistsChecker : public IExistsChecker {
+        // sharded paths exist if every item matches some file
         bool Exists(const TPathWithScheme& pathWithScheme) const override {
-            return NFs::Exists(pathWithScheme.Path);
+            return NFs::Exists(pathWithScheme.Path) || !GetShardPaths(pathWithScheme.Path).empty();
         }
         bool IsSharedFs() const override {
             return false;
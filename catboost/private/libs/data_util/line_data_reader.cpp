@@ -1,29 +1,220 @@
 #include "line_data_reader.h"
+#include "path_shards.h"
 
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/cast.h>
+#include <util/generic/utility.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
 #include <util/system/fs.h>
 
+#include <cstring>
+
 
 namespace NCB {
 
+    // big enough to make scheduling overhead negligible compared to the scan
+    static constexpr size_t LINE_COUNT_CHUNK_SIZE = 16 << 20;
+
+
     THolder<ILineDataReader> GetLineDataReader(const TPathWithScheme& pathWithScheme,
-                                               const TDsvFormatOptions& format)
+                                               const TDsvFormatOptions& format,
+                                               NPar::TLocalExecutor* localExecutor)
     {
         return GetProcessor<ILineDataReader, TLineDataReaderArgs>(
-            pathWithScheme, TLineDataReaderArgs{pathWithScheme, format}
+            pathWithScheme, TLineDataReaderArgs{pathWithScheme, format, localExecutor}
         );
     }
 
-    int CountLines(const TString& poolFile) {
-        CB_ENSURE(NFs::Exists(TString(poolFile)), "pool file '" << TString(poolFile) << "' is not found");
-        TIFStream reader(poolFile.c_str());
-        size_t count = 0;
-        TString buffer;
-        while (reader.ReadLine(buffer)) {
+    static ui64 CountNewLines(TStringBuf data) {
+        ui64 count = 0;
+        const char* const end = data.end();
+        for (const char* ptr = data.begin(); ptr != end; ++count, ++ptr) {
+            ptr = (const char*)memchr(ptr, '\n', end - ptr);
+            if (!ptr) {
+                break;
+            }
+        }
+        return count;
+    }
+
+    ui64 CountLines(TStringBuf data, NPar::TLocalExecutor* localExecutor) {
+        if (data.empty()) {
+            return 0;
+        }
+        ui64 count = 0;
+        const int chunkCount = SafeIntegerCast<int>(CeilDiv(data.size(), LINE_COUNT_CHUNK_SIZE));
+        if (localExecutor && (localExecutor->GetThreadCount() > 0) && (chunkCount > 1)) {
+            TVector<ui64> chunkCounts(chunkCount, 0);
+            localExecutor->ExecRangeWithThrow(
+                [&] (int chunkIdx) {
+                    chunkCounts[chunkIdx] = CountNewLines(
+                        data.SubStr(chunkIdx * LINE_COUNT_CHUNK_SIZE, LINE_COUNT_CHUNK_SIZE)
+                    );
+                },
+                0,
+                chunkCount,
+                NPar::TLocalExecutor::WAIT_COMPLETE
+            );
+            for (auto chunkLineCount : chunkCounts) {
+                count += chunkLineCount;
+            }
+        } else {
+            count = CountNewLines(data);
+        }
+        if (data.back() != '\n') {
             ++count;
         }
         return count;
     }
 
+    int CountLines(const TString& poolFile) {
+        CB_ENSURE(NFs::Exists(TString(poolFile)), "pool file '" << TString(poolFile) << "' is not found");
+        const TBlob data = TBlob::FromFile(poolFile);
+        return SafeIntegerCast<int>(CountLines(TStringBuf(data.AsCharPtr(), data.Size())));
+    }
+
+
+    TFileLineDataReader::TFileLineDataReader(const TLineDataReaderArgs& args)
+        : Args(args)
+        , HeaderProcessed(!Args.Format.HasHeader)
+    {
+        const TVector<TString> shardPaths = GetShardPaths(Args.PathWithScheme.Path);
+        CB_ENSURE(!shardPaths.empty(), "No data files found at '" << Args.PathWithScheme.Path << "'");
+        for (const auto& shardPath : shardPaths) {
+            Shards.push_back(TBlob::FromFile(shardPath));
+        }
+        StartNextShard();
+    }
+
+    static ui64 GetShardDataLineCount(const TBlob& shard, bool hasHeader, NPar::TLocalExecutor* localExecutor) {
+        ui64 nLines = CountLines(TStringBuf(shard.AsCharPtr(), shard.Size()), localExecutor);
+        if (hasHeader && nLines) {
+            --nLines;
+        }
+        return nLines;
+    }
+
+    TVector<ui64> TFileLineDataReader::GetShardDataLineCounts() {
+        const bool hasHeader = Args.Format.HasHeader;
+        NPar::TLocalExecutor* localExecutor = Args.LocalExecutor;
+
+        TVector<ui64> counts(Shards.size(), 0);
+        if (localExecutor && (localExecutor->GetThreadCount() > 0) && (Shards.size() > 1)) {
+            // shards are counted concurrently, big shards are additionally split into chunks
+            localExecutor->ExecRangeWithThrow(
+                [&] (int shardIdx) {
+                    counts[shardIdx] = GetShardDataLineCount(Shards[shardIdx], hasHeader, localExecutor);
+                },
+                0,
+                SafeIntegerCast<int>(Shards.size()),
+                NPar::TLocalExecutor::WAIT_COMPLETE
+            );
+        } else {
+            for (auto shardIdx : xrange(Shards.size())) {
+                counts[shardIdx] = GetShardDataLineCount(Shards[shardIdx], hasHeader, localExecutor);
+            }
+        }
+        return counts;
+    }
+
+    ui64 TFileLineDataReader::GetDataLineCount() {
+        ui64 nLines = 0;
+        for (auto shardLineCount : GetShardDataLineCounts()) {
+            nLines += shardLineCount;
+        }
+        return nLines;
+    }
+
+    TMaybe<TString> TFileLineDataReader::GetHeader() {
+        if (Args.Format.HasHeader) {
+            CB_ENSURE(!HeaderProcessed, "TFileLineDataReader: multiple calls to GetHeader");
+            TStringBuf header;
+            CB_ENSURE(NextLine(&header), "TFileLineDataReader: no header in file");
+            HeaderProcessed = true;
+            Header = TString(header);
+            return Header;
+        }
+
+        return {};
+    }
+
+    bool TFileLineDataReader::ReadLine(TString* line) {
+        TStringBuf lineBuf;
+        if (!ReadLineZeroCopy(&lineBuf)) {
+            return false;
+        }
+        line->assign(lineBuf.data(), lineBuf.size());
+        return true;
+    }
+
+    bool TFileLineDataReader::ReadLineZeroCopy(TStringBuf* line) {
+        // skip header if it hasn't been read
+        if (!HeaderProcessed) {
+            GetHeader();
+        }
+        while (!NextLine(line)) {
+            if (!StartNextShard()) {
+                return false;
+            }
+            if (Args.Format.HasHeader) {
+                TStringBuf header;
+                CB_ENSURE(NextLine(&header), "TFileLineDataReader: no header in file");
+                CB_ENSURE(
+                    header == *Header,
+                    "Header of data file " << Args.PathWithScheme.Path << " shard #" << (NextShardIdx - 1)
+                    << " differs from the header of the first shard"
+                );
+            }
+        }
+        return true;
+    }
+
+    bool TFileLineDataReader::NextLine(TStringBuf* line) {
+        if (!UnreadData.NextTok('\n', *line)) {
+            return false;
+        }
+        line->ChopSuffix(TStringBuf("\r"));
+        return true;
+    }
+
+    bool TFileLineDataReader::StartNextShard() {
+        // empty shards are skipped
+        while (NextShardIdx < Shards.size()) {
+            const TBlob& shard = Shards[NextShardIdx++];
+            if (shard.Size()) {
+                UnreadData = TStringBuf(shard.AsCharPtr(), shard.Size());
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+    TStringBufLineReader::TStringBufLineReader(ILineDataReader* reader, size_t linesToKeep)
+        : Reader(reader)
+    {
+        CB_ENSURE_INTERNAL(linesToKeep > 0, "TStringBufLineReader: linesToKeep == 0");
+        if (!Reader->SupportsZeroCopyReadLine()) {
+            Buffers.resize(linesToKeep);
+        }
+    }
+
+    bool TStringBufLineReader::ReadLine(TStringBuf* line) {
+        if (Buffers.empty()) {
+            return Reader->ReadLineZeroCopy(line);
+        }
+        TString& buffer = Buffers[NextBufferIdx];
+        if (!Reader->ReadLine(&buffer)) {
+            return false;
+        }
+        NextBufferIdx = (NextBufferIdx + 1) % Buffers.size();
+        *line = buffer;
+        return true;
+    }
+
+
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> DefLineDataReaderReg("");
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> FileLineDataReaderReg("file");
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> DsvLineDataReaderReg("dsv");
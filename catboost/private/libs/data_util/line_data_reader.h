@@ -7,11 +7,17 @@
 #include <library/object_factory/object_factory.h>
 
 #include <util/generic/maybe.h>
+#include <util/generic/strbuf.h>
 #include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/memory/blob.h>
 
-#include <util/stream/file.h>
 
 
+namespace NPar {
+    class TLocalExecutor;
+}
+
 
 namespace NCB {
 
@@ -23,6 +29,7 @@ namespace NCB {
     struct TLineDataReaderArgs {
         TPathWithScheme PathWithScheme;
         TDsvFormatOptions Format;
+        NPar::TLocalExecutor* LocalExecutor = nullptr; // optional, used for parallel line counting
     };
 
 
@@ -42,6 +49,20 @@ namespace NCB {
         */
         virtual bool ReadLine(TString* line) = 0;
 
+        // true if ReadLineZeroCopy is available
+        virtual bool SupportsZeroCopyReadLine() const {
+            return false;
+        }
+
+        /* same as ReadLine, but line points to the reader's own data
+           that stays valid until the reader is destroyed
+           not thread-safe
+        */
+        virtual bool ReadLineZeroCopy(TStringBuf* /*line*/) {
+            CB_ENSURE_INTERNAL(false, "ReadLineZeroCopy is not supported by this line data reader");
+            Y_UNREACHABLE();
+        }
+
         virtual ~ILineDataReader() = default;
     };
 
@@ -49,51 +70,78 @@ namespace NCB {
         NObjectFactory::TParametrizedObjectFactory<ILineDataReader, TString, TLineDataReaderArgs>;
 
     THolder<ILineDataReader> GetLineDataReader(const TPathWithScheme& pathWithScheme,
-                                               const TDsvFormatOptions& format = {});
+                                               const TDsvFormatOptions& format = {},
+                                               NPar::TLocalExecutor* localExecutor = nullptr);
+
 
+    // lines are counted as by ReadLine: last line without trailing '\n' is counted as well
+    ui64 CountLines(TStringBuf data, NPar::TLocalExecutor* localExecutor = nullptr);
 
     int CountLines(const TString& poolFile);
 
+    /* Files are memory-mapped: lines are returned without copying the data and GetDataLineCount
+       counts newlines over the mapped data (in parallel if Args.LocalExecutor is specified).
+       GetDataLineCount does not change the reading position, so it can be called concurrently
+       with reading.
+
+       Path can specify several shards (see GetShardPaths), they are read one after another
+       as a single file. If the format has a header each shard must start with the same header.
+    */
     class TFileLineDataReader : public ILineDataReader {
     public:
-        TFileLineDataReader(const TLineDataReaderArgs& args)
-            : Args(args)
-            , IFStream(args.PathWithScheme.Path)
-            , HeaderProcessed(!Args.Format.HasHeader)
-        {}
-
-        ui64 GetDataLineCount() override {
-            ui64 nLines = (ui64)CountLines(Args.PathWithScheme.Path);
-            if (Args.Format.HasHeader) {
-                --nLines;
-            }
-            return nLines;
-        }
+        TFileLineDataReader(const TLineDataReaderArgs& args);
+
+        ui64 GetDataLineCount() override;
 
-        TMaybe<TString> GetHeader() override {
-            if (Args.Format.HasHeader) {
-                CB_ENSURE(!HeaderProcessed, "TFileLineDataReader: multiple calls to GetHeader");
-                TString header;
-                CB_ENSURE(IFStream.ReadLine(header), "TFileLineDataReader: no header in file");
-                HeaderProcessed = true;
-                return header;
-            }
+        // [shardIdx], shard line counts are computed concurrently if Args.LocalExecutor is specified
+        TVector<ui64> GetShardDataLineCounts();
 
-            return {};
+        size_t GetShardCount() const {
+            return Shards.size();
         }
 
-        bool ReadLine(TString* line) override {
-            // skip header if it hasn't been read
-            if (!HeaderProcessed) {
-                GetHeader();
-            }
-            return IFStream.ReadLine(*line) != 0;
+        TMaybe<TString> GetHeader() override;
+
+        bool ReadLine(TString* line) override;
+
+        bool SupportsZeroCopyReadLine() const override {
+            return true;
         }
 
+        bool ReadLineZeroCopy(TStringBuf* line) override;
+
+    private:
+        bool NextLine(TStringBuf* line);
+
+        // returns false if there're no more shards
+        bool StartNextShard();
+
     private:
         TLineDataReaderArgs Args;
-        TIFStream IFStream;
+        TVector<TBlob> Shards;
+        size_t NextShardIdx = 0;
+        TStringBuf UnreadData;
+        TMaybe<TString> Header;
         bool HeaderProcessed;
     };
 
+
+    /* Provides lines as TStringBuf for any ILineDataReader.
+       If the reader supports zero-copy reading lines point to the reader's data,
+       otherwise they are copied to a ring of linesToKeep buffers,
+       so line data stays valid until linesToKeep more lines are read.
+    */
+    class TStringBufLineReader {
+    public:
+        TStringBufLineReader(ILineDataReader* reader, size_t linesToKeep);
+
+        // not thread-safe
+        bool ReadLine(TStringBuf* line);
+
+    private:
+        ILineDataReader* Reader;
+        TVector<TString> Buffers; // empty if Reader supports zero-copy reading
+        size_t NextBufferIdx = 0;
+    };
+
 }
@@ -0,0 +1,91 @@
+#include "path_shards.h"
+
+#include <util/folder/path.h>
+#include <util/generic/algorithm.h>
+#include <util/string/split.h>
+#include <util/system/fs.h>
+
+
+namespace NCB {
+
+    bool MatchesWildcardPattern(TStringBuf name, TStringBuf pattern) {
+        // greedy matching with backtracking to the last '*'
+        size_t nameIdx = 0;
+        size_t patternIdx = 0;
+        size_t lastStarPatternIdx = TStringBuf::npos;
+        size_t lastStarNameIdx = 0;
+        while (nameIdx < name.size()) {
+            if ((patternIdx < pattern.size())
+                && ((pattern[patternIdx] == '?') || (pattern[patternIdx] == name[nameIdx])))
+            {
+                ++nameIdx;
+                ++patternIdx;
+            } else if ((patternIdx < pattern.size()) && (pattern[patternIdx] == '*')) {
+                lastStarPatternIdx = patternIdx++;
+                lastStarNameIdx = nameIdx;
+            } else if (lastStarPatternIdx != TStringBuf::npos) {
+                patternIdx = lastStarPatternIdx + 1;
+                nameIdx = ++lastStarNameIdx;
+            } else {
+                return false;
+            }
+        }
+        while ((patternIdx < pattern.size()) && (pattern[patternIdx] == '*')) {
+            ++patternIdx;
+        }
+        return patternIdx == pattern.size();
+    }
+
+    static bool IsWildcardPattern(TStringBuf path) {
+        return path.find_first_of("*?") != TStringBuf::npos;
+    }
+
+    static void AddDirectoryFiles(const TFsPath& dir, TStringBuf namePattern, TVector<TString>* shardPaths) {
+        TVector<TString> names;
+        dir.ListNames(names);
+        Sort(names);
+        for (const auto& name : names) {
+            if (name.StartsWith(".") || (namePattern && !MatchesWildcardPattern(name, namePattern))) {
+                continue;
+            }
+            const TFsPath child = dir / name;
+            if (child.IsFile()) {
+                shardPaths->push_back(child.GetPath());
+            }
+        }
+    }
+
+    // returns false if item does not match anything
+    static bool AddShardPaths(const TString& item, TVector<TString>* shardPaths) {
+        const size_t sizeBefore = shardPaths->size();
+        const TFsPath path(item);
+        if (path.IsFile()) {
+            shardPaths->push_back(item);
+        } else if (path.IsDirectory()) {
+            AddDirectoryFiles(path, TStringBuf(), shardPaths);
+        } else if (IsWildcardPattern(path.GetName())) {
+            const TFsPath dir = path.Parent();
+            if (dir.IsDirectory()) {
+                AddDirectoryFiles(dir, path.GetName(), shardPaths);
+            }
+        }
+        return shardPaths->size() > sizeBefore;
+    }
+
+    TVector<TString> GetShardPaths(const TString& path) {
+        TVector<TString> shardPaths;
+        if (NFs::Exists(path) || (path.find(',') == TString::npos)) {
+            if (!AddShardPaths(path, &shardPaths)) {
+                shardPaths.clear();
+            }
+            return shardPaths;
+        }
+        for (const auto& item : StringSplitter(path).Split(',').SkipEmpty()) {
+            if (!AddShardPaths(TString(item.Token()), &shardPaths)) {
+                return {};
+            }
+        }
+        return shardPaths;
+    }
+
+}
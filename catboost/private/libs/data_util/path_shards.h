@@ -0,0 +1,25 @@
+#pragma once
+
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+
+
+namespace NCB {
+
+    /* Local file data paths can specify several files (shards) that are read as one
+     *  concatenated file:
+     *   - a directory: all files in it except hidden ones (with names starting with '.')
+     *   - a pattern with '*' and '?' wildcards in the last path component
+     *   - a comma-separated list of items of any kind above or plain file paths
+     *
+     * Shards from a directory or a pattern are ordered by name, list items keep their order.
+     * A path to an existing file is always a single shard even if it contains ',', '*' or '?'.
+     *
+     * Returns empty vector if some of the list items does not match any existing file.
+     */
+    TVector<TString> GetShardPaths(const TString& path);
+
+    // '*' matches any sequence of characters, '?' matches any single character
+    bool MatchesWildcardPattern(TStringBuf name, TStringBuf pattern);
+
+}
@@ -0,0 +1,184 @@
+#include <catboost/private/libs/data_util/line_data_reader.h>
+#include <catboost/private/libs/data_util/path_shards.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/folder/path.h>
+#include <util/folder/tempdir.h>
+#include <util/generic/xrange.h>
+#include <util/stream/file.h>
+#include <util/system/mktemp.h>
+#include <util/system/tempfile.h>
+
+#include <library/unittest/registar.h>
+
+
+using namespace NCB;
+
+
+namespace {
+    // reader without zero-copy support
+    class TVectorLineDataReader : public ILineDataReader {
+    public:
+        explicit TVectorLineDataReader(TVector<TString> lines)
+            : Lines(std::move(lines))
+        {}
+
+        ui64 GetDataLineCount() override {
+            return Lines.size();
+        }
+
+        TMaybe<TString> GetHeader() override {
+            return {};
+        }
+
+        bool ReadLine(TString* line) override {
+            if (LineIdx == Lines.size()) {
+                return false;
+            }
+            *line = Lines[LineIdx++];
+            return true;
+        }
+
+    private:
+        TVector<TString> Lines;
+        size_t LineIdx = 0;
+    };
+}
+
+
+static TVector<TString> ReadAllLines(ILineDataReader* reader) {
+    TVector<TString> lines;
+    for (TString line; reader->ReadLine(&line); ) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+
+Y_UNIT_TEST_SUITE(LineDataReader) {
+    Y_UNIT_TEST(FileLineDataReader) {
+        TTempFile dataFile(MakeTempName());
+        TOFStream(dataFile.Name()).Write("a\tb\nl1\r\n\nl3");
+
+        for (bool hasHeader : {false, true}) {
+            auto reader = GetLineDataReader(TPathWithScheme(dataFile.Name()), TDsvFormatOptions{hasHeader, '\t'});
+
+            UNIT_ASSERT_VALUES_EQUAL(reader->GetDataLineCount(), hasHeader ? 3 : 4);
+            if (hasHeader) {
+                UNIT_ASSERT_VALUES_EQUAL(*reader->GetHeader(), "a\tb");
+            }
+            TVector<TString> expectedLines = {"l1", "", "l3"};
+            if (!hasHeader) {
+                expectedLines.insert(expectedLines.begin(), "a\tb");
+            }
+            UNIT_ASSERT_VALUES_EQUAL(ReadAllLines(reader.Get()), expectedLines);
+        }
+    }
+
+    Y_UNIT_TEST(FileLineDataReaderEmptyFile) {
+        TTempFile dataFile(MakeTempName());
+        TOFStream(dataFile.Name()).Finish();
+
+        auto reader = GetLineDataReader(TPathWithScheme(dataFile.Name()));
+        UNIT_ASSERT_VALUES_EQUAL(reader->GetDataLineCount(), 0);
+        TStringBuf line;
+        UNIT_ASSERT(!reader->ReadLineZeroCopy(&line));
+    }
+
+    Y_UNIT_TEST(FileLineDataReaderShards) {
+        TTempDir dataDir;
+        const TFsPath dataDirPath(dataDir.Name());
+        TOFStream((dataDirPath / "part-1.tsv").GetPath()).Write("h\nl2\nl3\n");
+        TOFStream((dataDirPath / "part-0.tsv").GetPath()).Write("h\nl0\nl1");
+        TOFStream((dataDirPath / "part-2.tsv").GetPath()).Finish();
+        TOFStream((dataDirPath / "part-3.tsv").GetPath()).Write("h\nl4\n");
+        TOFStream((dataDirPath / ".hidden").GetPath()).Write("h\nhidden\n");
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        const TString partPath = (dataDirPath / "part-").GetPath();
+        for (const auto& path : {dataDir.Name(), partPath + "?.tsv", partPath + "*"}) {
+            for (auto* executor : {(NPar::TLocalExecutor*)nullptr, &localExecutor}) {
+                TFileLineDataReader reader(TLineDataReaderArgs{TPathWithScheme(path), {true, '\t'}, executor});
+
+                UNIT_ASSERT_VALUES_EQUAL(reader.GetShardCount(), 4);
+                UNIT_ASSERT_VALUES_EQUAL(reader.GetShardDataLineCounts(), (TVector<ui64>{2, 2, 0, 1}));
+                UNIT_ASSERT_VALUES_EQUAL(reader.GetDataLineCount(), 5);
+                UNIT_ASSERT_VALUES_EQUAL(*reader.GetHeader(), "h");
+                UNIT_ASSERT_VALUES_EQUAL(ReadAllLines(&reader), (TVector<TString>{"l0", "l1", "l2", "l3", "l4"}));
+            }
+        }
+
+        // list keeps the order of items
+        const TString listPath = partPath + "3.tsv," + partPath + "0.tsv";
+        auto reader = GetLineDataReader(TPathWithScheme(listPath), TDsvFormatOptions{true, '\t'});
+        UNIT_ASSERT_VALUES_EQUAL(reader->GetDataLineCount(), 3);
+        UNIT_ASSERT_VALUES_EQUAL(ReadAllLines(reader.Get()), (TVector<TString>{"l4", "l0", "l1"}));
+
+        UNIT_ASSERT(GetShardPaths(partPath + "3.tsv," + partPath + "9.tsv").empty());
+        UNIT_ASSERT(GetShardPaths(partPath + "9*").empty());
+
+        // headers must be the same
+        TOFStream((dataDirPath / "part-4.tsv").GetPath()).Write("other header\nl5\n");
+        auto readerWithDifferentHeaders = GetLineDataReader(TPathWithScheme(dataDir.Name()), TDsvFormatOptions{true, '\t'});
+        UNIT_ASSERT_EXCEPTION(ReadAllLines(readerWithDifferentHeaders.Get()), TCatBoostException);
+    }
+
+    Y_UNIT_TEST(MatchesWildcardPattern) {
+        UNIT_ASSERT(MatchesWildcardPattern("part-00001.tsv", "part-*.tsv"));
+        UNIT_ASSERT(MatchesWildcardPattern("part-00001.tsv", "*"));
+        UNIT_ASSERT(MatchesWildcardPattern("part-00001.tsv", "part-0000?.tsv"));
+        UNIT_ASSERT(MatchesWildcardPattern("a.tsv.tsv", "*.tsv"));
+        UNIT_ASSERT(MatchesWildcardPattern("", "*"));
+        UNIT_ASSERT(!MatchesWildcardPattern("part-00001.tsv", "part-?.tsv"));
+        UNIT_ASSERT(!MatchesWildcardPattern("part-00001.tsv.gz", "*.tsv"));
+        UNIT_ASSERT(!MatchesWildcardPattern("", "?"));
+    }
+
+    Y_UNIT_TEST(CountLines) {
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        // spans several parallel counting chunks
+        TString data;
+        for (auto i : xrange(3000000)) {
+            data += (i % 7 == 0) ? "\n" : "some line\n";
+        }
+
+        for (auto* executor : {(NPar::TLocalExecutor*)nullptr, &localExecutor}) {
+            UNIT_ASSERT_VALUES_EQUAL(CountLines(TStringBuf(data), executor), 3000000);
+            UNIT_ASSERT_VALUES_EQUAL(CountLines(TStringBuf(data).Chop(1), executor), 3000000);
+            UNIT_ASSERT_VALUES_EQUAL(CountLines(data + "no newline", executor), 3000001);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(CountLines(TStringBuf()), 0);
+    }
+
+    Y_UNIT_TEST(StringBufLineReader) {
+        TTempFile dataFile(MakeTempName());
+        TOFStream(dataFile.Name()).Write("l0\nl1\nl2\nl3\n");
+
+        auto fileReader = GetLineDataReader(TPathWithScheme(dataFile.Name()));
+        TVectorLineDataReader vectorReader({"l0", "l1", "l2", "l3"});
+
+        for (ILineDataReader* reader : {fileReader.Get(), (ILineDataReader*)&vectorReader}) {
+            TStringBufLineReader lineReader(reader, /*linesToKeep*/ 2);
+
+            TStringBuf line0;
+            TStringBuf line1;
+            UNIT_ASSERT(lineReader.ReadLine(&line0));
+            UNIT_ASSERT(lineReader.ReadLine(&line1));
+            UNIT_ASSERT_VALUES_EQUAL(line0, "l0");
+            UNIT_ASSERT_VALUES_EQUAL(line1, "l1");
+
+            TStringBuf line;
+            UNIT_ASSERT(lineReader.ReadLine(&line));
+            UNIT_ASSERT_VALUES_EQUAL(line, "l2");
+            UNIT_ASSERT_VALUES_EQUAL(line1, "l1");
+            UNIT_ASSERT(lineReader.ReadLine(&line));
+            UNIT_ASSERT_VALUES_EQUAL(line, "l3");
+            UNIT_ASSERT(!lineReader.ReadLine(&line));
+        }
+    }
+}
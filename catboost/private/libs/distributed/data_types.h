@@ -1,5 +1,7 @@
 #pragma once
 
+#include "stats_transport.h"
+
 #include <catboost/private/libs/algo/calc_score_cache.h>
 #include <catboost/private/libs/algo/fold.h>
 #include <catboost/private/libs/algo/learn_context.h>
@@ -41,6 +43,25 @@ namespace NCatboostDistributed {
 
     using TWorkerPairwiseStats = TVector<TVector<TPairwiseStats>>; // [cand][subCand]
 
+    // [cand][subCand][bucket], empty for candidates of other workers
+    using TWorkerCandidatesScores = TVector<TVector<TVector<double>>>;
+
+    struct TCandidateScores {
+        TVector<TVector<double>> Scores; // [subCand][bucket]
+        ui64 StatsTransportBytes = 0; // approximate size of bucket stats sent between hosts to get Scores
+
+    public:
+        SAVELOAD(Scores, StatsTransportBytes);
+    };
+
+    struct TApproxUpdaterParams {
+        TVector<TVector<double>> AverageLeafValues; // [dim][leaf]
+        bool SetDerivatives = false; // calc derivatives for the next tree right after the approx update
+
+    public:
+        SAVELOAD(AverageLeafValues, SetDerivatives);
+    };
+
     struct TTrainData : public IObjectBase {
         NCB::TTrainingForCPUDataProviderPtr TrainData;
 
@@ -130,7 +151,7 @@ namespace NCatboostDistributed {
         NCB::TTrainingForCPUDataProviderPtr TrainData;
         TVector<TString> ClassNamesFromDataset;
 
-        TFlatPairsInfo FlatPairs;
+        TCompactPairs CompactPairs;
 
     public:
         TLocalTensorSearchData()
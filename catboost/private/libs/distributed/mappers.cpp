@@ -27,6 +27,36 @@
 
 namespace NCatboostDistributed {
 
+    // output = outputsFromAllWorkers[0] + ... , addFunc(const TOutput& increment, TOutput* total)
+    template <typename TOutput, typename TAddFunc>
+    static void ReduceOutputs(TVector<TOutput>* outputsFromAllWorkers, TAddFunc addFunc, TOutput* output) {
+        Y_ASSERT(!outputsFromAllWorkers->empty());
+        *output = std::move((*outputsFromAllWorkers)[0]);
+        for (auto workerIdx : xrange<size_t>(1, outputsFromAllWorkers->size())) {
+            addFunc((*outputsFromAllWorkers)[workerIdx], output);
+        }
+    }
+
+    static void SetDerivatives(TLocalTensorSearchData* localData) {
+        Y_ASSERT(localData->Progress->AveragingFold.BodyTailArr.ysize() == 1);
+        const auto error = BuildError(localData->Params, /*custom objective*/Nothing());
+        CalcWeightedDerivatives(
+            *error,
+            /*bodyTailIdx*/0,
+            localData->Params,
+            localData->Progress->Rand.GenRand(),
+            &localData->Progress->AveragingFold,
+            &NPar::LocalExecutor());
+    }
+
+    // with EDistributedPartitioning::Features workers must make the same random choices (bootstrap etc.)
+    static ui64 GetWorkerRandomSeed(ui64 randomSeed, int hostId, const NCatboostOptions::TCatBoostOptions& params) {
+        if (params.SystemOptions->DistributedPartitioning == EDistributedPartitioning::Features) {
+            return randomSeed;
+        }
+        return randomSeed + hostId;
+    }
+
     static NCB::TTrainingForCPUDataProviderPtr GetTrainData(NPar::TCtxPtr<TTrainData> trainData) {
         if (trainData != nullptr) {
             return trainData->TrainData;
@@ -89,15 +119,22 @@ namespace NCatboostDistributed {
         TOutput* /*unused*/
     ) const {
         auto& localData = TLocalTensorSearchData::GetRef();
+        NCatboostOptions::TCatBoostOptions catBoostOptions(ETaskType::CPU);
+        catBoostOptions.Load(GetJson(params->TrainOptions));
         if (localData.Rand == nullptr) {
-            localData.Rand = new TRestorableFastRng64(params->RandomSeed + hostId);
+            localData.Rand = new TRestorableFastRng64(
+                GetWorkerRandomSeed(params->RandomSeed, hostId, catBoostOptions));
         }
 
         const int workerCount = ctx->GetHostIdCount();
         CATBOOST_DEBUG_LOG << "Worker count " << workerCount << Endl;
-        const auto workerParts = WorkaroundSplit(params->ObjectsGrouping, workerCount);
-        const ui32 loadStart = workerParts[hostId].Begin;
-        const ui32 loadEnd = workerParts[hostId].End;
+        ui32 loadStart = 0;
+        ui32 loadEnd = params->ObjectsGrouping.GetObjectCount();
+        if (catBoostOptions.SystemOptions->DistributedPartitioning == EDistributedPartitioning::Objects) {
+            const auto workerParts = WorkaroundSplit(params->ObjectsGrouping, workerCount);
+            loadStart = workerParts[hostId].Begin;
+            loadEnd = workerParts[hostId].End;
+        }
 
         const auto poolLoadOptions = params->PoolLoadOptions;
         TProfileInfo profile;
@@ -112,8 +149,6 @@ namespace NCatboostDistributed {
             &profile
         );
 
-        NCatboostOptions::TCatBoostOptions catBoostOptions(ETaskType::CPU);
-        catBoostOptions.Load(GetJson(params->TrainOptions));
         TLabelConverter labelConverter;
         auto quantizedFeaturesInfo = MakeIntrusive<NCB::TQuantizedFeaturesInfo>(
             params->FeaturesLayout,
@@ -150,14 +185,16 @@ namespace NCatboostDistributed {
     ) const {
         NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
         auto& localData = TLocalTensorSearchData::GetRef();
-        if (localData.Rand == nullptr) { // may be set by TDatasetLoader
-            localData.Rand = new TRestorableFastRng64(params->RandomSeed + hostId);
-        }
 
         auto trainParamsJson = GetJson(params->TrainParams);
         UpdateUndefinedClassNames(localData.ClassNamesFromDataset, &trainParamsJson);
         localData.Params.Load(trainParamsJson);
 
+        if (localData.Rand == nullptr) { // may be set by TDatasetLoader
+            localData.Rand = new TRestorableFastRng64(
+                GetWorkerRandomSeed(params->RandomSeed, hostId, localData.Params));
+        }
+
         const auto& trainParams = localData.Params;
 
         NCB::TTrainingForCPUDataProviders trainingDataProviders;
@@ -175,7 +212,7 @@ namespace NCatboostDistributed {
             trainingDataProviders,
             params->ApproxDimension,
             TLabelConverter(), // unused in case of localData
-            params->RandomSeed + hostId,
+            GetWorkerRandomSeed(params->RandomSeed, hostId, trainParams),
             /*initRand*/ localData.Rand.Get(),
             foldsCreationParams,
             /*datasetsCanContainBaseline*/ true,
@@ -297,7 +334,7 @@ namespace NCatboostDistributed {
             &localData.SampledDocs,
             &NPar::LocalExecutor(),
             &localData.Progress->Rand);
-        localData.FlatPairs = UnpackPairsFromQueries(localData.Progress->AveragingFold.LearnQueriesInfo);
+        localData.CompactPairs = UnpackCompactPairsFromQueries(localData.Progress->AveragingFold.LearnQueriesInfo);
     }
 
     template <typename TMapFunc, typename TInputType, typename TOutputType>
@@ -359,7 +396,7 @@ namespace NCatboostDistributed {
     }
 
     static void CalcPairwiseStats(const NPar::TCtxPtr<TTrainData>& trainData,
-        const TFlatPairsInfo& pairs,
+        const TCompactPairs& pairs,
         const TCandidateInfo& candidate,
         TPairwiseStats* pairwiseStats
     ) {
@@ -397,6 +434,24 @@ namespace NCatboostDistributed {
         MapCandidateList(calcStats3D, *candidateList, bucketStats);
     }
 
+    void TScoreCalcer::DoReduce(TVector<TOutput>* statsFromAllWorkers, TOutput* stats) const {
+        ReduceOutputs(
+            statsFromAllWorkers,
+            [] (const TStats5D& increment, TStats5D* total) {
+                Y_ASSERT(increment.size() == total->size());
+                NPar::ParallelFor(
+                    0,
+                    total->ysize(),
+                    [&] (int candidateIdx) {
+                        auto& totalCandidateStats = (*total)[candidateIdx];
+                        for (auto subcandidateIdx : xrange(totalCandidateStats.size())) {
+                            totalCandidateStats[subcandidateIdx].Add(increment[candidateIdx][subcandidateIdx]);
+                        }
+                    });
+            },
+            stats);
+    }
+
     void TPairwiseScoreCalcer::DoMap(
         NPar::IUserContext* ctx,
         int hostId,
@@ -406,7 +461,7 @@ namespace NCatboostDistributed {
         NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
         auto& localData = TLocalTensorSearchData::GetRef();
         auto calcPairwiseStats = [&](const TCandidateInfo& candidate, TPairwiseStats* pairwiseStats) {
-            CalcPairwiseStats(trainData, localData.FlatPairs, candidate, pairwiseStats);
+            CalcPairwiseStats(trainData, localData.CompactPairs, candidate, pairwiseStats);
         };
         MapCandidateList(calcPairwiseStats, *candidateList, bucketStats);
     }
@@ -421,7 +476,7 @@ namespace NCatboostDistributed {
         NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
         auto& localData = TLocalTensorSearchData::GetRef();
         auto calcPairwiseStats = [&](const TCandidateInfo& candidate, TPairwiseStats* pairwiseStats) {
-            CalcPairwiseStats(trainData, localData.FlatPairs, candidate, pairwiseStats);
+            CalcPairwiseStats(trainData, localData.CompactPairs, candidate, pairwiseStats);
         };
         MapVector(calcPairwiseStats, candidate->Candidates, bucketStats);
     }
@@ -466,7 +521,7 @@ namespace NCatboostDistributed {
         MapVector(getScores, *bucketStats, scores);
     }
 
-    // subcandidates -> TStats4D
+    // subcandidates -> TCompactStats4D
     void TRemoteBinCalcer::DoMap(
         NPar::IUserContext* ctx,
         int hostId,
@@ -474,29 +529,34 @@ namespace NCatboostDistributed {
         TOutput* bucketStats
     ) const {
         NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
-        auto calcStats3D = [&](const TCandidateInfo& candidate, TStats3D* stats3D) {
-            CalcStats3D(trainData, candidate, stats3D);
+        const auto codec = TLocalTensorSearchData::GetRef().Params.SystemOptions->DistributedStatsCodec.Get();
+        auto calcStats3D = [&](const TCandidateInfo& candidate, TCompactStats3D* compactStats3D) {
+            TStats3D stats3D;
+            CalcStats3D(trainData, candidate, &stats3D);
+            *compactStats3D = PackStats3D(stats3D, codec);
         };
         MapVector(calcStats3D, candidatesInfoList->Candidates, bucketStats);
     }
 
-    // vector<TStats4D> -> TStats4D
+    // vector<TCompactStats4D> -> TCompactStats4D
     void TRemoteBinCalcer::DoReduce(TVector<TOutput>* statsFromAllWorkers, TOutput* stats) const {
         const int workerCount = statsFromAllWorkers->ysize();
         const int bucketCount = (*statsFromAllWorkers)[0].ysize();
-        stats->yresize(bucketCount);
+        stats->resize(bucketCount);
         NPar::ParallelFor(
             0,
             bucketCount,
             [&] (int bucketIdx) {
-                (*stats)[bucketIdx] = (*statsFromAllWorkers)[0][bucketIdx];
-                for (int workerIdx = 1; workerIdx < workerCount; ++workerIdx) {
-                    (*stats)[bucketIdx].Add((*statsFromAllWorkers)[workerIdx][bucketIdx]);
+                TVector<const TCompactStats3D*> bucketStatsFromAllWorkers;
+                bucketStatsFromAllWorkers.reserve(workerCount);
+                for (int workerIdx = 0; workerIdx < workerCount; ++workerIdx) {
+                    bucketStatsFromAllWorkers.push_back(&(*statsFromAllWorkers)[workerIdx][bucketIdx]);
                 }
+                (*stats)[bucketIdx] = ReducePackedStats3D(bucketStatsFromAllWorkers);
             });
     }
 
-    // TStats4D -> TVector<TVector<double>> [subcandidate][bucket]
+    // TCompactStats4D -> TCandidateScores
     void TRemoteScoreCalcer::DoMap(
         NPar::IUserContext* /*ctx*/,
         int /*hostId*/,
@@ -505,21 +565,63 @@ namespace NCatboostDistributed {
     ) const {
         const auto& localData = TLocalTensorSearchData::GetRef();
         const auto getScores =
-            [&] (const TStats3D& candidateStats3D, TVector<double>* candidateScores) {
-                *candidateScores = GetScores(candidateStats3D,
+            [&] (const TCompactStats3D& candidateCompactStats3D, TVector<double>* candidateScores) {
+                *candidateScores = GetScores(UnpackStats3D(candidateCompactStats3D),
                                              localData.Depth,
                                              localData.SumAllWeights,
                                              localData.AllDocCount,
                                              localData.Params);
             };
-        MapVector(getScores, *bucketStats, scores);
+        MapVector(getScores, *bucketStats, &scores->Scores);
+        scores->StatsTransportBytes = 0;
+        for (const auto& candidateCompactStats3D : *bucketStats) {
+            scores->StatsTransportBytes += candidateCompactStats3D.TransportBytes;
+        }
+    }
+
+    void TFeatureParallelScoreCalcer::DoMap(
+        NPar::IUserContext* ctx,
+        int hostId,
+        TInput* candidateList,
+        TOutput* scores
+    ) const {
+        NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
+        const auto& localData = TLocalTensorSearchData::GetRef();
+        const int workerCount = ctx->GetHostIdCount();
+        scores->resize(candidateList->size());
+        NPar::ParallelFor(
+            0,
+            candidateList->ysize(),
+            [&] (int candidateIdx) {
+                const auto& subcandidates = (*candidateList)[candidateIdx].Candidates;
+                Y_ASSERT(!subcandidates.empty());
+                /* owner is defined by the split ensemble rather than the position in the list
+                 * for the tree level stats cache to have the same candidates on each depth
+                 */
+                const size_t ownerIdx = subcandidates[0].SplitEnsemble.GetHash() % workerCount;
+                if (ownerIdx != (size_t)hostId) {
+                    return;
+                }
+                auto& candidateScores = (*scores)[candidateIdx];
+                candidateScores.resize(subcandidates.size());
+                for (auto subcandidateIdx : xrange(subcandidates.size())) {
+                    TStats3D stats3D;
+                    CalcStats3D(trainData, subcandidates[subcandidateIdx], &stats3D);
+                    candidateScores[subcandidateIdx] = GetScores(
+                        stats3D,
+                        localData.Depth,
+                        localData.SumAllWeights,
+                        localData.AllDocCount,
+                        localData.Params);
+                }
+            });
     }
 
     void TLeafIndexSetter::DoMap(
         NPar::IUserContext* ctx,
         int hostId,
         TInput* bestSplit,
-        TOutput* /*unused*/
+        TOutput* isLeafEmpty
     ) const {
         Y_ASSERT(bestSplit->Type != ESplitType::OnlineCtr);
         auto& localData = TLocalTensorSearchData::GetRef();
@@ -540,19 +642,23 @@ namespace NCatboostDistributed {
                     &NPar::LocalExecutor());
             }
         }
-    }
-
-    void TEmptyLeafFinder::DoMap(
-        NPar::IUserContext* /*ctx*/,
-        int /*hostId*/,
-        TInput* /*unused*/,
-        TOutput* isLeafEmpty
-    ) const {
-        auto& localData = TLocalTensorSearchData::GetRef();
+        // reported in the same map step to save a round trip to the master
         *isLeafEmpty = GetIsLeafEmpty(localData.Depth + 1, localData.Indices);
         ++localData.Depth; // tree level completed
     }
 
+    void TLeafIndexSetter::DoReduce(TVector<TOutput>* isLeafEmptyFromAllWorkers, TOutput* isLeafEmpty) const {
+        ReduceOutputs(
+            isLeafEmptyFromAllWorkers,
+            [] (const TIsLeafEmpty& increment, TIsLeafEmpty* total) {
+                Y_ASSERT(increment.size() == total->size());
+                for (auto leafIdx : xrange(total->size())) {
+                    (*total)[leafIdx] = (*total)[leafIdx] && increment[leafIdx];
+                }
+            },
+            isLeafEmpty);
+    }
+
     void TBucketSimpleUpdater::DoMap(
         NPar::IUserContext* /*ctx*/,
         int /*hostId*/,
@@ -588,10 +694,36 @@ namespace NCatboostDistributed {
             &NPar::LocalExecutor(),
             &localData.Buckets,
             &localData.PairwiseBuckets,
-            &weightedDers);
+            weightedDers);
         *sums = std::make_pair(localData.Buckets, localData.PairwiseBuckets);
     }
 
+    void TBucketSimpleUpdater::DoReduce(TVector<TOutput>* sumsFromAllWorkers, TOutput* sums) const {
+        ReduceOutputs(
+            sumsFromAllWorkers,
+            [] (const TOutput& increment, TOutput* total) {
+                Y_ASSERT(increment.first.size() == total->first.size());
+                for (auto leafIdx : xrange(total->first.size())) {
+                    auto& totalSum = total->first[leafIdx];
+                    const auto& incrementSum = increment.first[leafIdx];
+                    totalSum.SumDer += incrementSum.SumDer;
+                    totalSum.SumDer2 += incrementSum.SumDer2;
+                    totalSum.SumWeights += incrementSum.SumWeights;
+                }
+                auto& totalPairwise = total->second;
+                const auto& incrementPairwise = increment.second;
+                Y_ASSERT(
+                    incrementPairwise.GetXSize() == totalPairwise.GetXSize()
+                    && incrementPairwise.GetYSize() == totalPairwise.GetYSize());
+                for (size_t winnerIdx = 0; winnerIdx < totalPairwise.GetYSize(); ++winnerIdx) {
+                    for (size_t loserIdx = 0; loserIdx < totalPairwise.GetXSize(); ++loserIdx) {
+                        totalPairwise[winnerIdx][loserIdx] += incrementPairwise[winnerIdx][loserIdx];
+                    }
+                }
+            },
+            sums);
+    }
+
     void TCalcApproxStarter::DoMap(
         NPar::IUserContext* ctx,
         int hostId,
@@ -649,7 +781,7 @@ namespace NCatboostDistributed {
     void TApproxUpdater::DoMap(
         NPar::IUserContext* /*unused*/,
         int /*unused*/,
-        TInput* averageLeafValues,
+        TInput* params,
         TOutput* /*unused*/
     ) const {
         auto& localData = TLocalTensorSearchData::GetRef();
@@ -674,9 +806,12 @@ namespace NCatboostDistributed {
             };
         UpdateApprox(
             updateAvrgApprox,
-            *averageLeafValues,
+            params->AverageLeafValues,
             &localData.Progress->AvrgApprox,
             &NPar::LocalExecutor());
+        if (params->SetDerivatives) {
+            SetDerivatives(&localData);
+        }
     }
 
     void TDerivativeSetter::DoMap(
@@ -685,16 +820,7 @@ namespace NCatboostDistributed {
         TInput* /*unused*/,
         TOutput* /*unused*/
     ) const {
-        auto& localData = TLocalTensorSearchData::GetRef();
-        Y_ASSERT(localData.Progress->AveragingFold.BodyTailArr.ysize() == 1);
-        const auto error = BuildError(localData.Params, /*custom objective*/Nothing());
-        CalcWeightedDerivatives(
-            *error,
-            /*bodyTailIdx*/0,
-            localData.Params,
-            localData.Progress->Rand.GenRand(),
-            &localData.Progress->AveragingFold,
-            &NPar::LocalExecutor());
+        SetDerivatives(&TLocalTensorSearchData::GetRef());
     }
 
     void TBucketMultiUpdater::DoMap(
@@ -722,6 +848,22 @@ namespace NCatboostDistributed {
         *sums = std::make_pair(localData.MultiBuckets, TUnusedInitializedParam());
     }
 
+    void TBucketMultiUpdater::DoReduce(TVector<TOutput>* sumsFromAllWorkers, TOutput* sums) const {
+        ReduceOutputs(
+            sumsFromAllWorkers,
+            [] (const TOutput& increment, TOutput* total) {
+                Y_ASSERT(increment.first.size() == total->first.size());
+                for (auto leafIdx : xrange(total->first.size())) {
+                    auto& totalSum = total->first[leafIdx];
+                    const auto& incrementSum = increment.first[leafIdx];
+                    AddElementwise(incrementSum.SumDer, &totalSum.SumDer);
+                    totalSum.SumDer2.AddDer2(incrementSum.SumDer2);
+                    totalSum.SumWeights += incrementSum.SumWeights;
+                }
+            },
+            sums);
+    }
+
     void TDeltaMultiUpdater::DoMap(
         NPar::IUserContext* /*ctx*/,
         int /*hostId*/,
@@ -776,6 +918,18 @@ namespace NCatboostDistributed {
         }
     }
 
+    void TErrorCalcer::DoReduce(TVector<TOutput>* additiveStatsFromAllWorkers, TOutput* additiveStats) const {
+        ReduceOutputs(
+            additiveStatsFromAllWorkers,
+            [] (const TOutput& increment, TOutput* total) {
+                for (auto& [description, stats] : *total) {
+                    Y_ASSERT(increment.contains(description));
+                    stats.Add(increment.at(description));
+                }
+            },
+            additiveStats);
+    }
+
     void TLeafWeightsGetter::DoMap(
         NPar::IUserContext* ctx,
         int hostId,
@@ -792,6 +946,15 @@ namespace NCatboostDistributed {
             GetWeights(*GetTrainData(trainData)->TargetData));
     }
 
+    void TLeafWeightsGetter::DoReduce(TVector<TOutput>* leafWeightsFromAllWorkers, TOutput* leafWeights) const {
+        ReduceOutputs(
+            leafWeightsFromAllWorkers,
+            [] (const TVector<double>& increment, TVector<double>* total) {
+                AddElementwise(increment, total);
+            },
+            leafWeights);
+    }
+
     void TQuantileLeafDeltasCalcer::DoMap(
             NPar::IUserContext* /*unused*/,
             int /*unused*/,
@@ -821,6 +984,32 @@ namespace NCatboostDistributed {
         *out = answer;
     }
 
+    // merges sorted samples of each leaf
+    void TQuantileLeafDeltasCalcer::DoReduce(TVector<TOutput>* leafValuesFromAllWorkers, TOutput* leafValues) const {
+        ReduceOutputs(
+            leafValuesFromAllWorkers,
+            [] (const TOutput& increment, TOutput* total) {
+                Y_ASSERT(increment.size() == total->size());
+                NPar::ParallelFor(
+                    0,
+                    total->ysize(),
+                    [&] (int leafIdx) {
+                        auto& totalSamples = (*total)[leafIdx];
+                        const auto& incrementSamples = increment[leafIdx];
+                        TVector<std::pair<float, float>> merged;
+                        merged.yresize(totalSamples.size() + incrementSamples.size());
+                        std::merge(
+                            totalSamples.begin(),
+                            totalSamples.end(),
+                            incrementSamples.begin(),
+                            incrementSamples.end(),
+                            merged.begin());
+                        totalSamples = std::move(merged);
+                    });
+            },
+            leafValues);
+    }
+
 } // NCatboostDistributed
 
 using namespace NCatboostDistributed;
@@ -833,7 +1022,6 @@ REGISTER_SAVELOAD_NM_CLASS(0xd66d485, NCatboostDistributed, TScoreCalcer);
 REGISTER_SAVELOAD_NM_CLASS(0xd66d585, NCatboostDistributed, TRemoteBinCalcer);
 REGISTER_SAVELOAD_NM_CLASS(0xd66d685, NCatboostDistributed, TRemoteScoreCalcer);
 REGISTER_SAVELOAD_NM_CLASS(0xd66d486, NCatboostDistributed, TLeafIndexSetter);
-REGISTER_SAVELOAD_NM_CLASS(0xd66d487, NCatboostDistributed, TEmptyLeafFinder);
 REGISTER_SAVELOAD_NM_CLASS(0xd66d488, NCatboostDistributed, TCalcApproxStarter);
 REGISTER_SAVELOAD_NM_CLASS(0xd66d489, NCatboostDistributed, TDeltaSimpleUpdater);
 REGISTER_SAVELOAD_NM_CLASS(0xd66d48a, NCatboostDistributed, TApproxUpdater);
@@ -852,3 +1040,4 @@ REGISTER_SAVELOAD_NM_CLASS(0xd66d4e0, NCatboostDistributed, TLeafWeightsGetter);
 
 REGISTER_SAVELOAD_NM_CLASS(0xd66d4e1, NCatboostDistributed, TDatasetLoader);
 REGISTER_SAVELOAD_NM_CLASS(0xd66d4e2, NCatboostDistributed, TQuantileLeafDeltasCalcer);
+REGISTER_SAVELOAD_NM_CLASS(0xd66d4e3, NCatboostDistributed, TFeatureParallelScoreCalcer);
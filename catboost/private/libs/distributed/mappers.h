@@ -49,6 +49,7 @@ namespace NCatboostDistributed {
             int hostId,
             TInput* candidateList,
             TOutput* bucketStats) const final;
+        void DoReduce(TVector<TOutput>* statsFromAllWorkers, TOutput* bucketStats) const final;
     };
 
     // [cand][subcand]
@@ -79,36 +80,40 @@ namespace NCatboostDistributed {
         OBJECT_NOCOPY_METHODS(TRemotePairwiseScoreCalcer);
         void DoMap(NPar::IUserContext* ctx, int hostId, TInput* bucketStats, TOutput* scores) const final;
     };
-    class TRemoteBinCalcer: public NPar::TMapReduceCmd<TCandidatesInfoList, TStats4D> { // [subcand]
+    class TRemoteBinCalcer: public NPar::TMapReduceCmd<TCandidatesInfoList, TCompactStats4D> { // [subcand]
         OBJECT_NOCOPY_METHODS(TRemoteBinCalcer);
         void DoMap(NPar::IUserContext* ctx, int hostId, TInput* candidatesInfoList, TOutput* bucketStats) const final;
         void DoReduce(TVector<TOutput>* statsFromAllWorkers, TOutput* bucketStats) const final;
     };
-    class TRemoteScoreCalcer: public NPar::TMapReduceCmd<TStats4D, TVector<TVector<double>>> {
+    class TRemoteScoreCalcer: public NPar::TMapReduceCmd<TCompactStats4D, TCandidateScores> {
         OBJECT_NOCOPY_METHODS(TRemoteScoreCalcer);
         void DoMap(NPar::IUserContext* ctx, int hostId, TInput* bucketStats, TOutput* scores) const final;
     };
-    class TLeafIndexSetter: public NPar::TMapReduceCmd<TSplit, TUnusedInitializedParam> {
-        OBJECT_NOCOPY_METHODS(TLeafIndexSetter);
+    // EDistributedPartitioning::Features, each worker calculates scores of its own candidates for all objects
+    class TFeatureParallelScoreCalcer: public NPar::TMapReduceCmd<TCandidateList, TWorkerCandidatesScores> {
+        OBJECT_NOCOPY_METHODS(TFeatureParallelScoreCalcer);
         void DoMap(
             NPar::IUserContext* ctx,
             int hostId,
-            TInput* bestSplit,
-            TOutput* /*unused*/) const final;
+            TInput* candidateList,
+            TOutput* scores) const final;
     };
-    class TEmptyLeafFinder: public NPar::TMapReduceCmd<TUnusedInitializedParam, TIsLeafEmpty> {
-        OBJECT_NOCOPY_METHODS(TEmptyLeafFinder);
+    // sets leaf indices for the next tree level and returns empty leaves of it
+    class TLeafIndexSetter: public NPar::TMapReduceCmd<TSplit, TIsLeafEmpty> {
+        OBJECT_NOCOPY_METHODS(TLeafIndexSetter);
         void DoMap(
-            NPar::IUserContext* /*ctx*/,
-            int /*hostId*/,
-            TInput* /*unused*/,
+            NPar::IUserContext* ctx,
+            int hostId,
+            TInput* bestSplit,
             TOutput* isLeafEmpty) const final;
+        void DoReduce(TVector<TOutput>* isLeafEmptyFromAllWorkers, TOutput* isLeafEmpty) const final;
     };
     class TBucketSimpleUpdater:
         public NPar::TMapReduceCmd<TUnusedInitializedParam, std::pair<TSums, TArray2D<double>>> {
 
         OBJECT_NOCOPY_METHODS(TBucketSimpleUpdater);
         void DoMap(NPar::IUserContext* /*ctx*/, int /*hostId*/, TInput* /*unused*/, TOutput* sums) const final;
+        void DoReduce(TVector<TOutput>* sumsFromAllWorkers, TOutput* sums) const final;
     };
     class TCalcApproxStarter: public NPar::TMapReduceCmd<TVariant<TSplitTree, TNonSymmetricTreeStructure>, TUnusedInitializedParam> {
         OBJECT_NOCOPY_METHODS(TCalcApproxStarter);
@@ -118,12 +123,12 @@ namespace NCatboostDistributed {
         OBJECT_NOCOPY_METHODS(TDeltaSimpleUpdater);
         void DoMap(NPar::IUserContext* ctx, int hostId, TInput* sums, TOutput* /*unused*/) const final;
     };
-    class TApproxUpdater: public NPar::TMapReduceCmd<TVector<TVector<double>>, TUnusedInitializedParam> {
+    class TApproxUpdater: public NPar::TMapReduceCmd<TApproxUpdaterParams, TUnusedInitializedParam> {
         OBJECT_NOCOPY_METHODS(TApproxUpdater);
         void DoMap(
             NPar::IUserContext* ctx,
             int hostId,
-            TInput* averageLeafValues,
+            TInput* params,
             TOutput* /*unused*/) const final;
     };
     class TDerivativeSetter: public NPar::TMapReduceCmd<TUnusedInitializedParam, TUnusedInitializedParam> {
@@ -141,6 +146,7 @@ namespace NCatboostDistributed {
 
         OBJECT_NOCOPY_METHODS(TBucketMultiUpdater);
         void DoMap(NPar::IUserContext* /*ctx*/, int /*hostId*/, TInput* /*unused*/, TOutput* sums) const final;
+        void DoReduce(TVector<TOutput>* sumsFromAllWorkers, TOutput* sums) const final;
     };
     class TDeltaMultiUpdater: public NPar::TMapReduceCmd<TVector<TVector<double>>, TUnusedInitializedParam> {
         OBJECT_NOCOPY_METHODS(TDeltaMultiUpdater);
@@ -149,14 +155,17 @@ namespace NCatboostDistributed {
     class TErrorCalcer: public NPar::TMapReduceCmd<TUnusedInitializedParam, THashMap<TString, TMetricHolder>> {
         OBJECT_NOCOPY_METHODS(TErrorCalcer);
         void DoMap(NPar::IUserContext* ctx, int hostId, TInput* /*unused*/, TOutput* additiveStats) const final;
+        void DoReduce(TVector<TOutput>* additiveStatsFromAllWorkers, TOutput* additiveStats) const final;
     };
     class TLeafWeightsGetter: public NPar::TMapReduceCmd<TUnusedInitializedParam, TVector<double>> {
         OBJECT_NOCOPY_METHODS(TLeafWeightsGetter);
         void DoMap(NPar::IUserContext* ctx, int hostId, TInput* /*unused*/, TOutput* leafWeights) const final;
+        void DoReduce(TVector<TOutput>* leafWeightsFromAllWorkers, TOutput* leafWeights) const final;
     };
     class TQuantileLeafDeltasCalcer: public NPar::TMapReduceCmd<TUnusedInitializedParam, TVector<TVector<std::pair<float, float>>>> {
         OBJECT_NOCOPY_METHODS(TQuantileLeafDeltasCalcer);
         void DoMap(NPar::IUserContext* ctx, int hostId, TInput* /*unused*/, TOutput* leafValues) const final;
+        void DoReduce(TVector<TOutput>* leafValuesFromAllWorkers, TOutput* leafValues) const final;
     };
 
 } // NCatboostDistributed
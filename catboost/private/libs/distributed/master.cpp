@@ -11,18 +11,44 @@
 #include <catboost/private/libs/algo_helpers/approx_calcer_multi_helpers.h>
 #include <catboost/private/libs/algo_helpers/error_functions.h>
 
+#include <catboost/libs/logging/logging.h>
+
 #include <library/par/par_settings.h>
 
+#include <util/generic/map.h>
+#include <util/generic/maybe.h>
+#include <util/string/printf.h>
 #include <util/system/yassert.h>
 
 
 using namespace NCatboostDistributed;
 using namespace NCB;
 
+struct TMapStepTimes {
+    TDuration MasterTime; // master-only work since the previous map step, overlaps with a pipelined step
+    TDuration MapTime; // from the start of the map step till all outputs are received
+    ui32 Count = 0;
+};
+
 struct TMasterEnvironment {
     TObj<NPar::IRootEnvironment> RootEnvironment = nullptr;
     TObj<NPar::IEnvironment> SharedTrainData = nullptr;
 
+    // bucket stats traffic of score calculation in the current tree
+    ui64 StatsTransportBytes = 0;
+
+    // map step started by LaunchMapper, its outputs are not needed by the master
+    THolder<NPar::TJobDescription> PendingJobDescription;
+    THolder<NPar::TJobExecutor> PendingJob;
+    TString PendingJobStepName;
+    TInstant PendingJobStartTime;
+
+    // derivatives for the next tree were calculated by workers together with the approx update
+    bool AreDerivativesSet = false;
+
+    TMap<TString, TMapStepTimes> MapStepTimes; // [step name]
+    TMaybe<TInstant> LastMapStepEndTime;
+
     Y_DECLARE_SINGLETON_FRIEND();
 
     inline static TMasterEnvironment& GetRef() {
@@ -30,6 +56,86 @@ struct TMasterEnvironment {
     }
 };
 
+static void WaitPendingJob() {
+    auto& environment = TMasterEnvironment::GetRef();
+    if (!environment.PendingJob) {
+        return;
+    }
+    environment.PendingJob->GetRawResult(/*res*/ nullptr);
+    environment.PendingJob.Destroy();
+    environment.PendingJobDescription.Destroy();
+    environment.MapStepTimes[environment.PendingJobStepName].MapTime
+        += TInstant::Now() - environment.PendingJobStartTime;
+}
+
+TMapStepScope::TMapStepScope(TStringBuf stepName)
+    : StepName(stepName.RAfter(':'))
+    , TraceGuard(NChromiumTrace::GetGlobalTracer(), StepName, AsStringBuf("map step"))
+{
+    WaitPendingJob();
+    auto& environment = TMasterEnvironment::GetRef();
+    StartTime = TInstant::Now();
+    auto& stepTimes = environment.MapStepTimes[StepName];
+    if (environment.LastMapStepEndTime) {
+        stepTimes.MasterTime += StartTime - *environment.LastMapStepEndTime;
+    }
+    ++stepTimes.Count;
+}
+
+TMapStepScope::~TMapStepScope() {
+    auto& environment = TMasterEnvironment::GetRef();
+    const auto endTime = TInstant::Now();
+    environment.MapStepTimes[StepName].MapTime += endTime - StartTime;
+    environment.LastMapStepEndTime = endTime;
+}
+
+/* Starts a map step without waiting for its completion, so that workers run it while the master does
+ * its own work. The step is completed by the next TMapStepScope.
+ */
+template <typename TMapper>
+static void LaunchMapper(int workerCount, const typename TMapper::TInput& value) {
+    auto& environment = TMasterEnvironment::GetRef();
+    const TString stepName = TypeName<TMapper>();
+    {
+        TMapStepScope mapStepScope(stepName); // completes the previous pending step
+    }
+    environment.PendingJobDescription = MakeHolder<NPar::TJobDescription>();
+    TVector<typename TMapper::TInput> mapperInput(1);
+    mapperInput[0] = value;
+    NPar::Map(environment.PendingJobDescription.Get(), new TMapper(), &mapperInput);
+    environment.PendingJobDescription->SeparateResults(workerCount);
+    environment.PendingJobStepName = TStringBuf(stepName).RAfter(':');
+    environment.PendingJobStartTime = TInstant::Now();
+    environment.PendingJob = MakeHolder<NPar::TJobExecutor>(
+        environment.PendingJobDescription.Get(),
+        environment.SharedTrainData);
+}
+
+static void LogMapStepTimes() {
+    const auto& mapStepTimes = TMasterEnvironment::GetRef().MapStepTimes;
+    if (mapStepTimes.empty()) {
+        return;
+    }
+    TDuration totalMasterTime;
+    TDuration totalMapTime;
+    CATBOOST_INFO_LOG << "Distributed map steps (master-only time before the step / map time / count):" << Endl;
+    for (const auto& [stepName, stepTimes] : mapStepTimes) {
+        CATBOOST_INFO_LOG << Sprintf(
+            "  %-28s %10.3fs %10.3fs %8" PRIu32,
+            stepName.c_str(),
+            stepTimes.MasterTime.SecondsFloat(),
+            stepTimes.MapTime.SecondsFloat(),
+            stepTimes.Count) << Endl;
+        totalMasterTime += stepTimes.MasterTime;
+        totalMapTime += stepTimes.MapTime;
+    }
+    CATBOOST_INFO_LOG << Sprintf(
+        "  %-28s %10.3fs %10.3fs",
+        "total",
+        totalMasterTime.SecondsFloat(),
+        totalMapTime.SecondsFloat()) << Endl;
+}
+
 void InitializeMaster(const NCatboostOptions::TSystemOptions& systemOptions) {
     Y_ASSERT(systemOptions.IsMaster());
     const ui32 unusedNodePort = NCatboostOptions::TSystemOptions::GetUnusedNodePort();
@@ -45,10 +151,15 @@ void InitializeMaster(const NCatboostOptions::TSystemOptions& systemOptions) {
     const int workerCount = TMasterEnvironment::GetRef().RootEnvironment->GetSlaveCount();
     const auto& workerMapping = TMasterEnvironment::GetRef().RootEnvironment->MakeHostIdMapping(workerCount);
     TMasterEnvironment::GetRef().SharedTrainData = TMasterEnvironment::GetRef().RootEnvironment->CreateEnvironment(SHARED_ID_TRAIN_DATA, workerMapping);
+    TMasterEnvironment::GetRef().AreDerivativesSet = false;
+    TMasterEnvironment::GetRef().MapStepTimes.clear();
+    TMasterEnvironment::GetRef().LastMapStepEndTime.Clear();
 }
 
 void FinalizeMaster(TLearnContext* ctx) {
     Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
+    WaitPendingJob();
+    LogMapStepTimes();
     if (TMasterEnvironment::GetRef().RootEnvironment != nullptr) {
         TMasterEnvironment::GetRef().RootEnvironment->Stop();
     }
@@ -85,10 +196,20 @@ void SetTrainDataFromQuantizedPool(
 
 void SetTrainDataFromMaster(
     NCB::TTrainingForCPUDataProviderPtr trainData,
+    EDistributedPartitioning partitioning,
     ui64 cpuUsedRamLimit,
     NPar::TLocalExecutor* localExecutor
 ) {
     const int workerCount = TMasterEnvironment::GetRef().RootEnvironment->GetSlaveCount();
+    if (partitioning == EDistributedPartitioning::Features) {
+        for (int workerIdx = 0; workerIdx < workerCount; ++workerIdx) {
+            TMasterEnvironment::GetRef().SharedTrainData->SetContextData(
+                workerIdx,
+                new NCatboostDistributed::TTrainData(trainData),
+                NPar::DELETE_RAW_DATA); // only workers
+        }
+        return;
+    }
     auto workerParts = Split(*trainData->ObjectsGrouping, (ui32)workerCount);
     for (int workerIdx = 0; workerIdx < workerCount; ++workerIdx) {
         TMasterEnvironment::GetRef().SharedTrainData->SetContextData(
@@ -142,6 +263,7 @@ void MapBuildPlainFold(TLearnContext* ctx) {
 
 void MapRestoreApproxFromTreeStruct(TLearnContext* ctx) {
     Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
+    TMasterEnvironment::GetRef().AreDerivativesSet = false;
     ApplyMapper<TApproxReconstructor>(
         TMasterEnvironment::GetRef().RootEnvironment->GetSlaveCount(),
         TMasterEnvironment::GetRef().SharedTrainData,
@@ -150,9 +272,14 @@ void MapRestoreApproxFromTreeStruct(TLearnContext* ctx) {
 
 void MapTensorSearchStart(TLearnContext* ctx) {
     Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
+    TMasterEnvironment::GetRef().StatsTransportBytes = 0;
     ApplyMapper<TTensorSearchStarter>(TMasterEnvironment::GetRef().RootEnvironment->GetSlaveCount(), TMasterEnvironment::GetRef().SharedTrainData);
 }
 
+ui64 GetStatsTransportBytesInTree() {
+    return TMasterEnvironment::GetRef().StatsTransportBytes;
+}
+
 void MapBootstrap(TLearnContext* ctx) {
     Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
     ApplyMapper<TBootstrapMaker>(TMasterEnvironment::GetRef().RootEnvironment->GetSlaveCount(), TMasterEnvironment::GetRef().SharedTrainData);
@@ -170,10 +297,12 @@ void MapGenericCalcScore(
     auto& candidateList = candidatesContext->CandidateList;
 
     const int workerCount = TMasterEnvironment::GetRef().RootEnvironment->GetSlaveCount();
-    auto allStatsFromAllWorkers = ApplyMapper<TScoreCalcMapper>(
+    auto allStatsFromAllWorkers = ApplyReducingMapper<TScoreCalcMapper>(
+        ctx->Params.SystemOptions,
         workerCount,
         TMasterEnvironment::GetRef().SharedTrainData,
         candidateList);
+    const int outputCount = allStatsFromAllWorkers.ysize();
     const int candidateCount = candidateList.ysize();
     const ui64 randSeed = ctx->LearnProgress->Rand.GenRand();
     // set best split for each candidate
@@ -188,7 +317,7 @@ void MapGenericCalcScore(
             for (int subcandidateIdx = 0; subcandidateIdx < subcandidateCount; ++subcandidateIdx) {
                 // reduce across workers
                 auto& reducedStats = allStatsFromAllWorkers[0][candidateIdx][subcandidateIdx];
-                for (int workerIdx = 1; workerIdx < workerCount; ++workerIdx) {
+                for (int workerIdx = 1; workerIdx < outputCount; ++workerIdx) {
                     const auto& stats = allStatsFromAllWorkers[workerIdx][candidateIdx][subcandidateIdx];
                     reducedStats.Add(stats);
                 }
@@ -219,6 +348,22 @@ void MapCalcScore(
     MapGenericCalcScore<TScoreCalcer>(getScore, scoreStDev, candidatesContext, ctx);
 }
 
+static const TVector<TVector<double>>& GetCandidateScores(const TVector<TVector<double>>& scores) {
+    return scores;
+}
+
+static const TVector<TVector<double>>& GetCandidateScores(const TCandidateScores& scores) {
+    return scores.Scores;
+}
+
+static ui64 GetStatsTransportBytes(const TVector<TVector<double>>& /*scores*/) {
+    return 0; // not tracked
+}
+
+static ui64 GetStatsTransportBytes(const TCandidateScores& scores) {
+    return scores.StatsTransportBytes;
+}
+
 template <typename TBinCalcMapper, typename TScoreCalcMapper>
 void MapGenericRemoteCalcScore(
     double scoreStDev,
@@ -229,15 +374,21 @@ void MapGenericRemoteCalcScore(
 
     auto& candidateList = candidatesContext->CandidateList;
 
-    NPar::TJobDescription job;
-    NPar::Map(&job, new TBinCalcMapper(), &candidateList);
-    NPar::RemoteMap(&job, new TScoreCalcMapper);
-    NPar::TJobExecutor exec(&job, TMasterEnvironment::GetRef().SharedTrainData);
     TVector<typename TScoreCalcMapper::TOutput> allScores;
-    exec.GetRemoteMapResults(&allScores);
+    {
+        TMapStepScope mapStepScope(TypeName<TBinCalcMapper>());
+        NPar::TJobDescription job;
+        NPar::Map(&job, new TBinCalcMapper(), &candidateList);
+        NPar::RemoteMap(&job, new TScoreCalcMapper);
+        NPar::TJobExecutor exec(&job, TMasterEnvironment::GetRef().SharedTrainData);
+        exec.GetRemoteMapResults(&allScores);
+    }
     // set best split for each candidate
     const int candidateCount = candidateList.ysize();
     Y_ASSERT(candidateCount == allScores.ysize());
+    for (const auto& candidateScores : allScores) {
+        TMasterEnvironment::GetRef().StatsTransportBytes += GetStatsTransportBytes(candidateScores);
+    }
     const ui64 randSeed = ctx->LearnProgress->Rand.GenRand();
     ctx->LocalExecutor->ExecRange(
         [&] (int candidateIdx) {
@@ -246,7 +397,7 @@ void MapGenericRemoteCalcScore(
 
             SetBestScore(
                 randSeed + candidateIdx,
-                allScores[candidateIdx],
+                GetCandidateScores(allScores[candidateIdx]),
                 scoreStDev,
                 *candidatesContext,
                 &candidates);
@@ -256,11 +407,51 @@ void MapGenericRemoteCalcScore(
         NPar::TLocalExecutor::WAIT_COMPLETE);
 }
 
+static void MapFeatureParallelCalcScore(
+    double scoreStDev,
+    TCandidatesContext* candidatesContext,
+    TLearnContext* ctx) {
+
+    Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
+
+    auto& candidateList = candidatesContext->CandidateList;
+    const int workerCount = TMasterEnvironment::GetRef().RootEnvironment->GetSlaveCount();
+    auto scoresFromAllWorkers = ApplyMapper<TFeatureParallelScoreCalcer>(
+        workerCount,
+        TMasterEnvironment::GetRef().SharedTrainData,
+        candidateList);
+    const ui64 randSeed = ctx->LearnProgress->Rand.GenRand();
+    ctx->LocalExecutor->ExecRangeWithThrow(
+        [&] (int candidateIdx) {
+            auto& candidates = candidateList[candidateIdx].Candidates;
+            Y_VERIFY(candidates.size() > 0);
+
+            // only the owner of the candidate returns its scores
+            const TVector<TVector<double>>* scores = nullptr;
+            for (const auto& workerScores : scoresFromAllWorkers) {
+                if (!workerScores[candidateIdx].empty()) {
+                    CB_ENSURE_INTERNAL(scores == nullptr, "Candidate scores are calculated by several workers");
+                    scores = &workerScores[candidateIdx];
+                }
+            }
+            CB_ENSURE_INTERNAL(scores != nullptr, "Candidate scores are not calculated by any worker");
+
+            SetBestScore(randSeed + candidateIdx, *scores, scoreStDev, *candidatesContext, &candidates);
+        },
+        0,
+        candidateList.ysize(),
+        NPar::TLocalExecutor::WAIT_COMPLETE);
+}
+
 void MapRemotePairwiseCalcScore(
     double scoreStDev,
     TCandidatesContext* candidatesContext,
     TLearnContext* ctx) {
 
+    CB_ENSURE(
+        ctx->Params.SystemOptions->DistributedPartitioning == EDistributedPartitioning::Objects,
+        "Pairwise scoring is not supported with features partitioning in distributed training");
+
     MapGenericRemoteCalcScore<TRemotePairwiseBinCalcer, TRemotePairwiseScoreCalcer>(
         scoreStDev,
         candidatesContext,
@@ -272,24 +463,27 @@ void MapRemoteCalcScore(
     TCandidatesContext* candidatesContext,
     TLearnContext* ctx) {
 
+    if (ctx->Params.SystemOptions->DistributedPartitioning == EDistributedPartitioning::Features) {
+        MapFeatureParallelCalcScore(scoreStDev, candidatesContext, ctx);
+        return;
+    }
+
     MapGenericRemoteCalcScore<TRemoteBinCalcer, TRemoteScoreCalcer>(
         scoreStDev,
         candidatesContext,
         ctx);
 }
 
-void MapSetIndices(const TSplit& bestSplit, TLearnContext* ctx) {
-    Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
-    const int workerCount = TMasterEnvironment::GetRef().RootEnvironment->GetSlaveCount();
-    ApplyMapper<TLeafIndexSetter>(workerCount, TMasterEnvironment::GetRef().SharedTrainData, bestSplit);
-}
-
-int MapGetRedundantSplitIdx(TLearnContext* ctx) {
+int MapSetIndices(const TSplit& bestSplit, TLearnContext* ctx) {
     Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
     const int workerCount = TMasterEnvironment::GetRef().RootEnvironment->GetSlaveCount();
-    TVector<TEmptyLeafFinder::TOutput> isLeafEmptyFromAllWorkers
-        = ApplyMapper<TEmptyLeafFinder>(workerCount, TMasterEnvironment::GetRef().SharedTrainData); // poll workers
-    for (int workerIdx = 1; workerIdx < workerCount; ++workerIdx) {
+    TVector<TLeafIndexSetter::TOutput> isLeafEmptyFromAllWorkers
+        = ApplyReducingMapper<TLeafIndexSetter>(
+            ctx->Params.SystemOptions,
+            workerCount,
+            TMasterEnvironment::GetRef().SharedTrainData,
+            bestSplit);
+    for (int workerIdx = 1; workerIdx < isLeafEmptyFromAllWorkers.ysize(); ++workerIdx) {
         for (int leafIdx = 0; leafIdx < isLeafEmptyFromAllWorkers[0].ysize(); ++leafIdx) {
             isLeafEmptyFromAllWorkers[0][leafIdx] &= isLeafEmptyFromAllWorkers[workerIdx][leafIdx];
         }
@@ -302,11 +496,14 @@ void MapCalcErrors(TLearnContext* ctx) {
     const size_t workerCount = TMasterEnvironment::GetRef().RootEnvironment->GetSlaveCount();
 
     // poll workers
-    auto additiveStatsFromAllWorkers = ApplyMapper<TErrorCalcer>(workerCount, TMasterEnvironment::GetRef().SharedTrainData);
-    Y_ASSERT(additiveStatsFromAllWorkers.size() == workerCount);
+    auto additiveStatsFromAllWorkers = ApplyReducingMapper<TErrorCalcer>(
+        ctx->Params.SystemOptions,
+        workerCount,
+        TMasterEnvironment::GetRef().SharedTrainData);
+    Y_ASSERT(additiveStatsFromAllWorkers.size() == workerCount || additiveStatsFromAllWorkers.size() == 1);
 
     auto& additiveStats = additiveStatsFromAllWorkers[0];
-    for (size_t workerIdx : xrange<size_t>(1, workerCount)) {
+    for (size_t workerIdx : xrange<size_t>(1, additiveStatsFromAllWorkers.size())) {
         const auto& workerAdditiveStats = additiveStatsFromAllWorkers[workerIdx];
         for (auto& [description, stats] : additiveStats) {
             Y_ASSERT(workerAdditiveStats.contains(description));
@@ -351,6 +548,7 @@ void MapSetApproxes(
 
     Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
     const int workerCount = TMasterEnvironment::GetRef().RootEnvironment->GetSlaveCount();
+    const auto& systemOptions = ctx->Params.SystemOptions.Get();
     ApplyMapper<TCalcApproxStarter>(workerCount, TMasterEnvironment::GetRef().SharedTrainData, splitTree);
     const int gradientIterations = ctx->Params.ObliviousTreeOptions->LeavesEstimationIterations;
     const int approxDimension = ctx->LearnProgress->ApproxDimension;
@@ -370,13 +568,16 @@ void MapSetApproxes(
             delta = DBL_EPSILON;
         }
 
-        const auto quantileLeafDeltasCalcer = ApplyMapper<TQuantileLeafDeltasCalcer>(workerCount, TMasterEnvironment::GetRef().SharedTrainData);
+        const auto quantileLeafDeltasCalcer = ApplyReducingMapper<TQuantileLeafDeltasCalcer>(
+            systemOptions,
+            workerCount,
+            TMasterEnvironment::GetRef().SharedTrainData);
 
         TVector<TVector<double>> leafValues(approxDimension, TVector<double>(leafCount));
 
         TVector<TVector<std::pair<float, float>>> leafSamples(leafCount);
         TVector<std::pair<float, float>> tmp;
-        for (int workerIdx = 0; workerIdx < workerCount; ++workerIdx) {
+        for (int workerIdx = 0; workerIdx < quantileLeafDeltasCalcer.ysize(); ++workerIdx) {
             const auto& workerSamples = quantileLeafDeltasCalcer[workerIdx];
             Y_ASSERT(leafCount == (int) workerSamples.size());
             for (int i = 0; i < leafCount; i++) {
@@ -409,9 +610,12 @@ void MapSetApproxes(
 
             TPairwiseBuckets pairwiseBuckets;
             TApproxDefs::SetPairwiseBucketsSize(leafCount, &pairwiseBuckets);
-            const auto bucketsFromAllWorkers = ApplyMapper<TBucketUpdater>(workerCount, TMasterEnvironment::GetRef().SharedTrainData);
+            const auto bucketsFromAllWorkers = ApplyReducingMapper<TBucketUpdater>(
+                systemOptions,
+                workerCount,
+                TMasterEnvironment::GetRef().SharedTrainData);
             // reduce across workers
-            for (int workerIdx = 0; workerIdx < workerCount; ++workerIdx) {
+            for (int workerIdx = 0; workerIdx < bucketsFromAllWorkers.ysize(); ++workerIdx) {
                 const auto &workerBuckets = bucketsFromAllWorkers[workerIdx].first;
                 for (int leafIdx = 0; leafIdx < leafCount; ++leafIdx) {
                     if (ctx->Params.ObliviousTreeOptions->LeavesEstimationMethod == ELeavesEstimation::Gradient) {
@@ -435,7 +639,10 @@ void MapSetApproxes(
     }
 
     // [workerIdx][dimIdx][leafIdx]
-    const auto leafWeightsFromAllWorkers = ApplyMapper<TLeafWeightsGetter>(workerCount, TMasterEnvironment::GetRef().SharedTrainData);
+    const auto leafWeightsFromAllWorkers = ApplyReducingMapper<TLeafWeightsGetter>(
+        systemOptions,
+        workerCount,
+        TMasterEnvironment::GetRef().SharedTrainData);
     sumLeafWeights->resize(leafCount);
     for (const auto& workerLeafWeights : leafWeightsFromAllWorkers) {
         AddElementwise(workerLeafWeights, sumLeafWeights);
@@ -447,8 +654,13 @@ void MapSetApproxes(
         *sumLeafWeights,
         averageLeafValues);
 
-    // update learn approx and average approx
-    ApplyMapper<TApproxUpdater>(workerCount, TMasterEnvironment::GetRef().SharedTrainData, *averageLeafValues);
+    // update learn approx and average approx, it is pipelined with the test approx update on the master
+    // and workers start derivatives for the next tree unless it is the last one
+    const bool setDerivatives
+        = ctx->LearnProgress->TreeStruct.size() + 1 < ctx->Params.BoostingOptions->IterationCount.Get()
+            && ctx->Params.BoostingOptions->ModelShrinkRate.Get() == 0;
+    LaunchMapper<TApproxUpdater>(workerCount, TApproxUpdaterParams{*averageLeafValues, setDerivatives});
+    TMasterEnvironment::GetRef().AreDerivativesSet = setDerivatives;
     // update test
     const auto indices = BuildIndices(
         /*unused fold*/{ },
@@ -493,7 +705,16 @@ public:
         TVector<TVector<double>> leafValues(/*dimensionCount*/ 1, TVector<double>(leafCount));
         const size_t allDocCount = ctx.LearnProgress->Folds[0].GetLearnSampleCount();
         const double sumAllWeights = ctx.LearnProgress->Folds[0].GetSumWeight();
-        CalcLeafDeltasSimple(buckets, pairwiseBuckets, ctx.Params, sumAllWeights, allDocCount, &leafValues[0]);
+        TVector<double> pairwiseSystemMatrix;
+        CalcLeafDeltasSimple(
+            buckets,
+            pairwiseBuckets,
+            ctx.Params,
+            sumAllWeights,
+            allDocCount,
+            ctx.LocalExecutor,
+            &leafValues[0],
+            &pairwiseSystemMatrix);
         return leafValues;
     }
 };
@@ -524,6 +745,7 @@ public:
             l2Regularizer,
             sumAllWeights,
             allDocCount,
+            ctx.LocalExecutor,
             &leafValues);
         return leafValues;
     }
@@ -555,5 +777,9 @@ void MapSetApproxesMulti(
 void MapSetDerivatives(TLearnContext* ctx) {
     using namespace NCatboostDistributed;
     Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
+    if (TMasterEnvironment::GetRef().AreDerivativesSet) {
+        TMasterEnvironment::GetRef().AreDerivativesSet = false;
+        return;
+    }
     ApplyMapper<TDerivativeSetter>(TMasterEnvironment::GetRef().RootEnvironment->GetSlaveCount(), TMasterEnvironment::GetRef().SharedTrainData);
 }
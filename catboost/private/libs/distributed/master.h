@@ -8,8 +8,13 @@
 #include <catboost/private/libs/algo/tensor_search_helpers.h>
 #include <catboost/libs/data/data_provider.h>
 #include <catboost/libs/data/loader.h>
+#include <catboost/libs/logging/event_trace.h>
 #include <catboost/private/libs/options/load_options.h>
 
+#include <util/datetime/base.h>
+#include <util/generic/noncopyable.h>
+#include <util/generic/type_name.h>
+
 void InitializeMaster(const NCatboostOptions::TSystemOptions& systemOptions);
 void FinalizeMaster(TLearnContext* ctx);
 void SetTrainDataFromQuantizedPool(
@@ -21,11 +26,14 @@ void SetTrainDataFromQuantizedPool(
 );
 void SetTrainDataFromMaster(
     NCB::TTrainingForCPUDataProviderPtr trainData,
+    EDistributedPartitioning partitioning,
     ui64 cpuUsedRamLimit,
     NPar::TLocalExecutor* localExecutor);
 void MapBuildPlainFold(TLearnContext* ctx);
 void MapRestoreApproxFromTreeStruct(TLearnContext* ctx);
 void MapTensorSearchStart(TLearnContext* ctx);
+// approximate size of bucket stats sent between hosts since the last MapTensorSearchStart
+ui64 GetStatsTransportBytesInTree();
 void MapBootstrap(TLearnContext* ctx);
 void MapCalcScore(
     double scoreStDev,
@@ -40,16 +48,33 @@ void MapRemotePairwiseCalcScore(
     double scoreStDev,
     TCandidatesContext* candidatesContext,
     TLearnContext* ctx);
-void MapSetIndices(const TSplit& bestSplit, TLearnContext* ctx);
-int MapGetRedundantSplitIdx(TLearnContext* ctx);
+// returns index of the split that became redundant after adding bestSplit (see GetRedundantSplitIdx) or -1
+int MapSetIndices(const TSplit& bestSplit, TLearnContext* ctx);
 void MapCalcErrors(TLearnContext* ctx);
 
+/* Waits for the pipelined map step if one is running (workers process map steps one at a time) and
+ * accounts the time of the map step and of the master-only work since the previous map step,
+ * when workers are idle. The totals are logged by FinalizeMaster.
+ * The step is also added to the event trace (see event_trace.h) as a "map step" event.
+ */
+class TMapStepScope : public TNonCopyable {
+public:
+    explicit TMapStepScope(TStringBuf stepName);
+    ~TMapStepScope();
+
+private:
+    TString StepName;
+    TInstant StartTime;
+    NChromiumTrace::TCompleteEventGuard TraceGuard;
+};
+
 template <typename TMapper>
 TVector<typename TMapper::TOutput> ApplyMapper(
     int workerCount,
     TObj<NPar::IEnvironment> environment,
     const typename TMapper::TInput& value = typename TMapper::TInput()) {
 
+    TMapStepScope mapStepScope(TypeName<TMapper>());
     NPar::TJobDescription job;
     TVector<typename TMapper::TInput> mapperInput(1);
     mapperInput[0] = value;
@@ -61,6 +86,41 @@ TVector<typename TMapper::TOutput> ApplyMapper(
     return mapperOutput;
 }
 
+/* Outputs of workers for reduction with TMapper::DoReduce.
+ * With EDistributedReduceTopology::Tree outputs are reduced by par on the workers along its distribution tree
+ * (each node merges the outputs of its subtree before sending them up), so a single already reduced output
+ * is returned. Otherwise outputs of all workers are returned to be reduced by the caller.
+ * With EDistributedPartitioning::Features all workers have all objects and the same outputs, so only
+ * the first one is returned.
+ */
+template <typename TMapper>
+TVector<typename TMapper::TOutput> ApplyReducingMapper(
+    const NCatboostOptions::TSystemOptions& systemOptions,
+    int workerCount,
+    TObj<NPar::IEnvironment> environment,
+    const typename TMapper::TInput& value = typename TMapper::TInput()) {
+
+    if (systemOptions.DistributedPartitioning == EDistributedPartitioning::Features) {
+        auto mapperOutput = ApplyMapper<TMapper>(workerCount, environment, value);
+        mapperOutput.resize(1);
+        return mapperOutput;
+    }
+    if (systemOptions.DistributedReduceTopology == EDistributedReduceTopology::Master) {
+        return ApplyMapper<TMapper>(workerCount, environment, value);
+    }
+
+    TMapStepScope mapStepScope(TypeName<TMapper>());
+    NPar::TJobDescription job;
+    TVector<typename TMapper::TInput> mapperInput(1);
+    mapperInput[0] = value;
+    NPar::Map(&job, new TMapper(), &mapperInput);
+    job.MergeResults();
+    NPar::TJobExecutor exec(&job, environment);
+    TVector<typename TMapper::TOutput> mapperOutput(1);
+    exec.GetResult(&mapperOutput[0]);
+    return mapperOutput;
+}
+
 void MapSetApproxesSimple(
     const IDerCalcer& error,
     const TVariant<TSplitTree, TNonSymmetricTreeStructure>& splitTree,
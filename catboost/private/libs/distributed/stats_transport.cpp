@@ -0,0 +1,252 @@
+#include "stats_transport.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <library/pop_count/popcount.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/bitops.h>
+#include <util/generic/cast.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+
+#include <cstring>
+
+
+using namespace NCatboostDistributed;
+
+
+static constexpr size_t MASK_WORD_BITS = sizeof(ui64) * CHAR_BIT;
+static constexpr size_t BUCKET_STATS_FIELD_COUNT = 4;
+
+
+static bool IsZero(const TBucketStats& bucketStats) {
+    return (bucketStats.SumWeightedDelta == 0.0)
+        && (bucketStats.SumWeight == 0.0)
+        && (bucketStats.SumDelta == 0.0)
+        && (bucketStats.Count == 0.0);
+}
+
+static double& GetField(size_t fieldIdx, TBucketStats* bucketStats) {
+    switch (fieldIdx) {
+        case 0:
+            return bucketStats->SumWeightedDelta;
+        case 1:
+            return bucketStats->SumWeight;
+        case 2:
+            return bucketStats->SumDelta;
+        default:
+            return bucketStats->Count;
+    }
+}
+
+static double GetField(size_t fieldIdx, const TBucketStats& bucketStats) {
+    return GetField(fieldIdx, const_cast<TBucketStats*>(&bucketStats));
+}
+
+static ui32 GetFloatBits(double value) {
+    const float floatValue = (float)value;
+    ui32 bits;
+    memcpy(&bits, &floatValue, sizeof(bits));
+    return bits;
+}
+
+static double FromFloatBits(ui32 bits) {
+    float floatValue;
+    memcpy(&floatValue, &bits, sizeof(floatValue));
+    return floatValue;
+}
+
+
+static TVector<ui8> EncodeValues(TConstArrayRef<TBucketStats> nonZeroStats, EDistributedStatsCodec codec) {
+    TVector<ui8> payload;
+    switch (codec) {
+        case EDistributedStatsCodec::Double:
+            payload.yresize(nonZeroStats.size() * sizeof(TBucketStats));
+            if (!nonZeroStats.empty()) {
+                memcpy(payload.data(), nonZeroStats.data(), payload.size());
+            }
+            break;
+        case EDistributedStatsCodec::Float:
+            {
+                payload.yresize(nonZeroStats.size() * BUCKET_STATS_FIELD_COUNT * sizeof(ui32));
+                ui8* dst = payload.data();
+                for (const auto& bucketStats : nonZeroStats) {
+                    for (auto fieldIdx : xrange(BUCKET_STATS_FIELD_COUNT)) {
+                        const ui32 bits = GetFloatBits(GetField(fieldIdx, bucketStats));
+                        memcpy(dst, &bits, sizeof(bits));
+                        dst += sizeof(bits);
+                    }
+                }
+            }
+            break;
+        case EDistributedStatsCodec::FloatDelta:
+            {
+                /* for each field: xor of float bits with the previous stored bucket's value,
+                 * stored by byte planes from the most significant one, so the similar sign, exponent and
+                 * high mantissa bits of neighbouring buckets become long runs of zeros for the
+                 * network compression
+                 */
+                const size_t count = nonZeroStats.size();
+                payload.yresize(count * BUCKET_STATS_FIELD_COUNT * sizeof(ui32));
+                TVector<ui32> deltas;
+                deltas.yresize(count);
+                ui8* dst = payload.data();
+                for (auto fieldIdx : xrange(BUCKET_STATS_FIELD_COUNT)) {
+                    ui32 prevBits = 0;
+                    for (auto i : xrange(count)) {
+                        const ui32 bits = GetFloatBits(GetField(fieldIdx, nonZeroStats[i]));
+                        deltas[i] = bits ^ prevBits;
+                        prevBits = bits;
+                    }
+                    for (int byteIdx = sizeof(ui32) - 1; byteIdx >= 0; --byteIdx) {
+                        for (auto i : xrange(count)) {
+                            *dst++ = (ui8)(deltas[i] >> (byteIdx * CHAR_BIT));
+                        }
+                    }
+                }
+            }
+            break;
+    }
+    return payload;
+}
+
+static TVector<TBucketStats> DecodeValues(const TCompactStats3D& compactStats3D, size_t nonZeroCount) {
+    const auto& payload = compactStats3D.Payload;
+
+    TVector<TBucketStats> nonZeroStats;
+    nonZeroStats.yresize(nonZeroCount);
+    switch (compactStats3D.Codec) {
+        case EDistributedStatsCodec::Double:
+            CB_ENSURE_INTERNAL(payload.size() == nonZeroCount * sizeof(TBucketStats), "Bad packed stats size");
+            if (nonZeroCount) {
+                memcpy(nonZeroStats.data(), payload.data(), payload.size());
+            }
+            break;
+        case EDistributedStatsCodec::Float:
+            {
+                CB_ENSURE_INTERNAL(
+                    payload.size() == nonZeroCount * BUCKET_STATS_FIELD_COUNT * sizeof(ui32),
+                    "Bad packed stats size"
+                );
+                const ui8* src = payload.data();
+                for (auto& bucketStats : nonZeroStats) {
+                    for (auto fieldIdx : xrange(BUCKET_STATS_FIELD_COUNT)) {
+                        ui32 bits;
+                        memcpy(&bits, src, sizeof(bits));
+                        src += sizeof(bits);
+                        GetField(fieldIdx, &bucketStats) = FromFloatBits(bits);
+                    }
+                }
+            }
+            break;
+        case EDistributedStatsCodec::FloatDelta:
+            {
+                CB_ENSURE_INTERNAL(
+                    payload.size() == nonZeroCount * BUCKET_STATS_FIELD_COUNT * sizeof(ui32),
+                    "Bad packed stats size"
+                );
+                TVector<ui32> deltas;
+                deltas.yresize(nonZeroCount);
+                const ui8* src = payload.data();
+                for (auto fieldIdx : xrange(BUCKET_STATS_FIELD_COUNT)) {
+                    Fill(deltas.begin(), deltas.end(), 0);
+                    for (int byteIdx = sizeof(ui32) - 1; byteIdx >= 0; --byteIdx) {
+                        for (auto i : xrange(nonZeroCount)) {
+                            deltas[i] |= ((ui32)*src++) << (byteIdx * CHAR_BIT);
+                        }
+                    }
+                    ui32 bits = 0;
+                    for (auto i : xrange(nonZeroCount)) {
+                        bits ^= deltas[i];
+                        GetField(fieldIdx, &nonZeroStats[i]) = FromFloatBits(bits);
+                    }
+                }
+            }
+            break;
+    }
+    return nonZeroStats;
+}
+
+
+ui64 TCompactStats3D::GetPackedByteSize() const {
+    // fixed part is approximated by the in-memory size
+    return sizeof(*this) + NonZeroMask.size() * sizeof(ui64) + Payload.size();
+}
+
+
+TCompactStats3D NCatboostDistributed::PackStats3D(const TStats3D& stats3D, EDistributedStatsCodec codec) {
+    TCompactStats3D compactStats3D;
+    compactStats3D.Codec = codec;
+    compactStats3D.StatsSize = SafeIntegerCast<ui32>(stats3D.Stats.size());
+    compactStats3D.BucketCount = stats3D.BucketCount;
+    compactStats3D.MaxLeafCount = stats3D.MaxLeafCount;
+    compactStats3D.SplitEnsembleSpec = stats3D.SplitEnsembleSpec;
+
+    compactStats3D.NonZeroMask.resize(CeilDiv<size_t>(stats3D.Stats.size(), MASK_WORD_BITS), 0);
+    TVector<TBucketStats> nonZeroStats;
+    for (auto statIdx : xrange(stats3D.Stats.size())) {
+        if (!IsZero(stats3D.Stats[statIdx])) {
+            compactStats3D.NonZeroMask[statIdx / MASK_WORD_BITS] |= ui64(1) << (statIdx % MASK_WORD_BITS);
+            nonZeroStats.push_back(stats3D.Stats[statIdx]);
+        }
+    }
+    compactStats3D.Payload = EncodeValues(nonZeroStats, codec);
+    compactStats3D.TransportBytes = compactStats3D.GetPackedByteSize();
+    return compactStats3D;
+}
+
+
+void NCatboostDistributed::AddPackedStats3D(const TCompactStats3D& compactStats3D, TStats3D* stats3D) {
+    if (stats3D->Stats.empty()) {
+        stats3D->Stats.resize(compactStats3D.StatsSize, TBucketStats{0, 0, 0, 0});
+        stats3D->BucketCount = compactStats3D.BucketCount;
+        stats3D->MaxLeafCount = compactStats3D.MaxLeafCount;
+        stats3D->SplitEnsembleSpec = compactStats3D.SplitEnsembleSpec;
+    }
+    CB_ENSURE_INTERNAL(
+        compactStats3D.BucketCount == stats3D->BucketCount
+        && compactStats3D.MaxLeafCount == stats3D->MaxLeafCount
+        && compactStats3D.StatsSize == stats3D->Stats.size()
+        && compactStats3D.SplitEnsembleSpec == stats3D->SplitEnsembleSpec,
+        "Packed stats layout does not match"
+    );
+
+    size_t nonZeroCount = 0;
+    for (auto word : compactStats3D.NonZeroMask) {
+        nonZeroCount += PopCount(word);
+    }
+    const auto nonZeroStats = DecodeValues(compactStats3D, nonZeroCount);
+
+    size_t nonZeroIdx = 0;
+    for (auto wordIdx : xrange(compactStats3D.NonZeroMask.size())) {
+        for (ui64 word = compactStats3D.NonZeroMask[wordIdx]; word; word &= word - 1) {
+            const size_t statIdx = wordIdx * MASK_WORD_BITS + CountTrailingZeroBits(word);
+            stats3D->Stats[statIdx].Add(nonZeroStats[nonZeroIdx++]);
+        }
+    }
+}
+
+
+TStats3D NCatboostDistributed::UnpackStats3D(const TCompactStats3D& compactStats3D) {
+    TStats3D stats3D;
+    AddPackedStats3D(compactStats3D, &stats3D);
+    return stats3D;
+}
+
+
+TCompactStats3D NCatboostDistributed::ReducePackedStats3D(
+    TConstArrayRef<const TCompactStats3D*> compactStatsFromAllWorkers
+) {
+    CB_ENSURE_INTERNAL(!compactStatsFromAllWorkers.empty(), "No stats to reduce");
+
+    TStats3D stats3D;
+    ui64 transportBytes = 0;
+    for (const auto* compactStats3D : compactStatsFromAllWorkers) {
+        AddPackedStats3D(*compactStats3D, &stats3D);
+        transportBytes += compactStats3D->TransportBytes;
+    }
+    auto result = PackStats3D(stats3D, compactStatsFromAllWorkers[0]->Codec);
+    result.TransportBytes += transportBytes;
+    return result;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <catboost/private/libs/algo/calc_score_cache.h>
+#include <catboost/private/libs/options/enums.h>
+
+#include <library/binsaver/bin_saver.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+
+namespace NCatboostDistributed {
+
+    /* TStats3D packed for sending between hosts:
+     *  - bucket stats with all fields equal to zero (empty leaves, unused bins) are not stored,
+     *    NonZeroMask has a bit for each element of TStats3D::Stats
+     *  - values of the remaining bucket stats are stored in Payload encoded with Codec
+     */
+    struct TCompactStats3D {
+        EDistributedStatsCodec Codec = EDistributedStatsCodec::Double;
+        ui32 StatsSize = 0; // size of TStats3D::Stats
+        int BucketCount = 0;
+        int MaxLeafCount = 0;
+        TSplitEnsembleSpec SplitEnsembleSpec;
+        TVector<ui64> NonZeroMask;
+        TVector<ui8> Payload;
+
+        /* approximate accumulated size of packed data of this object and all packed stats reduced to it,
+         * used for traffic reporting
+         */
+        ui64 TransportBytes = 0;
+
+    public:
+        SAVELOAD(Codec, StatsSize, BucketCount, MaxLeafCount, SplitEnsembleSpec, NonZeroMask, Payload, TransportBytes);
+
+        ui64 GetPackedByteSize() const;
+    };
+
+    using TCompactStats4D = TVector<TCompactStats3D>; // [subCand]
+
+
+    TCompactStats3D PackStats3D(const TStats3D& stats3D, EDistributedStatsCodec codec);
+
+    // stats3D can be empty, otherwise it must have the same layout as compactStats3D
+    void AddPackedStats3D(const TCompactStats3D& compactStats3D, TStats3D* stats3D);
+
+    TStats3D UnpackStats3D(const TCompactStats3D& compactStats3D);
+
+    // sum of packed stats from all workers, packed back with the same codec
+    TCompactStats3D ReducePackedStats3D(TConstArrayRef<const TCompactStats3D*> compactStatsFromAllWorkers);
+}
@@ -0,0 +1,120 @@
+#include <catboost/private/libs/distributed/stats_transport.h>
+
+#include <util/generic/xrange.h>
+
+#include <library/unittest/registar.h>
+
+
+using namespace NCatboostDistributed;
+
+
+static TStats3D MakeStats3D(int leafCount, int bucketCount, int seed) {
+    TStats3D stats3D;
+    stats3D.BucketCount = bucketCount;
+    stats3D.MaxLeafCount = leafCount;
+    stats3D.Stats.resize(leafCount * bucketCount, TBucketStats{0, 0, 0, 0});
+    for (auto leafIdx : xrange(leafCount)) {
+        if (leafIdx % 3 == 1) {
+            continue; // empty leaf
+        }
+        for (auto bucketIdx : xrange(bucketCount)) {
+            if ((bucketIdx + seed) % 4 == 0) {
+                continue; // empty bucket
+            }
+            const double count = 1 + (bucketIdx * 7 + leafIdx + seed) % 13;
+            stats3D.Stats[leafIdx * bucketCount + bucketIdx] = TBucketStats{
+                -0.1 * count + 0.01 * seed,
+                count * 1.5,
+                0.3 * count - 0.001 * bucketIdx,
+                count
+            };
+        }
+    }
+    return stats3D;
+}
+
+static void AssertStatsEqual(const TStats3D& lhs, const TStats3D& rhs, double eps) {
+    UNIT_ASSERT_VALUES_EQUAL(lhs.BucketCount, rhs.BucketCount);
+    UNIT_ASSERT_VALUES_EQUAL(lhs.MaxLeafCount, rhs.MaxLeafCount);
+    UNIT_ASSERT_VALUES_EQUAL(lhs.Stats.size(), rhs.Stats.size());
+    for (auto i : xrange(lhs.Stats.size())) {
+        UNIT_ASSERT_DOUBLES_EQUAL(lhs.Stats[i].SumWeightedDelta, rhs.Stats[i].SumWeightedDelta, eps);
+        UNIT_ASSERT_DOUBLES_EQUAL(lhs.Stats[i].SumWeight, rhs.Stats[i].SumWeight, eps);
+        UNIT_ASSERT_DOUBLES_EQUAL(lhs.Stats[i].SumDelta, rhs.Stats[i].SumDelta, eps);
+        UNIT_ASSERT_DOUBLES_EQUAL(lhs.Stats[i].Count, rhs.Stats[i].Count, eps);
+    }
+}
+
+
+Y_UNIT_TEST_SUITE(StatsTransport) {
+    Y_UNIT_TEST(PackUnpack) {
+        const auto stats3D = MakeStats3D(/*leafCount*/ 8, /*bucketCount*/ 33, /*seed*/ 0);
+
+        for (auto codec : {
+            EDistributedStatsCodec::Double,
+            EDistributedStatsCodec::Float,
+            EDistributedStatsCodec::FloatDelta
+        }) {
+            const auto compactStats3D = PackStats3D(stats3D, codec);
+            AssertStatsEqual(
+                UnpackStats3D(compactStats3D),
+                stats3D,
+                (codec == EDistributedStatsCodec::Double) ? 0.0 : 1e-5
+            );
+
+            // zero bucket stats are not stored
+            UNIT_ASSERT_LT(compactStats3D.Payload.size(), stats3D.Stats.size() * sizeof(TBucketStats) / 2);
+            UNIT_ASSERT_VALUES_EQUAL(compactStats3D.TransportBytes, compactStats3D.GetPackedByteSize());
+        }
+
+        // xor-delta encoding is lossless w.r.t. float rounding
+        AssertStatsEqual(
+            UnpackStats3D(PackStats3D(stats3D, EDistributedStatsCodec::FloatDelta)),
+            UnpackStats3D(PackStats3D(stats3D, EDistributedStatsCodec::Float)),
+            0.0
+        );
+    }
+
+    Y_UNIT_TEST(AllZero) {
+        TStats3D stats3D;
+        stats3D.BucketCount = 5;
+        stats3D.MaxLeafCount = 2;
+        stats3D.Stats.resize(10, TBucketStats{0, 0, 0, 0});
+
+        const auto compactStats3D = PackStats3D(stats3D, EDistributedStatsCodec::FloatDelta);
+        UNIT_ASSERT(compactStats3D.Payload.empty());
+        AssertStatsEqual(UnpackStats3D(compactStats3D), stats3D, 0.0);
+    }
+
+    Y_UNIT_TEST(Reduce) {
+        TVector<TStats3D> statsFromWorkers;
+        for (auto workerIdx : xrange(3)) {
+            statsFromWorkers.push_back(MakeStats3D(/*leafCount*/ 4, /*bucketCount*/ 70, workerIdx));
+        }
+        TStats3D expectedSum = statsFromWorkers[0];
+        expectedSum.Add(statsFromWorkers[1]);
+        expectedSum.Add(statsFromWorkers[2]);
+
+        for (auto codec : {EDistributedStatsCodec::Double, EDistributedStatsCodec::FloatDelta}) {
+            TVector<TCompactStats3D> packedStatsFromWorkers;
+            TVector<const TCompactStats3D*> packedStatsPtrs;
+            ui64 workersTransportBytes = 0;
+            for (const auto& stats3D : statsFromWorkers) {
+                packedStatsFromWorkers.push_back(PackStats3D(stats3D, codec));
+                workersTransportBytes += packedStatsFromWorkers.back().TransportBytes;
+            }
+            for (const auto& packedStats : packedStatsFromWorkers) {
+                packedStatsPtrs.push_back(&packedStats);
+            }
+
+            const auto reduced = ReducePackedStats3D(packedStatsPtrs);
+            UNIT_ASSERT_EQUAL(reduced.Codec, codec);
+            UNIT_ASSERT_VALUES_EQUAL(reduced.TransportBytes, workersTransportBytes + reduced.GetPackedByteSize());
+            AssertStatsEqual(
+                UnpackStats3D(reduced),
+                expectedSum,
+                (codec == EDistributedStatsCodec::Double) ? 1e-12 : 1e-4
+            );
+        }
+    }
+}
@@ -2,12 +2,17 @@
 
 #include <catboost/libs/helpers/exception.h>
 
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/utility.h>
 #include <util/generic/ymath.h>
 #include <util/generic/vector.h>
 #include <util/stream/output.h>
 
 #include <contrib/libs/clapack/clapack.h>
 
+#include <cmath>
+
 
 void SolveLinearSystem(TArrayRef<double> matrix, TArrayRef<double> target) {
     const auto expectedMatrixSize = target.size() * (target.size() + 1) / 2;
@@ -48,3 +53,124 @@ void SolveLinearSystemCholesky(TVector<double>* matrix,
 
     Y_VERIFY(info >= 0);
 }
+
+static constexpr int CHOLESKY_BLOCK_SIZE = 64;
+static constexpr int MIN_BLOCKED_CHOLESKY_SYSTEM_SIZE = 256;
+
+static inline double DotProduct(const double* lhs, const double* rhs, int size) {
+    double result = 0;
+    for (int idx = 0; idx < size; ++idx) {
+        result += lhs[idx] * rhs[idx];
+    }
+    return result;
+}
+
+// In-place L * L^T factorization of rows [begin, end) of the row-major lower triangle;
+// contributions of columns [0, begin) are already subtracted
+static bool FactorizeDiagonalBlock(int systemSize, int begin, int end, double* matrix) {
+    for (int j = begin; j < end; ++j) {
+        double* rowJ = matrix + (size_t)j * systemSize;
+        const double diag = rowJ[j] - DotProduct(rowJ + begin, rowJ + begin, j - begin);
+        if (!(diag > 0)) {
+            return false;
+        }
+        rowJ[j] = std::sqrt(diag);
+        for (int i = j + 1; i < end; ++i) {
+            double* rowI = matrix + (size_t)i * systemSize;
+            rowI[j] = (rowI[j] - DotProduct(rowI + begin, rowJ + begin, j - begin)) / rowJ[j];
+        }
+    }
+    return true;
+}
+
+// Solves panel rows [rowBegin, rowEnd) against the factorized diagonal block [begin, end)
+static void SolvePanel(int systemSize, int begin, int end, int rowBegin, int rowEnd, double* matrix) {
+    for (int i = rowBegin; i < rowEnd; ++i) {
+        double* rowI = matrix + (size_t)i * systemSize;
+        for (int j = begin; j < end; ++j) {
+            const double* rowJ = matrix + (size_t)j * systemSize;
+            rowI[j] = (rowI[j] - DotProduct(rowI + begin, rowJ + begin, j - begin)) / rowJ[j];
+        }
+    }
+}
+
+// Subtracts contribution of panel columns [begin, end) from trailing rows [rowBegin, rowEnd)
+static void UpdateTrailingRows(int systemSize, int begin, int end, int rowBegin, int rowEnd, double* matrix) {
+    const int panelWidth = end - begin;
+    for (int i = rowBegin; i < rowEnd; ++i) {
+        double* rowI = matrix + (size_t)i * systemSize;
+        for (int j = end; j <= i; ++j) {
+            const double* rowJ = matrix + (size_t)j * systemSize;
+            rowI[j] -= DotProduct(rowI + begin, rowJ + begin, panelWidth);
+        }
+    }
+}
+
+static bool FactorizeCholeskyBlocked(int systemSize, double* matrix, NPar::TLocalExecutor* localExecutor) {
+    for (int begin = 0; begin < systemSize; begin += CHOLESKY_BLOCK_SIZE) {
+        const int end = Min(begin + CHOLESKY_BLOCK_SIZE, systemSize);
+        if (!FactorizeDiagonalBlock(systemSize, begin, end, matrix)) {
+            return false;
+        }
+        const int rowBlockCount = CeilDiv(systemSize - end, CHOLESKY_BLOCK_SIZE);
+        if (rowBlockCount == 0) {
+            break;
+        }
+        // each element is computed by a single task, so results don't depend on scheduling
+        localExecutor->ExecRangeWithThrow(
+            [=] (int rowBlockIdx) {
+                const int rowBegin = end + rowBlockIdx * CHOLESKY_BLOCK_SIZE;
+                const int rowEnd = Min(rowBegin + CHOLESKY_BLOCK_SIZE, systemSize);
+                SolvePanel(systemSize, begin, end, rowBegin, rowEnd, matrix);
+            },
+            0,
+            rowBlockCount,
+            NPar::TLocalExecutor::WAIT_COMPLETE);
+        // trailing rows are processed from the bottom as they are the most expensive ones
+        localExecutor->ExecRangeWithThrow(
+            [=] (int blockIdx) {
+                const int rowBlockIdx = rowBlockCount - 1 - blockIdx;
+                const int rowBegin = end + rowBlockIdx * CHOLESKY_BLOCK_SIZE;
+                const int rowEnd = Min(rowBegin + CHOLESKY_BLOCK_SIZE, systemSize);
+                UpdateTrailingRows(systemSize, begin, end, rowBegin, rowEnd, matrix);
+            },
+            0,
+            rowBlockCount,
+            NPar::TLocalExecutor::WAIT_COMPLETE);
+    }
+    return true;
+}
+
+void SolveLinearSystemCholesky(
+    TVector<double>* matrix,
+    TVector<double>* target,
+    NPar::TLocalExecutor* localExecutor
+) {
+    const int systemSize = target->ysize();
+    if (localExecutor == nullptr || systemSize < MIN_BLOCKED_CHOLESKY_SYSTEM_SIZE) {
+        SolveLinearSystemCholesky(matrix, target);
+        return;
+    }
+    Y_ASSERT(matrix->size() == (size_t)systemSize * systemSize);
+
+    double* matrixData = matrix->data();
+    if (!FactorizeCholeskyBlocked(systemSize, matrixData, localExecutor)) {
+        return;
+    }
+
+    // L * y = target
+    double* targetData = target->data();
+    for (int i = 0; i < systemSize; ++i) {
+        const double* rowI = matrixData + (size_t)i * systemSize;
+        targetData[i] = (targetData[i] - DotProduct(rowI, targetData, i)) / rowI[i];
+    }
+    // L^T * x = y, L^T columns are L rows
+    for (int i = systemSize - 1; i >= 0; --i) {
+        const double* rowI = matrixData + (size_t)i * systemSize;
+        targetData[i] /= rowI[i];
+        const double value = targetData[i];
+        for (int j = 0; j < i; ++j) {
+            targetData[j] -= rowI[j] * value;
+        }
+    }
+}
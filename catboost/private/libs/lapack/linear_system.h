@@ -3,6 +3,21 @@
 #include <util/generic/fwd.h>
 #include <util/generic/array_ref.h>
 
+namespace NPar {
+    class TLocalExecutor;
+}
+
 void SolveLinearSystem(TArrayRef<double> matrix, TArrayRef<double> target);
 
 void SolveLinearSystemCholesky(TVector<double>* matrix, TVector<double>* target);
+
+/* Row-major matrix, only lower triangle is referenced (same storage as above).
+ * Large systems are factorized by blocks in parallel, small ones are passed to LAPACK.
+ * Results do not depend on thread count.
+ * Target is left unchanged if matrix is not positive definite.
+ */
+void SolveLinearSystemCholesky(
+    TVector<double>* matrix,
+    TVector<double>* target,
+    NPar::TLocalExecutor* localExecutor
+);
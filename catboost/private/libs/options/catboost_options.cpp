@@ -837,6 +837,12 @@ ui32 NCatboostOptions::GetThreadCount(const NJson::TJsonValue& source) {
     return threadCount.Get();
 }
 
+EThreadAffinity NCatboostOptions::GetThreadAffinity(const NJson::TJsonValue& source) {
+    TOption<EThreadAffinity> threadAffinity("thread_affinity", EThreadAffinity::None);
+    TJsonFieldHelper<decltype(threadAffinity)>::Read(source["system_options"], &threadAffinity);
+    return threadAffinity.Get();
+}
+
 NCatboostOptions::TCatBoostOptions NCatboostOptions::LoadOptions(const NJson::TJsonValue& source) {
     //little hack. JSON parsing needs to known device_type
     TCatBoostOptions options(GetTaskType(source));
@@ -79,6 +79,8 @@ namespace NCatboostOptions {
 
     ui32 GetThreadCount(const NJson::TJsonValue& source);
 
+    EThreadAffinity GetThreadAffinity(const NJson::TJsonValue& source);
+
     TCatBoostOptions LoadOptions(const NJson::TJsonValue& source);
 
     bool IsParamsCompatible(TStringBuf firstSerializedParams, TStringBuf secondSerializedParams);
@@ -23,6 +23,7 @@ NCatboostOptions::TDataProcessingOptions::TDataProcessingOptions(ETaskType type)
       , ClassNames("class_names", TVector<TString>())
       , DevDefaultValueFractionToEnableSparseStorage("dev_default_value_fraction_for_sparse", 0.83f)
       , DevSparseArrayIndexingType("dev_sparse_array_indexing", NCB::ESparseArrayIndexingType::Indices)
+      , DevQuantileSketchRankError("dev_quantile_sketch_rank_error", 0.0f)
       , GpuCatFeaturesStorage("gpu_cat_features_storage", EGpuCatFeaturesStorage::GpuRam, type)
       , DevLeafwiseScoring("dev_leafwise_scoring", false, type)
       , DevGroupFeatures("dev_group_features", false, type)
@@ -38,6 +39,7 @@ void NCatboostOptions::TDataProcessingOptions::Load(const NJson::TJsonValue& opt
         &ClassesCount, &ClassWeights, &ClassNames,
         &DevDefaultValueFractionToEnableSparseStorage,
         &DevSparseArrayIndexingType,
+        &DevQuantileSketchRankError,
         &GpuCatFeaturesStorage, &DevLeafwiseScoring, &DevGroupFeatures
     );
     Validate();
@@ -51,6 +53,7 @@ void NCatboostOptions::TDataProcessingOptions::Save(NJson::TJsonValue* options)
         ClassesCount, ClassWeights, ClassNames,
         DevDefaultValueFractionToEnableSparseStorage,
         DevSparseArrayIndexingType,
+        DevQuantileSketchRankError,
         GpuCatFeaturesStorage, DevLeafwiseScoring, DevGroupFeatures
     );
 }
@@ -60,13 +63,15 @@ bool NCatboostOptions::TDataProcessingOptions::operator==(const TDataProcessingO
                     FloatFeaturesBinarization, PerFloatFeatureQuantization, TextProcessingOptions,
                     ClassesCount, ClassWeights, ClassNames,
                     DevDefaultValueFractionToEnableSparseStorage,
-                    DevSparseArrayIndexingType, GpuCatFeaturesStorage, DevLeafwiseScoring,
+                    DevSparseArrayIndexingType, DevQuantileSketchRankError,
+                    GpuCatFeaturesStorage, DevLeafwiseScoring,
                     DevGroupFeatures) ==
            std::tie(rhs.IgnoredFeatures, rhs.HasTimeFlag, rhs.AllowConstLabel, rhs.TargetBorder,
                     rhs.FloatFeaturesBinarization, rhs.PerFloatFeatureQuantization, rhs.TextProcessingOptions,
                     rhs.ClassesCount, rhs.ClassWeights, rhs.ClassNames,
                     rhs.DevDefaultValueFractionToEnableSparseStorage,
-                    rhs.DevSparseArrayIndexingType, rhs.GpuCatFeaturesStorage, rhs.DevLeafwiseScoring,
+                    rhs.DevSparseArrayIndexingType, rhs.DevQuantileSketchRankError,
+                    rhs.GpuCatFeaturesStorage, rhs.DevLeafwiseScoring,
                     rhs.DevGroupFeatures);
 }
 
@@ -80,6 +85,10 @@ void NCatboostOptions::TDataProcessingOptions::Validate() const {
         (DevDefaultValueFractionToEnableSparseStorage.Get() < 1.f),
         "DevDefaultValueFractionToEnableSparseStorage must be in [0, 1)"
     );
+    CB_ENSURE(
+        (DevQuantileSketchRankError.Get() >= 0.f) && (DevQuantileSketchRankError.Get() < 1.f),
+        "DevQuantileSketchRankError must be in [0, 1)"
+    );
     CB_ENSURE(
         DevGroupFeatures.NotSet() || DevLeafwiseScoring.IsSet(),
         "DevGroupFeatures is supported only with DevLeafwiseScoring"
@@ -45,6 +45,7 @@ namespace NCatboostOptions {
 
         TOption<float> DevDefaultValueFractionToEnableSparseStorage; // 0 means sparse storage is disabled
         TOption<NCB::ESparseArrayIndexingType> DevSparseArrayIndexingType;
+        TOption<float> DevQuantileSketchRankError; // 0 means borders are calculated on a subset of exact values
 
         TGpuOnlyOption<EGpuCatFeaturesStorage> GpuCatFeaturesStorage;
         TCpuOnlyOption<bool> DevLeafwiseScoring;
@@ -270,6 +270,32 @@ enum class ENodeType {
     SingleHost
 };
 
+enum class EDistributedStatsCodec {
+    Double,     // exact
+    Float,      // values rounded to float32
+    FloatDelta  // values rounded to float32, xor-delta encoded between neighbouring buckets
+};
+
+enum class EDistributedReduceTopology {
+    Master, // all outputs are sent to the master and reduced there
+    Tree    // outputs are reduced on workers along the distribution tree, the master gets one output
+};
+
+enum class EDistributedDataLoading {
+    Master, // workers get their parts of the learn dataset from the master (unless it is on a shared file system)
+    Workers // workers read their parts of the quantized learn pool from the same path themselves
+};
+
+enum class EDistributedPartitioning {
+    Objects, // each worker has a part of objects and calculates stats of all features for it
+    Features // each worker has all objects and calculates scores of its part of features
+};
+
+enum class EThreadAffinity {
+    None,     // threads are scheduled by the OS
+    NumaNodes // each training thread is bound to its own CPU, threads with close ids are on the same NUMA node
+};
+
 enum class EFinalCtrComputationMode {
     Skip,
     Default
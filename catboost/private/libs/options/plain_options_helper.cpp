@@ -422,6 +422,7 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "class_weights", &dataProcessingOptions, &seenKeys);
     CopyOption(plainOptions, "dev_default_value_fraction_for_sparse", &dataProcessingOptions, &seenKeys);
     CopyOption(plainOptions, "dev_sparse_array_indexing", &dataProcessingOptions, &seenKeys);
+    CopyOption(plainOptions, "dev_quantile_sketch_rank_error", &dataProcessingOptions, &seenKeys);
     CopyOption(plainOptions, "gpu_cat_features_storage", &dataProcessingOptions, &seenKeys);
     CopyOption(plainOptions, "dev_leafwise_scoring", &dataProcessingOptions, &seenKeys);
     CopyOption(plainOptions, "dev_group_features", &dataProcessingOptions, &seenKeys);
@@ -451,6 +452,12 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "node_type", &systemOptions, &seenKeys);
     CopyOption(plainOptions, "node_port", &systemOptions, &seenKeys);
     CopyOption(plainOptions, "file_with_hosts", &systemOptions, &seenKeys);
+    CopyOption(plainOptions, "features_column_store_dir", &systemOptions, &seenKeys);
+    CopyOption(plainOptions, "distributed_stats_codec", &systemOptions, &seenKeys);
+    CopyOption(plainOptions, "distributed_reduce_topology", &systemOptions, &seenKeys);
+    CopyOption(plainOptions, "distributed_data_loading", &systemOptions, &seenKeys);
+    CopyOption(plainOptions, "distributed_partitioning", &systemOptions, &seenKeys);
+    CopyOption(plainOptions, "thread_affinity", &systemOptions, &seenKeys);
 
 
     //rest
@@ -801,6 +808,9 @@ void NCatboostOptions::ConvertOptionsToPlainJson(
         CopyOption(dataProcessingOptions, "dev_sparse_array_indexing", &plainOptionsJson, &seenKeys);
         DeleteSeenOption(&optionsCopyDataProcessing, "dev_sparse_array_indexing");
 
+        CopyOption(dataProcessingOptions, "dev_quantile_sketch_rank_error", &plainOptionsJson, &seenKeys);
+        DeleteSeenOption(&optionsCopyDataProcessing, "dev_quantile_sketch_rank_error");
+
         CopyOption(dataProcessingOptions, "gpu_cat_features_storage", &plainOptionsJson, &seenKeys);
         DeleteSeenOption(&optionsCopyDataProcessing, "gpu_cat_features_storage");
 
@@ -874,6 +884,21 @@ void NCatboostOptions::ConvertOptionsToPlainJson(
         CopyOption(systemOptions, "file_with_hosts", &plainOptionsJson, &seenKeys);
         DeleteSeenOption(&optionsCopySystemOptions, "file_with_hosts");
 
+        CopyOption(systemOptions, "features_column_store_dir", &plainOptionsJson, &seenKeys);
+        DeleteSeenOption(&optionsCopySystemOptions, "features_column_store_dir");
+
+        CopyOption(systemOptions, "distributed_stats_codec", &plainOptionsJson, &seenKeys);
+        DeleteSeenOption(&optionsCopySystemOptions, "distributed_stats_codec");
+
+        CopyOption(systemOptions, "distributed_reduce_topology", &plainOptionsJson, &seenKeys);
+        DeleteSeenOption(&optionsCopySystemOptions, "distributed_reduce_topology");
+        CopyOption(systemOptions, "distributed_data_loading", &plainOptionsJson, &seenKeys);
+        DeleteSeenOption(&optionsCopySystemOptions, "distributed_data_loading");
+        CopyOption(systemOptions, "distributed_partitioning", &plainOptionsJson, &seenKeys);
+        DeleteSeenOption(&optionsCopySystemOptions, "distributed_partitioning");
+        CopyOption(systemOptions, "thread_affinity", &plainOptionsJson, &seenKeys);
+        DeleteSeenOption(&optionsCopySystemOptions, "thread_affinity");
+
         CB_ENSURE(optionsCopySystemOptions.GetMapSafe().empty(), "system_options: key " + optionsCopySystemOptions.GetMapSafe().begin()->first + " wasn't added to plain options.");
         DeleteSeenOption(&optionsCopy, "system_options");
     }
@@ -919,6 +944,7 @@ void NCatboostOptions::CleanPlainJson(
     // options with no influence on the final model
     DeleteSeenOption(plainOptionsJsonEfficient, "objective_metric");
     DeleteSeenOption(plainOptionsJsonEfficient, "thread_count");
+    DeleteSeenOption(plainOptionsJsonEfficient, "thread_affinity");
     DeleteSeenOption(plainOptionsJsonEfficient, "allow_const_label");
     DeleteSeenOption(plainOptionsJsonEfficient, "detailed_profile");
     DeleteSeenOption(plainOptionsJsonEfficient, "logging_level");
@@ -17,6 +17,12 @@ TSystemOptions::TSystemOptions(ETaskType taskType)
     , NodeType("node_type", ENodeType::SingleHost, taskType)
     , FileWithHosts("file_with_hosts", "hosts.txt", taskType)
     , NodePort("node_port", GetUnusedNodePort(), taskType)
+    , FeaturesColumnStoreDir("features_column_store_dir", "", taskType)
+    , DistributedStatsCodec("distributed_stats_codec", EDistributedStatsCodec::Double, taskType)
+    , DistributedReduceTopology("distributed_reduce_topology", EDistributedReduceTopology::Master, taskType)
+    , DistributedDataLoading("distributed_data_loading", EDistributedDataLoading::Master, taskType)
+    , DistributedPartitioning("distributed_partitioning", EDistributedPartitioning::Objects, taskType)
+    , ThreadAffinity("thread_affinity", EThreadAffinity::None, taskType)
 {
     Devices.ChangeLoadUnimplementedPolicy(ELoadUnimplementedPolicy::SkipWithWarning);
     GpuRamPart.ChangeLoadUnimplementedPolicy(ELoadUnimplementedPolicy::SkipWithWarning);
@@ -24,18 +30,22 @@ TSystemOptions::TSystemOptions(ETaskType taskType)
 }
 
 void TSystemOptions::Load(const NJson::TJsonValue& options) {
-    CheckedLoad(options, &NumThreads, &CpuUsedRamLimit, &Devices, &GpuRamPart, &PinnedMemorySize, &NodeType, &FileWithHosts, &NodePort);
+    CheckedLoad(options, &NumThreads, &CpuUsedRamLimit, &Devices, &GpuRamPart, &PinnedMemorySize, &NodeType, &FileWithHosts, &NodePort, &FeaturesColumnStoreDir, &DistributedStatsCodec, &DistributedReduceTopology, &DistributedDataLoading, &DistributedPartitioning, &ThreadAffinity);
 }
 
 void TSystemOptions::Save(NJson::TJsonValue* options) const {
-    SaveFields(options, NumThreads, CpuUsedRamLimit, Devices, GpuRamPart, PinnedMemorySize, NodeType, FileWithHosts, NodePort);
+    SaveFields(options, NumThreads, CpuUsedRamLimit, Devices, GpuRamPart, PinnedMemorySize, NodeType, FileWithHosts, NodePort, FeaturesColumnStoreDir, DistributedStatsCodec, DistributedReduceTopology, DistributedDataLoading, DistributedPartitioning, ThreadAffinity);
 }
 
 bool TSystemOptions::operator==(const TSystemOptions& rhs) const {
     return std::tie(NumThreads, CpuUsedRamLimit, Devices,
-                    GpuRamPart, PinnedMemorySize, NodeType, FileWithHosts, NodePort) ==
+                    GpuRamPart, PinnedMemorySize, NodeType, FileWithHosts, NodePort, FeaturesColumnStoreDir,
+                    DistributedStatsCodec, DistributedReduceTopology, DistributedDataLoading,
+                    DistributedPartitioning, ThreadAffinity) ==
            std::tie(rhs.NumThreads, rhs.CpuUsedRamLimit, rhs.Devices,
-                    rhs.GpuRamPart, rhs.PinnedMemorySize, rhs.NodeType, rhs.FileWithHosts, rhs.NodePort);
+                    rhs.GpuRamPart, rhs.PinnedMemorySize, rhs.NodeType, rhs.FileWithHosts, rhs.NodePort,
+                    rhs.FeaturesColumnStoreDir, rhs.DistributedStatsCodec, rhs.DistributedReduceTopology,
+                    rhs.DistributedDataLoading, rhs.DistributedPartitioning, rhs.ThreadAffinity);
 }
 
 bool TSystemOptions::operator!=(const TSystemOptions& rhs) const {
@@ -30,6 +30,24 @@ namespace NCatboostOptions {
         TCpuOnlyOption<TString> FileWithHosts;
         TCpuOnlyOption<ui32> NodePort;
 
+        // if set, dense quantized features data is moved to a memory-mapped file in this dir for training
+        TCpuOnlyOption<TString> FeaturesColumnStoreDir;
+
+        // encoding of bucket statistics sent between hosts in distributed training
+        TCpuOnlyOption<EDistributedStatsCodec> DistributedStatsCodec;
+
+        // where outputs of workers are reduced in distributed training
+        TCpuOnlyOption<EDistributedReduceTopology> DistributedReduceTopology;
+
+        // how workers get their parts of the learn dataset in distributed training
+        TCpuOnlyOption<EDistributedDataLoading> DistributedDataLoading;
+
+        // how the work is split between workers in distributed training
+        TCpuOnlyOption<EDistributedPartitioning> DistributedPartitioning;
+
+        // binding of training threads to CPUs
+        TCpuOnlyOption<EThreadAffinity> ThreadAffinity;
+
         static ui32 GetUnusedNodePort() { return 0; }
         bool IsMaster() const;
         bool IsSingleHost() const;
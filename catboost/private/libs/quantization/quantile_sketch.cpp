@@ -0,0 +1,239 @@
+#include "quantile_sketch.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/hash_set.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+
+#include <cmath>
+
+
+namespace NCB {
+
+    static constexpr ui32 MIN_SKETCH_CAPACITY = 8;
+    static constexpr ui32 MIN_COMPACTOR_CAPACITY = 2;
+    static constexpr double COMPACTOR_CAPACITY_DECAY = 2.0 / 3.0;
+
+    // number of sketch quantiles used for quantile based border selection types
+    static constexpr ui32 MAX_SKETCH_QUANTILES_COUNT = 1 << 16;
+
+
+    TQuantileSketch::TQuantileSketch(float rankError, ui64 seed)
+        : Capacity(Max<ui32>(MIN_SKETCH_CAPACITY, (ui32)std::ceil(2.0 / rankError)))
+        , RandState(seed)
+        , Compactors(1)
+    {
+        CB_ENSURE_INTERNAL(
+            (rankError > 0.0f) && (rankError < 1.0f),
+            "Quantile sketch rank error must be in (0, 1), got " << rankError
+        );
+    }
+
+    void TQuantileSketch::Add(float value) {
+        Compactors[0].push_back(value);
+        ++Count;
+        MinValue = Min(MinValue, value);
+        MaxValue = Max(MaxValue, value);
+        if (Compactors[0].size() >= GetCompactorCapacity(0)) {
+            Compress();
+        }
+    }
+
+    void TQuantileSketch::Add(TConstArrayRef<float> values) {
+        // add by parts to keep the memory usage bounded
+        for (size_t begin = 0; begin < values.size(); begin += Capacity) {
+            const auto part = values.Slice(begin, Min<size_t>(Capacity, values.size() - begin));
+            for (auto value : part) {
+                MinValue = Min(MinValue, value);
+                MaxValue = Max(MaxValue, value);
+            }
+            Compactors[0].insert(Compactors[0].end(), part.begin(), part.end());
+            Count += part.size();
+            Compress();
+        }
+    }
+
+    void TQuantileSketch::Merge(const TQuantileSketch& rhs) {
+        CB_ENSURE_INTERNAL(Capacity == rhs.Capacity, "Merged quantile sketches have different rank errors");
+        if (!rhs.Count) {
+            return;
+        }
+        if (Compactors.size() < rhs.Compactors.size()) {
+            Compactors.resize(rhs.Compactors.size());
+        }
+        for (auto level : xrange(rhs.Compactors.size())) {
+            Compactors[level].insert(
+                Compactors[level].end(),
+                rhs.Compactors[level].begin(),
+                rhs.Compactors[level].end()
+            );
+        }
+        Count += rhs.Count;
+        MinValue = Min(MinValue, rhs.MinValue);
+        MaxValue = Max(MaxValue, rhs.MaxValue);
+        Compress();
+    }
+
+    size_t TQuantileSketch::GetStoredCount() const {
+        size_t result = 0;
+        for (const auto& compactor : Compactors) {
+            result += compactor.size();
+        }
+        return result;
+    }
+
+    void TQuantileSketch::GetWeightedValues(TVector<float>* values, TVector<float>* weights) const {
+        TVector<std::pair<float, double>> weightedValues;
+        weightedValues.reserve(GetStoredCount());
+        double weight = 1.0;
+        for (const auto& compactor : Compactors) {
+            for (auto value : compactor) {
+                weightedValues.emplace_back(value, weight);
+            }
+            weight *= 2.0;
+        }
+        Sort(weightedValues, [] (const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+        values->clear();
+        weights->clear();
+        for (const auto& [value, valueWeight] : weightedValues) {
+            if (!values->empty() && (values->back() == value)) {
+                weights->back() += valueWeight;
+            } else {
+                values->push_back(value);
+                weights->push_back(valueWeight);
+            }
+        }
+    }
+
+    float TQuantileSketch::GetQuantile(double rank) const {
+        CB_ENSURE_INTERNAL(Count, "Quantile of an empty sketch");
+        CB_ENSURE_INTERNAL((rank >= 0.0) && (rank <= 1.0), "Quantile rank must be in [0, 1], got " << rank);
+
+        TVector<float> values;
+        TVector<float> weights;
+        GetWeightedValues(&values, &weights);
+
+        const double targetWeight = rank * Count;
+        double cumulativeWeight = 0.0;
+        for (auto i : xrange(values.size())) {
+            cumulativeWeight += weights[i];
+            if (cumulativeWeight >= targetWeight) {
+                return values[i];
+            }
+        }
+        return MaxValue;
+    }
+
+    ui32 TQuantileSketch::GetCompactorCapacity(size_t level) const {
+        const size_t depth = Compactors.size() - 1 - level;
+        return Max<ui32>(
+            MIN_COMPACTOR_CAPACITY,
+            (ui32)std::ceil(Capacity * std::pow(COMPACTOR_CAPACITY_DECAY, (double)depth))
+        );
+    }
+
+    bool TQuantileSketch::GetRandomBit() {
+        // splitmix64
+        RandState += 0x9E3779B97F4A7C15ULL;
+        ui64 z = RandState;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z = z ^ (z >> 31);
+        return z >> 63;
+    }
+
+    void TQuantileSketch::Compress() {
+        for (size_t level = 0; level < Compactors.size(); ++level) {
+            if (Compactors[level].size() < GetCompactorCapacity(level)) {
+                continue;
+            }
+            if (level + 1 == Compactors.size()) {
+                Compactors.emplace_back();
+            }
+            auto& compactor = Compactors[level];
+            auto& nextCompactor = Compactors[level + 1];
+
+            Sort(compactor);
+
+            // the largest value stays in the compactor if the number of values is odd
+            const size_t compactedSize = compactor.size() & ~size_t(1);
+            for (size_t i = GetRandomBit(); i < compactedSize; i += 2) {
+                nextCompactor.push_back(compactor[i]);
+            }
+            if (compactedSize < compactor.size()) {
+                compactor[0] = compactor.back();
+                compactor.resize(1);
+            } else {
+                compactor.clear();
+            }
+        }
+    }
+
+
+    TVector<float> BuildBordersFromSketch(
+        const TQuantileSketch& sketch,
+        EBorderSelectionType borderSelectionType,
+        ui32 borderCount
+    ) {
+        if (!sketch.GetCount() || !borderCount) {
+            return {};
+        }
+
+        TVector<float> values;
+        TVector<float> weights;
+        sketch.GetWeightedValues(&values, &weights);
+
+        switch (borderSelectionType) {
+            case EBorderSelectionType::MinEntropy:
+            case EBorderSelectionType::MaxLogSum:
+            case EBorderSelectionType::GreedyLogSum:
+            case EBorderSelectionType::GreedyMinEntropy: {
+                const THashSet<float> borders = BestWeightedSplit(
+                    std::move(values),
+                    weights,
+                    borderCount,
+                    borderSelectionType,
+                    /*filterNans*/ false,
+                    /*featuresAreSorted*/ true
+                );
+                TVector<float> result(borders.begin(), borders.end());
+                Sort(result);
+                return result;
+            }
+            case EBorderSelectionType::Median:
+            case EBorderSelectionType::Uniform:
+            case EBorderSelectionType::UniformAndQuantiles: {
+                const ui32 quantilesCount = (ui32)Min<ui64>(sketch.GetCount(), MAX_SKETCH_QUANTILES_COUNT);
+
+                TVector<float> quantiles;
+                quantiles.yresize(quantilesCount);
+                const double weightStep = (double)sketch.GetCount() / quantilesCount;
+                double cumulativeWeight = 0.0;
+                size_t valueIdx = 0;
+                for (auto i : xrange(quantilesCount)) {
+                    const double targetWeight = (i + 0.5) * weightStep;
+                    while ((valueIdx + 1 < values.size()) && (cumulativeWeight + weights[valueIdx] < targetWeight)) {
+                        cumulativeWeight += weights[valueIdx];
+                        ++valueIdx;
+                    }
+                    quantiles[i] = values[valueIdx];
+                }
+                quantiles.front() = sketch.GetMin();
+                quantiles.back() = sketch.GetMax();
+
+                auto quantization = NSplitSelection::BestSplit(
+                    NSplitSelection::TFeatureValues(std::move(quantiles), /*valuesSorted*/ true),
+                    /*featureValuesMayContainNans*/ false,
+                    borderCount,
+                    borderSelectionType
+                );
+                return std::move(quantization.Borders);
+            }
+        }
+        ythrow TCatBoostException() << "Unexpected border selection type " << borderSelectionType;
+    }
+
+}
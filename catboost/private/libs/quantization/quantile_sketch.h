@@ -0,0 +1,92 @@
+#pragma once
+
+#include <library/binsaver/bin_saver.h>
+#include <library/grid_creator/binarization.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+#include <limits>
+
+
+namespace NCB {
+
+    /*
+     * Mergeable quantile sketch of float values (KLL: Karnin, Lang, Liberty, 2016).
+     *
+     * Values are stored in compactors, each value in compactor h has weight 2^h.
+     * When a compactor overflows its values are sorted and every second of them (odd or even positions
+     *  at random) is promoted to the next compactor, capacities of lower compactors decrease geometrically.
+     * Rank of any value is estimated with the error about rankError * GetCount() with high probability
+     *  using O(1 / rankError) memory, independently of the number of added values.
+     *
+     * Sketches can be built independently for parts of data (blocks, threads, workers) and then merged,
+     *  the result has the same error guarantees as a sketch built for all data.
+     * Exact minimum and maximum values are always preserved.
+     */
+    class TQuantileSketch {
+    public:
+        TQuantileSketch() = default; // for serialization only
+
+        // rankError must be in (0, 1)
+        explicit TQuantileSketch(float rankError, ui64 seed = 0);
+
+        // NaNs must be filtered out by the caller
+        void Add(float value);
+        void Add(TConstArrayRef<float> values);
+
+        // rhs must have the same rankError
+        void Merge(const TQuantileSketch& rhs);
+
+        ui64 GetCount() const {
+            return Count;
+        }
+
+        // must not be called for an empty sketch
+        float GetMin() const {
+            return MinValue;
+        }
+        float GetMax() const {
+            return MaxValue;
+        }
+
+        // number of values stored in the sketch
+        size_t GetStoredCount() const;
+
+        // distinct stored values sorted in ascending order and their weights, weights sum is GetCount()
+        void GetWeightedValues(TVector<float>* values, TVector<float>* weights) const;
+
+        // value with approximate rank (rank * GetCount()), rank must be in [0, 1]
+        float GetQuantile(double rank) const;
+
+        SAVELOAD(Capacity, Count, MinValue, MaxValue, RandState, Compactors);
+
+    private:
+        ui32 GetCompactorCapacity(size_t level) const;
+        bool GetRandomBit();
+        void Compress();
+
+    private:
+        ui32 Capacity = 0; // capacity of the top compactor
+        ui64 Count = 0;
+        float MinValue = std::numeric_limits<float>::max();
+        float MaxValue = std::numeric_limits<float>::lowest();
+        ui64 RandState = 0;
+        TVector<TVector<float>> Compactors;
+    };
+
+
+    /*
+     * Borders calculated on the weighted values stored in the sketch.
+     * Weighted greedy and entropy based algorithms are applied to them directly,
+     *  Median, Uniform and UniformAndQuantiles are applied to the equally spaced sketch quantiles
+     *  (with exact minimum and maximum).
+     */
+    TVector<float> BuildBordersFromSketch(
+        const TQuantileSketch& sketch,
+        EBorderSelectionType borderSelectionType,
+        ui32 borderCount
+    );
+
+}
@@ -0,0 +1,144 @@
+#include <library/unittest/registar.h>
+
+#include <catboost/private/libs/quantization/quantile_sketch.h>
+
+#include <library/binsaver/util_stream_io.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/random/shuffle.h>
+#include <util/stream/buffer.h>
+
+using namespace NCB;
+
+
+static TVector<float> GenerateValues(ui32 count, ui64 seed) {
+    TFastRng64 rng(seed);
+    TVector<float> values;
+    values.yresize(count);
+    for (auto i : xrange(count)) {
+        // a lot of duplicates and a long tail
+        values[i] = (i % 3) ? (float)rng.Uniform(1000) : (float)(rng.GenRandReal1() * rng.GenRandReal1() * 1e6);
+    }
+    return values;
+}
+
+// max deviation of the sketch quantiles from the exact ranks, as a fraction of the values count
+static double CalcMaxRankError(const TQuantileSketch& sketch, TVector<float> values) {
+    Sort(values);
+    double maxError = 0.0;
+    for (auto i : xrange(101)) {
+        const double rank = i / 100.0;
+        const float quantile = sketch.GetQuantile(rank);
+        const double lowerRank = (double)(LowerBound(values.begin(), values.end(), quantile) - values.begin());
+        const double upperRank = (double)(UpperBound(values.begin(), values.end(), quantile) - values.begin());
+        const double targetRank = rank * values.size();
+        if (targetRank < lowerRank) {
+            maxError = Max(maxError, lowerRank - targetRank);
+        } else if (targetRank > upperRank) {
+            maxError = Max(maxError, targetRank - upperRank);
+        }
+    }
+    return maxError / values.size();
+}
+
+Y_UNIT_TEST_SUITE(TQuantileSketchTests) {
+    Y_UNIT_TEST(TestExactForSmallData) {
+        const TVector<float> values = {3.0f, 1.0f, 2.0f, 2.0f, 5.0f};
+        TQuantileSketch sketch(0.01f);
+        sketch.Add(values);
+
+        TVector<float> sketchValues;
+        TVector<float> sketchWeights;
+        sketch.GetWeightedValues(&sketchValues, &sketchWeights);
+        UNIT_ASSERT_VALUES_EQUAL(sketchValues, TVector<float>({1.0f, 2.0f, 3.0f, 5.0f}));
+        UNIT_ASSERT_VALUES_EQUAL(sketchWeights, TVector<float>({1.0f, 2.0f, 1.0f, 1.0f}));
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetCount(), 5);
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetMin(), 1.0f);
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetMax(), 5.0f);
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetQuantile(0.5), 2.0f);
+    }
+
+    Y_UNIT_TEST(TestRankError) {
+        const auto values = GenerateValues(300000, 0);
+        for (float rankError : {0.05f, 0.01f, 0.002f}) {
+            TQuantileSketch sketch(rankError, 17);
+            for (auto value : values) {
+                sketch.Add(value);
+            }
+            UNIT_ASSERT_VALUES_EQUAL(sketch.GetCount(), values.size());
+            UNIT_ASSERT(sketch.GetStoredCount() < 10 / rankError);
+            UNIT_ASSERT_VALUES_EQUAL(sketch.GetMin(), *MinElement(values.begin(), values.end()));
+            UNIT_ASSERT_VALUES_EQUAL(sketch.GetMax(), *MaxElement(values.begin(), values.end()));
+            UNIT_ASSERT(CalcMaxRankError(sketch, values) < 2 * rankError);
+        }
+    }
+
+    Y_UNIT_TEST(TestMerge) {
+        const auto values = GenerateValues(200000, 1);
+        const float rankError = 0.01f;
+
+        const ui32 partCount = 7;
+        TVector<TQuantileSketch> sketches;
+        for (auto partIdx : xrange(partCount)) {
+            sketches.emplace_back(rankError, partIdx);
+            const ui32 begin = values.size() * partIdx / partCount;
+            const ui32 end = values.size() * (partIdx + 1) / partCount;
+            sketches.back().Add(TConstArrayRef<float>(values.data() + begin, values.data() + end));
+        }
+        for (auto partIdx : xrange<ui32>(1, partCount)) {
+            sketches[0].Merge(sketches[partIdx]);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(sketches[0].GetCount(), values.size());
+        UNIT_ASSERT(sketches[0].GetStoredCount() < 10 / rankError);
+        UNIT_ASSERT(CalcMaxRankError(sketches[0], values) < 2 * rankError);
+
+        TVector<float> sketchValues;
+        TVector<float> sketchWeights;
+        sketches[0].GetWeightedValues(&sketchValues, &sketchWeights);
+        UNIT_ASSERT(IsSorted(sketchValues.begin(), sketchValues.end()));
+        UNIT_ASSERT_VALUES_EQUAL(Accumulate(sketchWeights, 0.0), (double)values.size());
+    }
+
+    Y_UNIT_TEST(TestSerialization) {
+        TQuantileSketch sketch(0.01f);
+        sketch.Add(GenerateValues(10000, 2));
+
+        TBufferOutput out;
+        SerializeToStream(out, sketch);
+        TBufferInput in(out.Buffer());
+        TQuantileSketch loadedSketch;
+        SerializeFromStream(in, loadedSketch);
+
+        UNIT_ASSERT_VALUES_EQUAL(loadedSketch.GetCount(), sketch.GetCount());
+        for (auto rank : {0.0, 0.1, 0.5, 0.9, 1.0}) {
+            UNIT_ASSERT_VALUES_EQUAL(loadedSketch.GetQuantile(rank), sketch.GetQuantile(rank));
+        }
+    }
+
+    Y_UNIT_TEST(TestBordersFromSketch) {
+        const auto values = GenerateValues(100000, 3);
+        TQuantileSketch sketch(0.005f);
+        sketch.Add(values);
+
+        for (auto borderSelectionType : {
+                EBorderSelectionType::Median,
+                EBorderSelectionType::GreedyLogSum,
+                EBorderSelectionType::UniformAndQuantiles,
+                EBorderSelectionType::MinEntropy,
+                EBorderSelectionType::MaxLogSum,
+                EBorderSelectionType::Uniform,
+                EBorderSelectionType::GreedyMinEntropy})
+        {
+            const auto borders = BuildBordersFromSketch(sketch, borderSelectionType, 32);
+            UNIT_ASSERT(!borders.empty());
+            UNIT_ASSERT(borders.size() <= 32);
+            UNIT_ASSERT(IsSorted(borders.begin(), borders.end()));
+            UNIT_ASSERT(borders.front() >= sketch.GetMin());
+            UNIT_ASSERT(borders.back() <= sketch.GetMax());
+        }
+
+        UNIT_ASSERT(BuildBordersFromSketch(TQuantileSketch(0.01f), EBorderSelectionType::GreedyLogSum, 32).empty());
+    }
+}
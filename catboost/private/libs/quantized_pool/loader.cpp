@@ -8,8 +8,10 @@
 #include <catboost/libs/data/unaligned_mem.h>
 #include <catboost/private/libs/data_util/exists_checker.h>
 #include <catboost/private/libs/data_util/path_with_scheme.h>
+#include <catboost/libs/helpers/compression.h>
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/maybe_owning_array_holder.h>
+#include <catboost/libs/helpers/resource_holder.h>
 #include <catboost/libs/logging/logging.h>
 #include <catboost/private/libs/quantization_schema/serialization.h>
 
@@ -19,6 +21,7 @@
 #include <util/generic/scope.h>
 #include <util/generic/vector.h>
 #include <util/generic/ylimits.h>
+#include <util/memory/blob.h>
 #include <util/system/madvise.h>
 #include <util/system/types.h>
 #include <util/system/unaligned_mem.h>
@@ -26,7 +29,9 @@
 using NCB::EObjectsOrder;
 using NCB::IQuantizedFeaturesDataVisitor;
 using NCB::IQuantizedFeaturesDatasetLoader;
+using NCB::IResourceHolder;
 using NCB::QuantizationSchemaFromProto;
+using NCB::TBlobHolder;
 using NCB::TDataMetaInfo;
 using NCB::TDatasetLoaderFactory;
 using NCB::TDatasetLoaderPullArgs;
@@ -40,7 +45,7 @@ using NCB::TUnalignedArrayBuf;
 
 NCB::TCBQuantizedDataLoader::TCBQuantizedDataLoader(TDatasetLoaderPullArgs&& args)
     : ObjectCount(0) // inited later
-    , QuantizedPool(std::forward<TQuantizedPool>(LoadQuantizedPool(args.PoolPath, GetLoadParameters(args.CommonArgs.DatasetSubset))))
+    , QuantizedPool(std::forward<TQuantizedPool>(LoadQuantizedPool(args.PoolPath, GetLoadParameters(args.CommonArgs.DatasetSubset, args.CommonArgs.LocalExecutor))))
     , PairsPath(args.CommonArgs.PairsFilePath)
     , GroupWeightsPath(args.CommonArgs.GroupWeightsFilePath)
     , BaselinePath(args.CommonArgs.BaselineFilePath)
@@ -152,9 +157,18 @@ void TSequentialChunkEvictor::MaybeEvict(const bool force) noexcept {
     Evicted_ = true;
 }
 
-static TDeque<TChunkRef> GatherAndSortChunks(const TQuantizedPool& pool) {
+// chunks of ignored (including constant) features are not gathered, so their pages are never touched
+static TDeque<TChunkRef> GatherAndSortChunks(
+    const TQuantizedPool& pool,
+    const THashMap<size_t, size_t>& columnIdxToFlatIdx,
+    const TVector<bool>& isFeatureIgnored)
+{
     TDeque<TChunkRef> chunks;
     for (const auto [columnIdx, localIdx] : pool.ColumnIndexToLocalIndex) {
+        const auto* const flatFeatureIdx = columnIdxToFlatIdx.FindPtr(columnIdx);
+        if (flatFeatureIdx && isFeatureIgnored[*flatFeatureIdx]) {
+            continue;
+        }
         for (const auto& description : pool.Chunks[localIdx]) {
             chunks.push_back({&description, static_cast<ui32>(columnIdx), static_cast<ui32>(localIdx)});
         }
@@ -229,6 +243,50 @@ void NCB::TCBQuantizedDataLoader::AddQuantizedFeatureChunk(
         TMaybeOwningConstArrayHolder<ui8>::CreateNonOwning(quants));
 }
 
+bool NCB::TCBQuantizedDataLoader::TryAddMappedFeatureColumn(
+    const TQuantizedPool::TChunkDescription& chunk,
+    const EColumn columnType,
+    const size_t flatFeatureIdx,
+    const TConstArrayRef<ui8> mappedPool,
+    const TIntrusivePtr<IResourceHolder>& mappedPoolHolder,
+    IQuantizedFeaturesDataVisitor* const visitor) const
+{
+    if (!mappedPoolHolder || (DatasetSubset.Range.Begin != 0) || (chunk.DocumentOffset != 0)) {
+        return false;
+    }
+
+    const ui8 bitsPerDocument = chunk.Chunk->BitsPerDocument();
+    if ((bitsPerDocument != 8) && (bitsPerDocument != 16) && (bitsPerDocument != 32)) {
+        return false;
+    }
+
+    const auto* const data = reinterpret_cast<const ui8*>(chunk.Chunk->Quants()->data());
+    const size_t documentCount = chunk.Chunk->Quants()->size() / (bitsPerDocument / CHAR_BIT);
+    if (documentCount < ObjectCount) {
+        return false;
+    }
+
+    // TCompressedArray reads whole ui64 words, the tail of the last one is the padding after quants
+    const size_t storageSize = TIndexHelper<ui64>(bitsPerDocument).CompressedSize(ObjectCount);
+    if ((reinterpret_cast<uintptr_t>(data) % alignof(ui64) != 0) ||
+        (data < mappedPool.begin()) ||
+        (data + storageSize * sizeof(ui64) > mappedPool.end()))
+    {
+        return false;
+    }
+
+    auto featureData = TMaybeOwningConstArrayHolder<ui64>::CreateOwning(
+        TConstArrayRef<ui64>(reinterpret_cast<const ui64*>(data), storageSize),
+        mappedPoolHolder);
+    if (columnType == EColumn::Num) {
+        visitor->AddFloatFeature(flatFeatureIdx, bitsPerDocument, std::move(featureData));
+    } else {
+        CB_ENSURE_INTERNAL(columnType == EColumn::Categ, "Unexpected feature column type " << columnType);
+        visitor->AddCatFeature(flatFeatureIdx, bitsPerDocument, std::move(featureData));
+    }
+    return true;
+}
+
 void NCB::TCBQuantizedDataLoader::AddChunk(
     const TQuantizedPool::TChunkDescription& chunk,
     const EColumn columnType,
@@ -344,7 +402,19 @@ void NCB::TCBQuantizedDataLoader::Do(IQuantizedFeaturesDataVisitor* visitor) {
     const auto columnIdxToTargetIdx = GetColumnIndexToTargetIndexMap(QuantizedPool);
     const auto columnIdxToFlatIdx = GetColumnIndexToFlatIndexMap(QuantizedPool);
     const auto columnIdxToBaselineIdx = GetColumnIndexToBaselineIndexMap(QuantizedPool);
-    const auto chunkRefs = GatherAndSortChunks(QuantizedPool);
+    const auto chunkRefs = GatherAndSortChunks(QuantizedPool, columnIdxToFlatIdx, IsFeatureIgnored);
+
+    /* Features columns that consist of a single aligned chunk are used by data provider directly from
+     * the mapped file, pages are loaded on demand. Eviction of their pages below is safe: they are clean
+     * file-backed pages and will be read again from file on the next access.
+     */
+    TConstArrayRef<ui8> mappedPool;
+    TIntrusivePtr<IResourceHolder> mappedPoolHolder;
+    if (QuantizedPool.ChunkStorage.empty() && (QuantizedPool.Blobs.size() == 1)) {
+        const auto& blob = QuantizedPool.Blobs[0];
+        mappedPool = TConstArrayRef<ui8>(blob.AsUnsignedCharPtr(), blob.Size());
+        mappedPoolHolder = MakeIntrusive<TBlobHolder>(blob);
+    }
 
     TSequentialChunkEvictor evictor(1ULL << 24);
     CATBOOST_DEBUG_LOG << "Number of chunks to process " << chunkRefs.size() << Endl;
@@ -383,7 +453,19 @@ void NCB::TCBQuantizedDataLoader::Do(IQuantizedFeaturesDataVisitor* visitor) {
         }
 
         const auto* const flatFeatureIdx = columnIdxToFlatIdx.FindPtr(columnIdx);
-        if (flatFeatureIdx && IsFeatureIgnored[*flatFeatureIdx]) {
+
+        const bool isSingleChunkFeature = flatFeatureIdx &&
+            (columnType == EColumn::Num || columnType == EColumn::Categ) &&
+            (QuantizedPool.Chunks[localIdx].size() == 1);
+        if (isSingleChunkFeature &&
+            TryAddMappedFeatureColumn(
+                *chunkRef.Description,
+                columnType,
+                *flatFeatureIdx,
+                mappedPool,
+                mappedPoolHolder,
+                visitor))
+        {
             continue;
         }
 
@@ -36,11 +36,23 @@ namespace NCB {
             const size_t flatFeatureIdx,
             IQuantizedFeaturesDataVisitor* visitor) const;
 
+        // returns false if column can't be used without copying
+        bool TryAddMappedFeatureColumn(
+            const TQuantizedPool::TChunkDescription& chunk,
+            EColumn columnType,
+            const size_t flatFeatureIdx,
+            TConstArrayRef<ui8> mappedPool,
+            const TIntrusivePtr<IResourceHolder>& mappedPoolHolder,
+            IQuantizedFeaturesDataVisitor* visitor) const;
+
         TConstArrayRef<ui8> ClipByDatasetSubset(const TQuantizedPool::TChunkDescription& chunk) const;
         ui32 GetDatasetOffset(const TQuantizedPool::TChunkDescription& chunk) const;
 
-        static TLoadQuantizedPoolParameters GetLoadParameters(NCB::TDatasetSubset loadSubset) {
-            return {/*LockMemory*/ false, /*Precharge*/ false, loadSubset};
+        static TLoadQuantizedPoolParameters GetLoadParameters(
+            NCB::TDatasetSubset loadSubset,
+            NPar::TLocalExecutor* localExecutor
+        ) {
+            return {/*LockMemory*/ false, /*Precharge*/ false, loadSubset, localExecutor};
         }
 
     private:
@@ -12,6 +12,9 @@
 
 #include <contrib/libs/flatbuffers/include/flatbuffers/flatbuffers.h>
 
+#include <library/blockcodecs/core/codecs.h>
+#include <library/threading/local_executor/local_executor.h>
+
 #include <catboost/idl/pool/flat/quantized_chunk_t.fbs.h>
 
 #include <util/digest/numeric.h>
@@ -19,12 +22,14 @@
 #include <util/generic/algorithm.h>
 #include <util/generic/array_ref.h>
 #include <util/generic/array_size.h>
+#include <util/generic/buffer.h>
 #include <util/generic/cast.h>
 #include <util/generic/deque.h>
 #include <util/generic/strbuf.h>
 #include <util/generic/string.h>
 #include <util/generic/utility.h>
 #include <util/generic/vector.h>
+#include <util/generic/xrange.h>
 #include <util/memory/blob.h>
 #include <util/stream/file.h>
 #include <util/stream/input.h>
@@ -46,8 +51,10 @@ static const char Magic[] = "CatboostQuantizedPool";
 static const size_t MagicSize = Y_ARRAY_SIZE(Magic);  // yes, with terminating zero
 static const char MagicEnd[] = "CatboostQuantizedPoolEnd";
 static const size_t MagicEndSize = Y_ARRAY_SIZE(MagicEnd);  // yes, with terminating zero
-static const ui32 Version = 1;
-static const ui32 VersionHash = IntHash(Version);
+// version 1 -- chunks are stored as is
+// version 2 -- chunks are compressed, header metainfo contains block codec name
+static const ui32 UncompressedVersion = 1;
+static const ui32 CompressedVersion = 2;
 
 template <typename T>
 static TDeque<ui32> CollectAndSortKeys(const T& m) {
@@ -120,12 +127,16 @@ namespace {
 
 static void WriteChunk(
     const NCB::TQuantizedPool::TChunkDescription& chunk,
+    const NBlockCodecs::ICodec* const codec, // nullptr if chunks are not compressed
     TCountingOutput* const output,
     TDeque<TChunkInfo>* const chunkInfos,
-    flatbuffers::FlatBufferBuilder* const builder) {
+    flatbuffers::FlatBufferBuilder* const builder,
+    TBuffer* const compressedChunk) {
 
     builder->Clear();
 
+    // align quants to 8 bytes to allow loader to use them as ui64 storage of features data directly
+    builder->ForceVectorAlignment(chunk.Chunk->Quants()->size(), sizeof(ui8), sizeof(ui64));
     const auto quantsOffset = builder->CreateVector(
         chunk.Chunk->Quants()->data(),
         chunk.Chunk->Quants()->size());
@@ -137,22 +148,32 @@ static void WriteChunk(
     AddPadding(16, output);
 
     const auto chunkOffset = output->Counter();
-    output->Write(builder->GetBufferPointer(), builder->GetSize());
+    ui32 chunkSize;
+    if (codec) {
+        codec->Encode(TStringBuf((const char*)builder->GetBufferPointer(), builder->GetSize()), *compressedChunk);
+        chunkSize = SafeIntegerCast<ui32>(compressedChunk->Size());
+        output->Write(compressedChunk->Data(), compressedChunk->Size());
+    } else {
+        chunkSize = builder->GetSize();
+        output->Write(builder->GetBufferPointer(), builder->GetSize());
+    }
 
-    chunkInfos->emplace_back(builder->GetSize(), chunkOffset, chunk.DocumentOffset, chunk.DocumentCount);
+    chunkInfos->emplace_back(chunkSize, chunkOffset, chunk.DocumentOffset, chunk.DocumentCount);
 }
 
-static void WriteHeader(TCountingOutput* const output) {
+static void WriteHeader(const NBlockCodecs::ICodec* const codec, TCountingOutput* const output) {
+    const ui32 version = codec ? CompressedVersion : UncompressedVersion;
     output->Write(Magic, MagicSize);
-    WriteLittleEndian(Version, output);
-    WriteLittleEndian(VersionHash, output);
+    WriteLittleEndian(version, output);
+    WriteLittleEndian(IntHash(version), output);
 
-    const ui32 metainfoSize = 0;
+    const TStringBuf metainfo = codec ? codec->Name() : TStringBuf();
+    const ui32 metainfoSize = metainfo.size();
     WriteLittleEndian(metainfoSize, output);
 
     AddPadding(16, output);
 
-    // we may add some metainfo here
+    output->Write(metainfo.data(), metainfo.size());
 }
 
 static TPoolMetainfo MakePoolMetainfo(
@@ -230,10 +251,14 @@ static TPoolMetainfo MakePoolMetainfo(
     return metainfo;
 }
 
-static void WriteAsOneFile(const NCB::TQuantizedPool& pool, IOutputStream* slave) {
+static void WriteAsOneFile(
+    const NCB::TQuantizedPool& pool,
+    const NBlockCodecs::ICodec* const codec,
+    IOutputStream* slave) {
+
     TCountingOutput output(slave);
 
-    WriteHeader(&output);
+    WriteHeader(codec, &output);
 
     const auto chunksOffset = output.Counter();
 
@@ -242,11 +267,12 @@ static void WriteAsOneFile(const NCB::TQuantizedPool& pool, IOutputStream* slave
     perFeatureChunkInfos.resize(pool.ColumnIndexToLocalIndex.size());
     {
         flatbuffers::FlatBufferBuilder builder;
+        TBuffer compressedChunk;
         for (const auto trueFeatureIndex : sortedTrueFeatureIndices) {
             const auto localIndex = pool.ColumnIndexToLocalIndex.at(trueFeatureIndex);
             auto* const chunkInfos = &perFeatureChunkInfos[localIndex];
             for (const auto& chunk : pool.Chunks[localIndex]) {
-                WriteChunk(chunk, &output, chunkInfos, &builder);
+                WriteChunk(chunk, codec, &output, chunkInfos, &builder, &compressedChunk);
             }
         }
     }
@@ -293,8 +319,15 @@ static void WriteAsOneFile(const NCB::TQuantizedPool& pool, IOutputStream* slave
     output.Write(MagicEnd, MagicEndSize);
 }
 
-void NCB::SaveQuantizedPool(const TQuantizedPool& pool, IOutputStream* const output) {
-    WriteAsOneFile(pool, output);
+void NCB::SaveQuantizedPool(
+    const TQuantizedPool& pool,
+    IOutputStream* const output,
+    const TStringBuf compressionCodec) {
+
+    WriteAsOneFile(
+        pool,
+        compressionCodec ? NBlockCodecs::Codec(compressionCodec) : nullptr,
+        output);
 }
 
 static void ValidatePoolPart(const TConstArrayRef<char> blob) {
@@ -302,7 +335,8 @@ static void ValidatePoolPart(const TConstArrayRef<char> blob) {
     (void)blob;
 }
 
-static void ReadHeader(TCountingInput* const input) {
+// returns compression codec name, empty if chunks are not compressed
+static TString ReadHeader(TCountingInput* const input) {
     char magic[MagicSize];
     const auto magicSize = input->Load(magic, MagicSize);
     CB_ENSURE(MagicSize == magicSize);
@@ -310,19 +344,30 @@ static void ReadHeader(TCountingInput* const input) {
 
     ui32 version;
     ReadLittleEndian(&version, input);
-    CB_ENSURE(Version == version);
+    CB_ENSURE(
+        version == UncompressedVersion || version == CompressedVersion,
+        "Unsupported quantized pool format version " << version);
 
     ui32 versionHash;
     ReadLittleEndian(&versionHash, input);
-    CB_ENSURE(VersionHash == versionHash);
+    CB_ENSURE(IntHash(version) == versionHash);
 
     ui32 metainfoSize;
     ReadLittleEndian(&metainfoSize, input);
 
     SkipPadding(16, input);
 
-    const auto metainfoBytesSkipped = input->Skip(metainfoSize);
-    CB_ENSURE(metainfoSize == metainfoBytesSkipped);
+    TString compressionCodec;
+    if (version == CompressedVersion) {
+        compressionCodec.resize(metainfoSize);
+        const auto metainfoBytesRead = input->Load(compressionCodec.begin(), metainfoSize);
+        CB_ENSURE(metainfoSize == metainfoBytesRead);
+        CB_ENSURE(compressionCodec, "Compressed quantized pool does not contain compression codec name");
+    } else {
+        const auto metainfoBytesSkipped = input->Skip(metainfoSize);
+        CB_ENSURE(metainfoSize == metainfoBytesSkipped);
+    }
+    return compressionCodec;
 }
 
 template <typename T>
@@ -466,6 +511,38 @@ static TEpilogOffsets ReadEpilogOffsets(const TConstArrayRef<char> blob) {
     return offsets;
 }
 
+static void DecompressChunks(
+    const NBlockCodecs::ICodec& codec,
+    const TConstArrayRef<std::pair<NCB::TQuantizedPool::TChunkDescription*, TConstArrayRef<char>>> compressedChunks,
+    NPar::TLocalExecutor* const localExecutor,
+    TVector<TVector<ui8>>* const chunkStorage) {
+
+    chunkStorage->resize(compressedChunks.size());
+
+    // chunks are decompressed directly to their final storage
+    const auto decompressChunk = [&] (int chunkIdx) {
+        const auto [chunkDescription, compressedChunk] = compressedChunks[chunkIdx];
+        auto& chunkData = (*chunkStorage)[chunkIdx];
+        chunkData.yresize(codec.DecompressedLength(compressedChunk));
+        const auto decompressedSize = codec.Decompress(compressedChunk, chunkData.data());
+        CB_ENSURE(decompressedSize == chunkData.size(), "Corrupted compressed chunk in quantized pool");
+
+        chunkDescription->Chunk = flatbuffers::GetRoot<NCB::NIdl::TQuantizedFeatureChunk>(chunkData.data());
+    };
+
+    if (localExecutor) {
+        localExecutor->ExecRangeWithThrow(
+            decompressChunk,
+            0,
+            SafeIntegerCast<int>(compressedChunks.size()),
+            NPar::TLocalExecutor::WAIT_COMPLETE);
+    } else {
+        for (auto chunkIdx : xrange(compressedChunks.size())) {
+            decompressChunk(SafeIntegerCast<int>(chunkIdx));
+        }
+    }
+}
+
 namespace {
     class TFileQuantizedPoolLoader : public NCB::IQuantizedPoolLoader {
     public:
@@ -499,15 +576,19 @@ NCB::TQuantizedPool TFileQuantizedPoolLoader::LoadQuantizedPool(NCB::TLoadQuanti
 
     ValidatePoolPart(blob);
 
-    const auto chunksOffsetByReading = [blob] {
+    TString compressionCodec;
+    const auto chunksOffsetByReading = [blob, &compressionCodec] {
         TMemoryInput slave(blob.data(), blob.size());
         TCountingInput input(&slave);
-        ReadHeader(&input);
+        compressionCodec = ReadHeader(&input);
         return input.Counter();
     }();
     const auto epilogOffsets = ReadEpilogOffsets(blob);
     CB_ENSURE(chunksOffsetByReading == epilogOffsets.ChunksOffset);
 
+    // chunks are decompressed after all chunk descriptions are read
+    TVector<std::pair<NCB::TQuantizedPool::TChunkDescription*, TConstArrayRef<char>>> compressedChunks;
+
     TPoolMetainfo poolMetainfo;
     const auto poolMetainfoSize = LittleToHost(ReadUnaligned<ui32>(
         blob.data() + epilogOffsets.PoolMetainfoSizeOffset));
@@ -572,6 +653,8 @@ NCB::TQuantizedPool TFileQuantizedPoolLoader::LoadQuantizedPool(NCB::TLoadQuanti
         TVector<ui8> featureEpilog(featureEpilogBytes);
         CB_ENSURE(featureEpilogBytes == epilog.Load(featureEpilog.data(), featureEpilogBytes));
         const auto* featureEpilogPtr = featureEpilog.data();
+        // pointers to chunk descriptions must remain valid until decompression
+        chunks.reserve(chunkCount);
         for (ui32 chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex) {
             ReadLittleEndian(&chunkSize, &featureEpilogPtr);
 
@@ -584,6 +667,12 @@ NCB::TQuantizedPool TFileQuantizedPoolLoader::LoadQuantizedPool(NCB::TLoadQuanti
             ReadLittleEndian(&docsInChunkCount, &featureEpilogPtr);
 
             const TConstArrayRef<char> chunkBlob{blob.data() + chunkOffset, chunkSize};
+            if (compressionCodec) {
+                chunks.emplace_back(docOffset, docsInChunkCount, nullptr);
+                compressedChunks.emplace_back(&chunks.back(), chunkBlob);
+                continue;
+            }
+
             // TODO(yazevnul): validate flatbuffer, including document count
             const auto* const chunk = flatbuffers::GetRoot<NCB::NIdl::TQuantizedFeatureChunk>(chunkBlob.data());
 
@@ -591,6 +680,17 @@ NCB::TQuantizedPool TFileQuantizedPoolLoader::LoadQuantizedPool(NCB::TLoadQuanti
         }
     }
 
+    if (compressionCodec) {
+        DecompressChunks(
+            *NBlockCodecs::Codec(compressionCodec),
+            compressedChunks,
+            params.LocalExecutor,
+            &pool.ChunkStorage);
+
+        // all data is in pool.ChunkStorage now
+        pool.Blobs.clear();
+    }
+
     AddPoolMetainfo(poolMetainfo, &pool);
 
     // `pool.ColumnTypes` expected to have the same size as number of columns in pool,
@@ -828,7 +928,8 @@ namespace NCB {
 
     void SaveQuantizedPool(
         const TSrcData& srcData,
-        TString fileName
+        TString fileName,
+        TStringBuf compressionCodec
     ) {
         TQuantizedPool pool;
         pool.DocumentCount = srcData.DocumentCount;
@@ -861,7 +962,7 @@ namespace NCB {
 
 
         TFileOutput output(fileName);
-        SaveQuantizedPool(pool, &output);
+        SaveQuantizedPool(pool, &output, compressionCodec);
     }
 
 
@@ -885,8 +986,9 @@ namespace NCB {
     }
 
 
+    template <class TTObjectsDataProvider>
     static void BuildSrcDataFromDataProvider(
-        TDataProviderPtr dataProvider,
+        TIntrusivePtr<TDataProviderTemplate<TTObjectsDataProvider>> dataProvider,
         NPar::TLocalExecutor* localExecutor,
         TSrcData* srcData
     ) {
@@ -1070,7 +1172,64 @@ namespace NCB {
     }
 
 
-    void SaveQuantizedPool(const TDataProviderPtr& dataProvider, TString fileName) {
+    template <class T>
+    static void AppendSrcColumn(TSrcColumn<T>&& src, TSrcColumn<T>* dst) {
+        CB_ENSURE_INTERNAL(src.Type == dst->Type, "Inconsistent column types in quantized blocks");
+        for (auto& dataPart : src.Data) {
+            // merge small blocks into chunks of up to SLICE_COUNT documents
+            if (!dst->Data.empty() && (dst->Data.back().size() + dataPart.size() <= SLICE_COUNT)) {
+                dst->Data.back().insert(dst->Data.back().end(), dataPart.begin(), dataPart.end());
+            } else {
+                dst->Data.push_back(std::move(dataPart));
+            }
+        }
+    }
+
+
+    template <class T>
+    static void AppendSrcColumn(TMaybe<TSrcColumn<T>>&& src, TMaybe<TSrcColumn<T>>* dst) {
+        CB_ENSURE_INTERNAL(src.Defined() == dst->Defined(), "Inconsistent columns in quantized blocks");
+        if (src) {
+            AppendSrcColumn(std::move(*src), dst->Get());
+        }
+    }
+
+
+    void AddQuantizedBlockToSrcData(
+        TQuantizedDataProviderPtr quantizedBlock,
+        NPar::TLocalExecutor* localExecutor,
+        TSrcData* srcData
+    ) {
+        if (!srcData->DocumentCount) {
+            BuildSrcDataFromDataProvider(std::move(quantizedBlock), localExecutor, srcData);
+            return;
+        }
+
+        TSrcData blockSrcData;
+        BuildSrcDataFromDataProvider(std::move(quantizedBlock), localExecutor, &blockSrcData);
+        CB_ENSURE_INTERNAL(
+            (blockSrcData.ColumnNames == srcData->ColumnNames) &&
+            (blockSrcData.FloatFeatures.size() == srcData->FloatFeatures.size()) &&
+            (blockSrcData.Baseline.size() == srcData->Baseline.size()),
+            "Inconsistent columns in quantized blocks"
+        );
+
+        srcData->DocumentCount += blockSrcData.DocumentCount;
+        AppendSrcColumn(std::move(blockSrcData.GroupIds), &srcData->GroupIds);
+        AppendSrcColumn(std::move(blockSrcData.SubgroupIds), &srcData->SubgroupIds);
+        for (auto i : xrange(srcData->FloatFeatures.size())) {
+            AppendSrcColumn(std::move(blockSrcData.FloatFeatures[i]), &srcData->FloatFeatures[i]);
+        }
+        AppendSrcColumn(std::move(blockSrcData.Target), &srcData->Target);
+        for (auto i : xrange(srcData->Baseline.size())) {
+            AppendSrcColumn(std::move(blockSrcData.Baseline[i]), &srcData->Baseline[i]);
+        }
+        AppendSrcColumn(std::move(blockSrcData.Weights), &srcData->Weights);
+        AppendSrcColumn(std::move(blockSrcData.GroupWeights), &srcData->GroupWeights);
+    }
+
+
+    void SaveQuantizedPool(const TDataProviderPtr& dataProvider, TString fileName, TStringBuf compressionCodec) {
         const auto threadCount = NSystemInfo::CachedNumberOfCpus();
         NPar::TLocalExecutor localExecutor;
         localExecutor.RunAdditionalThreads(threadCount);
@@ -1078,6 +1237,6 @@ namespace NCB {
         TSrcData srcData;
         BuildSrcDataFromDataProvider(dataProvider, &localExecutor, &srcData);
 
-        SaveQuantizedPool(srcData, fileName);
+        SaveQuantizedPool(srcData, fileName, compressionCodec);
     }
 }
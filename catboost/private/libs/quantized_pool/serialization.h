@@ -19,7 +19,7 @@ namespace NCB {
     };
 
     struct TSrcData {
-        size_t DocumentCount;
+        size_t DocumentCount = 0;
 
         TVector<size_t> LocalIndexToColumnIndex; // [localIndex]
         TPoolQuantizationSchema PoolQuantizationSchema;
@@ -61,11 +61,23 @@ namespace NCB {
 }
 
 namespace NCB {
+    /* compressionCodec is a name of library/blockcodecs codec that is used to compress chunks,
+     * if empty - chunks are not compressed (the format is readable by older versions)
+     */
     //only for used C++
-    void SaveQuantizedPool(const TQuantizedPool& pool, IOutputStream* output);
-    void SaveQuantizedPool(const TSrcData& srcData, TString fileName);
+    void SaveQuantizedPool(const TQuantizedPool& pool, IOutputStream* output, TStringBuf compressionCodec = TStringBuf());
+    void SaveQuantizedPool(const TSrcData& srcData, TString fileName, TStringBuf compressionCodec = TStringBuf());
     //only for python
-    void SaveQuantizedPool(const TDataProviderPtr& dataProvider, TString fileName);
+    void SaveQuantizedPool(const TDataProviderPtr& dataProvider, TString fileName, TStringBuf compressionCodec = TStringBuf());
+
+    /* Appends quantized block (as returned by QuantizeInBlocks) to srcData that is empty before the first block,
+     * blocks data is stored in chunks, so quantized pool can be saved without materializing the whole dataset
+     */
+    void AddQuantizedBlockToSrcData(
+        TQuantizedDataProviderPtr quantizedBlock,
+        NPar::TLocalExecutor* localExecutor,
+        TSrcData* srcData
+    );
 
     template<class T>
     TSrcColumn<T> GenerateSrcColumn(TConstArrayRef<T> data, EColumn columnType);
@@ -74,6 +86,9 @@ namespace NCB {
         bool LockMemory = true;
         bool Precharge = true;
         TDatasetSubset DatasetSubset;
+
+        // used for parallel decompression of chunks, can be nullptr
+        NPar::TLocalExecutor* LocalExecutor = nullptr;
     };
 
     // Load quantized pool saved by `SaveQuantizedPool` from file.
@@ -3,6 +3,8 @@
 #include <catboost/libs/data/load_data.h>
 #include <catboost/libs/data/ut/lib/for_data_provider.h>
 #include <catboost/libs/data/ut/lib/for_loader.h>
+#include <catboost/libs/helpers/compression.h>
+#include <catboost/libs/helpers/resource_holder.h>
 #include <catboost/private/libs/data_types/groupid.h>
 #include <catboost/private/libs/quantized_pool/pool.h>
 #include <catboost/private/libs/quantized_pool/serialization.h>
@@ -18,6 +20,8 @@
 #include <util/string/printf.h>
 #include <util/system/mktemp.h>
 
+#include <functional>
+
 #include <library/unittest/registar.h>
 
 
@@ -73,7 +77,10 @@ Y_UNIT_TEST_SUITE(LoadDataFromQuantized) {
     }
 
 
-    void Test(const TTestCase& testCase) {
+    void Test(
+        const TTestCase& testCase,
+        std::function<void(const TDataProvider&)> checkDataProvider = {}
+    ) {
         TReadDatasetMainParams readDatasetMainParams;
 
         // TODO(akhropov): temporarily use THolder until TTempFile move semantic are fixed
@@ -97,6 +104,10 @@ Y_UNIT_TEST_SUITE(LoadDataFromQuantized) {
             &localExecutor
         );
 
+        if (checkDataProvider) {
+            checkDataProvider(*dataProvider);
+        }
+
         Compare<TQuantizedForCPUObjectsDataProvider>(std::move(dataProvider), testCase.ExpectedData);
     }
 
@@ -680,6 +691,110 @@ Y_UNIT_TEST_SUITE(LoadDataFromQuantized) {
     }
 
 
+    Y_UNIT_TEST(ReadDatasetSingleChunkColumns) {
+        // single chunk columns are used directly from the mapped file
+        TTestCase testCase;
+        NCB::TSrcData srcData;
+
+        srcData.DocumentCount = 9;
+        srcData.LocalIndexToColumnIndex = {0, 1, 2, 3};
+        srcData.PoolQuantizationSchema.FeatureIndices = {0, 1, 2};
+        srcData.PoolQuantizationSchema.Borders = {{0.1f, 0.2f, 0.3f}, {0.5f}, {0.25f, 0.5f, 0.75f}};
+        srcData.PoolQuantizationSchema.NanModes = {ENanMode::Forbidden, ENanMode::Forbidden, ENanMode::Min};
+        srcData.FloatFeatures = {
+            TSrcColumn<ui8>{EColumn::Num, {{1, 3, 0, 1, 2, 2, 0, 3, 1}}},
+            TSrcColumn<ui8>{EColumn::Num, {{0, 1, 1, 0, 0, 1, 0, 1, 1}}},
+            TSrcColumn<ui8>{EColumn::Num, {{2, 3, 0, 3, 1, 0, 0, 2, 3}}}
+        };
+
+        srcData.Target = TSrcColumn<float>{
+            EColumn::Label,
+            {{0.12f, 0.0f, 0.45f, 0.1f, 0.22f, 0.3f, 0.5f, 0.8f, 0.9f}}
+        };
+
+        testCase.SrcData = std::move(srcData);
+
+
+        TExpectedQuantizedData expectedData;
+
+        TDataColumnsMetaInfo dataColumnsMetaInfo;
+        dataColumnsMetaInfo.Columns = {
+            {EColumn::Num, ""},
+            {EColumn::Num, ""},
+            {EColumn::Num, ""},
+            {EColumn::Label, ""}
+        };
+
+        expectedData.MetaInfo = TDataMetaInfo(std::move(dataColumnsMetaInfo), false, false, /* additionalBaselineCount */ Nothing(), Nothing());
+        expectedData.Objects.FloatFeatures = {
+            TVector<ui8>{1, 3, 0, 1, 2, 2, 0, 3, 1},
+            TVector<ui8>{0, 1, 1, 0, 0, 1, 0, 1, 1},
+            TVector<ui8>{2, 3, 0, 3, 1, 0, 0, 2, 3}
+        };
+        expectedData.Objects.QuantizedFeaturesInfo = MakeIntrusive<TQuantizedFeaturesInfo>(
+            *expectedData.MetaInfo.FeaturesLayout,
+            TConstArrayRef<ui32>(),
+            NCatboostOptions::TBinarizationOptions(EBorderSelectionType::GreedyLogSum, 3)
+        );
+        expectedData.Objects.QuantizedFeaturesInfo->SetBorders(TFloatFeatureIdx(0), {0.1f, 0.2f, 0.3f});
+        expectedData.Objects.QuantizedFeaturesInfo->SetBorders(TFloatFeatureIdx(1), {0.5f});
+        expectedData.Objects.QuantizedFeaturesInfo->SetBorders(TFloatFeatureIdx(2), {0.25f, 0.5f, 0.75f});
+        expectedData.Objects.QuantizedFeaturesInfo->SetNanMode(TFloatFeatureIdx(0), ENanMode::Forbidden);
+        expectedData.Objects.QuantizedFeaturesInfo->SetNanMode(TFloatFeatureIdx(1), ENanMode::Forbidden);
+        expectedData.Objects.QuantizedFeaturesInfo->SetNanMode(TFloatFeatureIdx(2), ENanMode::Min);
+        expectedData.Objects.ExclusiveFeatureBundlesData = TExclusiveFeatureBundlesData(
+            *expectedData.MetaInfo.FeaturesLayout,
+            TVector<TExclusiveFeaturesBundle>()
+        );
+        expectedData.Objects.PackedBinaryFeaturesData = TPackedBinaryFeaturesData(
+            *expectedData.MetaInfo.FeaturesLayout,
+            *expectedData.Objects.QuantizedFeaturesInfo,
+            expectedData.Objects.ExclusiveFeatureBundlesData
+        );
+        expectedData.Objects.FeatureGroupsData = TFeatureGroupsData(
+            *expectedData.MetaInfo.FeaturesLayout,
+            TVector<TFeaturesGroup>()
+        );
+
+        expectedData.ObjectsGrouping = TObjectsGrouping(9);
+
+        TVector<TVector<TString>> rawTarget{{"0.12", "0", "0.45", "0.1", "0.22", "0.3", "0.5", "0.8", "0.9"}};
+        expectedData.Target.Target.assign(rawTarget.begin(), rawTarget.end());
+        expectedData.Target.SetTrivialWeights(9);
+
+        testCase.ExpectedData = std::move(expectedData);
+
+        auto checkFeaturesDataIsMapped = [] (const TDataProvider& dataProvider) {
+            const auto* objectsData = dynamic_cast<const TQuantizedForCPUObjectsDataProvider*>(
+                dataProvider.ObjectsData.Get()
+            );
+            UNIT_ASSERT(objectsData);
+
+            // feature 1 is binary and is copied to packs, other features are not
+            for (auto floatFeatureIdx : {0, 2}) {
+                const auto* featureData = dynamic_cast<const TQuantizedFloatValuesHolder*>(
+                    *objectsData->GetNonPackedFloatFeature(floatFeatureIdx)
+                );
+                UNIT_ASSERT(featureData);
+
+                const TCompressedArray& compressedArray = *featureData->GetCompressedData().GetSrc();
+                const auto resourceHolder = compressedArray.GetStorageResourceHolder();
+                const auto* blobHolder = dynamic_cast<const TBlobHolder*>(resourceHolder.Get());
+                UNIT_ASSERT_C(blobHolder, "feature " << floatFeatureIdx << " data is not from mapped pool");
+
+                const char* mappedBegin = blobHolder->Blob.AsCharPtr();
+                const char* mappedEnd = mappedBegin + blobHolder->Blob.Size();
+                const TConstArrayRef<ui64> storage = compressedArray.GetStorage();
+                const char* dataBegin = reinterpret_cast<const char*>(storage.data());
+                const char* dataEnd = reinterpret_cast<const char*>(storage.data() + storage.size());
+                UNIT_ASSERT(mappedBegin <= dataBegin);
+                UNIT_ASSERT(dataEnd <= mappedEnd);
+            }
+        };
+
+        Test(testCase, checkFeaturesDataIsMapped);
+    }
+
     Y_UNIT_TEST(ReadDatasetMidSize) {
         TTestCase testCase;
 
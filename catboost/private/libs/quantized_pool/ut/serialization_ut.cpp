@@ -9,6 +9,10 @@
 
 #include <catboost/idl/pool/flat/quantized_chunk_t.fbs.h>
 #include <catboost/idl/pool/proto/quantization_schema.pb.h>
+#include <catboost/libs/data/streaming_quantization.h>
+#include <catboost/libs/data/ut/lib/for_loader.h>
+
+#include <library/threading/local_executor/local_executor.h>
 
 #include <util/folder/dirut.h>
 #include <util/folder/path.h>
@@ -16,11 +20,13 @@
 #include <util/generic/array_ref.h>
 #include <util/generic/strbuf.h>
 #include <util/generic/string.h>
+#include <util/generic/xrange.h>
 #include <util/memory/blob.h>
 #include <util/stream/file.h>
 #include <util/stream/input.h>
 #include <util/stream/length.h>
 #include <util/stream/output.h>
+#include <util/string/builder.h>
 #include <util/system/fstat.h>
 
 using NCB::NIdl::TFeatureQuantizationSchema;
@@ -154,6 +160,36 @@ Y_UNIT_TEST_SUITE(SerializationTests) {
         UNIT_ASSERT_VALUES_EQUAL(loadedPoolAsText, poolAsText);
     }
 
+    Y_UNIT_TEST(TestSerializeDeserializeCompressed) {
+        const auto pool = MakeQuantizedPool();
+        const auto poolAsText = QuantizedPoolToString(pool);
+        const auto path = TFsPath(GetSystemTempDir()) / "quantized_pool.bin";
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        for (const auto codec : {TStringBuf("lz4"), TStringBuf("zstd_1")}) {
+            {
+                TFileOutput output(path.GetPath());
+                NCB::SaveQuantizedPool(pool, &output, codec);
+            }
+
+            for (auto* executor : {(NPar::TLocalExecutor*)nullptr, &localExecutor}) {
+                const auto loadedPool = NCB::LoadQuantizedPool(
+                    NCB::TPathWithScheme(path.GetPath(), "quantized"),
+                    {false, false, NCB::TDatasetSubset::MakeColumns(), executor});
+
+                UNIT_ASSERT(loadedPool.Blobs.empty());
+                UNIT_ASSERT_VALUES_EQUAL(QuantizedPoolToString(loadedPool), poolAsText);
+            }
+
+            TString diff;
+            UNIT_ASSERT_C(
+                IsEqual(MakeQuantizationSchema(), NCB::LoadQuantizationSchemaFromPool(path.GetPath()), &diff),
+                diff.data());
+        }
+    }
+
     Y_UNIT_TEST(TestLoadQuantizationSchema) {
         const auto pool = MakeQuantizedPool();
         const auto path = TFsPath(GetSystemTempDir()) / "quantized_pool.bin";
@@ -169,6 +205,67 @@ Y_UNIT_TEST_SUITE(SerializationTests) {
         TString diff;
         UNIT_ASSERT_C(IsEqual(expectedQuantizationSchema, quantizationSchema, &diff), diff.data());
     }
+
+    Y_UNIT_TEST(TestSaveQuantizedBlocks) {
+        constexpr ui32 objectCount = 1000;
+        constexpr ui32 blockSize = 64;
+
+        TStringBuilder dataset;
+        for (auto i : xrange(objectCount)) {
+            dataset << (i % 2) << '\t' << (i % 37) << '\t' << (i * 0.25f) << '\n';
+        }
+
+        NCB::NDataNewUT::TSrcData srcData;
+        srcData.CdFileData = TStringBuf("0\tTarget\n");
+        srcData.DatasetFileData = dataset;
+
+        NCB::NDataNewUT::TReadDatasetMainParams readDatasetMainParams;
+        TVector<THolder<TTempFile>> srcDataFiles;
+        NCB::NDataNewUT::SaveSrcData(srcData, &readDatasetMainParams, &srcDataFiles);
+
+        NPar::TLocalExecutor localExecutor;
+        TRestorableFastRng64 rand(0);
+
+        NCB::TSrcData quantizedSrcData;
+        ui32 blockCount = 0;
+        NCB::QuantizeInBlocks(
+            readDatasetMainParams.PoolPath,
+            readDatasetMainParams.BaselineFilePath,
+            readDatasetMainParams.ColumnarPoolFormatParams,
+            /*ignoredFeatures*/ {},
+            /*classNames*/ {},
+            NCatboostOptions::TBinarizationOptions(),
+            /*perFloatFeatureQuantization*/ {},
+            NCB::TQuantizationOptions(),
+            blockSize,
+            [&] (NCB::TQuantizedDataProviderPtr block) {
+                NCB::AddQuantizedBlockToSrcData(std::move(block), &localExecutor, &quantizedSrcData);
+                ++blockCount;
+            },
+            &rand,
+            &localExecutor
+        );
+        UNIT_ASSERT_VALUES_EQUAL(blockCount, (objectCount + blockSize - 1) / blockSize);
+        UNIT_ASSERT_VALUES_EQUAL(quantizedSrcData.DocumentCount, objectCount);
+
+        // small blocks are merged into one chunk
+        UNIT_ASSERT_VALUES_EQUAL(quantizedSrcData.FloatFeatures.size(), 2);
+        for (const auto& floatFeature : quantizedSrcData.FloatFeatures) {
+            UNIT_ASSERT(floatFeature);
+            UNIT_ASSERT_VALUES_EQUAL(floatFeature->Data.size(), 1);
+            UNIT_ASSERT_VALUES_EQUAL(floatFeature->Data[0].size(), objectCount);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(quantizedSrcData.Target->Data[0].size(), objectCount);
+
+        const auto path = TFsPath(GetSystemTempDir()) / "quantized_pool.bin";
+        NCB::SaveQuantizedPool(quantizedSrcData, path.GetPath());
+
+        const auto loadedPool = NCB::LoadQuantizedPool(
+            NCB::TPathWithScheme(path.GetPath(), "quantized"),
+            {false, false, NCB::TDatasetSubset::MakeColumns()}
+        );
+        UNIT_ASSERT_VALUES_EQUAL(loadedPool.DocumentCount, objectCount);
+    }
 }
 
 Y_UNIT_TEST_SUITE(DigestTests) {
@@ -150,23 +150,24 @@ def format_crossvalidation(is_inverted, n, k):
     return '{}:{};{}'.format(cv_type, n, k)
 
 
-def execute_dist_train(cmd):
+def execute_dist_train(cmd, worker_count=2):
     hosts_path = yatest.common.test_output_path('hosts.txt')
     with yatest.common.network.PortManager() as pm:
-        port0 = pm.get_port()
-        port1 = pm.get_port()
+        ports = [pm.get_port() for _ in range(worker_count)]
         with open(hosts_path, 'w') as hosts:
-            hosts.write('localhost:' + str(port0) + '\n')
-            hosts.write('localhost:' + str(port1) + '\n')
+            for port in ports:
+                hosts.write('localhost:' + str(port) + '\n')
 
         catboost_path = yatest.common.binary_path("catboost/app/catboost")
-        worker0 = yatest.common.execute((catboost_path, 'run-worker', '--node-port', str(port0),), wait=False)
-        worker1 = yatest.common.execute((catboost_path, 'run-worker', '--node-port', str(port1),), wait=False)
-        while pm.is_port_free(port0) or pm.is_port_free(port1):
+        workers = [
+            yatest.common.execute((catboost_path, 'run-worker', '--node-port', str(port),), wait=False)
+            for port in ports
+        ]
+        while any(pm.is_port_free(port) for port in ports):
             time.sleep(1)
 
         yatest.common.execute(
             cmd + ('--node-type', 'Master', '--file-with-hosts', hosts_path,)
         )
-        worker0.wait()
-        worker1.wait()
+        for worker in workers:
+            worker.wait()
@@ -4664,16 +4664,16 @@ def make_deterministic_train_cmd(loss_function, pool, train, test, cd, schema=''
     return cmd + other_options
 
 
-def run_dist_train(cmd, output_file_switch='--eval-file'):
+def run_dist_train(cmd, output_file_switch='--eval-file', worker_count=2, atol=1e-6, rtol=1e-3):
     eval_0_path = yatest.common.test_output_path('test_0.eval')
     yatest.common.execute(cmd + (output_file_switch, eval_0_path,))
 
     eval_1_path = yatest.common.test_output_path('test_1.eval')
-    execute_dist_train(cmd + (output_file_switch, eval_1_path,))
+    execute_dist_train(cmd + (output_file_switch, eval_1_path,), worker_count=worker_count)
 
     eval_0 = np.loadtxt(eval_0_path, dtype='float', delimiter='\t', skiprows=1)
     eval_1 = np.loadtxt(eval_1_path, dtype='float', delimiter='\t', skiprows=1)
-    assert(np.allclose(eval_0, eval_1, atol=1e-6, rtol=1e-3))
+    assert(np.allclose(eval_0, eval_1, atol=atol, rtol=rtol))
     return eval_1_path
 
 
@@ -4692,6 +4692,64 @@ def test_dist_train(dev_score_calc_obj_block_size):
         dev_score_calc_obj_block_size=dev_score_calc_obj_block_size)))]
 
 
+@pytest.mark.parametrize('stats_codec', ['Double', 'Float', 'FloatDelta'])
+def test_dist_train_stats_codec(stats_codec):
+    cmd = make_deterministic_train_cmd(
+        loss_function='Logloss',
+        pool='higgs',
+        train='train_small',
+        test='test_small',
+        cd='train.cd',
+        other_options=('--distributed-stats-codec', stats_codec))
+    if stats_codec == 'Double':
+        run_dist_train(cmd, worker_count=4)
+    else:
+        # with float32 stats near-tie splits can differ from exact training, so compare the test loss instead
+        run_dist_train(cmd, output_file_switch='--test-err-log', worker_count=4, atol=1e-4, rtol=1e-2)
+
+
+@pytest.mark.parametrize('reduce_topology', ['Master', 'Tree'])
+@pytest.mark.parametrize('loss_function', ['Logloss', 'Quantile:alpha=0.3'])
+def test_dist_train_reduce_topology(reduce_topology, loss_function):
+    run_dist_train(
+        make_deterministic_train_cmd(
+            loss_function=loss_function,
+            pool='higgs',
+            train='train_small',
+            test='test_small',
+            cd='train.cd',
+            other_options=('--distributed-reduce-topology', reduce_topology)),
+        worker_count=4)
+
+
+@pytest.mark.parametrize('worker_count', [2, 3])
+@pytest.mark.parametrize('loss_function', ['Logloss', 'Quantile:alpha=0.3'])
+def test_dist_train_features_partitioning(worker_count, loss_function):
+    run_dist_train(
+        make_deterministic_train_cmd(
+            loss_function=loss_function,
+            pool='higgs',
+            train='train_small',
+            test='test_small',
+            cd='train.cd',
+            other_options=('--distributed-partitioning', 'Features')),
+        worker_count=worker_count)
+
+
+def test_dist_train_quantized_features_partitioning():
+    run_dist_train(
+        make_deterministic_train_cmd(
+            loss_function='Logloss',
+            pool='higgs',
+            train='train_small_x128_greedylogsum.bin',
+            test='test_small',
+            cd='train.cd',
+            schema='quantized://',
+            other_options=('-x', '128', '--feature-border-type', 'GreedyLogSum',
+                           '--distributed-partitioning', 'Features')),
+        worker_count=3)
+
+
 @pytest.mark.parametrize(
     'dev_score_calc_obj_block_size',
     SCORE_CALC_OBJ_BLOCK_SIZES,
@@ -4769,6 +4827,21 @@ def test_dist_train_quantized(dev_score_calc_obj_block_size):
         other_options=('-x', '128', '--feature-border-type', 'GreedyLogSum'))))]
 
 
+@pytest.mark.parametrize('worker_count', [2, 3])
+def test_dist_train_quantized_loading_by_workers(worker_count):
+    run_dist_train(
+        make_deterministic_train_cmd(
+            loss_function='Logloss',
+            pool='higgs',
+            train='train_small_x128_greedylogsum.bin',
+            test='test_small',
+            cd='train.cd',
+            schema='quantized://',
+            other_options=('-x', '128', '--feature-border-type', 'GreedyLogSum',
+                           '--distributed-data-loading', 'Workers')),
+        worker_count=worker_count)
+
+
 @pytest.mark.parametrize(
     'dev_score_calc_obj_block_size',
     SCORE_CALC_OBJ_BLOCK_SIZES,
@@ -7923,6 +7996,46 @@ def test_leafwise_scoring():
     assert new_learn_errors_log == learn_errors_log
 
 
+def test_thread_affinity():
+    learn_error_path = yatest.common.test_output_path('learn_error.tsv')
+    cmd = [
+        CATBOOST_PATH,
+        'fit',
+        '--loss-function', 'Logloss',
+        '-f', data_file('adult', 'train_small'),
+        '--cd', data_file('adult', 'train.cd'),
+        '-i', '50',
+        '-r', '0',
+        '-T', '4',
+        '--learn-err-log', learn_error_path
+    ]
+    yatest.common.execute(cmd)
+    learn_errors_log = open(learn_error_path).read()
+    yatest.common.execute(cmd + ['--thread-affinity', 'NumaNodes'])
+    new_learn_errors_log = open(learn_error_path).read()
+    assert new_learn_errors_log == learn_errors_log
+
+
+def test_event_trace():
+    trace_path = yatest.common.test_output_path('trace.json')
+    cmd = [
+        CATBOOST_PATH,
+        'fit',
+        '--loss-function', 'Logloss',
+        '-f', data_file('adult', 'train_small'),
+        '--cd', data_file('adult', 'train.cd'),
+        '-i', '10',
+        '-T', '4',
+    ]
+    yatest.common.execute(cmd, env=dict(CB_EVENT_TRACE_FILE=trace_path))
+    with open(trace_path) as trace_file:
+        events = json.load(trace_file)
+    event_names = set(event.get('name', '') for event in events)
+    assert any('TrainOneIteration' in name for name in event_names)
+    assert any('ComputeOnlineCTRs' in name for name in event_names)
+    assert 'TLocalExecutor job' in event_names
+
+
 def test_group_features():
     learn_error_path = yatest.common.test_output_path('learn_error.tsv')
     test_predictions_path = yatest.common.test_output_path('test_predictions.tsv')
@@ -7987,3 +8100,38 @@ def test_model_sum():
         '--output-path', sum_eval,
     ])
     yatest.common.execute(get_limited_precision_dsv_diff_tool(0) + [model_eval, sum_eval])
+
+
+def test_convert_pool_quantize():
+    quantized_pool_path = yatest.common.test_output_path('train_small.quantized')
+    yatest.common.execute([
+        CATBOOST_PATH,
+        'convert-pool',
+        '--input-path', data_file('higgs', 'train_small'),
+        '--column-description', data_file('higgs', 'train.cd'),
+        '--quantize',
+        '-x', '128',
+        '--block-size', '30',
+        '-o', quantized_pool_path,
+    ])
+
+    learn_errors = []
+    for learn_set, cd in (
+        (data_file('higgs', 'train_small'), ('--column-description', data_file('higgs', 'train.cd'))),
+        ('quantized://' + quantized_pool_path, ())
+    ):
+        learn_error_path = yatest.common.test_output_path('learn_error_{}.tsv'.format(len(learn_errors)))
+        yatest.common.execute((
+            CATBOOST_PATH,
+            'fit',
+            '--loss-function', 'Logloss',
+            '--learn-set', learn_set,
+            '-x', '128',
+            '-i', '20',
+            '-T', '4',
+            '--learn-err-log', learn_error_path,
+        ) + cd)
+        learn_errors.append(np.loadtxt(learn_error_path, dtype='float', delimiter='\t', skiprows=1))
+
+    # dataset is smaller than the borders sample, so borders are the same as for in-memory quantization
+    assert np.allclose(learn_errors[0], learn_errors[1], atol=1e-6)
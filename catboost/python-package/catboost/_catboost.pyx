@@ -134,6 +134,11 @@ cdef extern from "catboost/libs/logging/logging.h":
     cdef void ResetTraceBackend(const TString&)
 
 
+cdef extern from "catboost/libs/logging/event_trace.h":
+    cdef void StartEventTrace(const TString& fileName) except +ProcessException
+    cdef void StopEventTrace() except +ProcessException
+
+
 cdef extern from "catboost/libs/cat_feature/cat_feature.h":
     cdef ui32 CalcCatFeatureHash(TStringBuf feature) except +ProcessException
     cdef float ConvertCatFeatureHashToFloat(ui32 hashVal) except +ProcessException
@@ -587,7 +592,11 @@ cdef extern from "catboost/libs/data/data_provider.h" namespace "NCB":
 
 
 cdef extern from "catboost/private/libs/quantized_pool/serialization.h" namespace "NCB":
-    cdef void SaveQuantizedPool(const TDataProviderPtr& dataProvider, TString fileName) except +ProcessException
+    cdef void SaveQuantizedPool(
+        const TDataProviderPtr& dataProvider,
+        TString fileName,
+        TString compressionCodec
+    ) except +ProcessException
 
 
 cdef extern from "catboost/private/libs/data_util/path_with_scheme.h" namespace "NCB":
@@ -703,6 +712,16 @@ cdef extern from "catboost/libs/data/data_provider_builders.h" namespace "NCB":
         IVisitor** loader
     ) except +ProcessException
 
+    cdef void AddFloatFeaturesFromExternalMatrix[TStoredValue](
+        const TStoredValue* data,
+        ui32 objectCount,
+        size_t objectStride,
+        size_t columnStride,
+        TConstArrayRef[ui32] flatFeatureIndices,
+        TIntrusivePtr[IResourceHolder] resourceHolder,
+        IRawFeaturesOrderDataVisitor* visitor
+    ) except +ProcessException
+
 
 cdef class Py_ObjectsOrderBuilderVisitor:
     cdef TDataProviderBuilderOptions options
@@ -2117,6 +2136,38 @@ def _set_features_order_data_ndarray(
             builder_visitor[0].AddFloatFeature(flat_feature_idx, num_factor_data)
 
 
+# only for data with numeric features only, see _init_pool
+# feature_values cannot be const due to https://github.com/cython/cython/issues/2485
+def _set_features_order_data_ndarray_row_major(
+    numpy_num_dtype [:,::1] feature_values,
+    Py_FeaturesOrderBuilderVisitor py_builder_visitor
+):
+    cdef IRawFeaturesOrderDataVisitor* builder_visitor
+    py_builder_visitor.get_raw_features_order_data_visitor(&builder_visitor)
+
+    cdef ui32 doc_count = <ui32>(feature_values.shape[0])
+    cdef ui32 feature_count = <ui32>(feature_values.shape[1])
+
+    cdef TVector[ui32] flat_feature_indices
+    cdef ui32 flat_feature_idx
+    for flat_feature_idx in range(feature_count):
+        flat_feature_indices.push_back(flat_feature_idx)
+
+    # empty, data is kept alive by Pool's data holders
+    cdef TIntrusivePtr[IResourceHolder] resource_holder
+
+    # columns are wrapped as strided views of the data without copying
+    AddFloatFeaturesFromExternalMatrix[numpy_num_dtype](
+        <const numpy_num_dtype*>&feature_values[0, 0],
+        doc_count,
+        <size_t>feature_count,
+        <size_t>1,
+        <TConstArrayRef[ui32]>flat_feature_indices,
+        resource_holder,
+        builder_visitor
+    )
+
+
 cdef float get_float_feature(ui32 non_default_doc_idx, ui32 flat_feature_idx, src_value) except*:
     try:
         return _FloatOrNan(src_value)
@@ -3244,18 +3295,21 @@ cdef class _PoolBase:
             if data_meta_info.FeaturesLayout.Get()[0].GetFloatFeatureCount():
                 new_data_holders = data
 
-            cat_features_mask = _get_is_feature_type_mask(features_layout, EFeatureType_Categorical)
-            text_features_mask = _get_is_feature_type_mask(features_layout, EFeatureType_Text)
-
             # needed because of https://github.com/cython/cython/issues/1772
             data.setflags(write=1)
 
-            _set_features_order_data_ndarray(
-                data,
-                <bool_t[:features_layout[0].GetExternalFeatureCount()]>cat_features_mask.data(),
-                <bool_t[:features_layout[0].GetExternalFeatureCount()]>text_features_mask.data(),
-                py_builder_visitor
-            )
+            if data.flags.f_contiguous:
+                cat_features_mask = _get_is_feature_type_mask(features_layout, EFeatureType_Categorical)
+                text_features_mask = _get_is_feature_type_mask(features_layout, EFeatureType_Text)
+
+                _set_features_order_data_ndarray(
+                    data,
+                    <bool_t[:features_layout[0].GetExternalFeatureCount()]>cat_features_mask.data(),
+                    <bool_t[:features_layout[0].GetExternalFeatureCount()]>text_features_mask.data(),
+                    py_builder_visitor
+                )
+            else:
+                _set_features_order_data_ndarray_row_major(data, py_builder_visitor)
 
             # set after _set_features_order_data_np call because we can't pass const data to it
             data.setflags(write=0)
@@ -3378,8 +3432,15 @@ cdef class _PoolBase:
             do_use_raw_data_in_features_order = True
         else:
             if isinstance(data, np.ndarray) and (data.dtype in numpy_num_dtype_list):
-                if data.flags.aligned and data.flags.f_contiguous and (len(data) != 0):
-                    do_use_raw_data_in_features_order = True
+                if data.flags.aligned and (len(data) != 0):
+                    if data.flags.f_contiguous:
+                        do_use_raw_data_in_features_order = True
+                    elif data.flags.c_contiguous:
+                        # row-major numeric features are used without copying via strided columns
+                        features_layout = data_meta_info.FeaturesLayout.Get()
+                        do_use_raw_data_in_features_order = (
+                            features_layout[0].GetFloatFeatureCount() == features_layout[0].GetExternalFeatureCount()
+                        )
 
         if do_use_raw_data_in_features_order:
             self._init_features_order_layout_pool(
@@ -3410,9 +3471,12 @@ cdef class _PoolBase:
                 thread_count
             )
 
-    cpdef _save(self, fname):
+    cpdef _save(self, fname, compression_codec):
         cdef TString file_name = to_arcadia_string(fname)
-        SaveQuantizedPool(self.__pool, file_name)
+        cdef TString codec_name
+        if compression_codec is not None:
+            codec_name = to_arcadia_string(compression_codec)
+        SaveQuantizedPool(self.__pool, file_name, codec_name)
 
 
     cpdef _set_pairs(self, pairs):
@@ -5069,6 +5133,14 @@ cpdef _reset_trace_backend(file):
     ResetTraceBackend(to_arcadia_string(file))
 
 
+cpdef _start_event_trace(file):
+    StartEventTrace(to_arcadia_string(file))
+
+
+cpdef _stop_event_trace():
+    StopEventTrace()
+
+
 @cython.embedsignature(True)
 cdef class TargetStats:
     cdef TTargetStats TargetStats
@@ -640,7 +640,7 @@ class Pool(_PoolBase):
         self._set_pairs_weight(pairs_weight)
         return self
 
-    def save(self, fname):
+    def save(self, fname, compression_codec=None):
         """
         Save the quantized pool to a file.
 
@@ -648,6 +648,10 @@ class Pool(_PoolBase):
         ----------
         fname : string
             Output file name.
+
+        compression_codec : string, optional (default=None)
+            Name of the block codec used to compress feature chunks (e.g. 'lz4', 'zstd_1').
+            If None chunks are not compressed and the file can be read by older versions.
         """
         if not self.is_quantized():
             raise CatBoostError('Pool is not quantized')
@@ -655,7 +659,10 @@ class Pool(_PoolBase):
         if not isinstance(fname, STRING_TYPES):
             raise CatBoostError("Invalid fname type={}: must be str().".format(type(fname)))
 
-        self._save(fname)
+        if compression_codec is not None and not isinstance(compression_codec, STRING_TYPES):
+            raise CatBoostError("Invalid compression_codec type={}: must be str().".format(type(compression_codec)))
+
+        self._save(fname, compression_codec)
 
     def quantize(self, ignored_features=None, per_float_feature_quantization=None, border_count=None,
                  max_bin=None, feature_border_type=None, sparse_features_conflict_fraction=None, dev_efb_max_buckets=None,
@@ -273,6 +273,19 @@ def reset_trace_backend(filename):
     get_catboost_bin_module()._reset_trace_backend(filename)
 
 
+def start_event_trace(filename):
+    """
+    Write chromium trace events of training, data loading, quantization and model evaluation to filename
+    until stop_event_trace is called. The file can be opened in chrome://tracing or Perfetto.
+    Must not be called while training or evaluation is running.
+    """
+    get_catboost_bin_module()._start_event_trace(filename)
+
+
+def stop_event_trace():
+    get_catboost_bin_module()._stop_event_trace()
+
+
 def get_confusion_matrix(model, data, thread_count=-1):
     """
     Build confusion matrix.
@@ -5844,7 +5844,32 @@ def test_pool_quantize():
     assert all(predictions1 == predictions2)
 
 
-def test_save_quantized_pool():
+def test_features_column_store_dir_with_shared_pool():
+    train_pool = Pool(QUERYWISE_TRAIN_FILE, column_description=QUERYWISE_CD_FILE)
+    test_pool = Pool(QUERYWISE_TEST_FILE, column_description=QUERYWISE_CD_FILE)
+    train_pool.quantize()
+    params = {
+        'task_type': 'CPU',
+        'loss_function': 'RMSE',
+        'iterations': 5,
+        'depth': 4,
+    }
+    column_store_dir = test_output_path('column_store')
+    os.mkdir(column_store_dir)
+
+    model = CatBoost(params=params)
+    model.fit(train_pool, eval_set=train_pool)
+
+    # the same pool is learn and eval set and is used again, its features data is moved to column store once
+    model_with_column_store = CatBoost(params=dict(params, features_column_store_dir=column_store_dir))
+    model_with_column_store.fit(train_pool, eval_set=train_pool)
+    model_with_column_store.fit(train_pool, eval_set=train_pool)
+
+    assert all(model.predict(test_pool) == model_with_column_store.predict(test_pool))
+
+
+@pytest.mark.parametrize('compression_codec', [None, 'lz4', 'zstd_1'])
+def test_save_quantized_pool(compression_codec):
     train_pool = Pool(QUERYWISE_TRAIN_FILE, column_description=QUERYWISE_CD_FILE)
     test_pool = Pool(QUERYWISE_TEST_FILE, column_description=QUERYWISE_CD_FILE)
     train_quantized_pool = Pool(QUERYWISE_TRAIN_FILE, column_description=QUERYWISE_CD_FILE)
@@ -5858,7 +5883,7 @@ def test_save_quantized_pool():
 
     assert(train_quantized_pool.is_quantized())
 
-    train_quantized_pool.save(OUTPUT_QUANTIZED_POOL_PATH)
+    train_quantized_pool.save(OUTPUT_QUANTIZED_POOL_PATH, compression_codec=compression_codec)
 
     train_quantized_load_pool = Pool(get_quantized_path(OUTPUT_QUANTIZED_POOL_PATH))
 
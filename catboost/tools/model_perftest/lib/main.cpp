@@ -21,8 +21,10 @@ struct TCMDOptions {
     TString CdPath;
     TString ModelPath;
     size_t BlockSize = Max<size_t>();
+    TVector<size_t> BatchSizes; // if not empty, used instead of BlockSize, results are reported for each size
     size_t RepetitionCount = 1;
     int ThreadCount = 1;
+    int ClientCount = 0; // if not 0, clients evaluate blocks concurrently, each with its own sequence of calls
 };
 
 struct TTimingResult {
@@ -48,27 +50,21 @@ struct TTimingResult {
         return sum / Times.size();
     }
 
-    void Output(const TTimingResult* ref = nullptr) const {
-        auto myMin = Min();
-        CATBOOST_INFO_LOG << "min:\t" << myMin;
-        if (ref) {
-            CATBOOST_INFO_LOG << "\t" << myMin/ref->Min();
-        }
-        CATBOOST_INFO_LOG << Endl;
-
-        auto myMax = Max();
-        CATBOOST_INFO_LOG << "max:\t" << myMax;
-        if (ref) {
-            CATBOOST_INFO_LOG << "\t" << myMax/ref->Max();
-        }
-        CATBOOST_INFO_LOG << Endl;
+    // q in [0, 1]
+    double Percentile(double q) const {
+        TVector<double> times = Times;
+        const size_t idx = ::Min(times.size() - 1, (size_t)(q * times.size()));
+        NthElement(times.begin(), times.begin() + idx, times.end());
+        return times[idx];
+    }
 
-        auto mymean = Mean();
-        CATBOOST_INFO_LOG << "mean:\t" << mymean;
-        if (ref) {
-            CATBOOST_INFO_LOG << "\t" << mymean / ref->Mean();
-        }
-        CATBOOST_INFO_LOG << Endl;
+    void Output(const TTimingResult* ref = nullptr) const {
+        OutputValue("min", Min(), ref ? ref->Min() : 0.0);
+        OutputValue("max", Max(), ref ? ref->Max() : 0.0);
+        OutputValue("mean", Mean(), ref ? ref->Mean() : 0.0);
+        OutputValue("p50", Percentile(0.5), ref ? ref->Percentile(0.5) : 0.0);
+        OutputValue("p99", Percentile(0.99), ref ? ref->Percentile(0.99) : 0.0);
+        OutputValue("p999", Percentile(0.999), ref ? ref->Percentile(0.999) : 0.0);
     }
 
     NJson::TJsonValue GetJsonValue() const {
@@ -76,12 +72,69 @@ struct TTimingResult {
         result["min"] = Min();
         result["max"] = Max();
         result["mean"] = Mean();
+        result["p50"] = Percentile(0.5);
+        result["p99"] = Percentile(0.99);
+        result["p999"] = Percentile(0.999);
+        result["count"] = Times.size();
+        result["histogram"] = GetHistogramJsonValue();
         return result;
     }
+
+private:
+    static void OutputValue(TStringBuf name, double value, double refValue) {
+        CATBOOST_INFO_LOG << name << ":\t" << value;
+        if (refValue) {
+            CATBOOST_INFO_LOG << "\t" << value / refValue;
+        }
+        CATBOOST_INFO_LOG << Endl;
+    }
+
+    // counts of times in [upper_bound / 2, upper_bound), upper bounds are 1 microsecond multiplied by powers of 2
+    NJson::TJsonValue GetHistogramJsonValue() const {
+        TVector<ui64> counts;
+        for (auto t : Times) {
+            size_t bucketIdx = 0;
+            for (double upperBound = 1e-6; t >= upperBound; upperBound *= 2) {
+                ++bucketIdx;
+            }
+            if (counts.size() <= bucketIdx) {
+                counts.resize(bucketIdx + 1, 0);
+            }
+            ++counts[bucketIdx];
+        }
+        NJson::TJsonValue histogram(NJson::JSON_ARRAY);
+        double upperBound = 1e-6;
+        for (auto count : counts) {
+            NJson::TJsonValue bucket;
+            bucket["upper_bound"] = upperBound;
+            bucket["count"] = count;
+            histogram.AppendValue(bucket);
+            upperBound *= 2;
+        }
+        return histogram;
+    }
+};
+
+// of concurrent clients
+struct TThroughputResult {
+    ui64 CallCount = 0;
+    ui64 ObjectCount = 0;
+    double WallTime = 0;
+
+    void Output() const {
+        CATBOOST_INFO_LOG << "calls per second:\t" << CallCount / WallTime << Endl;
+        CATBOOST_INFO_LOG << "objects per second:\t" << ObjectCount / WallTime << Endl;
+    }
+
+    void AddToJsonValue(NJson::TJsonValue* result) const {
+        (*result)["calls_per_second"] = CallCount / WallTime;
+        (*result)["objects_per_second"] = ObjectCount / WallTime;
+    }
 };
 
 struct TResults {
     TMap<TString, THolder<TTimingResult>> Results;
+    TMap<TString, TThroughputResult> Throughputs;
     TString BaseResultName;
     TAdaptiveLock Lock;
 
@@ -95,16 +148,23 @@ struct TResults {
         }
     }
 
-    void OutputResults() const {
-        NJson::TJsonValue jsonValue;
+    void UpdateResult(const TString& name, const TTimingResult& timingResult) {
+        for (auto time : timingResult.Times) {
+            UpdateResult(name, time);
+        }
+    }
+
+    void OutputResults(NJson::TJsonValue* jsonValue) const {
         const TTimingResult* refTimingResult = nullptr;
         CATBOOST_INFO_LOG << "name\tvalue\tdiff" << Endl;
 
-        if (BaseResultName) {
+        if (BaseResultName && Results.contains(BaseResultName)) { // base module can be skipped
             CATBOOST_INFO_LOG << BaseResultName << "\t" << Endl;
             refTimingResult = Results.at(BaseResultName).Get();
             Results.at(BaseResultName)->Output(refTimingResult);
-            jsonValue[BaseResultName] = refTimingResult->GetJsonValue();
+            OutputThroughput(BaseResultName);
+            (*jsonValue)[BaseResultName] = refTimingResult->GetJsonValue();
+            AddThroughputToJsonValue(BaseResultName, &(*jsonValue)[BaseResultName]);
         }
         for (const auto& [key, value] : Results) {
             if (key == BaseResultName) {
@@ -112,10 +172,23 @@ struct TResults {
             }
             CATBOOST_INFO_LOG << key << "\t" << Endl;
             value->Output(refTimingResult);
-            jsonValue[key] = value->GetJsonValue();
+            OutputThroughput(key);
+            (*jsonValue)[key] = value->GetJsonValue();
+            AddThroughputToJsonValue(key, &(*jsonValue)[key]);
+        }
+    }
+
+private:
+    void OutputThroughput(const TString& name) const {
+        if (Throughputs.contains(name)) {
+            Throughputs.at(name).Output();
+        }
+    }
+
+    void AddThroughputToJsonValue(const TString& name, NJson::TJsonValue* jsonValue) const {
+        if (Throughputs.contains(name)) {
+            Throughputs.at(name).AddToJsonValue(jsonValue);
         }
-        TFileOutput resultsFile("results.json");
-        resultsFile << jsonValue.GetStringRobust();
     }
 };
 
@@ -126,15 +199,16 @@ public:
         Results.resize(blockCount);
     }
 
-    void CheckOrSet(size_t blockId, const TVector<double>& blockResult) {
+    /// results of the first module are canonical, results of the other modules are compared with them
+    void CheckOrSet(const TString& name, size_t blockId, const TVector<double>& blockResult) {
         if (Results[blockId].empty()) {
             Results[blockId] = blockResult;
         }
         const auto& ref = Results[blockId];
-        CB_ENSURE(blockResult.size() == ref.size());
+        CB_ENSURE(blockResult.size() == ref.size(), name << " result size differs from canonical one");
         for (size_t i = 0; i < blockResult.size(); ++i) {
             if(abs(blockResult[i] - ref[i]) > Epsilon) {
-                Cerr << LabeledDump(blockId, i, blockResult[i], ref[i], blockResult[i] - ref[i]) << Endl;
+                Cerr << name << ": " << LabeledDump(blockId, i, blockResult[i], ref[i], blockResult[i] - ref[i]) << Endl;
             }
         }
     }
@@ -161,6 +235,89 @@ TVector<bool> GetFeaturesUsedInModel(const TFullModel& model) {
     return result;
 }
 
+struct TPoolBlocks {
+    TVector<float> IgnoredFeatureData;
+    TVector<TVector<TVector<float>>> NonTransposedPool;
+    TVector<TVector<TConstArrayRef<float>>> NonTranspFactorsRef;
+    TVector<TVector<TConstArrayRef<float>>> TranspFactorsRef;
+};
+
+static size_t GetObjectCount(
+    IPerftestModule::EPerftestModuleDataLayout layout,
+    TConstArrayRef<TConstArrayRef<float>> block) {
+
+    return layout == IPerftestModule::EPerftestModuleDataLayout::ObjectsFirst ? block.size() : block[0].size();
+}
+
+/* Each of clientCount clients evaluates all blocks one by one starting from its own block, as independent
+ * requests to a shared model. Latencies of all calls and throughput of all clients are added to results.
+ */
+static void RunClients(
+    int clientCount,
+    IPerftestModule::EPerftestModuleDataLayout layout,
+    const TVector<TVector<TConstArrayRef<float>>>& blocks,
+    IPerftestModule* module,
+    NPar::TLocalExecutor* clientsExecutor,
+    TResults* results) {
+
+    TVector<TTimingResult> clientTimings(clientCount);
+    TVector<ui64> clientObjectCounts(clientCount, 0);
+    THPTimer timer;
+    clientsExecutor->ExecRangeWithThrow([&](int clientId) {
+        TVector<double> resultsHolder;
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            const auto& block = blocks[(clientId + i) % blocks.size()];
+            clientTimings[clientId].Add(module->Do(layout, block, &resultsHolder));
+            clientObjectCounts[clientId] += GetObjectCount(layout, block);
+        }
+    }, 0, clientCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+    const double wallTime = timer.Passed();
+
+    const TString name = module->GetName(layout);
+    auto& throughput = results->Throughputs[name];
+    throughput.WallTime += wallTime;
+    for (int clientId = 0; clientId < clientCount; ++clientId) {
+        results->UpdateResult(name, clientTimings[clientId]);
+        throughput.CallCount += clientTimings[clientId].Times.size();
+        throughput.ObjectCount += clientObjectCounts[clientId];
+    }
+}
+
+static void RunModule(
+    const TCMDOptions& options,
+    IPerftestModule::EPerftestModuleDataLayout layout,
+    const TPoolBlocks& poolBlocks,
+    IPerftestModule* module,
+    NPar::TLocalExecutor* clientsExecutor,
+    TCanonData* canonData,
+    TResults* results) {
+
+    const TString name = module->GetName(layout);
+    if ((options.ClientCount > 0 || options.ThreadCount > 1) && !module->SupportsConcurrentCalls()) {
+        CATBOOST_INFO_LOG << name << " is skipped: it does not support concurrent calls" << Endl;
+        return;
+    }
+    const auto& blocks = (layout == IPerftestModule::EPerftestModuleDataLayout::ObjectsFirst)
+        ? poolBlocks.NonTranspFactorsRef
+        : poolBlocks.TranspFactorsRef;
+    if (options.ClientCount > 0) {
+        RunClients(options.ClientCount, layout, blocks, module, clientsExecutor, results);
+    } else if (options.ThreadCount == 1) {
+        TVector<double> resultsHolder;
+        for (size_t blockId = 0; blockId < blocks.size(); ++blockId) {
+            results->UpdateResult(name, module->Do(layout, blocks[blockId], &resultsHolder));
+            canonData->CheckOrSet(name, blockId, resultsHolder);
+        }
+    } else {
+        THPTimer timer;
+        NPar::LocalExecutor().ExecRangeWithThrow([&](int blockId) {
+            TVector<double> resultsHolder;
+            module->Do(layout, blocks[blockId], &resultsHolder);
+        }, 0, blocks.size(), NPar::TLocalExecutor::WAIT_COMPLETE);
+        results->UpdateResult(name, timer.Passed());
+    }
+}
+
 
 int DoMain(int argc, char** argv) {
     TCMDOptions options;
@@ -177,14 +334,26 @@ int DoMain(int argc, char** argv) {
     parser.AddLongOption("block-size")
         .StoreResult(&options.BlockSize)
         .Optional();
+    parser.AddLongOption("batch-sizes")
+        .SplitHandler(&options.BatchSizes, ',')
+        .Help("comma-separated block sizes to run with one by one, overrides --block-size")
+        .Optional();
     parser.AddLongOption("repetitions")
         .StoreResult(&options.RepetitionCount)
         .Optional();
     parser.AddLongOption("threads")
         .StoreResult(&options.ThreadCount)
         .Optional();
+    parser.AddLongOption("clients")
+        .StoreResult(&options.ClientCount)
+        .Help("number of concurrent clients sharing the model, reports latency percentiles and throughput")
+        .Optional();
 
     NLastGetopt::TOptsParseResult parserResult{&parser, argc, argv};
+    CB_ENSURE(
+        options.ThreadCount == 1 || options.ClientCount == 0,
+        "--threads and --clients can not be used together"
+    );
     TFullModel model = ReadModel(options.ModelPath);
 
     TVector<bool> featureUsedInModel = GetFeaturesUsedInModel(model);
@@ -233,54 +402,60 @@ int DoMain(int argc, char** argv) {
     };
 
 
-    options.BlockSize = Min(options.BlockSize, (size_t)dataset->GetObjectCount());
-    Y_ENSURE(options.BlockSize > 0, "Empty pool");
     const size_t docsCount = dataset->GetObjectCount();
-    const size_t blockCount = (docsCount) / options.BlockSize;
+    Y_ENSURE(docsCount > 0, "Empty pool");
     const size_t factorsCount = featureUsedInModel.size();
 
-    CATBOOST_DEBUG_LOG << "Blocks count: " << blockCount << " block size: " << options.BlockSize << Endl;
-
-    TVector<float> ignoredFeatureData(options.BlockSize);
-    TVector<TVector<TVector<float>>> nonTransposedPool(blockCount);
-    TVector<TVector<TConstArrayRef<float>>> nonTranspFactorsRef(blockCount);
-    TVector<TVector<TConstArrayRef<float>>> transpFactorsRef(blockCount);
-
-    for(size_t blockId = 0; blockId < blockCount; ++blockId) {
-        const size_t blockStart = options.BlockSize * blockId;
-        const size_t docsInCurrBlock = Min<size_t>(options.BlockSize, docsCount - options.BlockSize * blockId);
-        CB_ENSURE(docsInCurrBlock >= 0);
-        transpFactorsRef[blockId].resize(factorsCount);
-        for (size_t i = 0; i < factorsCount; ++i) {
-            if (featureUsedInModel[i]) {
-                transpFactorsRef[blockId][i] = MakeArrayRef<const float>(
-                    getFeatureDataBeginPtr(i) + blockStart,
-                    docsInCurrBlock);
-            } else {
-                transpFactorsRef[blockId][i] = MakeArrayRef<const float>(
-                    ignoredFeatureData.data(),
-                    docsInCurrBlock);
+    auto buildPoolBlocks = [&] (size_t blockSize) {
+        const size_t blockCount = (docsCount) / blockSize;
+        CATBOOST_DEBUG_LOG << "Blocks count: " << blockCount << " block size: " << blockSize << Endl;
+
+        TPoolBlocks poolBlocks;
+        auto& ignoredFeatureData = poolBlocks.IgnoredFeatureData;
+        auto& nonTransposedPool = poolBlocks.NonTransposedPool;
+        auto& nonTranspFactorsRef = poolBlocks.NonTranspFactorsRef;
+        auto& transpFactorsRef = poolBlocks.TranspFactorsRef;
+        ignoredFeatureData.resize(blockSize);
+        nonTransposedPool.resize(blockCount);
+        nonTranspFactorsRef.resize(blockCount);
+        transpFactorsRef.resize(blockCount);
+
+        for(size_t blockId = 0; blockId < blockCount; ++blockId) {
+            const size_t blockStart = blockSize * blockId;
+            const size_t docsInCurrBlock = Min<size_t>(blockSize, docsCount - blockSize * blockId);
+            CB_ENSURE(docsInCurrBlock >= 0);
+            transpFactorsRef[blockId].resize(factorsCount);
+            for (size_t i = 0; i < factorsCount; ++i) {
+                if (featureUsedInModel[i]) {
+                    transpFactorsRef[blockId][i] = MakeArrayRef<const float>(
+                        getFeatureDataBeginPtr(i) + blockStart,
+                        docsInCurrBlock);
+                } else {
+                    transpFactorsRef[blockId][i] = MakeArrayRef<const float>(
+                        ignoredFeatureData.data(),
+                        docsInCurrBlock);
+                }
             }
-        }
 
-        nonTransposedPool[blockId].resize(docsInCurrBlock);
-        nonTranspFactorsRef[blockId].resize(docsInCurrBlock);
-        for (size_t docId = 0; docId < docsInCurrBlock; ++docId) {
-            auto &docFacs = nonTransposedPool[blockId][docId];
-            docFacs.resize(factorsCount);
-            for (size_t featureId = 0; featureId < factorsCount; ++featureId) {
-                if (featureUsedInModel[featureId]) {
-                    docFacs[featureId] = getFeatureDataBeginPtr(featureId)[blockStart + docId];
-                } else {
-                    docFacs[featureId] = 0.0f;
+            nonTransposedPool[blockId].resize(docsInCurrBlock);
+            nonTranspFactorsRef[blockId].resize(docsInCurrBlock);
+            for (size_t docId = 0; docId < docsInCurrBlock; ++docId) {
+                auto &docFacs = nonTransposedPool[blockId][docId];
+                docFacs.resize(factorsCount);
+                for (size_t featureId = 0; featureId < factorsCount; ++featureId) {
+                    if (featureUsedInModel[featureId]) {
+                        docFacs[featureId] = getFeatureDataBeginPtr(featureId)[blockStart + docId];
+                    } else {
+                        docFacs[featureId] = 0.0f;
+                    }
                 }
+                nonTranspFactorsRef[blockId][docId] = MakeArrayRef(docFacs);
             }
-            nonTranspFactorsRef[blockId][docId] = MakeArrayRef(docFacs);
         }
-    }
-    TVector<double> results_vec(options.BlockSize);
-    TResults results;
-    TCanonData canonData(blockCount);
+        return poolBlocks;
+    };
+
+    TString baseResultName;
     TVector<THolder<IPerftestModule>> modules;
     TSet<TPerftestModuleFactory::TKey> allRegisteredKeys;
     TPerftestModuleFactory::GetRegisteredKeys(allRegisteredKeys);
@@ -294,61 +469,66 @@ int DoMain(int argc, char** argv) {
             modules.emplace_back(std::move(product));
             if (modules.back()->GetComparisonPriority(IPerftestModule::EPerftestModuleDataLayout::ObjectsFirst) > biggestPriority) {
                 biggestPriority = modules.back()->GetComparisonPriority(IPerftestModule::EPerftestModuleDataLayout::ObjectsFirst);
-                results.BaseResultName = modules.back()->GetName(IPerftestModule::EPerftestModuleDataLayout::ObjectsFirst);
+                baseResultName = modules.back()->GetName(IPerftestModule::EPerftestModuleDataLayout::ObjectsFirst);
             }
             if (modules.back()->GetComparisonPriority(IPerftestModule::EPerftestModuleDataLayout::FeaturesFirst) > biggestPriority) {
                 biggestPriority = modules.back()->GetComparisonPriority(IPerftestModule::EPerftestModuleDataLayout::FeaturesFirst);
-                results.BaseResultName = modules.back()->GetName(IPerftestModule::EPerftestModuleDataLayout::FeaturesFirst);
+                baseResultName = modules.back()->GetName(IPerftestModule::EPerftestModuleDataLayout::FeaturesFirst);
             }
+        } catch (TPerftestModuleNotApplicable& e) {
+            CATBOOST_INFO_LOG << "Module " << key << " is skipped: " << e.what() << Endl;
         } catch (yexception& e) {
             Cerr << "Failed to construct module " << key << " got error: " << e.what() << Endl;
         } catch (...) {
             Cerr << "Failed to construct module " << key << " got error: " << CurrentExceptionMessage() << Endl;
         }
     }
-    for (size_t i = 0; i < options.RepetitionCount; ++i) {
-        for (auto& module : modules) {
-            if (module->SupportsLayout(IPerftestModule::EPerftestModuleDataLayout::ObjectsFirst)) {
-                if (options.ThreadCount == 1) {
-                    for (size_t blockId = 0; blockId < blockCount; ++blockId) {
-                        results.UpdateResult(
-                            module->GetName(IPerftestModule::EPerftestModuleDataLayout::ObjectsFirst),
-                            module->Do(IPerftestModule::EPerftestModuleDataLayout::ObjectsFirst, nonTranspFactorsRef[blockId])
+
+    NPar::TLocalExecutor clientsExecutor;
+    if (options.ClientCount > 1) {
+        clientsExecutor.RunAdditionalThreads(options.ClientCount - 1);
+    }
+    if (options.BatchSizes.empty()) {
+        options.BatchSizes.push_back(options.BlockSize);
+    }
+    NJson::TJsonValue jsonValue;
+    for (auto batchSize : options.BatchSizes) {
+        batchSize = Min(batchSize, docsCount);
+        Y_ENSURE(batchSize > 0, "Zero batch size");
+        const TPoolBlocks poolBlocks = buildPoolBlocks(batchSize);
+        TCanonData canonData(poolBlocks.NonTranspFactorsRef.size());
+        TResults results;
+        results.BaseResultName = baseResultName;
+        for (size_t i = 0; i < options.RepetitionCount; ++i) {
+            for (auto& module : modules) {
+                for (auto layout : {
+                    IPerftestModule::EPerftestModuleDataLayout::ObjectsFirst,
+                    IPerftestModule::EPerftestModuleDataLayout::FeaturesFirst})
+                {
+                    if (module->SupportsLayout(layout)) {
+                        RunModule(
+                            options,
+                            layout,
+                            poolBlocks,
+                            module.Get(),
+                            &clientsExecutor,
+                            &canonData,
+                            &results
                         );
                     }
-                } else {
-                    THPTimer timer;
-                    NPar::LocalExecutor().ExecRangeWithThrow([&](int blockId) {
-                        module->Do(IPerftestModule::EPerftestModuleDataLayout::ObjectsFirst, nonTranspFactorsRef[blockId]);
-                    }, 0, blockCount, NPar::TLocalExecutor::WAIT_COMPLETE);
-                    results.UpdateResult(
-                        module->GetName(IPerftestModule::EPerftestModuleDataLayout::ObjectsFirst),
-                        timer.Passed()
-                    );
-                }
-            }
-            if (module->SupportsLayout(IPerftestModule::EPerftestModuleDataLayout::FeaturesFirst)) {
-                if (options.ThreadCount == 1) {
-                    for (size_t blockId = 0; blockId < blockCount; ++blockId) {
-                        results.UpdateResult(
-                            module->GetName(IPerftestModule::EPerftestModuleDataLayout::FeaturesFirst),
-                            module->Do(IPerftestModule::EPerftestModuleDataLayout::FeaturesFirst,
-                                transpFactorsRef[blockId]));
-                    }
-                } else {
-                    THPTimer timer;
-                    NPar::LocalExecutor().ExecRangeWithThrow([&](int blockId) {
-                        module->Do(IPerftestModule::EPerftestModuleDataLayout::FeaturesFirst, transpFactorsRef[blockId]);
-                    }, 0, blockCount, NPar::TLocalExecutor::WAIT_COMPLETE);
-                    results.UpdateResult(
-                        module->GetName(IPerftestModule::EPerftestModuleDataLayout::FeaturesFirst),
-                        timer.Passed()
-                    );
                 }
             }
         }
+        if (options.BatchSizes.size() > 1) {
+            const TString runName = "batch size " + ToString(batchSize);
+            CATBOOST_INFO_LOG << runName << Endl;
+            results.OutputResults(&jsonValue[runName]);
+        } else {
+            results.OutputResults(&jsonValue);
+        }
     }
-    results.OutputResults();
+    TFileOutput resultsFile("results.json");
+    resultsFile << jsonValue.GetStringRobust();
 
     return 0;
 }
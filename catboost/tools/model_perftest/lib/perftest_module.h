@@ -5,7 +5,8 @@
 #include <library/object_factory/object_factory.h>
 
 #include <util/generic/array_ref.h>
-#include <util/system/hp_timer.h>
+#include <util/generic/vector.h>
+#include <util/generic/yexception.h>
 
 class IPerftestModule {
 public:
@@ -17,15 +18,23 @@ public:
     /// we will dynamically select module with highest priority as baseline
     virtual int GetComparisonPriority(EPerftestModuleDataLayout layout) const = 0;
     virtual bool SupportsLayout(EPerftestModuleDataLayout layout) const = 0;
-    virtual double Do(EPerftestModuleDataLayout layout, TConstArrayRef<TConstArrayRef<float>> features) = 0;
+    /// if false, module is skipped in --threads and --clients modes
+    virtual bool SupportsConcurrentCalls() const {
+        return true;
+    }
+    /// returns time of evaluation, if SupportsConcurrentCalls() it may be called concurrently by several threads
+    /// with different resultsHolder
+    virtual double Do(
+        EPerftestModuleDataLayout layout,
+        TConstArrayRef<TConstArrayRef<float>> features,
+        TVector<double>* resultsHolder) = 0;
     virtual TString GetName(TMaybe<EPerftestModuleDataLayout> = Nothing()) const = 0;
 
     virtual ~IPerftestModule() = default;
 };
 
-class TBasePerftestModule : public IPerftestModule {
-protected:
-    THPTimer Timer;
+/// thrown from module constructor if module is not applicable to the model, such module is skipped without an error
+class TPerftestModuleNotApplicable : public yexception {
 };
 
 using TPerftestModuleFactory = NObjectFactory::TParametrizedObjectFactory<IPerftestModule, TString, const TFullModel&>;
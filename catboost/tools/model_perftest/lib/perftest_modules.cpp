@@ -1,6 +1,11 @@
 #include "perftest_module.h"
 
-class TBaseCatboostModule : public TBasePerftestModule {
+#include <catboost/libs/model_interface/c_api.h>
+
+#include <util/generic/cast.h>
+#include <util/system/hp_timer.h>
+
+class TBaseCatboostModule : public IPerftestModule {
 public:
     TBaseCatboostModule() = default;
 
@@ -15,17 +20,22 @@ public:
         return true;
     }
 
-    double Do(EPerftestModuleDataLayout layout, TConstArrayRef<TConstArrayRef<float>> features) override final {
+    double Do(
+        EPerftestModuleDataLayout layout,
+        TConstArrayRef<TConstArrayRef<float>> features,
+        TVector<double>* resultsHolder) override final {
+
+        const size_t approxDimension = ModelEvaluator->GetApproxDimension();
         if (layout == EPerftestModuleDataLayout::ObjectsFirst) {
-            ResultsHolder.resize(features.size());
-            Timer.Reset();
-            ModelEvaluator->CalcFlat(features, ResultsHolder);
-            return Timer.Passed();
+            resultsHolder->resize(features.size() * approxDimension);
+            THPTimer timer;
+            ModelEvaluator->CalcFlat(features, *resultsHolder);
+            return timer.Passed();
         } else {
-            ResultsHolder.resize(features[0].size());
-            Timer.Reset();
-            ModelEvaluator->CalcFlatTransposed(features, ResultsHolder);
-            return Timer.Passed();
+            resultsHolder->resize(features[0].size() * approxDimension);
+            THPTimer timer;
+            ModelEvaluator->CalcFlatTransposed(features, *resultsHolder);
+            return timer.Passed();
         }
     }
     TString GetName(TMaybe<EPerftestModuleDataLayout> layout) const override final {
@@ -41,7 +51,6 @@ protected:
     NCB::NModelEvaluation::TModelEvaluatorPtr ModelEvaluator;
     int Priority = 0;
     TString BaseName;
-    TVector<double> ResultsHolder;
 };
 
 class TCPUCatboostModule : public TBaseCatboostModule {
@@ -74,6 +83,172 @@ public:
         ModelEvaluator = NCB::NModelEvaluation::CreateEvaluator(EFormulaEvaluatorType::GPU, model);
         BaseName = "catboost gpu";
     }
+
+    // evaluator copies data to the device buffers shared by all calls
+    bool SupportsConcurrentCalls() const override {
+        return false;
+    }
 };
 
 TPerftestModuleFactory::TRegistrator<TGPUCatboostModule> GPUCatboostModuleRegistar("GPUCatboostModule");
+
+/// base for modules that take float and hashed categorical features separately instead of flat feature vectors
+class TSeparateFeaturesModule : public IPerftestModule {
+public:
+    explicit TSeparateFeaturesModule(const TFullModel& model)
+        : FloatFeatureFlatIndices(model.GetNumFloatFeatures(), 0)
+        , CatFeatureFlatIndices(model.GetNumCatFeatures(), 0)
+        , ApproxDimension(model.GetDimensionsCount())
+    {
+        for (const auto& floatFeature : model.ModelTrees->GetFloatFeatures()) {
+            FloatFeatureFlatIndices[floatFeature.Position.Index] = floatFeature.Position.FlatIndex;
+        }
+        for (const auto& catFeature : model.ModelTrees->GetCatFeatures()) {
+            CatFeatureFlatIndices[catFeature.Position.Index] = catFeature.Position.FlatIndex;
+        }
+    }
+
+    int GetComparisonPriority(EPerftestModuleDataLayout) const override {
+        return 0;
+    }
+
+    bool SupportsLayout(EPerftestModuleDataLayout layout) const override final {
+        return layout == EPerftestModuleDataLayout::ObjectsFirst;
+    }
+
+    TString GetName(TMaybe<EPerftestModuleDataLayout> layout) const override final {
+        return layout.Defined() ? BaseName + " objects order" : BaseName;
+    }
+
+protected:
+    // categorical values in flat features are hashes stored as float bits
+    void SplitFeatures(
+        TConstArrayRef<TConstArrayRef<float>> features,
+        TVector<TVector<float>>* floatFeatures,
+        TVector<TVector<int>>* catFeatures) const {
+
+        floatFeatures->resize(features.size());
+        catFeatures->resize(features.size());
+        for (size_t objectIdx = 0; objectIdx < features.size(); ++objectIdx) {
+            auto& objectFloatFeatures = (*floatFeatures)[objectIdx];
+            objectFloatFeatures.resize(FloatFeatureFlatIndices.size());
+            for (size_t i = 0; i < FloatFeatureFlatIndices.size(); ++i) {
+                objectFloatFeatures[i] = features[objectIdx][FloatFeatureFlatIndices[i]];
+            }
+            auto& objectCatFeatures = (*catFeatures)[objectIdx];
+            objectCatFeatures.resize(CatFeatureFlatIndices.size());
+            for (size_t i = 0; i < CatFeatureFlatIndices.size(); ++i) {
+                objectCatFeatures[i] = BitCast<int>(features[objectIdx][CatFeatureFlatIndices[i]]);
+            }
+        }
+    }
+
+protected:
+    TVector<size_t> FloatFeatureFlatIndices; // [floatFeatureIdx]
+    TVector<size_t> CatFeatureFlatIndices; // [catFeatureIdx]
+    size_t ApproxDimension;
+    TString BaseName;
+};
+
+/// evaluation of single objects with the C API, as in services that call the model per request
+class TCAPICatboostModule : public TSeparateFeaturesModule {
+public:
+    TCAPICatboostModule(const TFullModel& model)
+        : TSeparateFeaturesModule(model)
+        , ModelHandle(ModelCalcerCreate())
+    {
+        const TString serializedModel = SerializeModel(model);
+        if (!LoadFullModelFromBuffer(ModelHandle, serializedModel.data(), serializedModel.size())) {
+            ModelCalcerDelete(ModelHandle);
+            CB_ENSURE(false, "Failed to load model with C API: " << GetErrorString());
+        }
+        HasCatFeatures = !CatFeatureFlatIndices.empty();
+        BaseName = "catboost c api single";
+    }
+
+    ~TCAPICatboostModule() {
+        ModelCalcerDelete(ModelHandle);
+    }
+
+    /* Only hashed values of categorical features are available,
+     * so models with them are evaluated with CalcModelPredictionWithHashedCatFeatures for one object.
+     */
+    double Do(
+        EPerftestModuleDataLayout /*layout*/,
+        TConstArrayRef<TConstArrayRef<float>> features,
+        TVector<double>* resultsHolder) override {
+
+        TVector<TVector<float>> floatFeatures;
+        TVector<TVector<int>> catFeatures;
+        SplitFeatures(features, &floatFeatures, &catFeatures);
+        resultsHolder->resize(features.size() * ApproxDimension);
+
+        double time = 0;
+        for (size_t objectIdx = 0; objectIdx < features.size(); ++objectIdx) {
+            double* result = resultsHolder->data() + objectIdx * ApproxDimension;
+            bool calculated;
+            THPTimer timer;
+            if (HasCatFeatures) {
+                const float* objectFloatFeatures = floatFeatures[objectIdx].data();
+                const int* objectCatFeatures = catFeatures[objectIdx].data();
+                calculated = CalcModelPredictionWithHashedCatFeatures(
+                    ModelHandle,
+                    1,
+                    &objectFloatFeatures, floatFeatures[objectIdx].size(),
+                    &objectCatFeatures, catFeatures[objectIdx].size(),
+                    result, ApproxDimension);
+            } else {
+                calculated = CalcModelPredictionSingle(
+                    ModelHandle,
+                    floatFeatures[objectIdx].data(), floatFeatures[objectIdx].size(),
+                    nullptr, 0,
+                    result, ApproxDimension);
+            }
+            time += timer.Passed();
+            CB_ENSURE(calculated, "C API evaluation failed: " << GetErrorString());
+        }
+        return time;
+    }
+
+private:
+    ModelCalcerHandle* ModelHandle;
+    bool HasCatFeatures;
+};
+
+TPerftestModuleFactory::TRegistrator<TCAPICatboostModule> CAPICatboostModuleRegistar("CAPICatboost");
+
+/// evaluation with online ctrs calculated from hashed categorical features by TFullModel::Calc
+class TCPUCatboostCtrModule : public TSeparateFeaturesModule {
+public:
+    TCPUCatboostCtrModule(const TFullModel& model)
+        : TSeparateFeaturesModule(model)
+        , Model(model)
+    {
+        if (model.ModelTrees->GetUsedModelCtrs().empty()) {
+            throw TPerftestModuleNotApplicable() << "model has no ctrs";
+        }
+        BaseName = "catboost cpu ctrs";
+    }
+
+    double Do(
+        EPerftestModuleDataLayout /*layout*/,
+        TConstArrayRef<TConstArrayRef<float>> features,
+        TVector<double>* resultsHolder) override {
+
+        TVector<TVector<float>> floatFeatures;
+        TVector<TVector<int>> catFeatures;
+        SplitFeatures(features, &floatFeatures, &catFeatures);
+        const TVector<TConstArrayRef<float>> floatFeaturesRefs(floatFeatures.begin(), floatFeatures.end());
+        const TVector<TConstArrayRef<int>> catFeaturesRefs(catFeatures.begin(), catFeatures.end());
+        resultsHolder->resize(features.size() * ApproxDimension);
+
+        THPTimer timer;
+        Model.Calc(floatFeaturesRefs, catFeaturesRefs, *resultsHolder);
+        return timer.Passed();
+    }
+
+private:
+    const TFullModel& Model;
+};
+
+TPerftestModuleFactory::TRegistrator<TCPUCatboostCtrModule> CPUCatboostCtrModuleRegistar("CPUCatboostCtr");
@@ -4,8 +4,8 @@ TStringBuf NCsvFormat::CsvSplitter::Consume() {
     if (Begin == End) {
         return nullptr;
     }
-    TString::iterator TokenStart = Begin;
-    TString::iterator TokenEnd = Begin;
+    TStringBuf::const_iterator TokenStart = Begin;
+    TStringBuf::const_iterator TokenEnd = Begin;
     if (Quote == '\0') {
         while (1) {
             if (TokenEnd == End || *TokenEnd == Delimeter) {
@@ -11,7 +11,7 @@
 namespace NCsvFormat {
     class CsvSplitter {
     public:
-        CsvSplitter(TString& data, const char delimeter = ',', const char quote = '"')
+        CsvSplitter(TStringBuf data, const char delimeter = ',', const char quote = '"')
         // quote = '\0' ignores quoting in values and words like simple split
             : Delimeter(delimeter)
             , Quote(quote)
@@ -43,8 +43,8 @@ namespace NCsvFormat {
     private:
         const char Delimeter;
         const char Quote;
-        TString::iterator Begin;
-        const TString::const_iterator End;
+        TStringBuf::const_iterator Begin;
+        const TStringBuf::const_iterator End;
         TString CustomString;
         TVector<TStringBuf> CustomStringBufs;
     };
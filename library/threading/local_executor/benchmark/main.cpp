@@ -0,0 +1,95 @@
+#include <library/testing/benchmark/bench.h>
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/singleton.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+
+/* Parallel loops over an array of documents with per-document costs that are either uniform or skewed
+ * (like scoring of candidates with different bucket counts or CTR calculation over groups of different sizes),
+ * executed with blocks statically assigned to threads and with work stealing (ParallelFor).
+ */
+
+namespace {
+    constexpr int DOC_COUNT = 1 << 18;
+
+    template <int ThreadCount, bool PinToCpus>
+    struct TExecutorHolder {
+        NPar::TLocalExecutor Executor;
+        TVector<double> Values;
+
+        TExecutorHolder()
+            : Values(DOC_COUNT, 1.0)
+        {
+            Executor.RunAdditionalThreads(ThreadCount - 1, PinToCpus);
+        }
+    };
+
+    inline int GetUniformCost(int /*docIdx*/) {
+        return 8;
+    }
+
+    // the last tenth of documents is 32 times more expensive than the rest
+    inline int GetSkewedCost(int docIdx) {
+        return docIdx >= DOC_COUNT / 10 * 9 ? 256 : 8;
+    }
+
+    template <class TGetCost>
+    inline void ProcessDoc(int docIdx, const TGetCost& getCost, TVector<double>* values) {
+        double value = (*values)[docIdx];
+        for (int iter = 0, cost = getCost(docIdx); iter < cost; ++iter) {
+            value = value * 0.999 + 0.001;
+        }
+        (*values)[docIdx] = value;
+    }
+
+    template <int ThreadCount, bool PinToCpus, class TGetCost>
+    void RunStaticBlocks(const TGetCost& getCost, const NBench::NCpu::TParams& iface) {
+        auto& holder = *Singleton<TExecutorHolder<ThreadCount, PinToCpus>>();
+        for (const auto i : xrange(iface.Iterations())) {
+            Y_UNUSED(i);
+            NPar::TLocalExecutor::TExecRangeParams params(0, DOC_COUNT);
+            params.SetBlockCount(holder.Executor.GetThreadCount() + 1);
+            holder.Executor.ExecRange(
+                [&](int docIdx) { ProcessDoc(docIdx, getCost, &holder.Values); },
+                params,
+                NPar::TLocalExecutor::WAIT_COMPLETE);
+            Y_DO_NOT_OPTIMIZE_AWAY(holder.Values.data());
+        }
+    }
+
+    template <int ThreadCount, bool PinToCpus, class TGetCost>
+    void RunWorkStealing(const TGetCost& getCost, const NBench::NCpu::TParams& iface) {
+        auto& holder = *Singleton<TExecutorHolder<ThreadCount, PinToCpus>>();
+        for (const auto i : xrange(iface.Iterations())) {
+            Y_UNUSED(i);
+            NPar::ParallelFor(
+                holder.Executor,
+                0,
+                DOC_COUNT,
+                [&](int docIdx) { ProcessDoc(docIdx, getCost, &holder.Values); });
+            Y_DO_NOT_OPTIMIZE_AWAY(holder.Values.data());
+        }
+    }
+}
+
+#define DEFINE_BENCHMARKS(threadCount)                                                      \
+    Y_CPU_BENCHMARK(StaticBlocksUniform_##threadCount, iface) {                             \
+        RunStaticBlocks<threadCount, false>(GetUniformCost, iface);                         \
+    }                                                                                       \
+    Y_CPU_BENCHMARK(StaticBlocksSkewed_##threadCount, iface) {                              \
+        RunStaticBlocks<threadCount, false>(GetSkewedCost, iface);                          \
+    }                                                                                       \
+    Y_CPU_BENCHMARK(WorkStealingUniform_##threadCount, iface) {                             \
+        RunWorkStealing<threadCount, false>(GetUniformCost, iface);                         \
+    }                                                                                       \
+    Y_CPU_BENCHMARK(WorkStealingSkewed_##threadCount, iface) {                              \
+        RunWorkStealing<threadCount, false>(GetSkewedCost, iface);                          \
+    }                                                                                       \
+    Y_CPU_BENCHMARK(WorkStealingSkewedPinned_##threadCount, iface) {                        \
+        RunWorkStealing<threadCount, true>(GetSkewedCost, iface);                           \
+    }
+
+DEFINE_BENCHMARKS(8)
+DEFINE_BENCHMARKS(32)
+DEFINE_BENCHMARKS(128)
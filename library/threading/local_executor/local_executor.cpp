@@ -1,10 +1,20 @@
 #include "local_executor.h"
 
+#include <library/chromium_trace/interface.h>
 #include <library/threading/future/future.h>
 
+#include <util/folder/path.h>
+#include <util/generic/algorithm.h>
 #include <util/generic/utility.h>
+#include <util/generic/vector.h>
+#include <util/stream/file.h>
+#include <util/string/cast.h>
+#include <util/string/split.h>
+#include <util/string/strip.h>
 #include <util/system/atomic.h>
 #include <util/system/event.h>
+#include <util/system/guard.h>
+#include <util/system/spinlock.h>
 #include <util/system/thread.h>
 #include <util/system/tls.h>
 #include <util/system/yield.h>
@@ -12,6 +22,10 @@
 
 #include <utility>
 
+#if defined(_linux_)
+#include <sched.h>
+#endif
+
 #ifdef _win_
 static void RegularYield() {
 }
@@ -122,6 +136,204 @@ namespace {
         }
     };
 
+    class TStealingRangeExecutor: public NPar::ILocallyExecutable {
+        // contiguous part of the range, owned by one thread, padded to avoid false sharing
+        struct alignas(64) TPart {
+            TAdaptiveLock Lock;
+            int Begin = 0;
+            int End = 0;
+            TAtomic Size = 0; // End - Begin, to choose a victim without locking all parts
+            TAtomic IsOwned = 0;
+        };
+
+        // owner takes 1/GUIDED_CHUNK_DIVISOR of the rest of its part at once
+        static constexpr int GUIDED_CHUNK_DIVISOR = 8;
+
+        NPar::TLocallyExecutableRangeFunction Exec;
+        const NPar::TLocalExecutor* Executor;
+        TVector<TPart> Parts;
+        TAtomic Remaining;
+
+    private:
+        static void SetRange(int begin, int end, TPart* part) {
+            part->Begin = begin;
+            part->End = end;
+            AtomicSet(part->Size, end - begin);
+        }
+
+        int ClaimPart(int preferredPartIdx) {
+            if (preferredPartIdx < Parts.ysize() && AtomicCas(&Parts[preferredPartIdx].IsOwned, 1, 0)) {
+                return preferredPartIdx;
+            }
+            for (int partIdx = 0; partIdx < Parts.ysize(); ++partIdx) {
+                if (AtomicCas(&Parts[partIdx].IsOwned, 1, 0)) {
+                    return partIdx;
+                }
+            }
+            return -1;
+        }
+
+        bool TakeChunk(TPart* part, int* begin, int* end) {
+            with_lock (part->Lock) {
+                const int size = part->End - part->Begin;
+                if (size <= 0) {
+                    return false;
+                }
+                *begin = part->Begin;
+                *end = part->Begin + Max(1, size / GUIDED_CHUNK_DIVISOR);
+                SetRange(*end, part->End, part);
+            }
+            return true;
+        }
+
+        bool Steal(int* begin, int* end) {
+            for (;;) {
+                TPart* victim = nullptr;
+                TAtomicBase victimSize = 0;
+                for (auto& part : Parts) {
+                    const TAtomicBase size = AtomicGet(part.Size);
+                    if (size > victimSize) {
+                        victim = &part;
+                        victimSize = size;
+                    }
+                }
+                if (!victim) {
+                    return false;
+                }
+                with_lock (victim->Lock) {
+                    const int size = victim->End - victim->Begin;
+                    if (size > 0) {
+                        *begin = victim->End - Max(1, size / 2);
+                        *end = victim->End;
+                        SetRange(victim->Begin, *begin, victim);
+                        return true;
+                    }
+                }
+            }
+        }
+
+        void ExecChunk(int begin, int end) {
+            Exec(begin, end);
+            AtomicAdd(Remaining, -(end - begin));
+        }
+
+    public:
+        TStealingRangeExecutor(
+            NPar::TLocallyExecutableRangeFunction exec,
+            int firstId,
+            int lastId,
+            int partCount,
+            const NPar::TLocalExecutor* executor)
+            : Exec(std::move(exec))
+            , Executor(executor)
+            , Parts(partCount)
+            , Remaining(lastId - firstId)
+        {
+            const int rangeSize = lastId - firstId;
+            for (int partIdx = 0; partIdx < partCount; ++partIdx) {
+                SetRange(
+                    firstId + (i64)rangeSize * partIdx / partCount,
+                    firstId + (i64)rangeSize * (partIdx + 1) / partCount,
+                    &Parts[partIdx]);
+            }
+        }
+
+        void LocalExec(int) override {
+            const int ownPartIdx = ClaimPart(Executor->GetWorkerThreadId());
+            int begin = 0;
+            int end = 0;
+            if (ownPartIdx < 0) {
+                while (Steal(&begin, &end)) {
+                    ExecChunk(begin, end);
+                }
+                return;
+            }
+            TPart* ownPart = &Parts[ownPartIdx];
+            for (;;) {
+                while (TakeChunk(ownPart, &begin, &end)) {
+                    ExecChunk(begin, end);
+                }
+                if (!Steal(&begin, &end)) {
+                    break;
+                }
+                // stolen range becomes the own part, so it can be stolen from in its turn
+                with_lock (ownPart->Lock) {
+                    SetRange(begin, end, ownPart);
+                }
+            }
+        }
+
+        void WaitComplete() {
+            while (AtomicGet(Remaining) > 0) {
+                RegularYield();
+            }
+        }
+    };
+
+    // CPUs available to the process ordered by NUMA nodes
+    TVector<int> GetCpusByNumaNodes() {
+        TVector<int> cpus;
+#if defined(_linux_)
+        cpu_set_t allowedCpus;
+        CPU_ZERO(&allowedCpus);
+        if (sched_getaffinity(0, sizeof(allowedCpus), &allowedCpus) != 0) {
+            return cpus;
+        }
+        const auto isAllowed = [&] (int cpu) {
+            return cpu >= 0 && cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowedCpus) && !IsIn(cpus, cpu);
+        };
+
+        TVector<int> nodeIds;
+        try {
+            TVector<TString> nodeDirNames;
+            TFsPath("/sys/devices/system/node").ListNames(nodeDirNames);
+            for (const auto& name : nodeDirNames) {
+                int nodeId;
+                if (name.StartsWith("node") && TryFromString(name.substr(4), nodeId)) {
+                    nodeIds.push_back(nodeId);
+                }
+            }
+            Sort(nodeIds);
+            for (int nodeId : nodeIds) {
+                // cpulist format is "0-15,32-47"
+                const TString cpuList = StripString(
+                    TFileInput("/sys/devices/system/node/node" + ToString(nodeId) + "/cpulist").ReadAll());
+                for (TStringBuf cpuRange : StringSplitter(cpuList).Split(',').SkipEmpty()) {
+                    TStringBuf first;
+                    TStringBuf last;
+                    if (!cpuRange.TrySplit('-', first, last)) {
+                        first = last = cpuRange;
+                    }
+                    for (int cpu = FromString<int>(first); cpu <= FromString<int>(last); ++cpu) {
+                        if (isAllowed(cpu)) {
+                            cpus.push_back(cpu);
+                        }
+                    }
+                }
+            }
+        } catch (...) {
+            // no NUMA information, CPUs that are not listed are added below in the natural order
+        }
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (isAllowed(cpu)) {
+                cpus.push_back(cpu);
+            }
+        }
+#endif
+        return cpus;
+    }
+
+    void PinCurrentThreadToCpu(int cpu) {
+#if defined(_linux_)
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpu, &cpuSet);
+        sched_setaffinity(0, sizeof(cpuSet), &cpuSet); // best effort, thread is left unpinned on failure
+#else
+        Y_UNUSED(cpu);
+#endif
+    }
+
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -143,11 +355,21 @@ public:
     Y_THREAD(int)
     WorkerThreadId;
 
+    // filled before the first pinned thread is started, worker thread i is pinned to CpusByNumaNodes[i % size],
+    // CpusByNumaNodes[0] is left for the thread that runs the executor (its WorkerThreadId is 0)
+    TVector<int> CpusByNumaNodes;
+
+    struct TWorkerThreadParams {
+        TImpl* Impl;
+        bool PinToCpu;
+    };
+
     static void* HostWorkerThread(void* p);
     bool GetJob(TSingleJob* job);
-    void RunNewThread();
-    void LaunchRange(TIntrusivePtr<TLocalRangeExecutor> execRange, int queueSizeLimit,
+    void RunNewThread(bool pinToCpu);
+    void LaunchRange(TIntrusivePtr<NPar::ILocallyExecutable> execRange, int count, int queueSizeLimit,
                      TAtomic* queueSize, TLockFreeQueue<TSingleJob>* jobQueue);
+    void LaunchRange(TIntrusivePtr<NPar::ILocallyExecutable> execRange, int count, int queueSizeLimit, int prior);
 
     TImpl() = default;
     ~TImpl();
@@ -165,9 +387,15 @@ NPar::TLocalExecutor::TImpl::~TImpl() {
 void* NPar::TLocalExecutor::TImpl::HostWorkerThread(void* p) {
     static const int FAST_ITERATIONS = 200;
 
-    auto* const ctx = (TImpl*)p;
+    THolder<TWorkerThreadParams> params((TWorkerThreadParams*)p);
+    auto* const ctx = params->Impl;
     TThread::SetCurrentThreadName("ParLocalExecutor");
     ctx->WorkerThreadId = AtomicAdd(ctx->ThreadId, 1);
+    if (params->PinToCpu && !ctx->CpusByNumaNodes.empty()) {
+        PinCurrentThreadToCpu(ctx->CpusByNumaNodes[ctx->WorkerThreadId % ctx->CpusByNumaNodes.ysize()]);
+    }
+    CHROMIUM_TRACE_THREAD_NAME("ParLocalExecutor");
+    CHROMIUM_TRACE_THREAD_INDEX(ctx->WorkerThreadId);
     for (bool cont = true; cont;) {
         TSingleJob job;
         bool gotJob = false;
@@ -185,7 +413,10 @@ void* NPar::TLocalExecutor::TImpl::HostWorkerThread(void* p) {
             }
         }
         if (job.Exec.Get()) {
-            job.Exec->LocalExec(job.Id);
+            {
+                CHROMIUM_TRACE_SCOPE("TLocalExecutor job");
+                job.Exec->LocalExec(job.Id);
+            }
             RegularYield();
         } else {
             AtomicAdd(ctx->QueueSize, 1);
@@ -215,18 +446,18 @@ bool NPar::TLocalExecutor::TImpl::GetJob(TSingleJob* job) {
     return false;
 }
 
-void NPar::TLocalExecutor::TImpl::RunNewThread() {
+void NPar::TLocalExecutor::TImpl::RunNewThread(bool pinToCpu) {
     AtomicAdd(ThreadCount, 1);
-    TThread thr(HostWorkerThread, this);
+    TThread thr(HostWorkerThread, new TWorkerThreadParams{this, pinToCpu});
     thr.Start();
     thr.Detach();
 }
 
-void NPar::TLocalExecutor::TImpl::LaunchRange(TIntrusivePtr<TLocalRangeExecutor> rangeExec,
+void NPar::TLocalExecutor::TImpl::LaunchRange(TIntrusivePtr<NPar::ILocallyExecutable> rangeExec,
+                                              int count,
                                               int queueSizeLimit,
                                               TAtomic* queueSize,
                                               TLockFreeQueue<TSingleJob>* jobQueue) {
-    int count = Min<int>(ThreadCount + 1, rangeExec->GetRangeSize());
     if (queueSizeLimit >= 0 && AtomicGet(*queueSize) >= queueSizeLimit) {
         return;
     }
@@ -237,15 +468,38 @@ void NPar::TLocalExecutor::TImpl::LaunchRange(TIntrusivePtr<TLocalRangeExecutor>
     HasJob.Signal();
 }
 
+void NPar::TLocalExecutor::TImpl::LaunchRange(TIntrusivePtr<NPar::ILocallyExecutable> rangeExec,
+                                              int count,
+                                              int queueSizeLimit,
+                                              int prior) {
+    switch (prior) {
+        case HIGH_PRIORITY:
+            LaunchRange(std::move(rangeExec), count, queueSizeLimit, &QueueSize, &JobQueue);
+            break;
+        case MED_PRIORITY:
+            LaunchRange(std::move(rangeExec), count, queueSizeLimit, &MPQueueSize, &MedJobQueue);
+            break;
+        case LOW_PRIORITY:
+            LaunchRange(std::move(rangeExec), count, queueSizeLimit, &LPQueueSize, &LowJobQueue);
+            break;
+        default:
+            Y_ASSERT(0);
+            break;
+    }
+}
+
 NPar::TLocalExecutor::TLocalExecutor()
     : Impl_{MakeHolder<TImpl>()} {
 }
 
 NPar::TLocalExecutor::~TLocalExecutor() = default;
 
-void NPar::TLocalExecutor::RunAdditionalThreads(int threadCount) {
+void NPar::TLocalExecutor::RunAdditionalThreads(int threadCount, bool pinToCpus) {
+    if (pinToCpus && Impl_->CpusByNumaNodes.empty()) {
+        Impl_->CpusByNumaNodes = GetCpusByNumaNodes();
+    }
     for (int i = 0; i < threadCount; i++)
-        Impl_->RunNewThread();
+        Impl_->RunNewThread(pinToCpus);
 }
 
 void NPar::TLocalExecutor::Exec(TIntrusivePtr<ILocallyExecutable> exec, int id, int flags) {
@@ -287,20 +541,8 @@ void NPar::TLocalExecutor::ExecRange(TIntrusivePtr<ILocallyExecutable> exec, int
     auto rangeExec = MakeIntrusive<TLocalRangeExecutor>(std::move(exec), firstId, lastId);
     int queueSizeLimit = (flags & WAIT_COMPLETE) ? 10000 : -1;
     int prior = Max<int>(Impl_->CurrentTaskPriority, flags & PRIORITY_MASK);
-    switch (prior) {
-        case HIGH_PRIORITY:
-            Impl_->LaunchRange(rangeExec, queueSizeLimit, &Impl_->QueueSize, &Impl_->JobQueue);
-            break;
-        case MED_PRIORITY:
-            Impl_->LaunchRange(rangeExec, queueSizeLimit, &Impl_->MPQueueSize, &Impl_->MedJobQueue);
-            break;
-        case LOW_PRIORITY:
-            Impl_->LaunchRange(rangeExec, queueSizeLimit, &Impl_->LPQueueSize, &Impl_->LowJobQueue);
-            break;
-        default:
-            Y_ASSERT(0);
-            break;
-    }
+    const int count = Min<int>(GetThreadCount() + 1, rangeExec->GetRangeSize());
+    Impl_->LaunchRange(rangeExec, count, queueSizeLimit, prior);
     if (flags & WAIT_COMPLETE) {
         int keepPrior = Impl_->CurrentTaskPriority;
         Impl_->CurrentTaskPriority = prior;
@@ -331,6 +573,28 @@ NPar::TLocalExecutor::ExecRangeWithFutures(TLocallyExecutableFunction exec, int
     return out;
 }
 
+void NPar::TLocalExecutor::ExecRangeWithStealing(TLocallyExecutableRangeFunction exec, int firstId, int lastId, int flags) {
+    Y_VERIFY((flags & WAIT_COMPLETE) != 0, "ExecRangeWithStealing() requires WAIT_COMPLETE");
+    Y_ASSERT(lastId >= firstId);
+    if (firstId >= lastId) {
+        return;
+    }
+    const int partCount = Min<int>(GetThreadCount() + 1, lastId - firstId);
+    if (partCount == 1) {
+        exec(firstId, lastId);
+        return;
+    }
+    auto rangeExec = MakeIntrusive<TStealingRangeExecutor>(std::move(exec), firstId, lastId, partCount, this);
+    int prior = Max<int>(Impl_->CurrentTaskPriority, flags & PRIORITY_MASK);
+    Impl_->LaunchRange(rangeExec, partCount - 1, /*queueSizeLimit*/ 10000, prior);
+
+    int keepPrior = Impl_->CurrentTaskPriority;
+    Impl_->CurrentTaskPriority = prior;
+    rangeExec->LocalExec(0);
+    Impl_->CurrentTaskPriority = keepPrior;
+    rangeExec->WaitComplete();
+}
+
 void NPar::TLocalExecutor::ClearLPQueue() {
     for (bool cont = true; cont;) {
         cont = false;
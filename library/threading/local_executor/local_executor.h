@@ -25,6 +25,10 @@ namespace NPar {
     //
     using TLocallyExecutableFunction = std::function<void(int)>;
 
+    // Job processing a subrange [firstId, lastId) of tasks at once, used by `ExecRangeWithStealing`.
+    //
+    using TLocallyExecutableRangeFunction = std::function<void(int firstId, int lastId)>;
+
     // `TLocalExecutor` provides facilities for easy parallelization of existing code and cycles.
     //
     // Examples:
@@ -134,7 +138,10 @@ namespace NPar {
         // **Add** threads to underlying thread pool.
         //
         // @param threadCount       Number of threads to add.
-        void RunAdditionalThreads(int threadCount);
+        // @param pinToCpus         Bind each added thread to its own CPU (Linux only, best effort). CPUs are
+        //                          taken NUMA node by node, so threads with close ids (and the parts of
+        //                          ranges they own in `ExecRangeWithStealing`) stay on the same node.
+        void RunAdditionalThreads(int threadCount, bool pinToCpus = false);
 
         // Add task for further execution.
         //
@@ -166,6 +173,14 @@ namespace NPar {
         //
         TVector<NThreading::TFuture<void>> ExecRangeWithFutures(TLocallyExecutableFunction exec, int firstId, int lastId, int flags);
 
+        // Version of `ExecRange` for loops with uneven iteration costs. Range is split into ThreadCount+1
+        // contiguous parts, the part with index `GetWorkerThreadId()` is processed by that thread (so the
+        // same thread touches the same data in consecutive calls) in chunks from its beginning, and threads
+        // that have finished their parts steal the second half of the largest part left.
+        // Requires `WAIT_COMPLETE`.
+        //
+        void ExecRangeWithStealing(TLocallyExecutableRangeFunction exec, int firstId, int lastId, int flags);
+
         template <typename TBody>
         static inline auto BlockedLoopBody(const TLocalExecutor::TExecRangeParams& params, const TBody& body) {
             return [=](int blockId) {
@@ -182,6 +197,18 @@ namespace NPar {
             if (params.LastId == params.FirstId) {
                 return;
             }
+            if (params.GetBlockEqualToThreads() && (flags & WAIT_COMPLETE)) {
+                ExecRangeWithStealing(
+                    [=](int firstId, int lastId) {
+                        for (int i = firstId; i < lastId; ++i) {
+                            body(i);
+                        }
+                    },
+                    params.FirstId,
+                    params.LastId,
+                    flags);
+                return;
+            }
             if (params.GetBlockEqualToThreads()) {
                 params.SetBlockCount(GetThreadCount() + ((flags & WAIT_COMPLETE) != 0)); // ThreadCount or ThreadCount+1 depending on WaitFlag
             }
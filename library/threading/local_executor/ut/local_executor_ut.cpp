@@ -2,10 +2,13 @@
 #include <library/threading/future/future.h>
 
 #include <library/unittest/registar.h>
+#include <util/datetime/base.h>
 #include <util/system/mutex.h>
 #include <util/system/rwlock.h>
 #include <util/generic/algorithm.h>
 
+#include <atomic>
+
 using namespace NPar;
 
 class TTestException: public yexception {
@@ -369,3 +372,63 @@ Y_UNIT_TEST_SUITE(ExecLargeRangeWithThrow){
         );
     }
 };
+
+Y_UNIT_TEST_SUITE(ExecRangeWithStealing) {
+
+    static void CheckEachTaskIsExecutedOnce(int rangeSize, int threads, bool pinToCpus) {
+        TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(threads, pinToCpus);
+        TVector<std::atomic<int>> executionCounts(rangeSize);
+        localExecutor.ExecRangeWithStealing(
+            [&](int firstId, int lastId) {
+                UNIT_ASSERT(0 <= firstId && firstId < lastId && lastId <= rangeSize);
+                for (int i = firstId; i < lastId; ++i) {
+                    ++executionCounts[i];
+                }
+            },
+            0,
+            rangeSize,
+            TLocalExecutor::WAIT_COMPLETE);
+        UNIT_ASSERT(AllOf(executionCounts, [](const std::atomic<int>& count) { return count == 1; }));
+    }
+
+    Y_UNIT_TEST(EachTaskIsExecutedOnce) {
+        for (int rangeSize : {1, 2, 17, DefaultRangeSize, 100000}) {
+            for (int threads : {0, 1, 3, DefaultThreadsCount}) {
+                CheckEachTaskIsExecutedOnce(rangeSize, threads, /*pinToCpus*/ false);
+            }
+        }
+    }
+
+    Y_UNIT_TEST(EachTaskIsExecutedOnceWithPinnedThreads) {
+        CheckEachTaskIsExecutedOnce(DefaultRangeSize, DefaultThreadsCount, /*pinToCpus*/ true);
+    }
+
+    Y_UNIT_TEST(UnevenTasks) {
+        TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+        TVector<int> results(DefaultRangeSize, 0);
+        ParallelFor(localExecutor, 0, DefaultRangeSize, [&](int i) {
+            // the first part of the range is much more expensive than the rest
+            if (i < DefaultRangeSize / 4) {
+                Sleep(TDuration::MicroSeconds(100));
+            }
+            results[i] = i;
+        });
+        for (int i = 0; i < DefaultRangeSize; ++i) {
+            UNIT_ASSERT_EQUAL(results[i], i);
+        }
+    }
+
+    Y_UNIT_TEST(NestedParallelFor) {
+        TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(DefaultThreadsCount);
+        TVector<std::atomic<i64>> sums(DefaultThreadsCount);
+        ParallelFor(localExecutor, 0, DefaultThreadsCount, [&](int i) {
+            ParallelFor(localExecutor, 0, DefaultRangeSize, [&](int j) {
+                sums[i] += j;
+            });
+        });
+        UNIT_ASSERT(AllOf(sums, [](const std::atomic<i64>& sum) { return sum == DefaultRangeSize * (DefaultRangeSize - 1) / 2; }));
+    }
+};